@@ -14,6 +14,7 @@
 #include "SusyMassInfo.h"
 #include "../../objects/interface/Met.h"
 #include "../../objects/interface/PhysicsObject.h"
+#include "../../TreeReader/interface/BranchProfile.h"
 
 
 class TreeReader;
@@ -43,131 +44,141 @@ class Event{
         Event& operator=( Event&& ) noexcept; 
 
         ~Event();
+
+        //read the current entry of the TreeReader into this event, with the same options it was built with
+        //the objects of the previous entry are overwritten instead of reallocated (not possible when reading lazily)
+        void refill( const TreeReader& );
         
 
-        LeptonCollection& leptonCollection() const{ return *_leptonCollectionPtr; }
-        JetCollection& jetCollection() const{ return *_jetCollectionPtr; }
-        Met& met() const{ return *_metPtr; }
-        TriggerInfo& triggerInfo() const{ return *_triggerInfoPtr; }
+        //these accessors check that the branches they depend on were read (see BranchProfile.h)
+        LeptonCollection& leptonCollection() const;
+        JetCollection& jetCollection() const;
+        Met& met() const;
+        TriggerInfo& triggerInfo() const;
 	JetInfo& jetInfo() const{ return *_jetInfoPtr; }
-        EventTags& eventTags() const{ return *_eventTagsPtr; }
+        EventTags& eventTags() const;
         GeneratorInfo& generatorInfo() const;
         SusyMassInfo& susyMassInfo() const;
 
 	// return jet collection and met with varied JEC/JER/Uncl uncertainties
 	JetCollection getJetCollection( const std::string& variation ) const{ 
-	    return (*_jetCollectionPtr).getVariedJetCollection( variation); }
+	    return variedJetCollection( variation ); }
 	Met getMet( const std::string& variation ) const{
-	    return (*_metPtr).getVariedMet( variation); }
+	    return variedMet( variation ); }
 
         Lepton& lepton( const LeptonCollection::size_type leptonIndex ) const{ 
-	    return (*_leptonCollectionPtr)[ leptonIndex ]; }
+	    return leptonCollection()[ leptonIndex ]; }
         Jet& jet( const JetCollection::size_type jetIndex ) const{ 
-	    return (*_jetCollectionPtr)[ jetIndex ]; }
+	    return jetCollection()[ jetIndex ]; }
 
 
-        void sortLeptonsByPt() const{ _leptonCollectionPtr->sortByPt(); }
-        void sortJetsByPt() const{ _jetCollectionPtr->sortByPt(); }
+        void sortLeptonsByPt() const{ leptonCollection().sortByPt(); }
+        void sortJetsByPt() const{ jetCollection().sortByPt(); }
 
         unsigned numberOfVertices() const{ return _numberOfVertices; }
         double weight() const{ return _weight; }
 
-        double HT() const{ return _jetCollectionPtr->scalarPtSum(); }
-        double LT() const{ return _leptonCollectionPtr->scalarPtSum(); }
-        double metPt() const{ return _metPtr->pt(); }
+        double HT() const{ return jetCollection().scalarPtSum(); }
+        double LT() const{ return leptonCollection().scalarPtSum(); }
+        double metPt() const{ return met().pt(); }
         
         //jet selection and cleaning
-        void selectGoodJets() const{ _jetCollectionPtr->selectGoodJets(); }
-        void cleanJetsFromLooseLeptons( const double coneSize = 0.4 ) const{ _jetCollectionPtr->cleanJetsFromLooseLeptons( *_leptonCollectionPtr, coneSize ); }
-        void cleanJetsFromFOLeptons( const double coneSize = 0.4 ) const{ _jetCollectionPtr->cleanJetsFromFOLeptons( *_leptonCollectionPtr, coneSize ); }
-        void cleanJetsFromTightLeptons( const double coneSize = 0.4 ) const{ _jetCollectionPtr->cleanJetsFromTightLeptons( *_leptonCollectionPtr, coneSize ); }
+        void selectGoodJets() const{ jetCollection().selectGoodJets(); }
+        void cleanJetsFromLooseLeptons( const double coneSize = 0.4 ) const{ jetCollection().cleanJetsFromLooseLeptons( leptonCollection(), coneSize ); }
+        void cleanJetsFromFOLeptons( const double coneSize = 0.4 ) const{ jetCollection().cleanJetsFromFOLeptons( leptonCollection(), coneSize ); }
+        void cleanJetsFromTightLeptons( const double coneSize = 0.4 ) const{ jetCollection().cleanJetsFromTightLeptons( leptonCollection(), coneSize ); }
 
         //user specified jet selection
-        void selectJets( bool (&passSelection)( const Jet& ) ){ _jetCollectionPtr->selectObjects( passSelection ); }
+        void selectJets( bool (&passSelection)( const Jet& ) ){ jetCollection().selectObjects( passSelection ); }
 
         //b-tag collections
-        JetCollection looseBTagCollection() const{ return _jetCollectionPtr->looseBTagCollection(); }
-        JetCollection mediumBTagCollection() const{ return _jetCollectionPtr->mediumBTagCollection(); }
-        JetCollection tightBTagCollection() const{ return _jetCollectionPtr->tightBTagCollection(); }
+        JetCollection looseBTagCollection() const{ return jetCollection().looseBTagCollection(); }
+        JetCollection mediumBTagCollection() const{ return jetCollection().mediumBTagCollection(); }
+        JetCollection tightBTagCollection() const{ return jetCollection().tightBTagCollection(); }
 
         //lepton selection and cleaning
-        void selectLooseLeptons(){ _leptonCollectionPtr->selectLooseLeptons(); }
-        void selectFOLeptons(){ _leptonCollectionPtr->selectFOLeptons(); }
-        void selectTightLeptons(){ _leptonCollectionPtr->selectTightLeptons(); }
-       	void cleanElectronsFromLooseMuons( const double coneSize = 0.05 ){ _leptonCollectionPtr->cleanElectronsFromLooseMuons( coneSize ); }
-        void cleanElectronsFromFOMuons( const double coneSize = 0.05 ){ _leptonCollectionPtr->cleanElectronsFromFOMuons( coneSize ); }
-        void cleanTausFromLooseLightLeptons( const double coneSize = 0.4 ){ _leptonCollectionPtr->cleanTausFromLooseLightLeptons( coneSize ); }
-        void cleanTausFromFOLightLeptons( const double coneSize = 0.4 ){ _leptonCollectionPtr->cleanTausFromFOLightLeptons( coneSize ); }
+        void selectLooseLeptons(){ leptonCollection().selectLooseLeptons(); }
+        void selectFOLeptons(){ leptonCollection().selectFOLeptons(); }
+        void selectTightLeptons(){ leptonCollection().selectTightLeptons(); }
+       	void cleanElectronsFromLooseMuons( const double coneSize = 0.05 ){ leptonCollection().cleanElectronsFromLooseMuons( coneSize ); }
+        void cleanElectronsFromFOMuons( const double coneSize = 0.05 ){ leptonCollection().cleanElectronsFromFOMuons( coneSize ); }
+        void cleanTausFromLooseLightLeptons( const double coneSize = 0.4 ){ leptonCollection().cleanTausFromLooseLightLeptons( coneSize ); }
+        void cleanTausFromFOLightLeptons( const double coneSize = 0.4 ){ leptonCollection().cleanTausFromFOLightLeptons( coneSize ); }
 
         //separate lepton flavor collections
-        MuonCollection muonCollection() const{ return _leptonCollectionPtr->muonCollection(); }
-        ElectronCollection electronCollection() const{ return _leptonCollectionPtr->electronCollection(); }
-        TauCollection tauCollection() const{ return _leptonCollectionPtr->tauCollection(); }
-        LightLeptonCollection lightLeptonCollection() const{ return _leptonCollectionPtr->lightLeptonCollection(); }
-        LeptonCollection::size_type numberOfMuons() const{ return _leptonCollectionPtr->numberOfMuons(); }
-        LeptonCollection::size_type numberOfElectrons() const{ return _leptonCollectionPtr->numberOfElectrons(); }
-        LeptonCollection::size_type numberOfTaus() const{ return _leptonCollectionPtr->numberOfTaus(); }
-        LeptonCollection::size_type numberOfLightLeptons() const{ return _leptonCollectionPtr->numberOfLightLeptons(); }
+        MuonCollection muonCollection() const{ return leptonCollection().muonCollection(); }
+        ElectronCollection electronCollection() const{ return leptonCollection().electronCollection(); }
+        TauCollection tauCollection() const{ return leptonCollection().tauCollection(); }
+        LightLeptonCollection lightLeptonCollection() const{ return leptonCollection().lightLeptonCollection(); }
+        LeptonCollection::size_type numberOfMuons() const{ return leptonCollection().numberOfMuons(); }
+        LeptonCollection::size_type numberOfElectrons() const{ return leptonCollection().numberOfElectrons(); }
+        LeptonCollection::size_type numberOfTaus() const{ return leptonCollection().numberOfTaus(); }
+        LeptonCollection::size_type numberOfLightLeptons() const{ return leptonCollection().numberOfLightLeptons(); }
 
         //remove taus from the lepton collection
-        void removeTaus(){ _leptonCollectionPtr->removeTaus(); }
+        void removeTaus(){ leptonCollection().removeTaus(); }
 
-        //consider making these functions more efficient at some point with caching of the collections that are now generated every time
-        LightLepton& lightLepton( const LightLeptonCollection::size_type leptonIndex ) const{ return lightLeptonCollection()[ leptonIndex ]; }
-        Muon& muon( const MuonCollection::size_type muonIndex ) const{ return muonCollection()[ muonIndex ]; }
-        Electron& electron( const ElectronCollection::size_type electronIndex ) const{ return electronCollection()[ electronIndex ]; }
-        Tau& tau( const TauCollection::size_type tauIndex ) const{ return tauCollection()[ tauIndex ]; }
+        //leptons of a given flavor, using the flavor indices cached in the lepton collection
+        LightLepton& lightLepton( const LightLeptonCollection::size_type leptonIndex ) const{ return leptonCollection().lightLepton( leptonIndex ); }
+        Muon& muon( const MuonCollection::size_type muonIndex ) const{ return leptonCollection().muon( muonIndex ); }
+        Electron& electron( const ElectronCollection::size_type electronIndex ) const{ return leptonCollection().electron( electronIndex ); }
+        Tau& tau( const TauCollection::size_type tauIndex ) const{ return leptonCollection().tau( tauIndex ); }
 
         //lepton collections based on selection
-        LeptonCollection looseLeptonCollection() const{ return _leptonCollectionPtr->looseLeptonCollection(); }
-        LeptonCollection FOLeptonCollection() const{ return _leptonCollectionPtr->FOLeptonCollection(); }
-        LeptonCollection TightLeptonCollection() const{ return _leptonCollectionPtr->tightLeptonCollection(); }
-        LeptonCollection::size_type numberOfLooseLeptons() const{ return _leptonCollectionPtr->numberOfLooseLeptons(); }
-        LeptonCollection::size_type numberOfFOLeptons() const{ return _leptonCollectionPtr->numberOfFOLeptons(); }
-        LeptonCollection::size_type numberOfTightLeptons() const{ return _leptonCollectionPtr->numberOfTightLeptons(); }
+        LeptonCollection looseLeptonCollection() const{ return leptonCollection().looseLeptonCollection(); }
+        LeptonCollection FOLeptonCollection() const{ return leptonCollection().FOLeptonCollection(); }
+        LeptonCollection TightLeptonCollection() const{ return leptonCollection().tightLeptonCollection(); }
+        LeptonCollection::size_type numberOfLooseLeptons() const{ return leptonCollection().numberOfLooseLeptons(); }
+        LeptonCollection::size_type numberOfFOLeptons() const{ return leptonCollection().numberOfFOLeptons(); }
+        LeptonCollection::size_type numberOfTightLeptons() const{ return leptonCollection().numberOfTightLeptons(); }
 
         //user specified lepton selection
-        void selectLeptons( bool (&passSelection)( const Lepton& ) ){ _leptonCollectionPtr->selectObjects( passSelection ); }
+        void selectLeptons( bool (&passSelection)( const Lepton& ) ){ leptonCollection().selectObjects( passSelection ); }
         void selectLightLeptons( bool (&passSelection)( const LightLepton& ) ){ lightLeptonCollection().selectObjects( passSelection ); }
         void selectElectrons( bool (&passSelection)( const Electron& ) ){ electronCollection().selectObjects( passSelection ); }
         void selectMuons( bool (&passSelection)( const Muon& ) ){ muonCollection().selectObjects( passSelection ); }
         void selectTaus( bool (&passSelection)( const Tau& ) ){ tauCollection().selectObjects( passSelection ); }
 
         //apply lepton cone correction for fake-rate prediction
-        void applyLeptonConeCorrection() const{ _leptonCollectionPtr->applyConeCorrection(); }
+        void applyLeptonConeCorrection() const{ leptonCollection().applyConeCorrection(); }
 
         //Trigger information
-       	bool passTriggers_e() const{ return _triggerInfoPtr->passTriggers_e(); }
-        bool passTriggers_m() const{ return _triggerInfoPtr->passTriggers_m(); }
-        bool passTriggers_ee() const{ return _triggerInfoPtr->passTriggers_ee(); }
-        bool passTriggers_em() const{ return _triggerInfoPtr->passTriggers_em(); }
-        bool passTriggers_et() const{ return _triggerInfoPtr->passTriggers_et(); }
-        bool passTriggers_mm() const{ return _triggerInfoPtr->passTriggers_mm(); }
-        bool passTriggers_mt() const{ return _triggerInfoPtr->passTriggers_mt(); }
-        bool passTriggers_eee() const{ return _triggerInfoPtr->passTriggers_eee(); }
-        bool passTriggers_eem() const{ return _triggerInfoPtr->passTriggers_eem(); }
-        bool passTriggers_emm() const{ return _triggerInfoPtr->passTriggers_emm(); }
-        bool passTriggers_mmm() const{ return _triggerInfoPtr->passTriggers_mmm(); }
-        bool passTriggers_FR() const{ return _triggerInfoPtr->passTriggers_FR(); }
-        bool passTriggers_FR_iso() const{ return _triggerInfoPtr->passTriggers_FR_iso(); }
-        bool passMetFilters() const{ return _triggerInfoPtr->passMetFilters(); }
-        bool passTrigger( const std::string& triggerName ) const{ return _triggerInfoPtr->passTrigger( triggerName ); }
-        bool passMetFilter( const std::string& filterName ) const{ return _triggerInfoPtr->passMetFilter( filterName ); }
+       	bool passTriggers_e() const{ return triggerInfo().passTriggers_e(); }
+        bool passTriggers_m() const{ return triggerInfo().passTriggers_m(); }
+        bool passTriggers_ee() const{ return triggerInfo().passTriggers_ee(); }
+        bool passTriggers_em() const{ return triggerInfo().passTriggers_em(); }
+        bool passTriggers_et() const{ return triggerInfo().passTriggers_et(); }
+        bool passTriggers_mm() const{ return triggerInfo().passTriggers_mm(); }
+        bool passTriggers_mt() const{ return triggerInfo().passTriggers_mt(); }
+        bool passTriggers_eee() const{ return triggerInfo().passTriggers_eee(); }
+        bool passTriggers_eem() const{ return triggerInfo().passTriggers_eem(); }
+        bool passTriggers_emm() const{ return triggerInfo().passTriggers_emm(); }
+        bool passTriggers_mmm() const{ return triggerInfo().passTriggers_mmm(); }
+        bool passTriggers_FR() const{ return triggerInfo().passTriggers_FR(); }
+        bool passTriggers_FR_iso() const{ return triggerInfo().passTriggers_FR_iso(); }
+        bool passMetFilters() const{ return triggerInfo().passMetFilters(); }
+        bool passTrigger( const std::string& triggerName ) const;
+        bool passMetFilter( const std::string& filterName ) const;
+
+        //trigger addressed by its index in the trigger table of the tree (see TreeReader::triggerIndex), throws an std::out_of_range for invalid indices
+        bool passTrigger( const DecisionTable::size_type triggerIndex ) const;
+        bool passAnyTrigger( const DecisionSelection& triggers ) const;
+        bool passAnyMetFilter( const DecisionSelection& filters ) const;
 
         //number of leptons 
-        LeptonCollection::size_type numberOfLeptons() const{ return _leptonCollectionPtr->size(); }
+        LeptonCollection::size_type numberOfLeptons() const{ return leptonCollection().size(); }
         bool isSinglelepton() const{ return ( numberOfLeptons() == 1 ); }
         bool isDilepton() const{ return ( numberOfLeptons() == 2 ); }
         bool isTrilepton() const{ return ( numberOfLeptons() == 3 ); }
         bool isFourLepton() const{ return ( numberOfLeptons() == 4 ); }
 
         //lepton flavor and charge combinations
-        bool hasOSSFLeptonPair() const{ return _leptonCollectionPtr->hasOSSFPair(); }
-        bool hasOSSFLightLeptonPair() const{ return _leptonCollectionPtr->hasLightOSSFPair(); }
-        bool hasOSLeptonPair() const{ return _leptonCollectionPtr->hasOSPair(); }
-        bool leptonsAreSameSign() const{ return _leptonCollectionPtr->isSameSign(); }
-        LeptonCollection::size_type numberOfUniqueOSSFLeptonPairs() const{ return _leptonCollectionPtr->numberOfUniqueOSSFPairs(); }
-        LeptonCollection::size_type numberOfUniqueOSLeptonPairs() const{ return _leptonCollectionPtr->numberOfUniqueOSPairs(); }
+        bool hasOSSFLeptonPair() const{ return leptonCollection().hasOSSFPair(); }
+        bool hasOSSFLightLeptonPair() const{ return leptonCollection().hasLightOSSFPair(); }
+        bool hasOSLeptonPair() const{ return leptonCollection().hasOSPair(); }
+        bool leptonsAreSameSign() const{ return leptonCollection().isSameSign(); }
+        LeptonCollection::size_type numberOfUniqueOSSFLeptonPairs() const{ return leptonCollection().numberOfUniqueOSSFPairs(); }
+        LeptonCollection::size_type numberOfUniqueOSLeptonPairs() const{ return leptonCollection().numberOfUniqueOSPairs(); }
 
 
         //presence of a Z boson
@@ -185,22 +196,22 @@ class Event{
         double mtLeptonMet( const LeptonCollection::size_type leptonIndex ) const{ return mt( lepton( leptonIndex ), met() ); }
         
         //number of jets 
-        JetCollection::size_type numberOfJets() const{ return _jetCollectionPtr->size(); }
-        JetCollection::size_type numberOfGoodJets() const{ return _jetCollectionPtr->numberOfGoodJets(); }
+        JetCollection::size_type numberOfJets() const{ return jetCollection().size(); }
+        JetCollection::size_type numberOfGoodJets() const{ return jetCollection().numberOfGoodJets(); }
 
         //number of b-tagged jets
-        JetCollection::size_type numberOfLooseBTaggedJets() const{ return _jetCollectionPtr->numberOfLooseBTaggedJets(); }
-        JetCollection::size_type numberOfMediumBTaggedJets() const{ return _jetCollectionPtr->numberOfMediumBTaggedJets(); }
-        JetCollection::size_type numberOfTightBTaggedJets() const{ return _jetCollectionPtr->numberOfTightBTaggedJets(); }
+        JetCollection::size_type numberOfLooseBTaggedJets() const{ return jetCollection().numberOfLooseBTaggedJets(); }
+        JetCollection::size_type numberOfMediumBTaggedJets() const{ return jetCollection().numberOfMediumBTaggedJets(); }
+        JetCollection::size_type numberOfTightBTaggedJets() const{ return jetCollection().numberOfTightBTaggedJets(); }
         bool hasLooseBTaggedJet() const{ return ( numberOfLooseBTaggedJets() != 0 ); }
         bool hasMediumBTaggedJet() const{ return ( numberOfMediumBTaggedJets() != 0 ); }
         bool hasTightBTaggedJet() const{ return ( numberOfTightBTaggedJets() != 0 ); }
 
         //total lepton system
-        PhysicsObject leptonSystem() const{ return _leptonCollectionPtr->objectSum(); }
+        PhysicsObject leptonSystem() const{ return leptonCollection().objectSum(); }
 
         //total jet system 
-        PhysicsObject jetSystem() const{ return _leptonCollectionPtr->objectSum(); }
+        PhysicsObject jetSystem() const{ return leptonCollection().objectSum(); }
 
         //total lepton + jet system 
         PhysicsObject leptonJetSystem() const{ return ( leptonSystem() + jetSystem() ); }
@@ -232,18 +243,51 @@ class Event{
 	//         can be avoided...)
 
     private:
-        LeptonCollection* _leptonCollectionPtr = nullptr;
-        JetCollection* _jetCollectionPtr = nullptr;
-        Met* _metPtr = nullptr;
-        TriggerInfo* _triggerInfoPtr = nullptr;
+        //objects built from the tree are mutable since they are built on first access
+        //when the TreeReader reads lazily (see TreeReader::setLazyReading)
+        mutable LeptonCollection* _leptonCollectionPtr = nullptr;
+        mutable JetCollection* _jetCollectionPtr = nullptr;
+        mutable Met* _metPtr = nullptr;
+        mutable TriggerInfo* _triggerInfoPtr = nullptr;
 	JetInfo* _jetInfoPtr = nullptr;
         EventTags* _eventTagsPtr = nullptr;
-        GeneratorInfo* _generatorInfoPtr = nullptr;
-        SusyMassInfo* _susyMassInfoPtr = nullptr;
+        mutable GeneratorInfo* _generatorInfoPtr = nullptr;
+        mutable SusyMassInfo* _susyMassInfoPtr = nullptr;
         unsigned _numberOfVertices = 0;
         double _weight = 1;
         const Sample* _samplePtr = nullptr;
 
+        //groups of branches that were read by the TreeReader when building this event
+        BranchProfile _branchProfile;
+
+        //TreeReader from which the remaining objects are built, only set in lazy mode
+        const TreeReader* _lazyTreeReaderPtr = nullptr;
+        unsigned long _entryReadIndex = 0;
+        bool _isSusy = false;
+        bool _readIndividualTriggers = false;
+        bool _readIndividualMetFilters = false;
+        bool _readAllJECVariations = false;
+        bool _readGroupedJECVariations = false;
+        const TreeReader& lazyTreeReader( const std::string& accessorName ) const;
+
+        //requesting optional information for which the branches are not read is an error
+        void checkReadOptions( const std::string& functionName ) const;
+
+        //build objects, reading the branch groups they need first in lazy mode
+        void buildLeptonCollection( const TreeReader& ) const;
+        void buildJetCollection( const TreeReader& ) const;
+        void buildMet( const TreeReader& ) const;
+        void buildTriggerInfo( const TreeReader& ) const;
+        void buildGeneratorInfo( const TreeReader& ) const;
+        void buildSusyMassInfo( const TreeReader& ) const;
+        void copyObjects( const Event& );
+        void deleteObjects();
+        void moveObjects( Event& );
+
+        //build varied jet collections and met, checking the required branch groups
+        JetCollection variedJetCollection( const std::string& variation ) const;
+        Met variedMet( const std::string& variation ) const;
+
         //presence of Z boson
         bool ZIsInitialized = false;
         std::pair< LeptonCollection::size_type, LeptonCollection::size_type > _bestZBosonCandidateIndices;
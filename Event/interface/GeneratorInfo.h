@@ -48,7 +48,7 @@ class GeneratorInfo{
         double prefireWeightDown() const{ return _prefireWeightDown; }
         double prefireWeightUp() const{ return _prefireWeightUp; }
 
-        const GenMet& genMet() const{ return *_genMetPtr; }
+        const GenMet& genMet() const{ return _genMet; }
 
     private:
         static constexpr unsigned maxNumberOfLheWeights = 148;
@@ -66,7 +66,7 @@ class GeneratorInfo{
         double _partonLevelHT;
         float _numberOfTrueInteractions;
 
-        std::shared_ptr< GenMet > _genMetPtr;
+        GenMet _genMet;
 };
 
 #endif 
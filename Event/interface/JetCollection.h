@@ -10,7 +10,9 @@
 #include "../../objects/interface/Jet.h"
 #include "../../TreeReader/interface/TreeReader.h"
 #include "PhysicsObjectCollection.h"
+#include "ObjectPool.h"
 #include "../../objects/interface/Lepton.h"
+#include "../../Tools/interface/overlapRemoval.h"
 //#include "LeptonCollection.h"
 
 
@@ -23,6 +25,11 @@ class JetCollection : public PhysicsObjectCollection< Jet > {
 			const bool readAllJECVariations = false,
 			const bool readGroupedJECVariations = false );
 
+        //read the jets of the current entry, reusing the jets of the previous entry where possible
+        void refill( const TreeReader&,
+			const bool readAllJECVariations = false,
+			const bool readGroupedJECVariations = false );
+
         //make jet collection with b-tagged jets 
         JetCollection looseBTagCollection() const;
         JetCollection mediumBTagCollection() const;
@@ -57,6 +64,14 @@ class JetCollection : public PhysicsObjectCollection< Jet > {
         size_type minNumberOfTightBTaggedJetsAnyVariation() const;
         size_type maxNumberOfTightBTaggedJetsAnyVariation() const;
 
+        //good and b-tag decisions of the jets as bits of a mask,
+        //in the order of the collection (see also kinematicArrays)
+        static constexpr SelectionMask goodBit = 1;
+        static constexpr SelectionMask bTagLooseBit = 2;
+        static constexpr SelectionMask bTagMediumBit = 4;
+        static constexpr SelectionMask bTagTightBit = 8;
+        const std::vector< SelectionMask >& selectionMasks() const{ return PhysicsObjectCollection< Jet >::selectionMasks( &JetCollection::selectionMask ); }
+
         //clean jets 
         void cleanJetsFromLooseLeptons( const LeptonCollection&, const double coneSize = 0.4 );
         void cleanJetsFromFOLeptons( const LeptonCollection&, const double coneSize = 0.4 );
@@ -66,16 +81,29 @@ class JetCollection : public PhysicsObjectCollection< Jet > {
     private:
         
         //clean jets 
-        void cleanJetsFromLeptons(const LeptonCollection&, bool (Lepton::*passSelection)() const, const double coneSize );
+        void cleanJetsFromLeptons( const LeptonCollection&, const SelectionMask leptonSelectionBit, const double coneSize );
+        overlapRemoval::Workspace _cleaningWorkspace;
 
         //build JetCollection of jets satisfying a certain requirement
         JetCollection buildSubCollection( bool (Jet::*passSelection)() const ) const;
-        JetCollection( const std::vector< std::shared_ptr< Jet > >& jetVector ) : PhysicsObjectCollection< Jet >( jetVector ) {}
+        JetCollection buildSubCollection( const SelectionMask selectionBit ) const;
+
+        static SelectionMask selectionMask( const Jet& );
+
+        JetCollection( const std::vector< std::shared_ptr< Jet > >& jetVector, const BranchProfile& branchProfile ) : 
+            PhysicsObjectCollection< Jet >( jetVector ), _branchProfile( branchProfile ) {}
+
+        //groups of branches that were read when building the jets
+        BranchProfile _branchProfile;
+
+        //jets of earlier entries that can be reused by refill
+        ObjectPool< Jet > _jetPool;
+        void checkJetVariations( const std::string& accessorName ) const{ _branchProfile.require( BranchProfile::jetVariations, accessorName ); }
     
         //build JetCollection of varied Jets
         JetCollection buildVariedCollection( Jet (Jet::*variedJet)() const ) const;
-	JetCollection buildVariedCollection( Jet (Jet::*variedJet)(std::string) const, 
-	    std::string ) const;
+	JetCollection buildVariedCollection( Jet (Jet::*variedJet)( const JECVariationTable::size_type ) const, 
+	    const std::string& source ) const;
 
         //number of b-taged jets with variation
         std::vector< size_type > countsAnyVariation( bool ( Jet::*passSelection )() const ) const;
@@ -11,6 +11,8 @@
 #include "ElectronCollection.h"
 #include "TauCollection.h"
 #include "LightLeptonCollection.h"
+#include "ObjectPool.h"
+#include "../../Tools/interface/overlapRemoval.h"
 
 
 
@@ -19,11 +21,27 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
     public:
         LeptonCollection( const TreeReader& );
 
+        //read the leptons of the current entry, reusing the leptons of the previous entry where possible
+        void refill( const TreeReader& );
+
         MuonCollection muonCollection() const;
         ElectronCollection electronCollection() const;
         TauCollection tauCollection() const;
         LightLeptonCollection lightLeptonCollection() const;
 
+        //leptons of one flavor by their index among the leptons of that flavor, without building a new collection
+        Muon& muon( const size_type muonIndex ) const;
+        Electron& electron( const size_type electronIndex ) const;
+        Tau& tau( const size_type tauIndex ) const;
+        LightLepton& lightLepton( const size_type lightLeptonIndex ) const;
+
+        //positions of the leptons of each flavor in this collection
+        //(computed once, and again only when leptons are added, removed or reordered)
+        const std::vector< size_type >& muonIndices() const;
+        const std::vector< size_type >& electronIndices() const;
+        const std::vector< size_type >& tauIndices() const;
+        const std::vector< size_type >& lightLeptonIndices() const;
+
         //select leptons
         void selectLooseLeptons();
         void selectFOLeptons();
@@ -57,6 +75,13 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
         size_type numberOfFOLeptons() const;
         size_type numberOfTightLeptons() const;
 
+        //loose, FO and tight decisions of the leptons as bits of a mask,
+        //in the order of the collection (see also kinematicArrays)
+        static constexpr SelectionMask looseBit = 1;
+        static constexpr SelectionMask FOBit = 2;
+        static constexpr SelectionMask tightBit = 4;
+        const std::vector< SelectionMask >& selectionMasks() const;
+
         bool hasOSSFPair() const;
         bool hasLightOSSFPair() const;
         bool hasOSPair() const;
@@ -85,14 +110,38 @@ class LeptonCollection : public PhysicsObjectCollection< Lepton > {
     private:
 
         //clean electrons and taus
-        void cleanElectronsFromMuons( bool (Lepton::*passSelection)() const, const double );
-        void cleanTausFromLightLeptons( bool (Lepton::*passSelection)() const, const double );
-        void clean( bool (Lepton::*isFlavorToClean)() const, bool (Lepton::*isFlavorToCleanFrom)() const, bool (Lepton::*passSelection)() const, const double );
+        using FlavorIndicesFunction = const std::vector< size_type >& (LeptonCollection::*)() const;
+        void cleanElectronsFromMuons( const SelectionMask selectionBit, const double );
+        void cleanTausFromLightLeptons( const SelectionMask selectionBit, const double );
+        void clean( FlavorIndicesFunction flavorToClean, FlavorIndicesFunction flavorToCleanFrom, const SelectionMask selectionBit, const double );
+        overlapRemoval::Workspace _cleaningWorkspace;
 
         //build collection of objects passing given selection
         LeptonCollection selectedCollection( void (LeptonCollection::*applySelection)() ) const;
 
-        LeptonCollection( const std::vector< std::shared_ptr< Lepton > >& leptonVector ) : PhysicsObjectCollection< Lepton >( leptonVector ) {}
+        LeptonCollection( const std::vector< std::shared_ptr< Lepton > >& leptonVector, const BranchProfile& branchProfile ) : 
+            PhysicsObjectCollection< Lepton >( leptonVector ), _branchProfile( branchProfile ) {}
+
+        //groups of branches that were read when building the leptons
+        BranchProfile _branchProfile;
+
+        static SelectionMask selectionMask( const Lepton& );
+
+        //cached positions of the leptons of each flavor
+        mutable std::vector< size_type > _muonIndices;
+        mutable std::vector< size_type > _electronIndices;
+        mutable std::vector< size_type > _tauIndices;
+        mutable std::vector< size_type > _lightLeptonIndices;
+        mutable unsigned long _flavorIndicesVersion = 0;
+        mutable bool _flavorIndicesAreValid = false;
+        void updateFlavorIndices() const;
+
+        //leptons of earlier entries that can be reused by refill
+        ObjectPool< Muon > _muonPool;
+        ObjectPool< Electron > _electronPool;
+        ObjectPool< Tau > _tauPool;
+        void checkLeptonID( const std::string& accessorName ) const{ _branchProfile.require( BranchProfile::leptonID, accessorName ); }
+        void checkTaus( const std::string& accessorName ) const{ _branchProfile.require( BranchProfile::taus, accessorName ); }
 
         //determine the flavor + charge combination of the leptons
         enum FlavorCharge : unsigned int;
@@ -0,0 +1,57 @@
+/*
+Pool of physics objects that are reused when a collection is refilled for a new entry (see Event::refill).
+An object is only overwritten when the pool is the only owner left,
+objects that are still shared with other collections (e.g. copies kept by the user) are replaced by a new object.
+*/
+
+#ifndef ObjectPool_H
+#define ObjectPool_H
+
+//include c++ library classes
+#include <vector>
+#include <memory>
+
+//include other parts of framework
+#include "../../TreeReader/interface/TreeReader.h"
+
+
+template< typename ObjectType > class ObjectPool{
+
+    public:
+        using size_type = typename std::vector< std::shared_ptr< ObjectType > >::size_type;
+
+        ObjectPool() = default;
+
+        //copies start with an empty pool, since the objects of the original still belong to it
+        ObjectPool( const ObjectPool& ){}
+        ObjectPool( ObjectPool&& ) noexcept = default;
+        ObjectPool& operator=( const ObjectPool& ){ return *this; }
+        ObjectPool& operator=( ObjectPool&& ) noexcept = default;
+
+        //hand out the objects from the start of the pool again
+        void rewind(){ _nextIndex = 0; }
+
+        //object read from the given index, the extra arguments are passed to the constructor or refill function
+        template< typename... Args > std::shared_ptr< ObjectType > next( const TreeReader&, const unsigned objectIndex, const Args&... args );
+
+        size_type size() const{ return _objects.size(); }
+
+    private:
+        std::vector< std::shared_ptr< ObjectType > > _objects;
+        size_type _nextIndex = 0;
+};
+
+
+template< typename ObjectType > template< typename... Args >
+std::shared_ptr< ObjectType > ObjectPool< ObjectType >::next( const TreeReader& treeReader, const unsigned objectIndex, const Args&... args ){
+    if( _nextIndex == _objects.size() ){
+        _objects.push_back( std::make_shared< ObjectType >( treeReader, objectIndex, args... ) );
+    } else if( _objects[ _nextIndex ].use_count() == 1 ){
+        _objects[ _nextIndex ]->refill( treeReader, objectIndex, args... );
+    } else {
+        _objects[ _nextIndex ] = std::make_shared< ObjectType >( treeReader, objectIndex, args... );
+    }
+    return _objects[ _nextIndex++ ];
+}
+
+#endif
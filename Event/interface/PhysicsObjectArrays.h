@@ -0,0 +1,52 @@
+/*
+Kinematics of the objects of a collection stored as contiguous arrays (one array per quantity),
+so that loops over all objects of an event (sums, counts, overlap removal) run over plain arrays
+instead of following a pointer to every object (see PhysicsObjectCollection::kinematicArrays).
+The arrays are a cache filled from the objects of the collection, which remain the storage of the objects.
+*/
+
+#ifndef PhysicsObjectArrays_H
+#define PhysicsObjectArrays_H
+
+//include c++ library classes
+#include <vector>
+
+//include other parts of framework
+#include "../../objects/interface/PhysicsObject.h"
+
+
+class PhysicsObjectArrays{
+
+    public:
+        using size_type = std::vector< double >::size_type;
+
+        PhysicsObjectArrays() = default;
+
+        //remove all objects while keeping the allocated capacity
+        void clear();
+        void reserve( const size_type );
+        void push_back( const PhysicsObject& );
+
+        size_type size() const{ return _pt.size(); }
+
+        const std::vector< double >& pt() const{ return _pt; }
+        const std::vector< double >& eta() const{ return _eta; }
+        const std::vector< double >& phi() const{ return _phi; }
+        const std::vector< double >& energy() const{ return _energy; }
+        const std::vector< double >& px() const{ return _px; }
+        const std::vector< double >& py() const{ return _py; }
+        const std::vector< double >& pz() const{ return _pz; }
+
+        double scalarPtSum() const;
+
+    private:
+        std::vector< double > _pt;
+        std::vector< double > _eta;
+        std::vector< double > _phi;
+        std::vector< double > _energy;
+        std::vector< double > _px;
+        std::vector< double > _py;
+        std::vector< double > _pz;
+};
+
+#endif
@@ -6,6 +6,8 @@
 #include <memory>
 #include <algorithm>
 
+//include other parts of framework
+#include "PhysicsObjectArrays.h"
 
 
 template< typename ObjectType > class PhysicsObjectCollection {
@@ -16,6 +18,7 @@ template< typename ObjectType > class PhysicsObjectCollection {
         using const_iterator = typename collection_type::const_iterator;
         using value_type = typename collection_type::value_type;
         using size_type = typename collection_type::size_type;
+        using SelectionMask = unsigned char;
 
         PhysicsObjectCollection() {}
         ~PhysicsObjectCollection() = default;
@@ -48,9 +51,39 @@ template< typename ObjectType > class PhysicsObjectCollection {
         //return a vector of all possible object pairs
         std::vector< std::pair< std::shared_ptr< ObjectType >, std::shared_ptr< ObjectType > > > pairCollection() const;
 
+        //changes whenever objects are added, removed or reordered, so that information derived from the collection can be cached
+        unsigned long version() const{ return _version; }
+
+        //kinematics of all objects as contiguous arrays, in the order of the collection
+        //(filled once from the objects, and again only when the collection or one of its objects changes)
+        const PhysicsObjectArrays& kinematicArrays() const;
+
     protected:
         PhysicsObjectCollection( const collection_type& col ) : collection( col ) {}
 
+        //add an object that is already allocated, or remove all objects while keeping the allocated capacity
+        //(used to refill collections from an ObjectPool)
+        void push_back( const std::shared_ptr< ObjectType >& );
+        void clear(){ collection.clear(); ++_version; }
+
+        //to be called when the objects themselves are modified in a way that can change cached information
+        void markChanged() const{ ++_version; }
+
+        //the objects are shared with other collections and events that can modify them,
+        //so information cached from the objects also records the sum of their generations
+        unsigned long objectGenerationSum() const;
+
+        //selection decisions of each object packed in the bits of a mask, computed once by the given function
+        //and reused until the collection or one of its objects changes (a derived collection should always use the same function)
+        using SelectionMaskFunction = SelectionMask (*)( const ObjectType& );
+        const std::vector< SelectionMask >& selectionMasks( SelectionMaskFunction ) const;
+        size_type countSelectionBit( SelectionMaskFunction, const SelectionMask ) const;
+        void selectObjectsWithBit( SelectionMaskFunction, const SelectionMask );
+
+        //keep the objects for which the function of their index returns true and remove the others in a single pass
+        //(the selection masks of the remaining objects stay valid)
+        template< typename KeepFunction > void keepObjects( const KeepFunction& );
+
         //select objects passing a threshold and remove the others 
         void selectObjects( bool (ObjectType::*passSelection)() const );
 
@@ -61,30 +94,143 @@ template< typename ObjectType > class PhysicsObjectCollection {
 
     private:
         collection_type collection;
+        mutable unsigned long _version = 0;
+
+        bool selectionMasksAreCurrent() const;
+        bool kinematicArraysAreCurrent() const;
+
+        mutable std::vector< SelectionMask > _selectionMasks;
+        mutable unsigned long _selectionMasksVersion = 0;
+        mutable unsigned long _selectionMasksGeneration = 0;
+        mutable bool _selectionMasksAreValid = false;
+
+        mutable PhysicsObjectArrays _kinematicArrays;
+        mutable unsigned long _kinematicArraysVersion = 0;
+        mutable unsigned long _kinematicArraysGeneration = 0;
+        mutable bool _kinematicArraysAreValid = false;
 };
 
 
 
 template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::push_back( const ObjectType& physicsObject ){
     collection.push_back( std::shared_ptr< ObjectType >( physicsObject.clone() ) );
+    ++_version;
 }
 
 
 template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::push_back( ObjectType&& physicsObject ){
     collection.push_back( std::shared_ptr< ObjectType >( std::move( physicsObject ).clone() ) );
+    ++_version;
+}
+
+
+template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::push_back( const std::shared_ptr< ObjectType >& objectPtr ){
+    collection.push_back( objectPtr );
+    ++_version;
 }
 
 
 template< typename ObjectType > template< typename func > void PhysicsObjectCollection< ObjectType >::sortByAttribute( const func& f ){
     std::sort( begin(), end(), f );
+    ++_version;
 }
 
 
 template< typename ObjectType > template< typename IteratorType > IteratorType PhysicsObjectCollection< ObjectType >::erase( IteratorType it ){
+    ++_version;
     return collection.erase( it );
 } 
 
 
+//generations only increase, so the sum changes whenever one of the objects is modified
+template< typename ObjectType > unsigned long PhysicsObjectCollection< ObjectType >::objectGenerationSum() const{
+    unsigned long generationSum = 0;
+    for( const auto& objectPtr : collection ){
+        generationSum += objectPtr->generation();
+    }
+    return generationSum;
+}
+
+
+template< typename ObjectType > bool PhysicsObjectCollection< ObjectType >::selectionMasksAreCurrent() const{
+    return ( _selectionMasksAreValid && _selectionMasksVersion == _version && _selectionMasksGeneration == objectGenerationSum() );
+}
+
+
+template< typename ObjectType > bool PhysicsObjectCollection< ObjectType >::kinematicArraysAreCurrent() const{
+    return ( _kinematicArraysAreValid && _kinematicArraysVersion == _version && _kinematicArraysGeneration == objectGenerationSum() );
+}
+
+
+template< typename ObjectType > const std::vector< typename PhysicsObjectCollection< ObjectType >::SelectionMask >& PhysicsObjectCollection< ObjectType >::selectionMasks( SelectionMaskFunction maskFunction ) const{
+    if( !selectionMasksAreCurrent() ){
+        _selectionMasks.clear();
+        for( const auto& objectPtr : collection ){
+            _selectionMasks.push_back( maskFunction( *objectPtr ) );
+        }
+        _selectionMasksVersion = _version;
+        _selectionMasksGeneration = objectGenerationSum();
+        _selectionMasksAreValid = true;
+    }
+    return _selectionMasks;
+}
+
+
+template< typename ObjectType > const PhysicsObjectArrays& PhysicsObjectCollection< ObjectType >::kinematicArrays() const{
+    if( !kinematicArraysAreCurrent() ){
+        _kinematicArrays.clear();
+        _kinematicArrays.reserve( collection.size() );
+        for( const auto& objectPtr : collection ){
+            _kinematicArrays.push_back( *objectPtr );
+        }
+        _kinematicArraysVersion = _version;
+        _kinematicArraysGeneration = objectGenerationSum();
+        _kinematicArraysAreValid = true;
+    }
+    return _kinematicArrays;
+}
+
+
+template< typename ObjectType > typename PhysicsObjectCollection< ObjectType >::size_type PhysicsObjectCollection< ObjectType >::countSelectionBit( SelectionMaskFunction maskFunction, const SelectionMask selectionBit ) const{
+    size_type counter = 0;
+    for( const auto mask : selectionMasks( maskFunction ) ){
+        if( mask & selectionBit ){
+            ++counter;
+        }
+    }
+    return counter;
+}
+
+
+template< typename ObjectType > template< typename KeepFunction > void PhysicsObjectCollection< ObjectType >::keepObjects( const KeepFunction& keepObject ){
+    const bool masksAreValid = selectionMasksAreCurrent();
+    size_type numberOfKept = 0;
+    for( size_type i = 0; i < collection.size(); ++i ){
+        if( keepObject( i ) ){
+            if( numberOfKept != i ){
+                collection[ numberOfKept ] = std::move( collection[ i ] );
+                if( masksAreValid ) _selectionMasks[ numberOfKept ] = _selectionMasks[ i ];
+            }
+            ++numberOfKept;
+        }
+    }
+    collection.resize( numberOfKept );
+    ++_version;
+    if( masksAreValid ){
+        _selectionMasks.resize( numberOfKept );
+        _selectionMasksVersion = _version;
+        _selectionMasksGeneration = objectGenerationSum();
+    }
+}
+
+
+//the masks of the remaining objects stay valid, so other selections can still use them
+template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::selectObjectsWithBit( SelectionMaskFunction maskFunction, const SelectionMask selectionBit ){
+    const std::vector< SelectionMask >& masks = selectionMasks( maskFunction );
+    keepObjects( [&]( const size_type i ){ return ( masks[ i ] & selectionBit ) != 0; } );
+}
+
+
 template< typename ObjectType > void PhysicsObjectCollection< ObjectType >::selectObjects( bool (ObjectType::*passSelection)() const ){
     for( const_iterator it = cbegin(); it != cend(); ){
         if( !( (**it).*passSelection)() ){
@@ -134,7 +280,11 @@ template< typename ObjectType > double PhysicsObjectCollection< ObjectType >::ma
 }
 
 
+//the arrays are only used when they are already filled, building them for a single sum is slower than the direct loop
 template< typename ObjectType > double PhysicsObjectCollection< ObjectType >::scalarPtSum() const{
+    if( kinematicArraysAreCurrent() ){
+        return _kinematicArrays.scalarPtSum();
+    }
     double ptSum = 0;
     for( const auto& object : *this ){
         ptSum += object->pt();
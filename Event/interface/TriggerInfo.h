@@ -2,20 +2,24 @@
 #define TriggerInfo_H
 
 //include c++ library classes 
-#include <map>
 #include <string>
+#include <memory>
 
 //include other parts of framework
 #include "../../TreeReader/interface/TreeReader.h"
+#include "../../TreeReader/interface/DecisionTable.h"
 
 
 class TriggerInfo{
 
     public:
 
-        //WARNING : turning on 'readIndividualTriggers' and/or 'readIndividualMETFilters' is relatively slow ( takes slightly more time than building the entire event! )
+        //individual triggers and MET filters are stored as bitsets indexed by the tables of the TreeReader
         TriggerInfo( const TreeReader&, const bool readIndividualTriggers = false, const bool readIndividualMetFilters = false );
 
+        //read a new entry, reusing the storage of the bitsets
+        void refill( const TreeReader&, const bool readIndividualTriggers = false, const bool readIndividualMetFilters = false );
+
         bool passTriggers_e() const{ return _passTriggers_e; }
         bool passTriggers_m() const{ return _passTriggers_m; }
         bool passTriggers_ee() const{ return _passTriggers_ee; }
@@ -33,6 +37,18 @@ class TriggerInfo{
         bool passTrigger( const std::string& ) const;
         bool passMetFilter( const std::string& ) const;
 
+        //decisions addressed by their index in triggerTable() or metFilterTable()
+        bool passTrigger( const DecisionTable::size_type triggerIndex ) const{ return DecisionTable::testBit( _triggerBits, triggerIndex ); }
+        bool passMetFilter( const DecisionTable::size_type filterIndex ) const{ return DecisionTable::testBit( _metFilterBits, filterIndex ); }
+
+        //check whether any trigger (filter) of a selection is passed at once
+        bool passAnyTrigger( const DecisionSelection& triggers ) const{ return DecisionTable::passAny( _triggerBits, triggers.mask( _triggerTable ) ); }
+        bool passAnyMetFilter( const DecisionSelection& filters ) const{ return DecisionTable::passAny( _metFilterBits, filters.mask( _metFilterTable ) ); }
+
+        //nullptr if the individual triggers (filters) were not read
+        const std::shared_ptr< const DecisionTable >& triggerTable() const{ return _triggerTable; }
+        const std::shared_ptr< const DecisionTable >& metFilterTable() const{ return _metFilterTable; }
+
         void printAvailableIndividualTriggers() const;
         void printAvailableMetFilters() const;
 
@@ -51,8 +67,10 @@ class TriggerInfo{
         bool _passTriggers_FR;
         bool _passTriggers_FR_iso;
         bool _passMetFilters;
-        std::map< std::string, bool > individualTriggerMap; 
-        std::map< std::string, bool > individualMetFilterMap; 
+        std::shared_ptr< const DecisionTable > _triggerTable;
+        std::shared_ptr< const DecisionTable > _metFilterTable;
+        DecisionTable::Bits _triggerBits;
+        DecisionTable::Bits _metFilterBits;
 };
 
 #endif 
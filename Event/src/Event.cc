@@ -9,111 +9,300 @@
 Event::Event( const TreeReader& treeReader, 
 		const bool readIndividualTriggers , const bool readIndividualMetFilters,
 		const bool readAllJECVariations, const bool readGroupedJECVariations ) :
-    // make collections of physics objects
-    _leptonCollectionPtr( new LeptonCollection( treeReader ) ),
-    _jetCollectionPtr( new JetCollection( treeReader,
-			readAllJECVariations, readGroupedJECVariations ) ),
-    _metPtr( new Met( treeReader,
-			readAllJECVariations, readGroupedJECVariations ) ),
     // make additional information structures
-    _triggerInfoPtr( new TriggerInfo( treeReader, 
-			readIndividualTriggers, readIndividualMetFilters ) ),
     _jetInfoPtr( new JetInfo( treeReader, 
 			readAllJECVariations, readGroupedJECVariations ) ),
-    _eventTagsPtr( new EventTags( treeReader ) ),
-    _generatorInfoPtr( treeReader.isMC() ? new GeneratorInfo( treeReader ) : nullptr ),
-    _susyMassInfoPtr( treeReader.isSusy() ? new SusyMassInfo( treeReader ) : nullptr ),
+    _eventTagsPtr( treeReader.branchProfile().isEnabled( BranchProfile::eventInfo ) ? new EventTags( treeReader ) : nullptr ),
     _numberOfVertices( treeReader._nVertex ),
 
     //WARNING : use treeReader::_scaledWeight instead of treeReader::_weight since the former already includes cross-section and lumiosity scaling
     _weight( treeReader._scaledWeight ),
-    _samplePtr( treeReader.currentSamplePtr() )
-    {}
+    _samplePtr( treeReader.currentSamplePtr() ),
+    _branchProfile( treeReader.branchProfile() ),
+    _entryReadIndex( treeReader.entryReadIndex() ),
+    _isSusy( treeReader.isSusy() ),
+    _readIndividualTriggers( readIndividualTriggers ),
+    _readIndividualMetFilters( readIndividualMetFilters ),
+    _readAllJECVariations( readAllJECVariations ),
+    _readGroupedJECVariations( readGroupedJECVariations )
+{
+    checkReadOptions( "Event::Event" );
+
+    //in lazy mode the physics objects are only built (and their branches read) on first access
+    if( treeReader.lazyReading() ){
+        _lazyTreeReaderPtr = &treeReader;
+        return;
+    }
+
+    // make collections of physics objects
+    // objects of which the branch group is disabled are not built, their accessors throw (see BranchProfile::require)
+    buildLeptonCollection( treeReader );
+    buildJetCollection( treeReader );
+    if( _branchProfile.isEnabled( BranchProfile::met ) ) buildMet( treeReader );
+    if( _branchProfile.isEnabled( BranchProfile::triggers ) ) buildTriggerInfo( treeReader );
+
+    //generator and SUSY information are only built when their branches are read
+    if( treeReader.isMC() && _branchProfile.isEnabled( BranchProfile::generatorInfo ) ){
+        buildGeneratorInfo( treeReader );
+    }
+    if( _isSusy && _branchProfile.isEnabled( BranchProfile::susyMasses ) ){
+        buildSusyMassInfo( treeReader );
+    }
+}
+
+
+void Event::checkReadOptions( const std::string& functionName ) const{
+    if( _readIndividualTriggers ){
+	_branchProfile.require( BranchProfile::individualTriggers, functionName );
+    }
+    if( _readIndividualMetFilters ){
+	_branchProfile.require( BranchProfile::metFilters, functionName );
+    }
+    if( _readAllJECVariations ){
+	_branchProfile.require( BranchProfile::JECSources, functionName );
+    }
+    if( _readGroupedJECVariations ){
+	_branchProfile.require( BranchProfile::JECGrouped, functionName );
+    }
+}
+
+
+void Event::refill( const TreeReader& treeReader ){
+    if( treeReader.lazyReading() ){
+        throw std::domain_error( "ERROR in Event::refill: events can not be refilled from a TreeReader that reads lazily, use TreeReader::buildEvent instead." );
+    }
+    _branchProfile = treeReader.branchProfile();
+    checkReadOptions( "Event::refill" );
+
+    _numberOfVertices = treeReader._nVertex;
+    _weight = treeReader._scaledWeight;
+    _samplePtr = treeReader.currentSamplePtr();
+    _lazyTreeReaderPtr = nullptr;
+    _entryReadIndex = treeReader.entryReadIndex();
+    _isSusy = treeReader.isSusy();
+    ZIsInitialized = false;
+
+    //objects that are already there are overwritten, objects that were not built yet (e.g. when this event was read lazily) are built
+    if( _leptonCollectionPtr ){
+        _leptonCollectionPtr->refill( treeReader );
+    } else {
+        buildLeptonCollection( treeReader );
+    }
+    if( _jetCollectionPtr ){
+        _jetCollectionPtr->refill( treeReader, _readAllJECVariations, _readGroupedJECVariations );
+    } else {
+        buildJetCollection( treeReader );
+    }
+    //objects of which the branch group is disabled are removed
+    if( !_branchProfile.isEnabled( BranchProfile::met ) ){
+        delete _metPtr;
+        _metPtr = nullptr;
+    } else if( _metPtr ){
+        *_metPtr = Met( treeReader, _readAllJECVariations, _readGroupedJECVariations );
+    } else {
+        buildMet( treeReader );
+    }
+    if( !_branchProfile.isEnabled( BranchProfile::triggers ) ){
+        delete _triggerInfoPtr;
+        _triggerInfoPtr = nullptr;
+    } else if( _triggerInfoPtr ){
+        _triggerInfoPtr->refill( treeReader, _readIndividualTriggers, _readIndividualMetFilters );
+    } else {
+        buildTriggerInfo( treeReader );
+    }
+    *_jetInfoPtr = JetInfo( treeReader, _readAllJECVariations, _readGroupedJECVariations );
+    if( !_branchProfile.isEnabled( BranchProfile::eventInfo ) ){
+        delete _eventTagsPtr;
+        _eventTagsPtr = nullptr;
+    } else if( _eventTagsPtr ){
+        *_eventTagsPtr = EventTags( treeReader );
+    } else {
+        _eventTagsPtr = new EventTags( treeReader );
+    }
+
+    //generator and SUSY information are removed when the new entry does not have them
+    if( treeReader.isMC() && _branchProfile.isEnabled( BranchProfile::generatorInfo ) ){
+        if( _generatorInfoPtr ){
+            *_generatorInfoPtr = GeneratorInfo( treeReader );
+        } else {
+            buildGeneratorInfo( treeReader );
+        }
+    } else {
+        delete _generatorInfoPtr;
+        _generatorInfoPtr = nullptr;
+    }
+    if( _isSusy && _branchProfile.isEnabled( BranchProfile::susyMasses ) ){
+        if( _susyMassInfoPtr ){
+            *_susyMassInfoPtr = SusyMassInfo( treeReader );
+        } else {
+            buildSusyMassInfo( treeReader );
+        }
+    } else {
+        delete _susyMassInfoPtr;
+        _susyMassInfoPtr = nullptr;
+    }
+}
+
+
+void Event::buildLeptonCollection( const TreeReader& treeReader ) const{
+    treeReader.loadBranchGroups( { BranchProfile::leptonKinematics, BranchProfile::leptonVariations,
+        BranchProfile::leptonID, BranchProfile::leptonGenMatch, BranchProfile::taus } );
+    _leptonCollectionPtr = new LeptonCollection( treeReader );
+}
+
+
+void Event::buildJetCollection( const TreeReader& treeReader ) const{
+    treeReader.loadBranchGroups( { BranchProfile::jets, BranchProfile::jetVariations } );
+    if( _readAllJECVariations ) treeReader.loadBranchGroups( { BranchProfile::JECSources } );
+    if( _readGroupedJECVariations ) treeReader.loadBranchGroups( { BranchProfile::JECGrouped } );
+    _jetCollectionPtr = new JetCollection( treeReader, _readAllJECVariations, _readGroupedJECVariations );
+}
+
+
+void Event::buildMet( const TreeReader& treeReader ) const{
+    treeReader.loadBranchGroups( { BranchProfile::met, BranchProfile::metVariations } );
+    if( _readAllJECVariations ) treeReader.loadBranchGroups( { BranchProfile::JECSources } );
+    if( _readGroupedJECVariations ) treeReader.loadBranchGroups( { BranchProfile::JECGrouped } );
+    _metPtr = new Met( treeReader, _readAllJECVariations, _readGroupedJECVariations );
+}
+
+
+void Event::buildTriggerInfo( const TreeReader& treeReader ) const{
+    treeReader.loadBranchGroups( { BranchProfile::triggers } );
+    if( _readIndividualTriggers ) treeReader.loadBranchGroups( { BranchProfile::individualTriggers } );
+    if( _readIndividualMetFilters ) treeReader.loadBranchGroups( { BranchProfile::metFilters } );
+    _triggerInfoPtr = new TriggerInfo( treeReader, _readIndividualTriggers, _readIndividualMetFilters );
+}
+
+
+void Event::buildGeneratorInfo( const TreeReader& treeReader ) const{
+    treeReader.loadBranchGroups( { BranchProfile::generatorInfo } );
+    _generatorInfoPtr = new GeneratorInfo( treeReader );
+}
+
+
+void Event::buildSusyMassInfo( const TreeReader& treeReader ) const{
+    treeReader.loadBranchGroups( { BranchProfile::susyMasses } );
+    _susyMassInfoPtr = new SusyMassInfo( treeReader );
+}
+
+
+const TreeReader& Event::lazyTreeReader( const std::string& accessorName ) const{
+    if( _lazyTreeReaderPtr == nullptr ){
+        throw std::domain_error( "ERROR in " + accessorName + ": object was not built and this event is not read lazily." );
+    }
+    if( _lazyTreeReaderPtr->entryReadIndex() != _entryReadIndex ){
+        std::string message = "ERROR in " + accessorName + ":";
+        message += " the TreeReader this event was lazily read from has moved on to another entry,";
+        message += " objects that were not accessed before can no longer be built.";
+        throw std::domain_error( message );
+    }
+    return *_lazyTreeReaderPtr;
+}
 
 
 Event::~Event(){
+    deleteObjects();
+}
+
+
+void Event::deleteObjects(){
     delete _leptonCollectionPtr;
     delete _jetCollectionPtr;
     delete _metPtr;
     delete _triggerInfoPtr;
     delete _jetInfoPtr;
     delete _eventTagsPtr;
-    if( hasGeneratorInfo() ){
-        delete _generatorInfoPtr;
-    }
-    if( hasSusyMassInfo() ){
-        delete _susyMassInfoPtr;
-    }
+    delete _generatorInfoPtr;
+    delete _susyMassInfoPtr;
 }
 
 
-Event::Event( const Event& rhs ) :
-    _leptonCollectionPtr( new LeptonCollection( *rhs._leptonCollectionPtr ) ),
-    _jetCollectionPtr( new JetCollection( *rhs._jetCollectionPtr ) ),
-    _metPtr( new Met( *rhs._metPtr ) ),
-    _triggerInfoPtr( new TriggerInfo( *rhs._triggerInfoPtr ) ),
-    _jetInfoPtr( new JetInfo( *rhs._jetInfoPtr ) ),
-    _eventTagsPtr( new EventTags( *rhs._eventTagsPtr ) ),
-    _generatorInfoPtr( rhs.hasGeneratorInfo() ? new GeneratorInfo( *rhs._generatorInfoPtr ) : nullptr ),
-    _susyMassInfoPtr( rhs.hasSusyMassInfo() ? new SusyMassInfo( *rhs._susyMassInfoPtr ) : nullptr ),
-    _numberOfVertices( rhs._numberOfVertices ),
-    _weight( rhs._weight ),
-    _samplePtr( rhs._samplePtr )
-    {}
+//objects that were not built yet in lazy mode remain unbuilt in the copy
+void Event::copyObjects( const Event& rhs ){
+    _leptonCollectionPtr = rhs._leptonCollectionPtr ? new LeptonCollection( *rhs._leptonCollectionPtr ) : nullptr;
+    _jetCollectionPtr = rhs._jetCollectionPtr ? new JetCollection( *rhs._jetCollectionPtr ) : nullptr;
+    _metPtr = rhs._metPtr ? new Met( *rhs._metPtr ) : nullptr;
+    _triggerInfoPtr = rhs._triggerInfoPtr ? new TriggerInfo( *rhs._triggerInfoPtr ) : nullptr;
+    _jetInfoPtr = new JetInfo( *rhs._jetInfoPtr );
+    _eventTagsPtr = rhs._eventTagsPtr ? new EventTags( *rhs._eventTagsPtr ) : nullptr;
+    _generatorInfoPtr = rhs.hasGeneratorInfo() ? new GeneratorInfo( *rhs._generatorInfoPtr ) : nullptr;
+    _susyMassInfoPtr = rhs.hasSusyMassInfo() ? new SusyMassInfo( *rhs._susyMassInfoPtr ) : nullptr;
+}
 
 
-Event::Event( Event&& rhs ) noexcept :
-    _leptonCollectionPtr( rhs._leptonCollectionPtr ),
-    _jetCollectionPtr( rhs._jetCollectionPtr ),
-    _metPtr( rhs._metPtr ),
-    _triggerInfoPtr( rhs._triggerInfoPtr ),
-    _jetInfoPtr( rhs._jetInfoPtr ),
-    _eventTagsPtr( rhs._eventTagsPtr ),
-    _generatorInfoPtr( rhs._generatorInfoPtr ),
-    _susyMassInfoPtr( rhs._susyMassInfoPtr ),
-    _numberOfVertices( rhs._numberOfVertices ),
-    _weight( rhs._weight ),
-    _samplePtr( rhs._samplePtr )
-{
+void Event::moveObjects( Event& rhs ){
+    _leptonCollectionPtr = rhs._leptonCollectionPtr;
     rhs._leptonCollectionPtr = nullptr;
+    _jetCollectionPtr = rhs._jetCollectionPtr;
     rhs._jetCollectionPtr = nullptr;
+    _metPtr = rhs._metPtr;
     rhs._metPtr = nullptr;
+    _triggerInfoPtr = rhs._triggerInfoPtr;
     rhs._triggerInfoPtr = nullptr;
+    _jetInfoPtr = rhs._jetInfoPtr;
     rhs._jetInfoPtr = nullptr;
+    _eventTagsPtr = rhs._eventTagsPtr;
     rhs._eventTagsPtr = nullptr;
+    _generatorInfoPtr = rhs._generatorInfoPtr;
     rhs._generatorInfoPtr = nullptr;
+    _susyMassInfoPtr = rhs._susyMassInfoPtr;
     rhs._susyMassInfoPtr = nullptr;
+}
+
+
+Event::Event( const Event& rhs ) :
+    _numberOfVertices( rhs._numberOfVertices ),
+    _weight( rhs._weight ),
+    _samplePtr( rhs._samplePtr ),
+    _branchProfile( rhs._branchProfile ),
+    _lazyTreeReaderPtr( rhs._lazyTreeReaderPtr ),
+    _entryReadIndex( rhs._entryReadIndex ),
+    _isSusy( rhs._isSusy ),
+    _readIndividualTriggers( rhs._readIndividualTriggers ),
+    _readIndividualMetFilters( rhs._readIndividualMetFilters ),
+    _readAllJECVariations( rhs._readAllJECVariations ),
+    _readGroupedJECVariations( rhs._readGroupedJECVariations )
+{
+    copyObjects( rhs );
+}
+
+
+Event::Event( Event&& rhs ) noexcept :
+    _numberOfVertices( rhs._numberOfVertices ),
+    _weight( rhs._weight ),
+    _samplePtr( rhs._samplePtr ),
+    _branchProfile( rhs._branchProfile ),
+    _lazyTreeReaderPtr( rhs._lazyTreeReaderPtr ),
+    _entryReadIndex( rhs._entryReadIndex ),
+    _isSusy( rhs._isSusy ),
+    _readIndividualTriggers( rhs._readIndividualTriggers ),
+    _readIndividualMetFilters( rhs._readIndividualMetFilters ),
+    _readAllJECVariations( rhs._readAllJECVariations ),
+    _readGroupedJECVariations( rhs._readGroupedJECVariations )
+{
+    moveObjects( rhs );
     rhs._samplePtr = nullptr;
+    rhs._lazyTreeReaderPtr = nullptr;
 }
-    
+
 
 Event& Event::operator=( const Event& rhs ){
     if( this != &rhs ){
-        delete _leptonCollectionPtr;
-        delete _jetCollectionPtr;
-        delete _metPtr;
-        delete _triggerInfoPtr;
-	delete _jetInfoPtr;
-        delete _eventTagsPtr;
-        if( hasGeneratorInfo() ){
-            delete _generatorInfoPtr;
-        }
-        if( hasSusyMassInfo() ){
-            delete _susyMassInfoPtr;
-        }
-
-        _leptonCollectionPtr = new LeptonCollection( *rhs._leptonCollectionPtr );
-        _jetCollectionPtr = new JetCollection( *rhs._jetCollectionPtr );
-        _metPtr = new Met( *rhs._metPtr );
-        _triggerInfoPtr = new TriggerInfo( *rhs._triggerInfoPtr );
-	_jetInfoPtr = new JetInfo( *rhs._jetInfoPtr );
-        _eventTagsPtr = new EventTags( *rhs._eventTagsPtr );
-        _generatorInfoPtr = rhs.hasGeneratorInfo() ? new GeneratorInfo( *rhs._generatorInfoPtr ) : nullptr;
-        _susyMassInfoPtr = rhs.hasSusyMassInfo() ? new SusyMassInfo( *rhs._susyMassInfoPtr ) : nullptr;
+        deleteObjects();
+        copyObjects( rhs );
 
         _numberOfVertices = rhs._numberOfVertices;
         _weight = rhs._weight;
         _samplePtr = rhs._samplePtr;
+        _branchProfile = rhs._branchProfile;
+        _lazyTreeReaderPtr = rhs._lazyTreeReaderPtr;
+        _entryReadIndex = rhs._entryReadIndex;
+        _isSusy = rhs._isSusy;
+        _readIndividualTriggers = rhs._readIndividualTriggers;
+        _readIndividualMetFilters = rhs._readIndividualMetFilters;
+        _readAllJECVariations = rhs._readAllJECVariations;
+        _readGroupedJECVariations = rhs._readGroupedJECVariations;
     }
     return *this;
 }
@@ -121,39 +310,21 @@ Event& Event::operator=( const Event& rhs ){
 
 Event& Event::operator=( Event&& rhs ) noexcept{
     if( this != &rhs ){
-        delete _leptonCollectionPtr;
-        delete _jetCollectionPtr;
-        delete _metPtr;
-        delete _triggerInfoPtr;
-	delete _jetInfoPtr;
-        delete _eventTagsPtr;
-        if( hasGeneratorInfo() ){
-            delete _generatorInfoPtr;
-        }
-        if( hasSusyMassInfo() ){
-            delete _susyMassInfoPtr;
-        }
-
-        _leptonCollectionPtr = rhs._leptonCollectionPtr;
-        rhs._leptonCollectionPtr = nullptr;
-        _jetCollectionPtr = rhs._jetCollectionPtr;
-        rhs._jetCollectionPtr = nullptr;
-        _metPtr = rhs._metPtr;
-        rhs._metPtr = nullptr;
-        _triggerInfoPtr = rhs._triggerInfoPtr;
-        rhs._triggerInfoPtr = nullptr;
-	_jetInfoPtr = rhs._jetInfoPtr;
-	rhs._jetInfoPtr = nullptr;
-        _eventTagsPtr = rhs._eventTagsPtr;
-        rhs._eventTagsPtr = nullptr;
-        _generatorInfoPtr = rhs._generatorInfoPtr;
-        rhs._generatorInfoPtr = nullptr;
-        _susyMassInfoPtr = rhs._susyMassInfoPtr;
-        rhs._susyMassInfoPtr = nullptr;
+        deleteObjects();
+        moveObjects( rhs );
 
         _numberOfVertices = rhs._numberOfVertices;
         _weight = rhs._weight;
         _samplePtr = rhs._samplePtr;
+        _branchProfile = rhs._branchProfile;
+        _lazyTreeReaderPtr = rhs._lazyTreeReaderPtr;
+        rhs._lazyTreeReaderPtr = nullptr;
+        _entryReadIndex = rhs._entryReadIndex;
+        _isSusy = rhs._isSusy;
+        _readIndividualTriggers = rhs._readIndividualTriggers;
+        _readIndividualMetFilters = rhs._readIndividualMetFilters;
+        _readAllJECVariations = rhs._readAllJECVariations;
+        _readGroupedJECVariations = rhs._readGroupedJECVariations;
     }
     return *this;
 }
@@ -167,6 +338,10 @@ void Event::checkGeneratorInfo() const{
 
 
 GeneratorInfo& Event::generatorInfo() const{
+    _branchProfile.require( BranchProfile::generatorInfo, "Event::generatorInfo" );
+    if( !hasGeneratorInfo() && _lazyTreeReaderPtr && isMC() ){
+        buildGeneratorInfo( lazyTreeReader( "Event::generatorInfo" ) );
+    }
     checkGeneratorInfo();
     return *_generatorInfoPtr;
 }
@@ -180,11 +355,104 @@ void Event::checkSusyMassInfo() const{
 
 
 SusyMassInfo& Event::susyMassInfo() const{
+    _branchProfile.require( BranchProfile::susyMasses, "Event::susyMassInfo" );
+    if( !hasSusyMassInfo() && _lazyTreeReaderPtr && _isSusy ){
+        buildSusyMassInfo( lazyTreeReader( "Event::susyMassInfo" ) );
+    }
     checkSusyMassInfo();
     return *_susyMassInfoPtr;
 }
 
 
+LeptonCollection& Event::leptonCollection() const{
+    _branchProfile.require( BranchProfile::leptonKinematics, "Event::leptonCollection" );
+    if( !_leptonCollectionPtr ) buildLeptonCollection( lazyTreeReader( "Event::leptonCollection" ) );
+    return *_leptonCollectionPtr;
+}
+
+
+JetCollection& Event::jetCollection() const{
+    _branchProfile.require( BranchProfile::jets, "Event::jetCollection" );
+    if( !_jetCollectionPtr ) buildJetCollection( lazyTreeReader( "Event::jetCollection" ) );
+    return *_jetCollectionPtr;
+}
+
+
+Met& Event::met() const{
+    _branchProfile.require( BranchProfile::met, "Event::met" );
+    if( !_metPtr ) buildMet( lazyTreeReader( "Event::met" ) );
+    return *_metPtr;
+}
+
+
+TriggerInfo& Event::triggerInfo() const{
+    _branchProfile.require( BranchProfile::triggers, "Event::triggerInfo" );
+    if( !_triggerInfoPtr ) buildTriggerInfo( lazyTreeReader( "Event::triggerInfo" ) );
+    return *_triggerInfoPtr;
+}
+
+
+EventTags& Event::eventTags() const{
+    _branchProfile.require( BranchProfile::eventInfo, "Event::eventTags" );
+    return *_eventTagsPtr;
+}
+
+
+bool Event::passTrigger( const std::string& triggerName ) const{
+    _branchProfile.require( BranchProfile::individualTriggers, "Event::passTrigger" );
+    return triggerInfo().passTrigger( triggerName );
+}
+
+
+bool Event::passTrigger( const DecisionTable::size_type triggerIndex ) const{
+    _branchProfile.require( BranchProfile::individualTriggers, "Event::passTrigger" );
+    const std::shared_ptr< const DecisionTable >& triggerTable = triggerInfo().triggerTable();
+    if( !triggerTable || triggerIndex >= triggerTable->size() ){
+        throw std::out_of_range( "ERROR in Event::passTrigger: trigger index " + std::to_string( triggerIndex ) 
+            + " is out of range for the individual triggers of this event." );
+    }
+    return triggerInfo().passTrigger( triggerIndex );
+}
+
+
+bool Event::passMetFilter( const std::string& filterName ) const{
+    _branchProfile.require( BranchProfile::metFilters, "Event::passMetFilter" );
+    return triggerInfo().passMetFilter( filterName );
+}
+
+
+bool Event::passAnyTrigger( const DecisionSelection& triggers ) const{
+    _branchProfile.require( BranchProfile::individualTriggers, "Event::passAnyTrigger" );
+    return triggerInfo().passAnyTrigger( triggers );
+}
+
+
+bool Event::passAnyMetFilter( const DecisionSelection& filters ) const{
+    _branchProfile.require( BranchProfile::metFilters, "Event::passAnyMetFilter" );
+    return triggerInfo().passAnyMetFilter( filters );
+}
+
+
+JetCollection Event::variedJetCollection( const std::string& variation ) const{
+    // (split JEC sources are checked when the event is built)
+    if( variation == "JECDown" || variation == "JECUp" 
+	|| variation == "JERDown" || variation == "JERUp" ){
+	_branchProfile.require( BranchProfile::jetVariations, "Event::getJetCollection" );
+    }
+    return jetCollection().getVariedJetCollection( variation );
+}
+
+
+Met Event::variedMet( const std::string& variation ) const{
+    // (split JEC sources are checked when the event is built)
+    if( variation == "JECDown" || variation == "JECUp" 
+	|| variation == "UnclDown" || variation == "UnclUp" ){
+	_branchProfile.require( BranchProfile::metVariations, "Event::getMet" );
+    }
+    return met().getVariedMet( variation );
+}
+
+
 void Event::initializeZBosonCandidate(){
     if( !ZIsInitialized ){
 
@@ -195,7 +463,7 @@ void Event::initializeZBosonCandidate(){
         sortLeptonsByPt();
 
         //reconstruct the best Z boson
-        std::pair< std::pair< LeptonCollection::size_type, LeptonCollection::size_type >, double > ZBosonCandidateIndicesAndMass = _leptonCollectionPtr->bestZBosonCandidateIndicesAndMass();
+        std::pair< std::pair< LeptonCollection::size_type, LeptonCollection::size_type >, double > ZBosonCandidateIndicesAndMass = leptonCollection().bestZBosonCandidateIndicesAndMass();
         _bestZBosonCandidateIndices = ZBosonCandidateIndicesAndMass.first;
         _bestZBosonCandidateMass = ZBosonCandidateIndicesAndMass.second;
 
@@ -253,6 +521,7 @@ double Event::mtW(){
 // experimental stage! need to check what attributes are copied or modified in-place!
 
 void Event::setLeptonCollection( const LeptonCollection& lepCollection ){
+    delete _leptonCollectionPtr;
     _leptonCollectionPtr = new LeptonCollection( lepCollection);
 }
 
@@ -15,7 +15,7 @@ GeneratorInfo::GeneratorInfo( const TreeReader& treeReader ) :
     _zgEventType( treeReader._zgEventType ),
     _partonLevelHT( treeReader._lheHTIncoming ),
     _numberOfTrueInteractions( treeReader._nTrueInt ),
-    _genMetPtr( new GenMet( treeReader ) )
+    _genMet( treeReader )
 { 
     if( _numberOfLheWeights > maxNumberOfLheWeights ){
 	std::string message = "ERROR in GeneratorInfo::GeneratorInfo:";
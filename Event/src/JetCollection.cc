@@ -8,46 +8,59 @@
 JetCollection::JetCollection( const TreeReader& treeReader,
 				const bool readAllJECVariations,
 				const bool readGroupedJECVariations ){
+    refill( treeReader, readAllJECVariations, readGroupedJECVariations );
+}
+
+
+void JetCollection::refill( const TreeReader& treeReader,
+				const bool readAllJECVariations,
+				const bool readGroupedJECVariations ){
+    clear();
+    _branchProfile = treeReader.branchProfile();
+    _jetPool.rewind();
+
+    //jet multiplicity is not read, the collection can not be filled
+    if( !_branchProfile.isEnabled( BranchProfile::jets ) ) return;
+
     for( unsigned j = 0; j < treeReader._nJets; ++j ){
-        this->push_back( Jet( treeReader, j, readAllJECVariations, readGroupedJECVariations ) ); 
+        this->push_back( _jetPool.next( treeReader, j, readAllJECVariations, readGroupedJECVariations ) ); 
     }
 }
 
 
 void JetCollection::selectGoodJets(){
-    selectObjects( &Jet::isGood );
+    selectObjectsWithBit( &JetCollection::selectionMask, goodBit );
 }
 
 
 void JetCollection::selectGoodAnyVariationJets(){
+    checkJetVariations( "JetCollection::selectGoodAnyVariationJets" );
     selectObjects( &Jet::isGoodAnyVariation );
 }
 
 
-void JetCollection::cleanJetsFromLeptons( const LeptonCollection& leptonCollection, bool (Lepton::*passSelection)() const, const double coneSize ){
-    for( const_iterator jetIt = cbegin(); jetIt != cend(); ){
-        Jet& jet = **jetIt;
-
-        //increment iterator if jet is not deleted 
-        bool isDeleted = false;
-        for( LeptonCollection::const_iterator lIt = leptonCollection.cbegin(); lIt != leptonCollection.cend(); ++lIt ){
-            Lepton& lepton = **lIt;
-
-            //lepton must pass specified selection
-            if( !(lepton.*passSelection)() ) continue;
+void JetCollection::cleanJetsFromLeptons( const LeptonCollection& leptonCollection, const SelectionMask leptonSelectionBit, const double coneSize ){
 
-            //remove jet if it overlaps with a selected lepton
-            if( deltaR( jet, lepton ) < coneSize ){
-
-                jetIt = erase( jetIt );
-                isDeleted = true;
-                break;
-            }
-        }
-        if( !isDeleted ){
-            ++jetIt;
+    //leptons passing the selection
+    const PhysicsObjectArrays& leptonArrays = leptonCollection.kinematicArrays();
+    const std::vector< SelectionMask >& leptonMasks = leptonCollection.selectionMasks();
+    _cleaningWorkspace.referenceEta.clear();
+    _cleaningWorkspace.referencePhi.clear();
+    for( LeptonCollection::size_type l = 0; l < leptonArrays.size(); ++l ){
+        if( leptonMasks[ l ] & leptonSelectionBit ){
+            _cleaningWorkspace.referenceEta.push_back( leptonArrays.eta()[ l ] );
+            _cleaningWorkspace.referencePhi.push_back( leptonArrays.phi()[ l ] );
         }
     }
+    if( _cleaningWorkspace.referenceEta.empty() ) return;
+
+    //remove jets that overlap with a selected lepton
+    const PhysicsObjectArrays& jetArrays = kinematicArrays();
+    overlapRemoval::outsideConesMask( jetArrays.eta().data(), jetArrays.phi().data(), jetArrays.size(),
+        _cleaningWorkspace.referenceEta.data(), _cleaningWorkspace.referencePhi.data(), _cleaningWorkspace.referenceEta.size(),
+        coneSize, _cleaningWorkspace.mask );
+    const std::vector< unsigned char >& isOutsideCones = _cleaningWorkspace.mask;
+    keepObjects( [&]( const size_type j ){ return isOutsideCones[ j ] != 0; } );
 }
 
 
@@ -60,12 +73,36 @@ JetCollection JetCollection::buildSubCollection( bool (Jet::*passSelection)() co
             jetVector.push_back( jetPtr );
         }
     }
-    return JetCollection( jetVector );
+    return JetCollection( jetVector, _branchProfile );
+}
+
+
+JetCollection JetCollection::buildSubCollection( const SelectionMask selectionBit ) const{
+    const std::vector< SelectionMask >& masks = selectionMasks();
+    std::vector< std::shared_ptr< Jet > > jetVector;
+    for( size_type i = 0; i < size(); ++i ){
+        if( masks[ i ] & selectionBit ){
+
+            //jets are shared between collections!
+            jetVector.push_back( cbegin()[ i ] );
+        }
+    }
+    return JetCollection( jetVector, _branchProfile );
+}
+
+
+JetCollection::SelectionMask JetCollection::selectionMask( const Jet& jet ){
+    SelectionMask mask = 0;
+    if( jet.isGood() ) mask |= goodBit;
+    if( jet.isBTaggedLoose() ) mask |= bTagLooseBit;
+    if( jet.isBTaggedMedium() ) mask |= bTagMediumBit;
+    if( jet.isBTaggedTight() ) mask |= bTagTightBit;
+    return mask;
 }
 
 
 JetCollection JetCollection::goodJetCollection() const{
-    return buildSubCollection( &Jet::isGood );
+    return buildSubCollection( goodBit );
 }
 
 
@@ -75,40 +112,43 @@ JetCollection JetCollection::goodAnyVariationJetCollection() const{
 
 
 JetCollection JetCollection::looseBTagCollection() const{
-    return buildSubCollection( &Jet::isBTaggedLoose );
+    return buildSubCollection( bTagLooseBit );
 }
 
 
 JetCollection JetCollection::mediumBTagCollection() const{
-    return buildSubCollection( &Jet::isBTaggedMedium );
+    return buildSubCollection( bTagMediumBit );
 }
 
 
 JetCollection JetCollection::tightBTagCollection() const{
-    return buildSubCollection( &Jet::isBTaggedTight );
+    return buildSubCollection( bTagTightBit );
 }
 
 
 JetCollection JetCollection::buildVariedCollection( Jet (Jet::*variedJet)() const ) const{
+    checkJetVariations( "JetCollection::buildVariedCollection" );
     std::vector< std::shared_ptr< Jet > > jetVector;
     for( const auto& jetPtr : *this ){
 
         //jets are NOT shared between collections!
         jetVector.push_back( std::make_shared< Jet >( (*jetPtr.*variedJet)() ) );
     }
-    return JetCollection( jetVector );
+    return JetCollection( jetVector, _branchProfile );
 }
 
-JetCollection JetCollection::buildVariedCollection( Jet (Jet::*variedJet)(std::string) const, 
-    std::string variationArg ) const{
-    // similar to above but with argument passed to Jet::*variedJet
+JetCollection JetCollection::buildVariedCollection( Jet (Jet::*variedJet)( const JECVariationTable::size_type ) const, 
+    const std::string& source ) const{
+    // similar to above, the variation is looked up once since all jets share the same JECVariationTable
     std::vector< std::shared_ptr< Jet > > jetVector;
+    if( size() == 0 ) return JetCollection( jetVector, _branchProfile );
+    const JECVariationTable::size_type variationIndex = (*this)[0].JECVariationIndex( source );
     for( const auto& jetPtr : *this ){
 
         //jets are NOT shared between collections!
-        jetVector.push_back( std::make_shared< Jet >( (*jetPtr.*variedJet)( variationArg ) ) );
+        jetVector.push_back( std::make_shared< Jet >( (*jetPtr.*variedJet)( variationIndex ) ) );
     }
-    return JetCollection( jetVector );
+    return JetCollection( jetVector, _branchProfile );
 }
 
 JetCollection JetCollection::JECDownCollection() const{
@@ -167,42 +207,43 @@ JetCollection JetCollection::getVariedJetCollection( const std::string& variatio
 
 
 JetCollection::size_type JetCollection::numberOfLooseBTaggedJets() const{
-    return count( &Jet::isBTaggedLoose );
+    return countSelectionBit( &JetCollection::selectionMask, bTagLooseBit );
 }
 
 
 JetCollection::size_type JetCollection::numberOfMediumBTaggedJets() const{
-    return count( &Jet::isBTaggedMedium );
+    return countSelectionBit( &JetCollection::selectionMask, bTagMediumBit );
 }
 
 
 JetCollection::size_type JetCollection::numberOfTightBTaggedJets() const{
-    return count( &Jet::isBTaggedTight );
+    return countSelectionBit( &JetCollection::selectionMask, bTagTightBit );
 }
 
 
 JetCollection::size_type JetCollection::numberOfGoodJets() const{
-    return count( &Jet::isGood );
+    return countSelectionBit( &JetCollection::selectionMask, goodBit );
 }
 
 
 JetCollection::size_type JetCollection::numberOfGoodAnyVariationJets() const{
+    checkJetVariations( "JetCollection::numberOfGoodAnyVariationJets" );
     return count( &Jet::isGoodAnyVariation );
 }
 
 
 void JetCollection::cleanJetsFromLooseLeptons( const LeptonCollection& leptonCollection, const double coneSize ){
-    cleanJetsFromLeptons( leptonCollection, &Lepton::isLoose, coneSize );
+    cleanJetsFromLeptons( leptonCollection, LeptonCollection::looseBit, coneSize );
 } 
 
 
 void JetCollection::cleanJetsFromFOLeptons( const LeptonCollection& leptonCollection, const double coneSize ){
-    cleanJetsFromLeptons( leptonCollection, &Lepton::isFO, coneSize );
+    cleanJetsFromLeptons( leptonCollection, LeptonCollection::FOBit, coneSize );
 } 
 
 
 void JetCollection::cleanJetsFromTightLeptons( const LeptonCollection& leptonCollection, const double coneSize ){
-    cleanJetsFromLeptons( leptonCollection, &Lepton::isTight, coneSize );
+    cleanJetsFromLeptons( leptonCollection, LeptonCollection::tightBit, coneSize );
 }
 
 
@@ -5,37 +5,21 @@
 #include <stdexcept>
 
 // include other parts of the framework
-#include "../../Tools/interface/stringTools.h"
-
-std::string cleanJECVariationName( std::string branchName ){
-    // convert a branch name holding a JEC variation into the pure JEC variation name
-    std::string jecName = stringTools::removeOccurencesOf(branchName,"_jetPt_");
-    jecName = stringTools::removeOccurencesOf(jecName,"_jetSmearedPt_");
-    jecName = stringTools::removeOccurencesOf(jecName,"_JECSourcesUp");
-    jecName = stringTools::removeOccurencesOf(jecName,"_JECSourcesDown");
-    jecName = stringTools::removeOccurencesOf(jecName,"_JECGroupedUp");
-    jecName = stringTools::removeOccurencesOf(jecName,"_JECGroupedDown");
-    return jecName;
-}
+#include "../../TreeReader/interface/TreeReader.h"
 
 JetInfo::JetInfo( const TreeReader& treeReader, 
 		  const bool readAllJECVariations,
 		  const bool readGroupedJECVariations ){
+    // note: the names are taken from the smeared jet pt up variations,
+    // as up/down and pt/smearedPt are supposed to contain the same variations
     _JECSources = std::vector< std::string >();
     _JECGrouped = std::vector< std::string >();
+    if( !treeReader._JECVariationTable ) return;
     if( readAllJECVariations ){
-	for( auto mapEl: treeReader._jetSmearedPt_JECSourcesUp ){
-	    // note: in principle only checking one branch should be enough
-	    // as up/down and pt/smearedPt are supposed to contain the same variations
-	    _JECSources.push_back( cleanJECVariationName(mapEl.first) );
-	}
+	_JECSources = treeReader._JECVariationTable->sourceNames();
     }
     if( readGroupedJECVariations ){
-	for( auto mapEl: treeReader._jetSmearedPt_JECGroupedUp ){
-	    // note: in principle only checking one branch should be enough
-            // as up/down and pt/smearedPt are supposed to contain the same variations
-            _JECGrouped.push_back( cleanJECVariationName(mapEl.first) );
-	}
+	_JECGrouped = treeReader._JECVariationTable->groupedNames();
     }
 }
 
@@ -11,30 +11,113 @@
 
 
 LeptonCollection::LeptonCollection( const TreeReader& treeReader ){
+    refill( treeReader );
+}
+
+
+void LeptonCollection::refill( const TreeReader& treeReader ){
+    clear();
+    _branchProfile = treeReader.branchProfile();
+    _muonPool.rewind();
+    _electronPool.rewind();
+    _tauPool.rewind();
+
+    //lepton multiplicities are not read, the collection can not be filled
+    if( !_branchProfile.isEnabled( BranchProfile::leptonKinematics ) ) return;
 
     //add muons to lepton collection
     for( unsigned m = 0; m < treeReader._nMu; ++m){
-        push_back( Muon( treeReader, m ) );
+        push_back( _muonPool.next( treeReader, m ) );
     }
 
     //add electrons to lepton collection
     for( unsigned e = treeReader._nMu; e < treeReader._nLight; ++ e){
-        push_back( Electron( treeReader, e ) );
+        push_back( _electronPool.next( treeReader, e ) );
     } 
 
     //add taus to lepton collection
+    if( !_branchProfile.isEnabled( BranchProfile::taus ) ) return;
     for( unsigned t = treeReader._nLight; t < treeReader._nL; ++t){
-        push_back( Tau( treeReader, t ) );
+        push_back( _tauPool.next( treeReader, t ) );
+    }
+}
+
+
+void LeptonCollection::updateFlavorIndices() const{
+    if( _flavorIndicesAreValid && _flavorIndicesVersion == version() ) return;
+    _muonIndices.clear();
+    _electronIndices.clear();
+    _tauIndices.clear();
+    _lightLeptonIndices.clear();
+    for( size_type i = 0; i < size(); ++i ){
+        const Lepton& lepton = (*this)[ i ];
+        if( lepton.isMuon() ){
+            _muonIndices.push_back( i );
+        } else if( lepton.isElectron() ){
+            _electronIndices.push_back( i );
+        } else if( lepton.isTau() ){
+            _tauIndices.push_back( i );
+        }
+        if( lepton.isLightLepton() ){
+            _lightLeptonIndices.push_back( i );
+        }
     }
+    _flavorIndicesVersion = version();
+    _flavorIndicesAreValid = true;
+}
+
+
+const std::vector< LeptonCollection::size_type >& LeptonCollection::muonIndices() const{
+    updateFlavorIndices();
+    return _muonIndices;
+}
+
+
+const std::vector< LeptonCollection::size_type >& LeptonCollection::electronIndices() const{
+    updateFlavorIndices();
+    return _electronIndices;
+}
+
+
+const std::vector< LeptonCollection::size_type >& LeptonCollection::tauIndices() const{
+    checkTaus( "LeptonCollection::tauIndices" );
+    updateFlavorIndices();
+    return _tauIndices;
+}
+
+
+const std::vector< LeptonCollection::size_type >& LeptonCollection::lightLeptonIndices() const{
+    updateFlavorIndices();
+    return _lightLeptonIndices;
+}
+
+
+Muon& LeptonCollection::muon( const size_type muonIndex ) const{
+    return static_cast< Muon& >( *( cbegin()[ muonIndices().at( muonIndex ) ] ) );
+}
+
+
+Electron& LeptonCollection::electron( const size_type electronIndex ) const{
+    return static_cast< Electron& >( *( cbegin()[ electronIndices().at( electronIndex ) ] ) );
+}
+
+
+Tau& LeptonCollection::tau( const size_type tauIndex ) const{
+    return static_cast< Tau& >( *( cbegin()[ tauIndices().at( tauIndex ) ] ) );
 }
 
 
+LightLepton& LeptonCollection::lightLepton( const size_type lightLeptonIndex ) const{
+    return static_cast< LightLepton& >( *( cbegin()[ lightLeptonIndices().at( lightLeptonIndex ) ] ) );
+}
+
+
+//the flavor collections share their leptons with this collection
 MuonCollection LeptonCollection::muonCollection() const{
     std::vector< std::shared_ptr< Muon > > muonVector;
-    for( const auto& leptonPtr : *this ){
-        if( leptonPtr->isMuon() ){
-            muonVector.push_back( std::static_pointer_cast< Muon >( leptonPtr ) );
-        }
+    muonVector.reserve( muonIndices().size() );
+    for( const auto index : muonIndices() ){
+        muonVector.push_back( std::static_pointer_cast< Muon >( cbegin()[ index ] ) );
     }
     return MuonCollection( muonVector );
 }
@@ -42,21 +125,20 @@ MuonCollection LeptonCollection::muonCollection() const{
 
 ElectronCollection LeptonCollection::electronCollection() const{
     std::vector< std::shared_ptr< Electron > > electronVector;
-    for( const auto& leptonPtr : *this ){
-        if( leptonPtr->isElectron() ){
-            electronVector.push_back( std::static_pointer_cast< Electron >( leptonPtr ) );
-        }
+    electronVector.reserve( electronIndices().size() );
+    for( const auto index : electronIndices() ){
+        electronVector.push_back( std::static_pointer_cast< Electron >( cbegin()[ index ] ) );
     }
     return ElectronCollection( electronVector );
 }
 
 
 TauCollection LeptonCollection::tauCollection() const{
+    checkTaus( "LeptonCollection::tauCollection" );
     std::vector< std::shared_ptr< Tau > > tauVector;
-    for( const auto& leptonPtr : *this  ){
-        if( leptonPtr->isTau() ){
-            tauVector.push_back( std::static_pointer_cast< Tau >( leptonPtr ) );
-        }
+    tauVector.reserve( tauIndices().size() );
+    for( const auto index : tauIndices() ){
+        tauVector.push_back( std::static_pointer_cast< Tau >( cbegin()[ index ] ) );
     }
     return TauCollection( tauVector );
 }
@@ -64,27 +146,44 @@ TauCollection LeptonCollection::tauCollection() const{
 
 LightLeptonCollection LeptonCollection::lightLeptonCollection() const{
     std::vector< std::shared_ptr< LightLepton > > lightLeptonVector;
-    for( const auto leptonPtr : *this ){
-        if( leptonPtr->isLightLepton() ){
-            lightLeptonVector.push_back( std::static_pointer_cast< LightLepton >( leptonPtr ) );
-        }
+    lightLeptonVector.reserve( lightLeptonIndices().size() );
+    for( const auto index : lightLeptonIndices() ){
+        lightLeptonVector.push_back( std::static_pointer_cast< LightLepton >( cbegin()[ index ] ) );
     }
     return LightLeptonCollection( lightLeptonVector );
 }
 
 
+LeptonCollection::SelectionMask LeptonCollection::selectionMask( const Lepton& lepton ){
+    SelectionMask mask = 0;
+    if( lepton.isLoose() ) mask |= looseBit;
+    if( lepton.isFO() ) mask |= FOBit;
+    if( lepton.isTight() ) mask |= tightBit;
+    return mask;
+}
+
+
+const std::vector< LeptonCollection::SelectionMask >& LeptonCollection::selectionMasks() const{
+    checkLeptonID( "LeptonCollection::selectionMasks" );
+    return PhysicsObjectCollection< Lepton >::selectionMasks( &LeptonCollection::selectionMask );
+}
+
+
 void LeptonCollection::selectLooseLeptons(){
-    selectObjects( &Lepton::isLoose );
+    checkLeptonID( "LeptonCollection::selectLooseLeptons" );
+    selectObjectsWithBit( &LeptonCollection::selectionMask, looseBit );
 }
 
 
 void LeptonCollection::selectFOLeptons(){
-    selectObjects( &Lepton::isFO );
+    checkLeptonID( "LeptonCollection::selectFOLeptons" );
+    selectObjectsWithBit( &LeptonCollection::selectionMask, FOBit );
 }
 
 
 void LeptonCollection::selectTightLeptons(){
-    selectObjects( &Lepton::isTight );
+    checkLeptonID( "LeptonCollection::selectTightLeptons" );
+    selectObjectsWithBit( &LeptonCollection::selectionMask, tightBit );
 }
 
 
@@ -129,115 +228,128 @@ LeptonCollection LeptonCollection::leadingLeptonCollection( LeptonCollection::si
             break;
         }
     }
-    return LeptonCollection( leptonVector );
+    return LeptonCollection( leptonVector, _branchProfile );
 }
 
 
-void LeptonCollection::clean( bool (Lepton::*isFlavorToClean)() const, bool (Lepton::*isFlavorToCleanFrom)() const, bool (Lepton::*passSelection)() const, const double coneSize ){
+void LeptonCollection::clean( FlavorIndicesFunction flavorToClean, FlavorIndicesFunction flavorToCleanFrom, const SelectionMask selectionBit, const double coneSize ){
+    checkLeptonID( "LeptonCollection::clean" );
+    const PhysicsObjectArrays& arrays = kinematicArrays();
+    const std::vector< SelectionMask >& masks = selectionMasks();
 
-    for( const_iterator l1It = cbegin(); l1It != cend(); ){
-        Lepton& l1 = **l1It;
-
-        //to increment iterator when no lepton is deleted 
-        bool isDeleted = false;
-        if( (l1.*isFlavorToClean)() ){
-
-            for( const_iterator l2It = cbegin(); l2It != cend(); ++l2It ){
-
-                //prevent comparing same objects 
-                if( l1It == l2It ) continue;
-
-                Lepton& l2 = **l2It;
-
-                //make sure l2 passes required selection for cleaning 
-                if( ! ( (l2.*isFlavorToCleanFrom)() && (l2.*passSelection)() ) ) continue;
-
-                //clean within given cone size
-                if( deltaR( l1, l2 ) < coneSize ){
-
-                    l1It = erase( l1It );
-                    isDeleted = true;
-
-                    break;
-                }
-            }
-        }
-        if( ! isDeleted ){
-            ++l1It;
+    //leptons to clean from must pass the required selection
+    _cleaningWorkspace.referenceEta.clear();
+    _cleaningWorkspace.referencePhi.clear();
+    for( const auto index : (this->*flavorToCleanFrom)() ){
+        if( masks[ index ] & selectionBit ){
+            _cleaningWorkspace.referenceEta.push_back( arrays.eta()[ index ] );
+            _cleaningWorkspace.referencePhi.push_back( arrays.phi()[ index ] );
         }
     }
+    if( _cleaningWorkspace.referenceEta.empty() ) return;
+
+    //the flavors differ, so removing a lepton never changes the leptons that are cleaned from
+    const std::vector< size_type >& indicesToClean = (this->*flavorToClean)();
+    _cleaningWorkspace.eta.clear();
+    _cleaningWorkspace.phi.clear();
+    for( const auto index : indicesToClean ){
+        _cleaningWorkspace.eta.push_back( arrays.eta()[ index ] );
+        _cleaningWorkspace.phi.push_back( arrays.phi()[ index ] );
+    }
+    overlapRemoval::outsideConesMask( _cleaningWorkspace.eta.data(), _cleaningWorkspace.phi.data(), _cleaningWorkspace.eta.size(),
+        _cleaningWorkspace.referenceEta.data(), _cleaningWorkspace.referencePhi.data(), _cleaningWorkspace.referenceEta.size(),
+        coneSize, _cleaningWorkspace.mask );
+
+    //keepObjects goes through the leptons in order, and the flavor indices are sorted
+    const std::vector< unsigned char >& isOutsideCones = _cleaningWorkspace.mask;
+    std::vector< size_type >::size_type nextToClean = 0;
+    keepObjects( [&]( const size_type i ){
+        if( nextToClean < indicesToClean.size() && indicesToClean[ nextToClean ] == i ){
+            return isOutsideCones[ nextToClean++ ] != 0;
+        }
+        return true;
+    } );
 }
 
 
-void LeptonCollection::cleanElectronsFromMuons( bool (Lepton::*passSelection)() const, const double coneSize ){
-    return clean( &Lepton::isElectron, &Lepton::isMuon, passSelection, coneSize );
+void LeptonCollection::cleanElectronsFromMuons( const SelectionMask selectionBit, const double coneSize ){
+    return clean( &LeptonCollection::electronIndices, &LeptonCollection::muonIndices, selectionBit, coneSize );
 }
 
 
-void LeptonCollection::cleanTausFromLightLeptons( bool (Lepton::*passSelection)() const, const double coneSize ){
-    return clean( &Lepton::isTau, &Lepton::isLightLepton, passSelection, coneSize );
+void LeptonCollection::cleanTausFromLightLeptons( const SelectionMask selectionBit, const double coneSize ){
+    checkTaus( "LeptonCollection::cleanTausFromLightLeptons" );
+    return clean( &LeptonCollection::tauIndices, &LeptonCollection::lightLeptonIndices, selectionBit, coneSize );
 }
 
 
 void LeptonCollection::cleanElectronsFromLooseMuons( const double coneSize ){
-    return cleanElectronsFromMuons( &Lepton::isLoose, coneSize );
+    return cleanElectronsFromMuons( looseBit, coneSize );
 }
 
 
 void LeptonCollection::cleanElectronsFromFOMuons( const double coneSize ){
-    return cleanElectronsFromMuons( &Lepton::isFO, coneSize );
+    return cleanElectronsFromMuons( FOBit, coneSize );
 }
 
 
 void LeptonCollection::cleanTausFromLooseLightLeptons( const double coneSize ){
-    return cleanTausFromLightLeptons( &Lepton::isLoose, coneSize );
+    return cleanTausFromLightLeptons( looseBit, coneSize );
 }
 
 
 void LeptonCollection::cleanTausFromFOLightLeptons( const double coneSize ){
-    return cleanTausFromLightLeptons( &Lepton::isFO, coneSize );
+    return cleanTausFromLightLeptons( FOBit, coneSize );
 }
 
 
 void LeptonCollection::applyConeCorrection() const{
+    checkLeptonID( "LeptonCollection::applyConeCorrection" );
     for( const auto& leptonPtr : *this ){
         leptonPtr->applyConeCorrection();
     }
+
+    //the corrected momenta can change the selection decisions
+    markChanged();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfMuons() const{
-    return count( &Lepton::isMuon );
+    return muonIndices().size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfElectrons() const{
-    return count( &Lepton::isElectron );
+    return electronIndices().size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfTaus() const{
-    return count( &Lepton::isTau );
+    checkTaus( "LeptonCollection::numberOfTaus" );
+    return tauIndices().size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfLightLeptons() const{
-    return count( &Lepton::isLightLepton );
+    return lightLeptonIndices().size();
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfLooseLeptons() const{
-    return count( &Lepton::isLoose );
+    checkLeptonID( "LeptonCollection::numberOfLooseLeptons" );
+    return countSelectionBit( &LeptonCollection::selectionMask, looseBit );
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfFOLeptons() const{
-    return count( &Lepton::isFO );
+    checkLeptonID( "LeptonCollection::numberOfFOLeptons" );
+    return countSelectionBit( &LeptonCollection::selectionMask, FOBit );
 }
 
 
 LeptonCollection::size_type LeptonCollection::numberOfTightLeptons() const{
-    return count( &Lepton::isTight );
+    checkLeptonID( "LeptonCollection::numberOfTightLeptons" );
+    return countSelectionBit( &LeptonCollection::selectionMask, tightBit );
 }
 
 
@@ -398,7 +510,7 @@ LeptonCollection LeptonCollection::buildVariedElectronCollection(
 	}
 	else{ lepVector.push_back( lepPtr ); }
     }
-    return LeptonCollection( lepVector );
+    return LeptonCollection( lepVector, _branchProfile );
 }
 
 LeptonCollection LeptonCollection::electronScaleDownCollection() const{
@@ -0,0 +1,43 @@
+#include "../interface/PhysicsObjectArrays.h"
+
+
+void PhysicsObjectArrays::clear(){
+    _pt.clear();
+    _eta.clear();
+    _phi.clear();
+    _energy.clear();
+    _px.clear();
+    _py.clear();
+    _pz.clear();
+}
+
+
+void PhysicsObjectArrays::reserve( const size_type numberOfObjects ){
+    _pt.reserve( numberOfObjects );
+    _eta.reserve( numberOfObjects );
+    _phi.reserve( numberOfObjects );
+    _energy.reserve( numberOfObjects );
+    _px.reserve( numberOfObjects );
+    _py.reserve( numberOfObjects );
+    _pz.reserve( numberOfObjects );
+}
+
+
+void PhysicsObjectArrays::push_back( const PhysicsObject& object ){
+    _pt.push_back( object.pt() );
+    _eta.push_back( object.eta() );
+    _phi.push_back( object.phi() );
+    _energy.push_back( object.energy() );
+    _px.push_back( object.px() );
+    _py.push_back( object.py() );
+    _pz.push_back( object.pz() );
+}
+
+
+double PhysicsObjectArrays::scalarPtSum() const{
+    double ptSum = 0;
+    for( const auto pt : _pt ){
+        ptSum += pt;
+    }
+    return ptSum;
+}
@@ -4,84 +4,82 @@
 #include <iostream>
 #include <stdexcept>
 
-//include other parts of framework
-#include "../../Tools/interface/stringTools.h"
 
-
-//remove leading _ from trigger and filter names 
-std::string cleanName( const std::string& name ){
-    std::string ret( name );
-    if( stringTools::stringStartsWith( name, "_" ) ){
-        ret.erase(0, 1);
-    }
-    return ret;
+TriggerInfo::TriggerInfo( const TreeReader& treeReader, const bool readIndividualTriggers, const bool readIndividualMetFilters ){
+    refill( treeReader, readIndividualTriggers, readIndividualMetFilters );
 }
 
 
-TriggerInfo::TriggerInfo( const TreeReader& treeReader, const bool readIndividualTriggers, const bool readIndividualMetFilters ) :
-    _passTriggers_e( treeReader._passTrigger_e ),
-    _passTriggers_m( treeReader._passTrigger_m ),
-    _passTriggers_ee( treeReader._passTrigger_ee ),
-    _passTriggers_em( treeReader._passTrigger_em ),
-    _passTriggers_et( treeReader._passTrigger_et ),
-    _passTriggers_mm( treeReader._passTrigger_mm ),
-    _passTriggers_mt( treeReader._passTrigger_mt ),
-    _passTriggers_eee( treeReader._passTrigger_eee ),
-    _passTriggers_eem( treeReader._passTrigger_eem ),
-    _passTriggers_emm( treeReader._passTrigger_emm ),
-    _passTriggers_mmm( treeReader._passTrigger_mmm ),
-    _passTriggers_FR( treeReader._passTrigger_FR ),
-    _passTriggers_FR_iso( treeReader._passTrigger_FR_iso ),
-    _passMetFilters( treeReader._passMETFilters )
-{
-    if( readIndividualTriggers ){
-        for( const auto& trigger : treeReader._triggerMap ){
-            individualTriggerMap.insert( { cleanName( trigger.first ), trigger.second } );
-        }
+void TriggerInfo::refill( const TreeReader& treeReader, const bool readIndividualTriggers, const bool readIndividualMetFilters ){
+    _passTriggers_e = treeReader._passTrigger_e;
+    _passTriggers_m = treeReader._passTrigger_m;
+    _passTriggers_ee = treeReader._passTrigger_ee;
+    _passTriggers_em = treeReader._passTrigger_em;
+    _passTriggers_et = treeReader._passTrigger_et;
+    _passTriggers_mm = treeReader._passTrigger_mm;
+    _passTriggers_mt = treeReader._passTrigger_mt;
+    _passTriggers_eee = treeReader._passTrigger_eee;
+    _passTriggers_eem = treeReader._passTrigger_eem;
+    _passTriggers_emm = treeReader._passTrigger_emm;
+    _passTriggers_mmm = treeReader._passTrigger_mmm;
+    _passTriggers_FR = treeReader._passTrigger_FR;
+    _passTriggers_FR_iso = treeReader._passTrigger_FR_iso;
+    _passMetFilters = treeReader._passMETFilters;
+
+    //the names are interned by the TreeReader, only the decisions are copied for every entry
+    if( readIndividualTriggers && treeReader._triggerTable ){
+        _triggerTable = treeReader._triggerTable;
+        _triggerTable->fillBits( treeReader._triggerMap, _triggerBits );
+    } else {
+        _triggerTable.reset();
+        _triggerBits.clear();
     }
-    if( readIndividualMetFilters ){
-        for( const auto& filter : treeReader._MetFilterMap ){
-            individualMetFilterMap.insert( { cleanName( filter.first ), filter.second } );
-        }   
+    if( readIndividualMetFilters && treeReader._MetFilterTable ){
+        _metFilterTable = treeReader._MetFilterTable;
+        _metFilterTable->fillBits( treeReader._MetFilterMap, _metFilterBits );
+    } else {
+        _metFilterTable.reset();
+        _metFilterBits.clear();
     }
 }
 
 
-bool passTriggerOrFilter( const std::map< std::string, bool >& decisionMap,  const std::string& name ){
-    auto decisionIt = decisionMap.find( name );
+bool passTriggerOrFilter( const std::shared_ptr< const DecisionTable >& tablePtr, const DecisionTable::Bits& bits, const std::string& name ){
+    DecisionTable::size_type decisionIndex = ( tablePtr ? tablePtr->index( name ) : 0 );
 
     //throw error if non-existing trigger or MET filter is requested
-    if( decisionIt == decisionMap.cend() ){
+    if( !tablePtr || decisionIndex == tablePtr->size() ){
         throw std::invalid_argument( "Requested trigger or MET filter '" + name + "' does not exist." );
     } else {
-        return (*decisionIt).second;
+        return DecisionTable::testBit( bits, decisionIndex );
     }
 }
 
 
 bool TriggerInfo::passTrigger( const std::string& triggerName ) const{
-    return passTriggerOrFilter( individualTriggerMap, triggerName );
+    return passTriggerOrFilter( _triggerTable, _triggerBits, triggerName );
 }
 
 
 bool TriggerInfo::passMetFilter( const std::string& filterName ) const{
-    return passTriggerOrFilter( individualMetFilterMap, filterName );
+    return passTriggerOrFilter( _metFilterTable, _metFilterBits, filterName );
 }
 
 
-void printAvailableInfo( const std::map< std::string, bool >& decisionMap, const std::string& decisionType ){
+void printAvailableInfo( const std::shared_ptr< const DecisionTable >& tablePtr, const std::string& decisionType ){
     std::cout << "Available " << decisionType << " :\n";
-    for( const auto& decision : decisionMap ){
-        std::cout << decision.first << "\n";
+    if( !tablePtr ) return;
+    for( const auto& name : tablePtr->names() ){
+        std::cout << name << "\n";
     }
 }
 
 
 void TriggerInfo::printAvailableIndividualTriggers() const{
-    printAvailableInfo( individualTriggerMap, "triggers" );
+    printAvailableInfo( _triggerTable, "triggers" );
 }
 
 
 void TriggerInfo::printAvailableMetFilters() const{
-    printAvailableInfo( individualMetFilterMap, "MET filters");
+    printAvailableInfo( _metFilterTable, "MET filters");
 }
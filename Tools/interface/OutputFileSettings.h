@@ -0,0 +1,87 @@
+/*
+Settings for writing ROOT output files: compression algorithm and level, AutoFlush and basket size of trees,
+and the number of threads used to compress baskets in parallel.
+Output files and trees of all programs should be made through openFile and configureTree,
+so the settings can be chosen per program and per named profile:
+    default     ROOT defaults
+    fastread    LZ4, fast to decompress, for intermediate files that are read many times (e.g. skims)
+    balanced    ZSTD, good compression at a moderate cost
+    archive     LZMA at the highest level, for final merged datasets that are rarely rewritten
+The settings can be given on the command line of a program (see fromCommandLine):
+    --compression=<profile>
+    --compressionAlgorithm=<ZLIB|LZMA|LZ4|ZSTD>
+    --compressionLevel=<n>
+    --autoFlush=<n>             entries per cluster, or bytes per cluster when negative
+    --basketSize=<bytes>
+    --compressionThreads=<n>
+where the individual options override the profile.
+The compression threads are a process-wide ROOT setting (implicit multi-threading), so opening a file does not change them:
+a program writing trees calls enableParallelCompression once in its main function.
+*/
+
+#ifndef OutputFileSettings_H
+#define OutputFileSettings_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <iostream>
+
+//include ROOT classes
+#include "TFile.h"
+#include "TTree.h"
+
+
+class OutputFileSettings{
+
+    public:
+        OutputFileSettings() = default;
+        OutputFileSettings( const std::string& algorithmName, const int level, const long long autoFlush = 0,
+                            const int basketSize = 0, const unsigned numberOfThreads = 1 );
+
+        static OutputFileSettings fromProfile( const std::string& profileName );
+        static std::vector< std::string > availableProfiles();
+
+        //remove the output file options from the command line arguments and return the settings they define,
+        //starting from the default profile of the program
+        static OutputFileSettings fromCommandLine( std::vector< std::string >& arguments, const std::string& defaultProfile = "default" );
+
+        //description of the command line options for usage messages
+        static std::string commandLineUsage();
+
+        //command line options reproducing these settings, e.g. to pass them on to submitted jobs
+        std::string commandLineOptions() const;
+
+        //open a file with the compression settings, and set AutoFlush and basket size for a tree
+        TFile* openFile( const std::string& path, const std::string& option = "RECREATE" ) const;
+        void configureTree( TTree* ) const;
+
+        //whether configureTree changes anything, i.e. trees can not simply be cloned as they are
+        bool configuresTree() const{ return ( _autoFlush != 0 || _basketSize != 0 ); }
+
+        //enable implicit multi-threading for the whole process so baskets of different branches are compressed in parallel
+        //(to be called explicitly by the main function of a program, as it also affects all other ROOT operations)
+        void enableParallelCompression() const;
+
+        const std::string& algorithmName() const{ return _algorithmName; }
+        int level() const{ return _level; }
+        long long autoFlush() const{ return _autoFlush; }
+        int basketSize() const{ return _basketSize; }
+        unsigned numberOfThreads() const{ return _numberOfThreads; }
+        std::string toString() const;
+
+        //compression ratio of a written tree or file and write throughput given the time spent writing it
+        static void printCompressionReport( TTree*, const double writeTimeInSeconds, std::ostream& os = std::cout );
+        static void printCompressionReport( TFile*, const double writeTimeInSeconds, std::ostream& os = std::cout );
+
+    private:
+
+        //empty algorithm name and negative level leave the ROOT defaults
+        std::string _algorithmName;
+        int _level = -1;
+        long long _autoFlush = 0;
+        int _basketSize = 0;
+        unsigned _numberOfThreads = 1;
+};
+
+#endif
@@ -38,6 +38,11 @@ namespace histogram{
     double contentDownAtValues( TH2*, const double valueX, const double valueY );
     double contentUpAtValues( TH2*, const double valueX, const double valueY );
 
+    //bin containing the value, with under- and overflow mapped to the first and last bins
+    //to retrieve the content and its uncertainties with a single bin search
+    int binAtValue( TH1*, const double value );
+    int binAtValues( TH2*, const double valueX, const double valueY );
+
     void fillValue( TH1*, const double value, const double weight );
     void fillValues( TH2*, const double valueX, const double valueY, const double weight );
 
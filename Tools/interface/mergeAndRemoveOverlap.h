@@ -10,8 +10,14 @@ This is necessary to merge several primary datasets and make sure no events are
 #include <vector>
 #include <string>
 
+//include other parts of framework
+#include "../../TreeReader/interface/ReadCacheSettings.h"
+#include "OutputFileSettings.h"
+
 //merge several ROOT files and remove overlap
 //input is a vector of file paths (strings) and the output path
-void mergeAndRemoveOverlap( const std::vector< std::string >&, const std::string&, const bool allowMergingYears = false );
+void mergeAndRemoveOverlap( const std::vector< std::string >&, const std::string&, const bool allowMergingYears = false,
+    const ReadCacheSettings& readCacheSettings = ReadCacheSettings(),
+    const OutputFileSettings& outputFileSettings = OutputFileSettings() );
 
 #endif
@@ -0,0 +1,36 @@
+/*
+Overlap removal between two sets of objects given as arrays of eta and phi (e.g. from PhysicsObjectArrays).
+All pairs are compared with deltaR^2 against the cone size squared, without computing deltaR itself.
+*/
+
+#ifndef overlapRemoval_H
+#define overlapRemoval_H
+
+//include c++ library classes
+#include <vector>
+#include <cstddef>
+
+namespace overlapRemoval{
+
+    //for each of the objects, 1 if it is outside the cones around all reference objects and 0 otherwise
+    //phi values are expected to be in [ -pi, pi ]
+    void outsideConesMask( const double* eta, const double* phi, const std::size_t numberOfObjects,
+        const double* referenceEta, const double* referencePhi, const std::size_t numberOfReferenceObjects,
+        const double coneSize, std::vector< unsigned char >& mask );
+
+    //arrays reused by a collection between cleanings, so that cleaning does not allocate memory for every event
+    //copies start empty since the contents are only meaningful during a single cleaning
+    struct Workspace{
+        Workspace() = default;
+        Workspace( const Workspace& ){}
+        Workspace& operator=( const Workspace& ){ return *this; }
+
+        std::vector< double > eta;
+        std::vector< double > phi;
+        std::vector< double > referenceEta;
+        std::vector< double > referencePhi;
+        std::vector< unsigned char > mask;
+    };
+}
+
+#endif
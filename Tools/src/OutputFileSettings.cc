@@ -0,0 +1,228 @@
+#include "../interface/OutputFileSettings.h"
+
+//include c++ library classes
+#include <map>
+#include <stdexcept>
+#include <iomanip>
+
+//include ROOT classes
+#include "TROOT.h"
+#include "Compression.h"
+
+//include other parts of framework
+#include "../interface/stringTools.h"
+
+
+namespace{
+
+    const std::map< std::string, ROOT::RCompressionSetting::EAlgorithm::EValues >& algorithmMap(){
+        static const std::map< std::string, ROOT::RCompressionSetting::EAlgorithm::EValues > algorithms = {
+            { "ZLIB", ROOT::RCompressionSetting::EAlgorithm::kZLIB },
+            { "LZMA", ROOT::RCompressionSetting::EAlgorithm::kLZMA },
+            { "LZ4", ROOT::RCompressionSetting::EAlgorithm::kLZ4 },
+            { "ZSTD", ROOT::RCompressionSetting::EAlgorithm::kZSTD }
+        };
+        return algorithms;
+    }
+
+
+    const std::map< std::string, OutputFileSettings >& profileMap(){
+        static const std::map< std::string, OutputFileSettings > profiles = {
+            { "default", OutputFileSettings() },
+            { "fastread", OutputFileSettings( "LZ4", 4 ) },
+            { "balanced", OutputFileSettings( "ZSTD", 5 ) },
+            { "archive", OutputFileSettings( "LZMA", 9 ) }
+        };
+        return profiles;
+    }
+}
+
+
+OutputFileSettings::OutputFileSettings( const std::string& algorithmName, const int level, const long long autoFlush,
+        const int basketSize, const unsigned numberOfThreads ) :
+    _algorithmName( algorithmName ),
+    _level( level ),
+    _autoFlush( autoFlush ),
+    _basketSize( basketSize ),
+    _numberOfThreads( numberOfThreads )
+{
+    if( algorithmMap().find( algorithmName ) == algorithmMap().cend() ){
+        throw std::invalid_argument( "ERROR in OutputFileSettings::OutputFileSettings: unknown compression algorithm '" + algorithmName + "'." );
+    }
+    if( level < 0 || level > 9 ){
+        throw std::invalid_argument( "ERROR in OutputFileSettings::OutputFileSettings: compression level must be between 0 and 9." );
+    }
+    if( basketSize < 0 ){
+        throw std::invalid_argument( "ERROR in OutputFileSettings::OutputFileSettings: basket size can not be negative." );
+    }
+    if( numberOfThreads == 0 ){
+        throw std::invalid_argument( "ERROR in OutputFileSettings::OutputFileSettings: number of threads must be larger than 0." );
+    }
+}
+
+
+OutputFileSettings OutputFileSettings::fromProfile( const std::string& profileName ){
+    auto profileIt = profileMap().find( profileName );
+    if( profileIt == profileMap().cend() ){
+        throw std::invalid_argument( "ERROR in OutputFileSettings::fromProfile: unknown output file profile '" + profileName + "'." );
+    }
+    return profileIt->second;
+}
+
+
+std::vector< std::string > OutputFileSettings::availableProfiles(){
+    std::vector< std::string > profileNames;
+    for( const auto& profile : profileMap() ){
+        profileNames.push_back( profile.first );
+    }
+    return profileNames;
+}
+
+
+namespace{
+
+    //value of an option of the form --name=value, empty if the argument is not this option
+    std::string outputOptionValue( const std::string& argument, const std::string& optionName ){
+        const std::string prefix = "--" + optionName + "=";
+        if( !stringTools::stringStartsWith( argument, prefix ) ) return "";
+        std::string value = argument.substr( prefix.size() );
+        if( value.empty() ){
+            throw std::invalid_argument( "ERROR in OutputFileSettings::fromCommandLine: no value given for option '" + argument + "'." );
+        }
+        return value;
+    }
+}
+
+
+OutputFileSettings OutputFileSettings::fromCommandLine( std::vector< std::string >& arguments, const std::string& defaultProfile ){
+    OutputFileSettings settings = fromProfile( defaultProfile );
+    std::string algorithmName, level, autoFlush, basketSize, numberOfThreads;
+    std::vector< std::string > remainingArguments;
+    for( const auto& argument : arguments ){
+        std::string value;
+        if( !( value = outputOptionValue( argument, "compression" ) ).empty() ){
+            settings = fromProfile( value );
+        } else if( !( value = outputOptionValue( argument, "compressionAlgorithm" ) ).empty() ){
+            algorithmName = value;
+        } else if( !( value = outputOptionValue( argument, "compressionLevel" ) ).empty() ){
+            level = value;
+        } else if( !( value = outputOptionValue( argument, "autoFlush" ) ).empty() ){
+            autoFlush = value;
+        } else if( !( value = outputOptionValue( argument, "basketSize" ) ).empty() ){
+            basketSize = value;
+        } else if( !( value = outputOptionValue( argument, "compressionThreads" ) ).empty() ){
+            numberOfThreads = value;
+        } else {
+            remainingArguments.push_back( argument );
+        }
+    }
+    arguments = remainingArguments;
+
+    //individual options override the profile, an algorithm without a level uses level 5
+    if( !algorithmName.empty() ) settings._algorithmName = algorithmName;
+    if( !level.empty() ) settings._level = std::stoi( level );
+    if( !settings._algorithmName.empty() && settings._level < 0 ) settings._level = 5;
+    if( !autoFlush.empty() ) settings._autoFlush = std::stoll( autoFlush );
+    if( !basketSize.empty() ) settings._basketSize = std::stoi( basketSize );
+    if( !numberOfThreads.empty() ){
+
+        //std::stoul silently wraps negative numbers around
+        const long parsedNumberOfThreads = std::stol( numberOfThreads );
+        if( parsedNumberOfThreads < 1 ){
+            throw std::invalid_argument( "ERROR in OutputFileSettings::fromCommandLine: number of compression threads must be larger than 0." );
+        }
+        settings._numberOfThreads = static_cast< unsigned >( parsedNumberOfThreads );
+    }
+
+    //check the combined settings
+    if( !settings._algorithmName.empty() ){
+        return OutputFileSettings( settings._algorithmName, settings._level, settings._autoFlush, settings._basketSize, settings._numberOfThreads );
+    }
+    if( settings._level >= 0 ){
+        throw std::invalid_argument( "ERROR in OutputFileSettings::fromCommandLine: a compression level requires a compression algorithm." );
+    }
+    return settings;
+}
+
+
+std::string OutputFileSettings::commandLineOptions() const{
+    std::string options;
+
+    //the receiving program can have another default profile, so the ROOT default is passed on explicitly
+    if( _algorithmName.empty() ){
+        options += " --compression=default";
+    } else {
+        options += " --compressionAlgorithm=" + _algorithmName;
+        options += " --compressionLevel=" + std::to_string( _level );
+    }
+    if( _autoFlush != 0 ) options += " --autoFlush=" + std::to_string( _autoFlush );
+    if( _basketSize != 0 ) options += " --basketSize=" + std::to_string( _basketSize );
+    if( _numberOfThreads > 1 ) options += " --compressionThreads=" + std::to_string( _numberOfThreads );
+    return options;
+}
+
+
+std::string OutputFileSettings::commandLineUsage(){
+    std::string usage = "optional output file settings:\n";
+    usage += "  --compression=<profile>  one of";
+    for( const auto& profileName : availableProfiles() ){
+        usage += " " + profileName;
+    }
+    usage += "\n";
+    usage += "  --compressionAlgorithm=<ZLIB|LZMA|LZ4|ZSTD>  --compressionLevel=<0-9>\n";
+    usage += "  --autoFlush=<n>  entries per cluster (bytes when negative)  --basketSize=<bytes>\n";
+    usage += "  --compressionThreads=<n>  number of threads compressing baskets in parallel";
+    return usage;
+}
+
+
+std::string OutputFileSettings::toString() const{
+    std::string description = ( _algorithmName.empty() ? std::string( "ROOT default compression" ) : _algorithmName + " level " + std::to_string( _level ) );
+    if( _autoFlush != 0 ) description += ", AutoFlush " + std::to_string( _autoFlush );
+    if( _basketSize != 0 ) description += ", basket size " + std::to_string( _basketSize );
+    if( _numberOfThreads > 1 ) description += ", " + std::to_string( _numberOfThreads ) + " compression threads";
+    return description;
+}
+
+
+TFile* OutputFileSettings::openFile( const std::string& path, const std::string& option ) const{
+    TFile* filePtr = TFile::Open( path.c_str(), option.c_str() );
+    if( filePtr == nullptr || filePtr->IsZombie() ){
+        throw std::runtime_error( "ERROR in OutputFileSettings::openFile: can not open file '" + path + "'." );
+    }
+    if( !_algorithmName.empty() ){
+        filePtr->SetCompressionSettings( ROOT::CompressionSettings( algorithmMap().at( _algorithmName ), _level ) );
+    }
+    return filePtr;
+}
+
+
+void OutputFileSettings::configureTree( TTree* treePtr ) const{
+    if( _autoFlush != 0 ) treePtr->SetAutoFlush( _autoFlush );
+    if( _basketSize != 0 ) treePtr->SetBasketSize( "*", _basketSize );
+}
+
+
+void OutputFileSettings::enableParallelCompression() const{
+    if( _numberOfThreads > 1 ) ROOT::EnableImplicitMT( _numberOfThreads );
+}
+
+
+void OutputFileSettings::printCompressionReport( TTree* treePtr, const double writeTimeInSeconds, std::ostream& os ){
+    const double uncompressedSize = treePtr->GetTotBytes();
+    const double compressedSize = treePtr->GetZipBytes();
+    os << "output tree " << treePtr->GetName() << " : " << std::fixed << std::setprecision( 2 );
+    os << uncompressedSize/1e6 << " MB uncompressed, " << compressedSize/1e6 << " MB compressed";
+    if( compressedSize > 0 ) os << ", compression ratio " << uncompressedSize/compressedSize;
+    if( writeTimeInSeconds > 0 ) os << ", write throughput " << uncompressedSize/1e6/writeTimeInSeconds << " MB/s";
+    os << std::defaultfloat << std::endl;
+}
+
+
+void OutputFileSettings::printCompressionReport( TFile* filePtr, const double writeTimeInSeconds, std::ostream& os ){
+    const double writtenSize = filePtr->GetBytesWritten();
+    os << "output file " << filePtr->GetName() << " : " << std::fixed << std::setprecision( 2 );
+    os << writtenSize/1e6 << " MB written, compression ratio " << filePtr->GetCompressionFactor();
+    if( writeTimeInSeconds > 0 ) os << ", write throughput " << writtenSize/1e6/writeTimeInSeconds << " MB/s";
+    os << std::defaultfloat << std::endl;
+}
@@ -140,6 +140,16 @@ double histogram::contentUpAtValues( TH2* histPtr, const double valueX, const do
 }
 
 
+int histogram::binAtValue( TH1* histPtr, const double value ){
+    return histPtr->FindBin( boundedValue( histPtr, value ) );
+}
+
+
+int histogram::binAtValues( TH2* histPtr, const double valueX, const double valueY ){
+    return histPtr->FindBin( boundedXValue( histPtr, valueX ), boundedYValue( histPtr, valueY ) );
+}
+
+
 void histogram::fillValue( TH1* histPtr, const double value, const double weight ){
 	histPtr->Fill( boundedValue( histPtr, value ), weight );
 }
@@ -1,5 +1,8 @@
 #include "../interface/mergeAndRemoveOverlap.h"
 
+//include c++ library classes
+#include <chrono>
+
 //include ROOT classes 
 #include "TFile.h"
 
@@ -54,7 +57,9 @@ bool eventIsNew( const Event& event, std::set< EventTags >& usedEventTags ){
 
 void mergeAndRemoveOverlap( const std::vector< std::string >& inputPathVector, 
 			    const std::string& outputPath, 
-			    const bool allowMergingYears ){
+			    const bool allowMergingYears,
+			    const ReadCacheSettings& readCacheSettings,
+			    const OutputFileSettings& outputFileSettings ){
 
     // size of input vector must be at least 2, otherwise there can be no merging 
     if( inputPathVector.size() < 2 ){
@@ -72,13 +77,15 @@ void mergeAndRemoveOverlap( const std::vector< std::string >& inputPathVector,
 
     // initialize TreeReader
     TreeReader treeReader;
+    treeReader.setReadCache( readCacheSettings );
 
     // make output file and output Tree
-    TFile* outputFilePtr = TFile::Open( outputPath.c_str(), "RECREATE" );
+    TFile* outputFilePtr = outputFileSettings.openFile( outputPath );
     outputFilePtr->mkdir( "blackJackAndHookers" );
     outputFilePtr->cd( "blackJackAndHookers" );
     std::shared_ptr< TTree > outputTreePtr( std::make_shared< TTree >( 
 				"blackJackAndHookersTree","blackJackAndHookersTree" ) );
+    outputFileSettings.configureTree( outputTreePtr.get() );
 
     // histograms stored in file
     std::map< std::string, std::shared_ptr< TH1 > > outputHistogramMap;
@@ -87,6 +94,9 @@ void mergeAndRemoveOverlap( const std::vector< std::string >& inputPathVector,
     // use std::set so search scales as log(N) 
     std::set< EventTags > usedEventTags;
 
+    // time spent filling and writing the output tree
+    std::chrono::duration< double > writeTime( 0. );
+
     // loop over files
     for( auto inputPathIt = inputPathVector.cbegin(); 
 	inputPathIt != inputPathVector.cend(); 
@@ -109,12 +119,19 @@ void mergeAndRemoveOverlap( const std::vector< std::string >& inputPathVector,
                 outputHistogramMap[ histPtr->GetName() ] = histPtr;
             }
 
-            // set uo output tree
+            // set uo output tree, slimmed inputs are written with the same branches and narrowing
+            treeReader.setSlimmingProfile( treeReader.slimmingProfileOfCurrentTree() );
             treeReader.setOutputTree( outputTreePtr.get() );
 
         // for next files, add the histograms to the current histograms 
 	// and check that no unknown histograms are present
         } else {
+            if( treeReader.slimmingProfileOfCurrentTree().name() != treeReader.slimmingProfile().name() ){
+		std::string msg = "ERROR in mergeAndRemoveOverlap: ";
+		msg += "file " + inputFilePath + " was slimmed with profile '" + treeReader.slimmingProfileOfCurrentTree().name();
+		msg += "' while file " + inputPathVector[0] + " was slimmed with profile '" + treeReader.slimmingProfile().name() + "'.";
+                throw std::invalid_argument( msg );
+            }
             for( const auto& histPtr : treeReader.getHistogramsFromCurrentFile() ){
                 auto histIt = outputHistogramMap.find( histPtr->GetName() );
                 if( histIt == outputHistogramMap.cend() ){
@@ -140,10 +157,12 @@ void mergeAndRemoveOverlap( const std::vector< std::string >& inputPathVector,
             if( eventIsNew( event, usedEventTags ) ){
 
                 // write event to output tree
-                outputTreePtr->Fill();
+                auto fillBegin = std::chrono::steady_clock::now();
+                treeReader.fillOutputTree( outputTreePtr.get() );
+                writeTime += std::chrono::steady_clock::now() - fillBegin;
             }
         }
-
+        if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
     }
 
     // need to change directory for writing
@@ -155,7 +174,10 @@ void mergeAndRemoveOverlap( const std::vector< std::string >& inputPathVector,
     }
     
     // write output tree 
+    auto writeBegin = std::chrono::steady_clock::now();
     outputTreePtr->Write( "", BIT(2) );
+    writeTime += std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( outputTreePtr.get(), writeTime.count() );
 
     // close output file
     outputFilePtr->Close();
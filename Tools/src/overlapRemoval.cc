@@ -0,0 +1,35 @@
+#include "../interface/overlapRemoval.h"
+
+//include c++ library classes
+#include <cmath>
+#include <algorithm>
+
+
+namespace{
+
+    //same phi wrapping as deltaPhi in LorentzVector
+    bool insideCone( const double eta, const double phi, const double referenceEta, const double referencePhi, const double coneSizeSquared ){
+        double dEta = eta - referenceEta;
+        double dPhi = std::fabs( phi - referencePhi );
+        dPhi = std::min( dPhi, 2*M_PI - dPhi );
+        return ( dEta*dEta + dPhi*dPhi < coneSizeSquared );
+    }
+}
+
+
+void overlapRemoval::outsideConesMask( const double* eta, const double* phi, const std::size_t numberOfObjects,
+    const double* referenceEta, const double* referencePhi, const std::size_t numberOfReferenceObjects,
+    const double coneSize, std::vector< unsigned char >& mask ){
+    mask.resize( numberOfObjects );
+    const double coneSizeSquared = coneSize*coneSize;
+    for( std::size_t i = 0; i < numberOfObjects; ++i ){
+        unsigned char isOutside = 1;
+        for( std::size_t r = 0; r < numberOfReferenceObjects; ++r ){
+            if( insideCone( eta[ i ], phi[ i ], referenceEta[ r ], referencePhi[ r ], coneSizeSquared ) ){
+                isOutside = 0;
+                break;
+            }
+        }
+        mask[ i ] = isOutside;
+    }
+}
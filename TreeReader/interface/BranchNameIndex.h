@@ -0,0 +1,43 @@
+/*
+Index of the branch names of a tree, built once when a tree is opened
+so that checking for the presence of a branch does not require a scan over the list of branches.
+Exact names are looked up in a hash table, prefixes with a binary search in the sorted list of names.
+*/
+
+#ifndef BranchNameIndex_H
+#define BranchNameIndex_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+
+class BranchNameIndex{
+
+    public:
+        using size_type = std::vector< std::string >::size_type;
+
+        BranchNameIndex() = default;
+        BranchNameIndex( const std::vector< std::string >& branchNames );
+
+        size_type size() const{ return _sortedNames.size(); }
+
+        //branch names in alphabetical order
+        const std::vector< std::string >& names() const{ return _sortedNames; }
+
+        //branch with exactly this name
+        bool contains( const std::string& name ) const{ return ( _names.find( name ) != _names.cend() ); }
+
+        //branch whose name starts with the given prefix
+        bool containsPrefix( const std::string& prefix ) const;
+
+        //branch whose name contains the given string anywhere, this requires a scan over all names
+        bool containsSubstring( const std::string& ) const;
+
+    private:
+        std::vector< std::string > _sortedNames;
+        std::unordered_set< std::string > _names;
+};
+
+#endif
@@ -0,0 +1,82 @@
+/*
+Class describing which groups of branches of the ntuples are read by a TreeReader.
+Branches in disabled groups are switched off with SetBranchStatus,
+so they are neither read nor decompressed in GetEntry.
+A profile can be built from a string containing a comma-separated list of
+named profiles and/or branch groups, where a leading '-' removes the group or profile,
+e.g. "nominal,-taus,-generatorInfo" or "leptonKinematics,leptonID,jets".
+*/
+
+#ifndef BranchProfile_H
+#define BranchProfile_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <initializer_list>
+
+
+class BranchProfile{
+
+    public:
+
+        //groups of branches that can be switched on or off together
+        enum Group : unsigned {
+            eventInfo           = 1u << 0,  // run, lumi block, event number, vertices, event weight
+            triggers            = 1u << 1,  // combined trigger flags and combined MET filter
+            individualTriggers  = 1u << 2,  // individual HLT paths
+            metFilters          = 1u << 3,  // individual MET filters
+            leptonKinematics    = 1u << 4,  // lepton multiplicities, four-momenta, flavor and charge
+            leptonVariations    = 1u << 5,  // lepton energy scale and resolution variations
+            leptonID            = 1u << 6,  // lepton identification and isolation variables
+            leptonGenMatch      = 1u << 7,  // lepton generator matching
+            taus                = 1u << 8,  // tau identification variables
+            jets                = 1u << 9,  // nominal jets
+            jetVariations       = 1u << 10, // jet JEC and JER variations
+            JECSources          = 1u << 11, // split JEC uncertainty sources (jets and MET)
+            JECGrouped          = 1u << 12, // grouped JEC uncertainty sources (jets and MET)
+            met                 = 1u << 13, // nominal MET
+            metVariations       = 1u << 14, // MET JEC and unclustered energy variations
+            generatorInfo       = 1u << 15, // LHE and parton shower weights, pileup and prefire info, gen MET
+            genParticles        = 1u << 16, // generator level leptons
+            susyMasses          = 1u << 17, // SUSY mass point
+            other               = 1u << 18  // branches that do not belong to any of the above
+        };
+
+        //default profile enables all branches
+        BranchProfile() = default;
+        BranchProfile( const std::string& profileString );
+        BranchProfile( std::initializer_list< Group > );
+
+        bool isEnabled( const Group group ) const{ return ( _enabledGroups & group ); }
+        bool enablesAll() const{ return ( _enabledGroups == allGroups ); }
+        BranchProfile& enable( const Group group ){ _enabledGroups |= group; return *this; }
+        BranchProfile& disable( const Group group ){ _enabledGroups &= ~group; return *this; }
+
+        //whether all groups enabled in the other profile are enabled in this one
+        bool includes( const BranchProfile& other ) const{ return ( ( other._enabledGroups & ~_enabledGroups ) == 0 ); }
+
+        //throw an std::domain_error when the given group is disabled
+        //accessorName is used in the error message
+        void require( const Group group, const std::string& accessorName ) const{
+            if( !isEnabled( group ) ) throwDisabledGroup( group, accessorName );
+        }
+
+        //determine the group a branch belongs to from its name
+        static Group groupOfBranch( const std::string& branchName );
+
+        //names of groups and named profiles
+        static std::string groupName( const Group );
+        static std::vector< std::string > availableProfiles();
+
+        std::string toString() const;
+
+    private:
+        static constexpr unsigned allGroups = ( 1u << 19 ) - 1;
+        unsigned _enabledGroups = allGroups;
+
+        void addToken( const std::string& token );
+        [[noreturn]] static void throwDisabledGroup( const Group, const std::string& );
+};
+
+#endif
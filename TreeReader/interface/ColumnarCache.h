@@ -0,0 +1,175 @@
+/*
+Columnar on-disk cache of the branches read by a TreeReader, for analyses that run over the same skims many times.
+A cache is written once from an ntuple with TreeReader::writeColumnarCache, after which a TreeReader
+initialized with initSampleFromCache (or with a cache directory set, see TreeReader::setColumnarCacheDirectory)
+serves GetEntry, buildEvent and readBatch from the cache without any ROOT decompression.
+
+A cache is a directory containing:
+    metadata.txt        number of entries, sample info (era, data or MC, sum of simulated event weights from hCounter),
+                        size and modification time of the source ntuple, 
+                        branch profile used to write the cache and the description of every column
+    <name>.values       the values of one branch for all entries, stored contiguously in native byte order
+    <sizeName>.offsets  for every branch holding the size of arrays (e.g. _nL, _nJets): the index of the first object of each entry
+                        (numberOfEntries + 1 unsigned 64-bit integers), shared by all arrays of this size
+The files are memory-mapped when the cache is opened, so only the pages of the columns that are actually read
+are loaded, and they stay in the page cache between passes.
+*/
+
+#ifndef ColumnarCache_H
+#define ColumnarCache_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include <stdexcept>
+
+
+//type of the values in a column, using the ROOT leaf type codes
+template< typename T > constexpr char columnTypeCode(){
+    static_assert( std::is_arithmetic< T >::value, "columns can only hold arithmetic types" );
+    return std::is_same< T, bool >::value ? 'O' :
+        std::is_same< T, double >::value ? 'D' :
+        std::is_same< T, float >::value ? 'F' :
+        std::is_same< T, int >::value ? 'I' :
+        std::is_same< T, unsigned >::value ? 'i' :
+        std::is_same< T, long >::value ? 'G' :
+        std::is_same< T, unsigned long >::value ? 'g' :
+        std::is_same< T, long long >::value ? 'L' :
+        std::is_same< T, unsigned long long >::value ? 'l' : '?';
+}
+
+
+//description of a column: scalars have an empty sizeName, arrays have valuesPerObject values for every object
+struct ColumnInfo{
+    std::string name;
+    char typeCode;
+    std::size_t valueSize;
+    std::string sizeName;
+    unsigned valuesPerObject;
+
+    bool isArray() const{ return !sizeName.empty(); }
+};
+
+
+struct ColumnarCacheMetadata{
+    std::string source;
+    long long sourceSize = -1;
+    long long sourceModificationTime = -1;
+    long unsigned numberOfEntries = 0;
+    bool isData = false;
+    bool is2016 = false;
+    bool is2016PreVFP = false;
+    bool is2016PostVFP = false;
+    bool is2017 = false;
+    bool is2018 = false;
+    double sumOfSimulatedEventWeights = 0.;
+    std::string branchProfile;
+    std::vector< ColumnInfo > columns;
+
+    void write( const std::string& directory ) const;
+    static ColumnarCacheMetadata read( const std::string& directory );
+
+    //record the size and modification time of the source ntuple, and check whether the ntuple was rewritten since
+    //(a cache of which the ntuple can no longer be accessed counts as changed, since it can not be checked)
+    void setSourceStatus( const std::string& sourcePath );
+    bool sourceChanged( const std::string& sourcePath ) const;
+};
+
+
+class ColumnarCacheWriter{
+
+    public:
+        using size_type = std::vector< ColumnInfo >::size_type;
+
+        //the size column of every array column must be one of the columns
+        ColumnarCacheWriter( const std::string& directory, const ColumnarCacheMetadata& metadata );
+
+        //append an entry, given the address of the variable holding the values of each column (in the order of the metadata)
+        void fill( const std::vector< const void* >& addresses );
+
+        //write the remaining values and the metadata, the cache can not be read before this is called
+        void close();
+
+        long unsigned numberOfEntries() const{ return _metadata.numberOfEntries; }
+        unsigned long long numberOfBytesWritten() const{ return _numberOfBytesWritten; }
+
+    private:
+        std::string _directory;
+        ColumnarCacheMetadata _metadata;
+        bool _closed = false;
+
+        //values are collected in memory and appended to the files in large blocks,
+        //so the number of open files does not grow with the number of columns
+        std::vector< std::vector< char > > _valueBuffers;
+        std::vector< size_type > _sizeColumnIndices;
+        std::map< std::string, std::vector< std::uint64_t > > _offsetBuffers;
+        std::map< std::string, std::uint64_t > _numberOfObjects;
+        std::size_t _bufferedBytes = 0;
+        bool _filesCreated = false;
+        unsigned long long _numberOfBytesWritten = 0;
+        void flush();
+};
+
+
+class ColumnarCache{
+
+    public:
+        using size_type = std::vector< ColumnInfo >::size_type;
+
+        ColumnarCache( const std::string& directory );
+        ~ColumnarCache();
+        ColumnarCache( const ColumnarCache& ) = delete;
+        ColumnarCache& operator=( const ColumnarCache& ) = delete;
+
+        //whether the directory contains a (completely written) cache
+        static bool exists( const std::string& directory );
+
+        const std::string& directory() const{ return _directory; }
+        const ColumnarCacheMetadata& metadata() const{ return _metadata; }
+        long unsigned numberOfEntries() const{ return _metadata.numberOfEntries; }
+        size_type numberOfColumns() const{ return _metadata.columns.size(); }
+        std::vector< std::string > columnNames() const;
+
+        bool contains( const std::string& name ) const{ return ( _columnIndices.find( name ) != _columnIndices.cend() ); }
+        size_type columnIndex( const std::string& name ) const;
+        const ColumnInfo& column( const size_type columnIndex ) const{ return _metadata.columns[ columnIndex ]; }
+
+        //copy the values of an entry to the given address, which can hold at most maximumNumberOfValues values,
+        //returns the number of values
+        std::size_t copyEntry( const size_type columnIndex, const long unsigned entry, void* address, const std::size_t maximumNumberOfValues ) const;
+
+        //direct access to the mapped values of a column, which must hold values of type T
+        template< typename T > const T* values( const size_type columnIndex ) const{
+            if( column( columnIndex ).typeCode != columnTypeCode< T >() ){
+                throw std::invalid_argument( "ERROR in ColumnarCache::values: column '" + column( columnIndex ).name + "' does not hold values of the requested type." );
+            }
+            return static_cast< const T* >( _values[ columnIndex ].data );
+        }
+
+        //index of the first object of each entry for an array column, nullptr for scalars
+        const std::uint64_t* offsets( const size_type columnIndex ) const{ return _offsets[ columnIndex ]; }
+
+        //total size of the mapped files
+        std::size_t mappedBytes() const;
+
+    private:
+        struct MappedFile{
+            const void* data = nullptr;
+            std::size_t size = 0;
+        };
+        static MappedFile mapFile( const std::string& path );
+        static void unmapFile( MappedFile& );
+
+        std::string _directory;
+        ColumnarCacheMetadata _metadata;
+        std::map< std::string, size_type > _columnIndices;
+        std::vector< MappedFile > _values;
+        std::map< std::string, MappedFile > _offsetFiles;
+        std::vector< const std::uint64_t* > _offsets;
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*
+Names of the individual triggers or MET filters present in a tree, interned once per tree.
+A decision is addressed by its index in the table, which follows the order of the TreeReader maps
+of decisions (i.e. the branch names in alphabetical order), so that the decisions of an entry
+are stored as a bitset without any string handling.
+Names are stored without the leading underscore of the branch names, e.g. "HLT_Ele32_WPTight_Gsf".
+*/
+
+#ifndef DecisionTable_H
+#define DecisionTable_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <initializer_list>
+#include <cstdint>
+
+
+class DecisionTable{
+
+    public:
+        using size_type = std::vector< std::string >::size_type;
+        using Word = std::uint64_t;
+        using Bits = std::vector< Word >;
+
+        DecisionTable() = default;
+
+        //the names are the keys of a map of decisions as read by the TreeReader
+        DecisionTable( const std::map< std::string, bool >& decisionMap );
+
+        size_type size() const{ return _names.size(); }
+        size_type numberOfWords() const{ return ( _names.size() + wordSize - 1 ) / wordSize; }
+        const std::string& name( const size_type index ) const{ return _names[ index ]; }
+        const std::vector< std::string >& names() const{ return _names; }
+
+        //index of a name, size() if the name is not present
+        size_type index( const std::string& ) const;
+        bool contains( const std::string& name ) const{ return ( index( name ) != size() ); }
+
+        //bitset with the bits of the given names set, throws an invalid_argument if a name is not present
+        Bits mask( const std::vector< std::string >& names ) const;
+
+        //store the decisions of the map this table was built from in a bitset
+        void fillBits( const std::map< std::string, bool >& decisionMap, Bits& bits ) const;
+
+        static bool testBit( const Bits& bits, const size_type index ){
+            return ( bits[ index / wordSize ] >> ( index % wordSize ) ) & 1;
+        }
+        static bool passAny( const Bits& bits, const Bits& mask );
+
+    private:
+        static constexpr size_type wordSize = 64;
+
+        std::vector< std::string > _names;
+        std::unordered_map< std::string, size_type > _indices;
+};
+
+
+/*
+Set of trigger or MET filter names that is translated to a mask of decision bits only when the table changes,
+e.g. when a new sample is opened, instead of for every event.
+The mask is cached inside the selection, so a selection should not be shared between threads.
+*/
+class DecisionSelection{
+
+    public:
+        DecisionSelection( const std::vector< std::string >& names ) : _names( names ) {}
+        DecisionSelection( std::initializer_list< std::string > names ) : _names( names ) {}
+        DecisionSelection( const std::string& name ) : _names( { name } ) {}
+
+        const std::vector< std::string >& names() const{ return _names; }
+
+        //mask for the given table, throws an invalid_argument if one of the names is not present
+        const DecisionTable::Bits& mask( const std::shared_ptr< const DecisionTable >& ) const;
+
+    private:
+        std::vector< std::string > _names;
+
+        //the table is kept alive by the selection, so a new table can never be mistaken for the cached one
+        mutable std::shared_ptr< const DecisionTable > _tablePtr;
+        mutable DecisionTable::Bits _mask;
+};
+
+#endif
@@ -0,0 +1,121 @@
+/*
+Columnar storage of the lepton, jet, MET and combined trigger branches for a range of entries of a tree,
+filled by TreeReader::readBatch.
+Per-object quantities are stored as jagged columns: the values of all entries in one contiguous array,
+with offsets marking where the values of each entry (row) start.
+Selections on these columns can run over a whole batch before any Event is built,
+after which TreeReader::buildEvent builds the events of the selected rows from their tree entries (see entry()).
+The batch only holds the columns needed for such pre-selections, so it can not replace the Event itself.
+*/
+
+#ifndef EventBatch_H
+#define EventBatch_H
+
+//include c++ library classes
+#include <vector>
+#include <cstdint>
+
+
+template< typename T > class JaggedColumn{
+
+    public:
+        using size_type = std::vector< unsigned >::size_type;
+
+        //set the number of values in each row, the values themselves are left uninitialized
+        void resize( const std::vector< unsigned >& counts );
+
+        size_type numberOfRows() const{ return _offsets.size() - 1; }
+        unsigned count( const size_type row ) const{ return _offsets[ row + 1 ] - _offsets[ row ]; }
+
+        const T* row( const size_type row ) const{ return _values.data() + _offsets[ row ]; }
+        T* row( const size_type row ){ return _values.data() + _offsets[ row ]; }
+
+        const std::vector< T >& values() const{ return _values; }
+        const std::vector< unsigned >& offsets() const{ return _offsets; }
+
+    private:
+        std::vector< unsigned > _offsets = { 0 };
+        std::vector< T > _values;
+};
+
+
+template< typename T > void JaggedColumn< T >::resize( const std::vector< unsigned >& counts ){
+    _offsets.resize( counts.size() + 1 );
+    _offsets[ 0 ] = 0;
+    for( size_type i = 0; i < counts.size(); ++i ){
+        _offsets[ i + 1 ] = _offsets[ i ] + counts[ i ];
+    }
+    _values.resize( _offsets.back() );
+}
+
+
+class TreeReader;
+
+class EventBatch{
+
+    friend class TreeReader;
+
+    public:
+        using size_type = std::vector< double >::size_type;
+
+        //bits of the combined trigger flags and MET filter in triggerBits()
+        enum TriggerBit : std::uint16_t {
+            trigger_e       = 1u << 0,
+            trigger_m       = 1u << 1,
+            trigger_ee      = 1u << 2,
+            trigger_em      = 1u << 3,
+            trigger_et      = 1u << 4,
+            trigger_mm      = 1u << 5,
+            trigger_mt      = 1u << 6,
+            trigger_eee     = 1u << 7,
+            trigger_eem     = 1u << 8,
+            trigger_emm     = 1u << 9,
+            trigger_mmm     = 1u << 10,
+            trigger_FR      = 1u << 11,
+            trigger_FR_iso  = 1u << 12,
+            metFilters      = 1u << 13
+        };
+
+        size_type size() const{ return _met.size(); }
+        bool empty() const{ return _met.empty(); }
+
+        //tree entry of a row
+        long unsigned firstEntry() const{ return _firstEntry; }
+        long unsigned entry( const size_type row ) const{ return _firstEntry + row; }
+
+        //all leptons of the ntuples, with the uncorrected lepton pT
+        const JaggedColumn< double >& leptonPt() const{ return _leptonPt; }
+        const JaggedColumn< double >& leptonEta() const{ return _leptonEta; }
+        const JaggedColumn< double >& leptonPhi() const{ return _leptonPhi; }
+        const JaggedColumn< unsigned >& leptonFlavor() const{ return _leptonFlavor; }
+        const JaggedColumn< int >& leptonCharge() const{ return _leptonCharge; }
+
+        const JaggedColumn< double >& jetPt() const{ return _jetPt; }
+        const JaggedColumn< double >& jetEta() const{ return _jetEta; }
+        const JaggedColumn< double >& jetPhi() const{ return _jetPhi; }
+
+        const std::vector< double >& met() const{ return _met; }
+        const std::vector< double >& metPhi() const{ return _metPhi; }
+
+        const std::vector< std::uint16_t >& triggerBits() const{ return _triggerBits; }
+        bool passTriggerBits( const size_type row, const std::uint16_t bits ) const{ return ( _triggerBits[ row ] & bits ); }
+
+    private:
+        long unsigned _firstEntry = 0;
+
+        JaggedColumn< double > _leptonPt;
+        JaggedColumn< double > _leptonEta;
+        JaggedColumn< double > _leptonPhi;
+        JaggedColumn< unsigned > _leptonFlavor;
+        JaggedColumn< int > _leptonCharge;
+
+        JaggedColumn< double > _jetPt;
+        JaggedColumn< double > _jetEta;
+        JaggedColumn< double > _jetPhi;
+
+        std::vector< double > _met;
+        std::vector< double > _metPhi;
+        std::vector< std::uint16_t > _triggerBits;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+Names of the split (sources) and grouped JEC uncertainty variations present in a tree.
+The names are extracted from the branch names once per tree,
+after which the variations are addressed by their index in the table:
+sources first, followed by the grouped variations.
+The TreeReader stores the values of the variations in flat arrays ordered by this index,
+and jets and MET resolve a variation name to its index only once.
+*/
+
+#ifndef JECVariationTable_H
+#define JECVariationTable_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <map>
+
+
+class JECVariationTable{
+
+    public:
+        using size_type = std::vector< std::string >::size_type;
+
+        JECVariationTable() = default;
+        JECVariationTable( const std::vector< std::string >& sourceNames, const std::vector< std::string >& groupedNames );
+
+        //variation names from the branches of a tree, e.g. "_jetSmearedPt_AbsoluteStat_JECSourcesUp" gives "AbsoluteStat"
+        static JECVariationTable fromBranchNames( const std::vector< std::string >& branchNames );
+
+        size_type size() const{ return _names.size(); }
+        size_type numberOfSources() const{ return _numberOfSources; }
+        size_type numberOfGrouped() const{ return _names.size() - _numberOfSources; }
+
+        const std::string& name( const size_type index ) const{ return _names[ index ]; }
+        bool isGrouped( const size_type index ) const{ return ( index >= _numberOfSources ); }
+
+        //index of a variation name, size() if the name is not present
+        size_type sourceIndex( const std::string& ) const;
+        size_type groupedIndex( const std::string& ) const;
+
+        std::vector< std::string > sourceNames() const;
+        std::vector< std::string > groupedNames() const;
+
+        //name of the branch holding a variation, e.g. branchName( "_jetPt", index, "Up" ) gives "_jetPt_AbsoluteStat_JECSourcesUp"
+        std::string branchName( const std::string& quantity, const size_type index, const std::string& direction ) const;
+
+    private:
+        std::vector< std::string > _names;
+        size_type _numberOfSources = 0;
+        std::map< std::string, size_type > _sourceIndices;
+        std::map< std::string, size_type > _groupedIndices;
+};
+
+#endif
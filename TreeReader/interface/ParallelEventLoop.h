@@ -0,0 +1,162 @@
+/*
+Event loop over a single sample, split in ranges of entries that are processed by a pool of threads.
+Each thread has its own TreeReader (and hence its own TFile) and its own output object,
+the outputs of the threads are merged when all ranges are processed.
+
+Usage:
+    ParallelEventLoop loop( sample, numberOfThreads );
+    auto histograms = loop.run(
+        [&](){ return makeEmptyHistograms(); },                        // output for one thread
+        []( Event& event, Histograms& output ){ ... },                 // called for every event
+        []( Histograms& output, const Histograms& other ){ ... } );    // add other to output
+The output object is built in the calling thread, and should not be registered in a ROOT directory
+(e.g. use TH1::AddDirectory( false ) ), since ROOT directories are not thread safe.
+*/
+
+#ifndef ParallelEventLoop_H
+#define ParallelEventLoop_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+//include other parts of framework
+#include "TreeReader.h"
+#include "BranchProfile.h"
+#include "../../Tools/interface/Sample.h"
+#include "../../Event/interface/Event.h"
+
+
+class ParallelEventLoop{
+
+    public:
+
+        //sample from a sample list, event weights are scaled as in TreeReader::initSample
+        ParallelEventLoop( const Sample&, const unsigned numberOfThreads = 0 );
+
+        //single file, read as in TreeReader::initSampleFromFile (i.e. without weight scaling)
+        ParallelEventLoop( const std::string& pathToFile, const unsigned numberOfThreads = 0 );
+
+        //settings of the TreeReader of each thread
+        void setBranchProfile( const BranchProfile& profile ){ _branchProfile = profile; }
+        void setLazyReading( const bool lazy = true ){ _lazyReading = lazy; }
+
+        //arguments passed to TreeReader::buildEvent
+        void setEventOptions( const bool readIndividualTriggers, const bool readIndividualMetFilters,
+            const bool readAllJECVariations, const bool readGroupedJECVariations );
+
+        //number of entries in each range that is handed to a thread
+        void setEntriesPerRange( const long unsigned );
+
+        //only process the first entries of the sample (0 means all entries)
+        void setMaximumNumberOfEntries( const long unsigned maximum ){ _maximumNumberOfEntries = maximum; }
+
+        //0 threads means all hardware threads of the machine
+        unsigned numberOfThreads() const{ return _numberOfThreads; }
+
+        long unsigned numberOfEntries() const;
+
+        //ROOT::EnableThreadSafety has to be called before threads read from ROOT files
+        static void enableThreadSafety();
+
+        //0 threads is translated to the number of hardware threads of the machine
+        static unsigned resolveNumberOfThreads( const unsigned numberOfThreads );
+
+        //process all entries and return the merged output of all threads
+        template< typename MakeOutput, typename ProcessEvent, typename MergeOutput >
+        auto run( MakeOutput makeOutput, ProcessEvent processEvent, MergeOutput mergeOutput ) const
+            -> decltype( makeOutput() );
+
+    private:
+        std::shared_ptr< const Sample > _samplePtr;
+        std::string _pathToFile;
+        unsigned _numberOfThreads;
+        long unsigned _entriesPerRange = 10000;
+        long unsigned _maximumNumberOfEntries = 0;
+
+        BranchProfile _branchProfile;
+        bool _lazyReading = false;
+        bool _readIndividualTriggers = false;
+        bool _readIndividualMetFilters = false;
+        bool _readAllJECVariations = false;
+        bool _readGroupedJECVariations = false;
+
+        //open the sample in the given TreeReader and apply the settings
+        void initializeTreeReader( TreeReader& ) const;
+
+        //split the entries to process in ranges [ first, second )
+        std::vector< std::pair< long unsigned, long unsigned > > entryRanges() const;
+};
+
+
+template< typename MakeOutput, typename ProcessEvent, typename MergeOutput >
+auto ParallelEventLoop::run( MakeOutput makeOutput, ProcessEvent processEvent, MergeOutput mergeOutput ) const
+    -> decltype( makeOutput() )
+{
+    using OutputType = decltype( makeOutput() );
+
+    std::vector< std::pair< long unsigned, long unsigned > > ranges = entryRanges();
+    unsigned numberOfWorkers = std::max( 1u, std::min( _numberOfThreads, static_cast< unsigned >( ranges.size() ) ) );
+
+    //outputs are made in the calling thread
+    std::vector< OutputType > outputs;
+    outputs.reserve( numberOfWorkers );
+    for( unsigned i = 0; i < numberOfWorkers; ++i ){
+        outputs.push_back( makeOutput() );
+    }
+
+    //ranges are handed out one at a time, so threads that finish early take over the remaining work
+    enableThreadSafety();
+    std::atomic< std::size_t > nextRange( 0 );
+    std::vector< std::exception_ptr > errors( numberOfWorkers );
+    auto work = [&]( const unsigned workerIndex ){
+        try{
+            TreeReader treeReader;
+            initializeTreeReader( treeReader );
+
+            //when reading eagerly the event of a thread is refilled for every entry instead of being rebuilt
+            std::unique_ptr< Event > eventPtr;
+            for( std::size_t rangeIndex = nextRange++; rangeIndex < ranges.size(); rangeIndex = nextRange++ ){
+                for( long unsigned entry = ranges[ rangeIndex ].first; entry < ranges[ rangeIndex ].second; ++entry ){
+                    if( eventPtr && !_lazyReading ){
+                        treeReader.refillEvent( *eventPtr, entry );
+                    } else {
+                        eventPtr.reset( new Event( treeReader.buildEvent( entry, _readIndividualTriggers, _readIndividualMetFilters,
+                            _readAllJECVariations, _readGroupedJECVariations ) ) );
+                    }
+                    processEvent( *eventPtr, outputs[ workerIndex ] );
+                }
+            }
+        } catch( ... ){
+            errors[ workerIndex ] = std::current_exception();
+
+            //make the other threads stop early
+            nextRange = ranges.size();
+        }
+    };
+
+    std::vector< std::thread > threads;
+    for( unsigned i = 0; i < numberOfWorkers; ++i ){
+        threads.emplace_back( work, i );
+    }
+    for( auto& thread : threads ){
+        thread.join();
+    }
+    for( const auto& error : errors ){
+        if( error ) std::rethrow_exception( error );
+    }
+
+    OutputType merged = std::move( outputs.front() );
+    for( unsigned i = 1; i < numberOfWorkers; ++i ){
+        mergeOutput( merged, outputs[ i ] );
+    }
+    return merged;
+}
+
+#endif
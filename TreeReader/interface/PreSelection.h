@@ -0,0 +1,91 @@
+/*
+Cheap event selection on the raw branches of an EventBatch, applied before any Event is built.
+A PreSelection is a list of conditions that each act on a full batch at once, 
+setting to false the entries of a mask that fail them, so that the loops run over the contiguous column arrays.
+TreeReader::preSelectEntries applies it to the entries of the current tree and returns the surviving entries,
+after which only the events of these entries have to be built.
+Since the conditions act on the uncorrected ntuple content, they must be looser than the full selection applied to the events.
+*/
+
+#ifndef PreSelection_H
+#define PreSelection_H
+
+//include c++ library classes
+#include <vector>
+#include <functional>
+#include <iostream>
+#include <cstdint>
+
+//include other parts of framework
+#include "EventBatch.h"
+
+
+class PreSelection{
+
+    public:
+        using Mask = std::vector< char >;
+        using Condition = std::function< void( const EventBatch&, Mask& ) >;
+
+        //without conditions all entries pass
+        PreSelection() = default;
+        PreSelection( const Condition& );
+
+        //require the conditions of both selections
+        PreSelection& operator&=( const PreSelection& );
+
+        bool empty() const{ return _conditions.empty(); }
+
+        //resize the mask to the batch size and set the decision for each row
+        void apply( const EventBatch&, Mask& ) const;
+
+        //conditions on the number of objects with an uncorrected pT above a threshold
+        static PreSelection minimumNumberOfLeptons( const unsigned number, const double minimumPt = 0. );
+        static PreSelection minimumNumberOfLightLeptons( const unsigned number, const double minimumPt = 0. );
+        static PreSelection minimumNumberOfElectrons( const unsigned number, const double minimumPt = 0. );
+        static PreSelection minimumNumberOfMuons( const unsigned number, const double minimumPt = 0. );
+        static PreSelection minimumNumberOfJets( const unsigned number, const double minimumPt = 0. );
+
+        //at least one of the given bits of EventBatch::triggerBits must be set
+        static PreSelection passAnyTriggerBit( const std::uint16_t bits );
+
+    private:
+        std::vector< Condition > _conditions;
+};
+
+PreSelection operator&( PreSelection, const PreSelection& );
+
+
+//entries surviving a pre-selection, and statistics on the pre-selection
+class PreSelectionResult{
+
+    friend class TreeReader;
+
+    public:
+        using size_type = std::vector< long unsigned >::size_type;
+
+        const std::vector< long unsigned >& entries() const{ return _entries; }
+        size_type size() const{ return _entries.size(); }
+        long unsigned operator[]( const size_type index ) const{ return _entries[ index ]; }
+        std::vector< long unsigned >::const_iterator begin() const{ return _entries.cbegin(); }
+        std::vector< long unsigned >::const_iterator end() const{ return _entries.cend(); }
+
+        long unsigned numberOfProcessedEntries() const{ return _numberOfProcessedEntries; }
+        double rejectionFraction() const;
+
+        //time in seconds spent reading the batches and applying the pre-selection
+        double preSelectionTime() const{ return _preSelectionTime; }
+
+        //estimated time saved by not building the events of the rejected entries,
+        //given the time in seconds needed to build an event
+        double timeSaved( const double buildTimePerEvent ) const;
+
+        void print( std::ostream& os = std::cout ) const;
+        void print( std::ostream& os, const double buildTimePerEvent ) const;
+
+    private:
+        std::vector< long unsigned > _entries;
+        long unsigned _numberOfProcessedEntries = 0;
+        double _preSelectionTime = 0.;
+};
+
+#endif
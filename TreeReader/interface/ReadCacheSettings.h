@@ -0,0 +1,65 @@
+/*
+Settings of the read cache (TTreeCache) and asynchronous prefetching used by a TreeReader.
+With a cache the baskets of all cached branches for a range of entries are fetched with a few large reads
+instead of one read per branch and entry, which matters for ntuples on network filesystems.
+When reading all enabled branches for each entry the cache is trained on the branches enabled by the branch profile,
+when reading lazily it learns which branches are read during the first entries of each tree.
+Asynchronous prefetching reads the next range of entries in a separate thread while the current one is processed.
+Prefetching is a process-wide ROOT setting that applies to all files opened afterwards, so it is not switched on by a TreeReader:
+a program calls enableAsyncPrefetching once in its main function, before opening any input file.
+Samples for which a columnar cache was written to the given cache directory are read from the cache instead of their tree
+(see ColumnarCache.h and TreeReader::setColumnarCacheDirectory).
+
+The settings can be given on the command line of a program (see fromCommandLine):
+    --cacheSize=<MB>            size of the cache, 0 switches the cache off
+    --cacheLearnEntries=<n>     number of entries used to learn the branches to cache when reading lazily
+    --prefetch                  asynchronous prefetching
+    --columnarCache=<directory> directory with columnar caches of the samples
+Default settings leave the ROOT defaults unchanged.
+*/
+
+#ifndef ReadCacheSettings_H
+#define ReadCacheSettings_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+
+
+class ReadCacheSettings{
+
+    public:
+        ReadCacheSettings() = default;
+        ReadCacheSettings( const double cacheSizeInMB, const bool asyncPrefetching = false, const unsigned learnEntries = 100 );
+
+        //remove the read cache options from the command line arguments and return the settings they define
+        static ReadCacheSettings fromCommandLine( std::vector< std::string >& arguments );
+
+        //description of the command line options for usage messages
+        static std::string commandLineUsage();
+
+        //command line options reproducing these settings, e.g. to pass them on to submitted jobs
+        std::string commandLineOptions() const;
+
+        //negative cache size means the cache size is not modified
+        bool setsCacheSize() const{ return ( _cacheSize >= 0 ); }
+        long long cacheSize() const{ return _cacheSize; }
+        unsigned learnEntries() const{ return _learnEntries; }
+        bool asyncPrefetching() const{ return _asyncPrefetching; }
+        const std::string& columnarCacheDirectory() const{ return _columnarCacheDirectory; }
+        void setColumnarCacheDirectory( const std::string& directory ){ _columnarCacheDirectory = directory; }
+
+        //switch on asynchronous prefetching for all files opened afterwards in the whole process if these settings request it
+        void enableAsyncPrefetching() const;
+
+        //whether any option differs from the ROOT defaults
+        bool isSet() const{ return ( setsCacheSize() || _asyncPrefetching || !_columnarCacheDirectory.empty() ); }
+
+    private:
+        long long _cacheSize = -1;
+        unsigned _learnEntries = 100;
+        bool _asyncPrefetching = false;
+        std::string _columnarCacheDirectory;
+};
+
+#endif
@@ -0,0 +1,202 @@
+/*
+Event loop over all samples of a sample list, processed by a pool of threads.
+Each sample is split in tasks (ranges of entries) with a similar estimated cost,
+based on the number of entries and the compressed size of the tree.
+The tasks are divided over the threads in sample order, and threads that run out of tasks
+steal the remaining tasks of the other threads, so a single large sample is shared by all threads.
+The outputs are kept per sample, keyed by Sample::uniqueName.
+
+Usage:
+    SampleListScheduler scheduler( sampleListFile, sampleDirectory, numberOfThreads );
+    std::map< std::string, Histograms > histogramMap = scheduler.run(
+        []( const Sample& sample ){ return makeEmptyHistograms( sample ); },  // output for one sample
+        []( Event& event, Histograms& output ){ ... },                         // called for every event
+        []( Histograms& output, const Histograms& other ){ ... } );            // add other to output
+Outputs are built one at a time by the threads, and should not be registered in a ROOT directory
+(e.g. use TH1::AddDirectory( false ) ), since ROOT directories are not thread safe.
+*/
+
+#ifndef SampleListScheduler_H
+#define SampleListScheduler_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <exception>
+#include <utility>
+#include <algorithm>
+
+//include other parts of framework
+#include "TreeReader.h"
+#include "BranchProfile.h"
+#include "ParallelEventLoop.h"
+#include "../../Tools/interface/Sample.h"
+#include "../../Event/interface/Event.h"
+
+
+class SampleListScheduler{
+
+    public:
+        SampleListScheduler( const std::vector< Sample >&, const unsigned numberOfThreads = 0 );
+        SampleListScheduler( const std::string& sampleListFile, const std::string& sampleDirectory,
+            const unsigned numberOfThreads = 0 );
+
+        //settings of the TreeReaders of the threads
+        void setBranchProfile( const BranchProfile& profile ){ _branchProfile = profile; }
+        void setLazyReading( const bool lazy = true ){ _lazyReading = lazy; }
+
+        //arguments passed to TreeReader::buildEvent
+        void setEventOptions( const bool readIndividualTriggers, const bool readIndividualMetFilters,
+            const bool readAllJECVariations, const bool readGroupedJECVariations );
+
+        //only process the first entries of each sample (0 means all entries)
+        void setMaximumNumberOfEntries( const long unsigned maximum ){ _maximumNumberOfEntries = maximum; }
+
+        //target compressed size and maximum number of entries of a single task
+        void setTaskSize( const long long compressedBytesPerTask, const long unsigned maximumEntriesPerTask );
+
+        const std::vector< Sample >& sampleVector() const{ return _samples; }
+        unsigned numberOfThreads() const{ return _numberOfThreads; }
+
+        //process all samples and return the merged output of each sample
+        template< typename MakeOutput, typename ProcessEvent, typename MergeOutput >
+        auto run( MakeOutput makeOutput, ProcessEvent processEvent, MergeOutput mergeOutput ) const
+            -> std::map< std::string, decltype( makeOutput( std::declval< const Sample& >() ) ) >;
+
+    private:
+
+        struct Task{
+            std::vector< Sample >::size_type sampleIndex;
+            long unsigned firstEntry;
+            long unsigned lastEntry;
+            double cost;
+        };
+
+        //per-thread task queues, the owner takes tasks from the front and other threads steal from the back
+        class TaskQueues{
+            public:
+                TaskQueues( const std::vector< Task >&, const unsigned numberOfQueues );
+                bool nextTask( const unsigned queueIndex, Task& );
+                void clear();
+
+            private:
+                std::vector< std::deque< Task > > _queues;
+                std::vector< std::unique_ptr< std::mutex > > _mutexes;
+        };
+
+        std::vector< Sample > _samples;
+        unsigned _numberOfThreads;
+        long long _compressedBytesPerTask = 32000000;
+        long unsigned _maximumEntriesPerTask = 100000;
+        long unsigned _maximumNumberOfEntries = 0;
+
+        BranchProfile _branchProfile;
+        bool _lazyReading = false;
+        bool _readIndividualTriggers = false;
+        bool _readIndividualMetFilters = false;
+        bool _readAllJECVariations = false;
+        bool _readGroupedJECVariations = false;
+
+        //open a sample in the given TreeReader and apply the settings
+        void initializeTreeReader( TreeReader&, const Sample& ) const;
+
+        //split all samples in tasks, in sample order
+        std::vector< Task > makeTasks() const;
+};
+
+
+template< typename MakeOutput, typename ProcessEvent, typename MergeOutput >
+auto SampleListScheduler::run( MakeOutput makeOutput, ProcessEvent processEvent, MergeOutput mergeOutput ) const
+    -> std::map< std::string, decltype( makeOutput( std::declval< const Sample& >() ) ) >
+{
+    using OutputType = decltype( makeOutput( std::declval< const Sample& >() ) );
+    using OutputMap = std::map< std::string, OutputType >;
+
+    std::vector< Task > tasks = makeTasks();
+    unsigned numberOfWorkers = std::max( 1u, std::min( _numberOfThreads, static_cast< unsigned >( tasks.size() ) ) );
+    TaskQueues queues( tasks, numberOfWorkers );
+
+    ParallelEventLoop::enableThreadSafety();
+    std::mutex outputMutex;
+    std::vector< OutputMap > outputs( numberOfWorkers );
+    std::vector< std::exception_ptr > errors( numberOfWorkers );
+    auto work = [&]( const unsigned workerIndex ){
+        try{
+
+            //the TreeReader is only reinitialized when a task of another sample is taken
+            TreeReader treeReader;
+            std::vector< Sample >::size_type currentSampleIndex = _samples.size();
+            OutputType* outputPtr = nullptr;
+
+            //when reading eagerly the event of a thread is refilled for every entry instead of being rebuilt
+            std::unique_ptr< Event > eventPtr;
+            Task task;
+            while( queues.nextTask( workerIndex, task ) ){
+                const Sample& sample = _samples[ task.sampleIndex ];
+                if( task.sampleIndex != currentSampleIndex ){
+                    initializeTreeReader( treeReader, sample );
+                    currentSampleIndex = task.sampleIndex;
+                    auto outputIt = outputs[ workerIndex ].find( sample.uniqueName() );
+                    if( outputIt == outputs[ workerIndex ].end() ){
+                        std::lock_guard< std::mutex > lock( outputMutex );
+                        outputIt = outputs[ workerIndex ].emplace( sample.uniqueName(), makeOutput( sample ) ).first;
+                    }
+                    outputPtr = &( outputIt->second );
+                }
+                for( long unsigned entry = task.firstEntry; entry < task.lastEntry; ++entry ){
+                    if( eventPtr && !_lazyReading ){
+                        treeReader.refillEvent( *eventPtr, sample, entry );
+                    } else {
+                        eventPtr.reset( new Event( treeReader.buildEvent( sample, entry, _readIndividualTriggers,
+                            _readIndividualMetFilters, _readAllJECVariations, _readGroupedJECVariations ) ) );
+                    }
+                    processEvent( *eventPtr, *outputPtr );
+                }
+            }
+        } catch( ... ){
+            errors[ workerIndex ] = std::current_exception();
+
+            //make the other threads stop early
+            queues.clear();
+        }
+    };
+
+    std::vector< std::thread > threads;
+    for( unsigned i = 0; i < numberOfWorkers; ++i ){
+        threads.emplace_back( work, i );
+    }
+    for( auto& thread : threads ){
+        thread.join();
+    }
+    for( const auto& error : errors ){
+        if( error ) std::rethrow_exception( error );
+    }
+
+    //merge the outputs of the threads per sample
+    OutputMap merged;
+    for( auto& workerOutputs : outputs ){
+        for( auto& entry : workerOutputs ){
+            auto mergedIt = merged.find( entry.first );
+            if( mergedIt == merged.end() ){
+                merged.emplace( entry.first, std::move( entry.second ) );
+            } else {
+                mergeOutput( mergedIt->second, entry.second );
+            }
+        }
+    }
+
+    //samples without entries still get an (empty) output
+    for( const auto& sample : _samples ){
+        if( merged.find( sample.uniqueName() ) == merged.end() ){
+            merged.emplace( sample.uniqueName(), makeOutput( sample ) );
+        }
+    }
+    return merged;
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+Class describing which branches TreeReader::setOutputTree writes, and which Double_t branches are written as Float_t.
+Profiles are defined by name in a configuration file (see skimmer/slimmingProfiles.txt) with lines of the form
+    [profileName]
+    keep <patterns>
+    drop <patterns>
+    narrow <patterns>
+where a pattern is a branch name in which '*' matches any sequence of characters.
+A branch is written if it matches a keep pattern and no drop pattern,
+and a written Double_t branch matching a narrow pattern is stored as Float_t.
+The default profile writes all branches without narrowing.
+Trees written with another profile carry its name in their UserInfo (see userInfoName),
+so that TreeReader only tolerates missing branches when reading such trees.
+*/
+
+#ifndef SlimmingProfile_H
+#define SlimmingProfile_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+
+
+class SlimmingProfile{
+
+    public:
+        SlimmingProfile() = default;
+        SlimmingProfile( const std::string& name, const std::vector< std::string >& keepPatterns,
+                         const std::vector< std::string >& dropPatterns = {}, const std::vector< std::string >& narrowPatterns = {} );
+
+        //read a named profile from a configuration file
+        static SlimmingProfile fromFile( const std::string& configPath, const std::string& profileName );
+        static std::vector< std::string > profilesInFile( const std::string& configPath );
+
+        const std::string& name() const{ return _name; }
+        bool keeps( const std::string& branchName ) const;
+        bool narrows( const std::string& branchName ) const;
+        bool keepsAll() const{ return _keepAll; }
+
+        //name of the object holding the profile name in the UserInfo of a slimmed tree
+        static const char* userInfoName(){ return "slimmingProfile"; }
+
+        //match a branch name to a pattern in which '*' matches any sequence of characters
+        static bool matches( const std::string& pattern, const std::string& branchName );
+
+    private:
+        std::string _name = "all";
+        bool _keepAll = true;
+        std::vector< std::string > _keepPatterns;
+        std::vector< std::string > _dropPatterns;
+        std::vector< std::string > _narrowPatterns;
+
+        static bool matchesAny( const std::vector< std::string >& patterns, const std::string& branchName );
+};
+
+#endif
@@ -1,6 +1,16 @@
 #ifndef TreeReader_H
 #define TreeReader_H
 
+//include c++ library classes
+#include <iostream>
+#include <map>
+#include <vector>
+#include <memory>
+#include <initializer_list>
+#include <limits>
+#include <type_traits>
+#include <functional>
+
 //include ROOT classes
 #include "TROOT.h"
 #include "TChain.h"
@@ -12,9 +22,19 @@
 
 //include other parts of code
 #include "../../Tools/interface/Sample.h"
+#include "BranchProfile.h"
+#include "JECVariationTable.h"
+#include "DecisionTable.h"
+#include "BranchNameIndex.h"
+#include "ReadCacheSettings.h"
+#include "EventBatch.h"
+#include "PreSelection.h"
+#include "SlimmingProfile.h"
+#include "ColumnarCache.h"
 
 
 class Event;
+class TLeaf;
 
 
 class TreeReader {
@@ -189,14 +209,13 @@ class TreeReader {
         Double_t        _jetChargedEmFraction[nJets_max];
         Double_t        _jetHFHadronFraction[nJets_max];
         Double_t        _jetHFEmFraction[nJets_max];
-	std::map< std::string, Double_t[nJets_max] > _jetPt_JECGroupedDown;
-        std::map< std::string, Double_t[nJets_max] > _jetPt_JECGroupedUp;
-        std::map< std::string, Double_t[nJets_max] > _jetPt_JECSourcesDown;
-        std::map< std::string, Double_t[nJets_max] > _jetPt_JECSourcesUp;
-        std::map< std::string, Double_t[nJets_max] > _jetSmearedPt_JECGroupedDown;
-        std::map< std::string, Double_t[nJets_max] > _jetSmearedPt_JECGroupedUp;
-        std::map< std::string, Double_t[nJets_max] > _jetSmearedPt_JECSourcesDown;
-        std::map< std::string, Double_t[nJets_max] > _jetSmearedPt_JECSourcesUp;
+	// split and grouped JEC variations, indexed by [ variation index ][ jet index ]
+	// (i.e. at variationIndex*nJets_max + jetIndex, see JECVariationTable for the variation indices)
+        std::shared_ptr< const JECVariationTable > _JECVariationTable;
+        std::vector< Double_t > _jetPt_JECVariationsDown;
+        std::vector< Double_t > _jetPt_JECVariationsUp;
+        std::vector< Double_t > _jetSmearedPt_JECVariationsDown;
+        std::vector< Double_t > _jetSmearedPt_JECVariationsUp;
         // variables related to missing transverse energy
 	Double_t        _met;
         Double_t        _met_JECDown;
@@ -209,14 +228,11 @@ class TreeReader {
         Double_t        _metPhi_UnclDown;
         Double_t        _metPhi_UnclUp;       
         Double_t        _metSignificance;
-	std::map< std::string, Double_t > _corrMETx_JECGroupedDown;
-        std::map< std::string, Double_t > _corrMETx_JECGroupedUp;
-        std::map< std::string, Double_t > _corrMETx_JECSourcesDown;
-        std::map< std::string, Double_t > _corrMETx_JECSourcesUp;
-	std::map< std::string, Double_t > _corrMETy_JECGroupedDown;
-        std::map< std::string, Double_t > _corrMETy_JECGroupedUp;
-        std::map< std::string, Double_t > _corrMETy_JECSourcesDown;
-        std::map< std::string, Double_t > _corrMETy_JECSourcesUp;
+	// split and grouped JEC variations, indexed by variation index
+        std::vector< Double_t > _corrMETx_JECVariationsDown;
+        std::vector< Double_t > _corrMETx_JECVariationsUp;
+        std::vector< Double_t > _corrMETy_JECVariationsDown;
+        std::vector< Double_t > _corrMETy_JECVariationsUp;
 	// variables related to taus
 	UInt_t          _tauDecayMode[nL_max];
         Bool_t          _decayModeFinding[nL_max];
@@ -254,6 +270,10 @@ class TreeReader {
         std::map< std::string, bool > _triggerMap;
         std::map< std::string, bool > _MetFilterMap;
 
+        //names of the triggers and MET filters in the maps above, rebuilt together with the maps
+        std::shared_ptr< const DecisionTable > _triggerTable;
+        std::shared_ptr< const DecisionTable > _MetFilterTable;
+
         //weight including cross section scaling 
         double          _scaledWeight;
 
@@ -267,11 +287,69 @@ class TreeReader {
 			    bool includeGeneratorInfo = true,
 			    bool includeGenParticles = true );
 
+        //select which branches setOutputTree writes and which are narrowed to Float_t (see SlimmingProfile.h)
+        //the profile is applied in addition to the include flags of setOutputTree
+        void setSlimmingProfile( const SlimmingProfile& profile ){ _slimmingProfile = profile; }
+        const SlimmingProfile& slimmingProfile() const{ return _slimmingProfile; }
+
+        //profile reproducing the slimming of the current tree: it keeps the branches present in the tree and narrows its Float_t branches
+        //(the default profile if the tree was not slimmed), to write the tree again without widening or adding branches
+        SlimmingProfile slimmingProfileOfCurrentTree() const;
+
+        //fill an output tree set with setOutputTree, this has to be used instead of TTree::Fill when branches are narrowed
+        void fillOutputTree( TTree* );
+
+        //copy the given entries (in increasing order) of the current tree with all of its branches to a new tree in the current directory
+        //when all entries are copied to a file with the compression settings of the input file
+        //the compressed baskets are cloned without being decompressed,
+        //otherwise only the given entries are read and written with the compression of the output file,
+        //without going through the variables of the TreeReader (a warning gives the reason the baskets are not cloned)
+        //a given configuration of the new tree (e.g. OutputFileSettings::configureTree) is applied before any entry is written,
+        //in which case the baskets are never cloned as they are, since their layout could not follow the configuration
+        TTree* copyEntries( const std::vector< long unsigned >& entries, const std::function< void( TTree* ) >& configureTree = nullptr );
+
+        //select which groups of branches are read from the tree (see BranchProfile.h)
+        //the profile is applied to the current tree and to all trees initialized afterwards
+        //a columnar cache must contain all groups of the profile, otherwise it is refused
+        void setBranchProfile( const BranchProfile& );
+        const BranchProfile& branchProfile() const{ return _branchProfile; }
+
+        //lazy reading: GetEntry only reads the eventInfo group, the other branch groups
+        //are read for the current entry when an Event first accesses the objects built from them
+        //(setOutputTree can not be used in this mode)
+        void setLazyReading( const bool lazy = true ){ _lazyReading = lazy; }
+        bool lazyReading() const{ return _lazyReading; }
+
+        //read cache (see ReadCacheSettings.h)
+        //the cache is applied to the current tree and to all trees initialized afterwards,
+        //asynchronous prefetching is a process-wide setting (see ReadCacheSettings::enableAsyncPrefetching)
+        void setReadCache( const ReadCacheSettings& );
+        const ReadCacheSettings& readCacheSettings() const{ return _readCacheSettings; }
+
+        //report of the cache hit rate and the number of read calls per entry for the current tree
+        void printReadCacheStatistics( std::ostream& os = std::cout ) const;
+
+        //read the branches of the given groups for the current entry if this was not done yet
+        //(does nothing when not reading lazily, since GetEntry then reads all enabled branches)
+        void loadBranchGroups( std::initializer_list< BranchProfile::Group > ) const;
+
+        //number of calls to GetEntry, used to check that lazily read branches belong to a given event
+        unsigned long entryReadIndex() const{ return _entryReadIndex; }
+
+        //report of the number of bytes read from the trees (per branch group in lazy mode)
+        void printReadStatistics( std::ostream& os = std::cout ) const;
+        void resetReadStatistics();
+
         //initialize the next sample
         void initSample();
         void initSample(const Sample&);  
 
+        //initialize the sample at the given index in the sample list
+        //(only the file of this sample is opened, so use this to jump to a sample in a job)
+        void initSample( const std::vector< Sample >::size_type sampleIndex );
+
         //read sample list from text file
+        //(no files are opened until a sample is initialized)
         void readSamples2016(const std::string&, const std::string&);
         void readSamples2017(const std::string&, const std::string&);
         void readSamples2018(const std::string&, const std::string&);
@@ -289,6 +367,23 @@ class TreeReader {
         void initSampleFromFile( const std::string& pathToFile, 
 				 const bool resetTriggersAndFilters = true );
 
+        //columnar cache of the branches of a sample (see ColumnarCache.h)
+        //write the branches of the groups enabled by the branch profile of the current tree to a cache in the given directory,
+        //returns the number of bytes written
+        unsigned long long writeColumnarCache( const std::string& cacheDirectory,
+            const long unsigned maximumNumberOfEntries = std::numeric_limits< long unsigned >::max() );
+
+        //initialize the current sample from a cache instead of a root file, the sample info is taken from the cache
+        //(a cache is refused when its source file changed since it was written,
+        //or when it was written with a branch profile that lacks groups of the profile of this reader)
+        void initSampleFromCache( const std::string& cacheDirectory );
+
+        //samples of the sample list initialized afterwards are read from the cache in columnarCachePath( directory, sample )
+        //if it exists, and from their root file otherwise
+        void setColumnarCacheDirectory( const std::string& directory ){ _columnarCacheDirectory = directory; }
+        static std::string columnarCachePath( const std::string& directory, const Sample& );
+        bool readsFromColumnarCache() const{ return static_cast< bool >( _columnarCachePtr ); }
+
         //Get entry from Tree, should not be used except for test purposes
         void GetEntry(const Sample&, long unsigned );
         void GetEntry(long unsigned );
@@ -306,17 +401,42 @@ class TreeReader {
 			    const bool readAllJECVariations = false, 
                             const bool readGroupedJECVariations = false );
 
+        //read the given entry into an existing event, which keeps the options it was built with
+        //and reuses the memory of its objects (see Event::refill), in loops use this instead of buildEvent
+        //for all but the first entry to avoid allocating every event again
+        void refillEvent( Event&, const Sample&, long unsigned );
+        void refillEvent( Event&, long unsigned );
+
+        //read the lepton, jet, MET and combined trigger branches of a range of entries into a batch (see EventBatch.h)
+        //only these branches are read, basket by basket, and their values are unpacked straight into the columns of the batch
+        //the variables of the reader are left untouched, so the current entry stays valid
+        //returns false if there are no entries left in the range
+        bool readBatch( EventBatch&, const long unsigned firstEntry, const long unsigned numberOfEntries );
+
+        //apply a pre-selection to the first entries of the current tree, reading them in batches
+        //the events of the surviving entries can then be built with buildEvent
+        PreSelectionResult preSelectEntries( const PreSelection&, const long unsigned maximumNumberOfEntries = std::numeric_limits< long unsigned >::max(),
+                                              const long unsigned batchSize = 10000 );
+
         //check whether specific info is present in current tree
-        bool containsTauInfo() const;
-	bool containsGeneratorInfo() const;
-	bool containsGenParticles() const;
+        bool containsTauInfo() const{ return _containsTauInfo; }
+	bool containsGeneratorInfo() const{ return _containsGeneratorInfo; }
+	bool containsGenParticles() const{ return _containsGenParticles; }
 
         //check whether SUSY mass info is present in the current sample
 	// ( this is the case for SUSY signal scans )
-        bool containsSusyMassInfo() const;
+        bool containsSusyMassInfo() const{ return _containsSusyMassInfo; }
+
+        //check whether a particular trigger is present, either with exactly the given name or as the start of a trigger name
+        //( the leading underscore of the branch names can be omitted, e.g. "HLT_Ele32" )
+        bool containsTriggerInfo( const std::string& triggerPath, const bool exactMatch = false ) const;
+
+        //index of an individual trigger in the trigger table of the current tree, to be passed to Event::passTrigger
+        //throws an std::invalid_argument if the trigger does not exist
+        DecisionTable::size_type triggerIndex( const std::string& triggerName ) const;
 
-        //check whether a particular trigger is present 
-        bool containsTriggerInfo( const std::string& triggerPath ) const;
+        //names of the branches in the current tree
+        const BranchNameIndex& branchNameIndex() const{ return _branchNameIndex; }
 
         //check which year the current sample belongs to
         bool is2016() const;
@@ -352,6 +472,9 @@ class TreeReader {
 
         unsigned long numberOfEntries() const;
 
+        //compressed size in bytes of the current tree
+        long long compressedTreeSize() const;
+
     private:
 
         //list of samples to loop over 
@@ -369,9 +492,68 @@ class TreeReader {
         //TTree associated to current sample 
         TTree* _currentTreePtr = nullptr;
 
+        //columnar cache the current sample is read from instead of the tree
+        std::string _columnarCacheDirectory;
+        std::shared_ptr< const ColumnarCache > _columnarCachePtr;
+        void readEntryFromCache( const long unsigned entry );
+        void readBatchFromCache( EventBatch&, const long unsigned firstEntry, const long unsigned batchSize ) const;
+        void checkCacheMatchesSample( const Sample& ) const;
+        void checkCacheIsCurrent( const std::string& sourcePath ) const;
+        void checkCacheContainsBranchProfile( const BranchProfile& ) const;
+
         //cache whether current sample is SUSY to avoid having to check the branch names for each event
         bool _isSusy = false;
 
+        //branch names and types of information in the current tree, set once when the tree is opened
+        BranchNameIndex _branchNameIndex;
+        bool _containsTauInfo = false;
+        bool _containsGeneratorInfo = false;
+        bool _containsGenParticles = false;
+        bool _containsSusyMassInfo = false;
+        void indexCurrentTree();
+
+        //groups of branches that are read from the tree
+        BranchProfile _branchProfile;
+
+        //switch off the branches of disabled groups in the current tree
+        void applyBranchProfile();
+
+        //read cache of the current tree, trained on the branches enabled by the profile
+        ReadCacheSettings _readCacheSettings;
+        unsigned long _numberOfEntriesReadFromTree = 0;
+        void applyReadCache();
+
+        //branches written by setOutputTree, with Float_t copies of narrowed Double_t branches
+        SlimmingProfile _slimmingProfile;
+        struct NarrowedBranch{
+            const Double_t* source;
+            std::vector< Float_t > values;
+        };
+        std::vector< NarrowedBranch > _narrowedOutputBranches;
+
+        //create a branch in an output tree if the slimming profile keeps it
+        void addOutputBranch( TTree*, const std::string& name, void* address, const std::string& leafList, const std::size_t numberOfValues );
+        template< typename T > void addOutputBranch( TTree* outputTree, const std::string& name, T* address, const std::string& leafList ){
+            addOutputBranch( outputTree, name, static_cast< void* >( address ), leafList, 
+                sizeof( T ) / sizeof( typename std::remove_all_extents< T >::type ) );
+        }
+        void setJECVariationOutputBranch( TTree*, const std::string& quantity, const JECVariationTable::size_type variationIndex,
+            const std::string& direction, Double_t* address, const TBranch* inputBranchPtr, const bool isJetArray );
+
+        //lazy reading of branch groups
+        bool _lazyReading = false;
+        long unsigned _currentEntry = 0;
+        unsigned long _entryReadIndex = 0;
+        mutable unsigned _loadedGroups = 0;
+        std::map< BranchProfile::Group, std::vector< TBranch* > > _branchesPerGroup;
+        void loadBranchGroup( const BranchProfile::Group ) const;
+
+        //read statistics
+        unsigned long _numberOfEntriesRead = 0;
+        unsigned long long _bytesReadEagerly = 0;
+        mutable std::map< BranchProfile::Group, unsigned long long > _bytesReadPerGroup;
+        mutable std::map< BranchProfile::Group, unsigned long > _entriesReadPerGroup;
+
         //check whether current sample is initialized, throw an error if it is not 
         void checkCurrentSample() const;
 
@@ -395,12 +577,64 @@ class TreeReader {
         void readSamples(const std::string&, const std::string&, std::vector<Sample>&);
 
         //initialize triggerMap
-        void initializeTriggerMap( TTree* );
-        void initializeMetFilterMap( TTree* );
-
-	// initialize split jec uncertainty source maps
-        void initializeJecSourcesMaps( TTree* );
-        void initializeJecSourcesGroupedMaps( TTree* );
+        void initializeTriggerMap();
+        void initializeMetFilterMap();
+
+	// initialize the table and storage of the split and grouped jec uncertainties
+	// and set the addresses of their branches
+        void initializeJECVariations();
+        void setJECVariationBranchAddresses();
+
+        //sum of simulated event weights stored in the hCounter histogram of the current file
+        double sumSimulatedEventWeightsFromFile() const;
+
+        //set the address of an input branch, Double_t variables can be read from branches narrowed to Float_t (see SlimmingProfile.h)
+        //the values of narrowed branches are read into a buffer and converted after each read of the branch,
+        //only up to the size of the array in the entry that was read
+        struct NarrowedInputBranch{
+            std::vector< Float_t > values;
+            Double_t* target;
+            std::size_t valuesPerObject;
+            const TLeaf* sizeLeafPtr;   //nullptr for scalars and fixed-size arrays
+            BranchProfile::Group group;
+        };
+        std::vector< NarrowedInputBranch > _narrowedInputBranches;
+        std::map< const TBranch*, std::size_t > _narrowedInputBranchIndices;
+        void convertNarrowedInputBranch( const NarrowedInputBranch& ) const;
+        void convertNarrowedInputBranches() const;
+        void convertNarrowedInputBranches( const BranchProfile::Group ) const;
+        const NarrowedInputBranch* narrowedInputBranch( const TBranch* ) const;
+
+        //branches missing from trees written with a slimming profile are skipped, with their (size) variable set to zero,
+        //for other trees a missing branch is reported by ROOT as before
+        //when reading from a columnar cache only the column is bound to the variable and the branch pointer stays nullptr
+        bool _isSlimmedTree = false;
+        template< typename T > void setInputBranchAddress( const char* name, T* address, TBranch** branchPtrPtr ){
+            *branchPtrPtr = nullptr;
+            if( !_branchNameIndex.contains( name ) ){
+                *address = T();
+                if( !_isSlimmedTree && !_columnarCachePtr ) _currentTreePtr->SetBranchAddress( name, address, branchPtrPtr );
+                return;
+            }
+            addInputColumn( name, address, columnTypeCode< T >(), sizeof( T ) );
+            if( !_columnarCachePtr ) _currentTreePtr->SetBranchAddress( name, address, branchPtrPtr );
+        }
+        void setInputBranchAddress( const char* name, Double_t* address, TBranch** branchPtrPtr );
+
+        //variables bound to the branches of the current tree or to the columns of the cache,
+        //with the layout of the branch in the tree (or the column in the cache) and the number of values the variable can hold
+        struct InputColumn{
+            ColumnInfo info;
+            void* address;
+            BranchProfile::Group group;
+            ColumnarCache::size_type cacheIndex;
+            std::size_t capacity;
+        };
+        std::vector< InputColumn > _inputColumns;
+        void addInputColumn( const char* name, void* address, const char typeCode, const std::size_t valueSize );
+
+        //size of the arrays bound to the branches holding the number of objects (e.g. nL_max for _nL)
+        static std::size_t maximumNumberOfObjects( const std::string& sizeName );
 
         //list of branches
         TBranch        *b__runNb;   
@@ -579,14 +813,10 @@ class TreeReader {
         TBranch        *b__jetChargedEmFraction;
         TBranch        *b__jetHFHadronFraction;
         TBranch        *b__jetHFEmFraction;
-	std::map< std::string, TBranch* > b__jetPt_JECGroupedDown;
-        std::map< std::string, TBranch* > b__jetPt_JECGroupedUp;
-        std::map< std::string, TBranch* > b__jetPt_JECSourcesDown;
-        std::map< std::string, TBranch* > b__jetPt_JECSourcesUp;
-        std::map< std::string, TBranch* > b__jetSmearedPt_JECGroupedDown;
-        std::map< std::string, TBranch* > b__jetSmearedPt_JECGroupedUp;
-        std::map< std::string, TBranch* > b__jetSmearedPt_JECSourcesDown;
-        std::map< std::string, TBranch* > b__jetSmearedPt_JECSourcesUp;
+        std::vector< TBranch* > b__jetPt_JECVariationsDown;
+        std::vector< TBranch* > b__jetPt_JECVariationsUp;
+        std::vector< TBranch* > b__jetSmearedPt_JECVariationsDown;
+        std::vector< TBranch* > b__jetSmearedPt_JECVariationsUp;
         TBranch        *b__met;   
         TBranch        *b__met_JECDown;   
         TBranch        *b__met_JECUp;   
@@ -598,14 +828,10 @@ class TreeReader {
         TBranch        *b__metPhi_UnclDown;   
         TBranch        *b__metPhi_UnclUp;   
         TBranch        *b__metSignificance;
-	std::map< std::string, TBranch* > b__corrMETx_JECGroupedDown;
-        std::map< std::string, TBranch* > b__corrMETx_JECGroupedUp;
-        std::map< std::string, TBranch* > b__corrMETx_JECSourcesDown;
-        std::map< std::string, TBranch* > b__corrMETx_JECSourcesUp;
-	std::map< std::string, TBranch* > b__corrMETy_JECGroupedDown;
-        std::map< std::string, TBranch* > b__corrMETy_JECGroupedUp;
-        std::map< std::string, TBranch* > b__corrMETy_JECSourcesDown;
-        std::map< std::string, TBranch* > b__corrMETy_JECSourcesUp;
+        std::vector< TBranch* > b__corrMETx_JECVariationsDown;
+        std::vector< TBranch* > b__corrMETx_JECVariationsUp;
+        std::vector< TBranch* > b__corrMETy_JECVariationsDown;
+        std::vector< TBranch* > b__corrMETy_JECVariationsUp;
         TBranch        *b__mChi1;
         TBranch        *b__mChi2;
 
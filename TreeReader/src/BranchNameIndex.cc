@@ -0,0 +1,31 @@
+#include "../interface/BranchNameIndex.h"
+
+//include c++ library classes
+#include <algorithm>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+BranchNameIndex::BranchNameIndex( const std::vector< std::string >& branchNames ) :
+    _sortedNames( branchNames ),
+    _names( branchNames.cbegin(), branchNames.cend() )
+{
+    std::sort( _sortedNames.begin(), _sortedNames.end() );
+}
+
+
+bool BranchNameIndex::containsPrefix( const std::string& prefix ) const{
+
+    //the first name that is not smaller than the prefix is the only candidate to start with it
+    auto nameIt = std::lower_bound( _sortedNames.cbegin(), _sortedNames.cend(), prefix );
+    return ( nameIt != _sortedNames.cend() && stringTools::stringStartsWith( *nameIt, prefix ) );
+}
+
+
+bool BranchNameIndex::containsSubstring( const std::string& nameToFind ) const{
+    for( const auto& name : _sortedNames ){
+        if( stringTools::stringContains( name, nameToFind ) ) return true;
+    }
+    return false;
+}
@@ -0,0 +1,225 @@
+#include "../interface/BranchProfile.h"
+
+//include c++ library classes
+#include <map>
+#include <set>
+#include <stdexcept>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+namespace{
+
+    const std::map< std::string, BranchProfile::Group >& groupNameMap(){
+        static const std::map< std::string, BranchProfile::Group > nameMap = {
+            { "eventInfo", BranchProfile::eventInfo },
+            { "triggers", BranchProfile::triggers },
+            { "individualTriggers", BranchProfile::individualTriggers },
+            { "metFilters", BranchProfile::metFilters },
+            { "leptonKinematics", BranchProfile::leptonKinematics },
+            { "leptonVariations", BranchProfile::leptonVariations },
+            { "leptonID", BranchProfile::leptonID },
+            { "leptonGenMatch", BranchProfile::leptonGenMatch },
+            { "taus", BranchProfile::taus },
+            { "jets", BranchProfile::jets },
+            { "jetVariations", BranchProfile::jetVariations },
+            { "JECSources", BranchProfile::JECSources },
+            { "JECGrouped", BranchProfile::JECGrouped },
+            { "met", BranchProfile::met },
+            { "metVariations", BranchProfile::metVariations },
+            { "generatorInfo", BranchProfile::generatorInfo },
+            { "genParticles", BranchProfile::genParticles },
+            { "susyMasses", BranchProfile::susyMasses },
+            { "other", BranchProfile::other }
+        };
+        return nameMap;
+    }
+
+
+    //named profiles in terms of groups
+    const std::map< std::string, BranchProfile >& namedProfileMap(){
+        using bp = BranchProfile;
+        static const std::map< std::string, BranchProfile > profileMap = {
+            { "all", bp() },
+
+            //everything except the expensive per-name maps and generator particles
+            { "nominal", bp().disable( bp::individualTriggers ).disable( bp::metFilters )
+                .disable( bp::JECSources ).disable( bp::JECGrouped ).disable( bp::genParticles ) },
+
+            //kinematics, lepton ID and nominal jets and MET, no variations, taus or generator info
+            { "minimal", bp( { bp::eventInfo, bp::triggers, bp::leptonKinematics, bp::leptonID,
+                bp::jets, bp::met, bp::other } ) },
+
+            //fake-rate measurements need individual triggers and prompt matching in MC
+            { "fakerate", bp( { bp::eventInfo, bp::triggers, bp::individualTriggers,
+                bp::leptonKinematics, bp::leptonID, bp::leptonGenMatch, bp::jets, bp::met,
+                bp::generatorInfo, bp::other } ) },
+
+            //charge-flip measurements only need leptons and prompt matching in MC
+            { "chargeflip", bp( { bp::eventInfo, bp::triggers, bp::leptonKinematics,
+                bp::leptonID, bp::leptonGenMatch, bp::jets, bp::met, bp::generatorInfo,
+                bp::other } ) }
+        };
+        return profileMap;
+    }
+}
+
+
+BranchProfile::BranchProfile( const std::string& profileString ) :
+    _enabledGroups( 0 )
+{
+    for( const auto& token : stringTools::split( profileString, "," ) ){
+        std::string cleanToken = stringTools::cleanSpaces( token );
+        if( cleanToken.empty() ) continue;
+        addToken( cleanToken );
+    }
+}
+
+
+BranchProfile::BranchProfile( std::initializer_list< Group > groups ) :
+    _enabledGroups( 0 )
+{
+    for( const auto group : groups ){
+        enable( group );
+    }
+}
+
+
+void BranchProfile::addToken( const std::string& token ){
+    bool remove = stringTools::stringStartsWith( token, "-" );
+    std::string name = ( remove ? token.substr( 1 ) : token );
+
+    unsigned groupsToChange = 0;
+    auto profileIt = namedProfileMap().find( name );
+    auto groupIt = groupNameMap().find( name );
+    if( profileIt != namedProfileMap().cend() ){
+        groupsToChange = profileIt->second._enabledGroups;
+    } else if( groupIt != groupNameMap().cend() ){
+        groupsToChange = groupIt->second;
+    } else {
+        std::string message = "ERROR in BranchProfile::BranchProfile:";
+        message += " '" + name + "' is neither a known branch group nor a named profile.";
+        throw std::invalid_argument( message );
+    }
+
+    if( remove ) _enabledGroups &= ~groupsToChange;
+    else _enabledGroups |= groupsToChange;
+}
+
+
+BranchProfile::Group BranchProfile::groupOfBranch( const std::string& branchName ){
+    //the event weight is needed for every MC event, so it is read together with the event info
+    static const std::set< std::string > eventInfoBranches = {
+        "_runNb", "_lumiBlock", "_eventNb", "_nVertex", "_weight"
+    };
+    static const std::set< std::string > generatorInfoBranches = {
+        "_nLheWeights", "_lheWeight", "_nPsWeights", "_psWeight", "_nTrueInt",
+        "_lheHTIncoming", "_ttgEventType", "_zgEventType", "_gen_met", "_gen_metPhi"
+    };
+    static const std::set< std::string > leptonKinematicsBranches = {
+        "_nL", "_nMu", "_nEle", "_nLight", "_nTau", "_lPt", "_lPtCorr", "_lEta", "_lEtaSC",
+        "_lPhi", "_lE", "_lECorr", "_lFlavor", "_lCharge"
+    };
+    static const std::set< std::string > leptonGenMatchBranches = {
+        "_lIsPrompt", "_lMatchPdgId", "_lMatchCharge", "_lMomPdgId"
+    };
+    static const std::set< std::string > leptonIDBranches = {
+        "_lElectronPassEmu", "_lElectronPassConvVeto", "_lElectronChargeConst", "_lElectronMissingHits",
+        "_lElectronSigmaIetaIeta", "_lElectronHOverE", "_lElectronEInvMinusPInv", "_lElectronMvaFall17Iso",
+        "_lElectronMvaFall17NoIso", "_lElectronPassMVAFall17NoIsoWPLoose", "_lElectronPassMVAFall17NoIsoWP80",
+        "_lElectronPassMVAFall17NoIsoWP90", "_lElectronSummer16MvaGP", "_lElectronSummer16MvaHZZ",
+        "_lPOGVeto", "_lPOGLoose", "_lPOGMedium", "_lPOGTight",
+        "_lMuonSegComp", "_lMuonTrackPt", "_lMuonTrackPtErr"
+    };
+    static const std::vector< std::string > leptonIDPrefixes = {
+        "_dxy", "_dz", "_3dIP", "_relIso", "_miniIso", "_ptRel", "_ptRatio",
+        "_closestJet", "_selectedTrackMult", "_leptonMva"
+    };
+    using stringTools::stringContains;
+    using stringTools::stringStartsWith;
+
+    //split JEC sources also exist for MET, so check these first
+    if( stringContains( branchName, "JECSources" ) ) return JECSources;
+    if( stringContains( branchName, "JECGrouped" ) ) return JECGrouped;
+
+    //trigger and MET filter names follow the conventions of TreeReader::initializeTriggerMap
+    //and TreeReader::initializeMetFilterMap
+    if( stringContains( branchName, "HLT" ) ) return individualTriggers;
+    if( stringContains( branchName, "Flag" ) || stringContains( branchName, "updated" ) ){
+        return metFilters;
+    }
+    if( stringStartsWith( branchName, "_passTrigger" ) || branchName == "_passMETFilters" ){
+        return triggers;
+    }
+
+    if( eventInfoBranches.count( branchName ) ) return eventInfo;
+    if( generatorInfoBranches.count( branchName ) ) return generatorInfo;
+    if( stringStartsWith( branchName, "_prefireWeight" ) ) return generatorInfo;
+    if( stringStartsWith( branchName, "_gen_" ) ) return genParticles;
+    if( stringStartsWith( branchName, "_mChi" ) ) return susyMasses;
+
+    if( stringStartsWith( branchName, "_tau" )
+        || stringStartsWith( branchName, "_decayModeFinding" ) ) return taus;
+
+    if( stringStartsWith( branchName, "_met_" )
+        || stringStartsWith( branchName, "_metPhi_" ) ) return metVariations;
+    if( stringStartsWith( branchName, "_met" ) ) return met;
+
+    if( branchName == "_nJets" || stringStartsWith( branchName, "_jet" ) ){
+        if( stringContains( branchName, "_JEC" ) || stringContains( branchName, "_JER" ) ){
+            return jetVariations;
+        }
+        return jets;
+    }
+
+    if( leptonKinematicsBranches.count( branchName ) ) return leptonKinematics;
+    if( leptonGenMatchBranches.count( branchName )
+        || stringStartsWith( branchName, "_lProvenance" ) ) return leptonGenMatch;
+    for( const auto& prefix : { "_lPtScale", "_lPtRes", "_lEScale", "_lERes" } ){
+        if( stringStartsWith( branchName, prefix ) ) return leptonVariations;
+    }
+    if( leptonIDBranches.count( branchName ) ) return leptonID;
+    for( const auto& prefix : leptonIDPrefixes ){
+        if( stringStartsWith( branchName, prefix ) ) return leptonID;
+    }
+    return other;
+}
+
+
+std::string BranchProfile::groupName( const Group group ){
+    for( const auto& entry : groupNameMap() ){
+        if( entry.second == group ) return entry.first;
+    }
+    throw std::invalid_argument( "ERROR in BranchProfile::groupName: unknown group "
+        + std::to_string( static_cast< unsigned >( group ) ) + "." );
+}
+
+
+std::vector< std::string > BranchProfile::availableProfiles(){
+    std::vector< std::string > names;
+    for( const auto& entry : namedProfileMap() ){
+        names.push_back( entry.first );
+    }
+    return names;
+}
+
+
+std::string BranchProfile::toString() const{
+    if( enablesAll() ) return "all";
+    std::string ret;
+    for( const auto& entry : groupNameMap() ){
+        if( !isEnabled( entry.second ) ) continue;
+        if( !ret.empty() ) ret += ",";
+        ret += entry.first;
+    }
+    return ret;
+}
+
+
+void BranchProfile::throwDisabledGroup( const Group group, const std::string& accessorName ){
+    std::string message = "ERROR in " + accessorName + ":";
+    message += " branch group '" + groupName( group ) + "' is disabled in the BranchProfile";
+    message += " of the TreeReader this object was built from.";
+    throw std::domain_error( message );
+}
@@ -0,0 +1,373 @@
+#include "../interface/ColumnarCache.h"
+
+//include c++ library classes
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstring>
+#include <algorithm>
+
+//include POSIX functions for memory-mapping files
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+//include other parts of framework
+#include "../../Tools/interface/systemTools.h"
+#include "../../Tools/interface/stringTools.h"
+
+
+namespace{
+
+    std::string metadataPath( const std::string& directory ){
+        return stringTools::formatDirectoryName( directory ) + "metadata.txt";
+    }
+
+    std::string valuesPath( const std::string& directory, const std::string& columnName ){
+        return stringTools::formatDirectoryName( directory ) + columnName + ".values";
+    }
+
+    std::string offsetsPath( const std::string& directory, const std::string& sizeName ){
+        return stringTools::formatDirectoryName( directory ) + sizeName + ".offsets";
+    }
+
+    //value of a column holding the size of arrays
+    std::uint64_t sizeValue( const void* address, const ColumnInfo& sizeColumn ){
+        switch( sizeColumn.typeCode ){
+            case 'i' : return *static_cast< const unsigned* >( address );
+            case 'g' : return *static_cast< const unsigned long* >( address );
+            case 'l' : return *static_cast< const unsigned long long* >( address );
+            case 'I' : return static_cast< std::uint64_t >( std::max( *static_cast< const int* >( address ), 0 ) );
+            case 'G' : return static_cast< std::uint64_t >( std::max( *static_cast< const long* >( address ), 0L ) );
+            case 'L' : return static_cast< std::uint64_t >( std::max( *static_cast< const long long* >( address ), 0LL ) );
+            default : throw std::invalid_argument( "ERROR in ColumnarCacheWriter::fill: column '" + sizeColumn.name + "' can not hold the size of arrays." );
+        }
+    }
+}
+
+
+void ColumnarCacheMetadata::write( const std::string& directory ) const{
+    std::ofstream metadataFile( metadataPath( directory ) );
+    metadataFile << "# columnar cache written by TreeReader::writeColumnarCache, see TreeReader/interface/ColumnarCache.h" << "\n";
+    metadataFile << "format 1" << "\n";
+    metadataFile << "source " << source << "\n";
+    metadataFile << "sourceSize " << sourceSize << "\n";
+    metadataFile << "sourceModificationTime " << sourceModificationTime << "\n";
+    metadataFile << "entries " << numberOfEntries << "\n";
+    metadataFile << "isData " << isData << "\n";
+    metadataFile << "is2016 " << is2016 << "\n";
+    metadataFile << "is2016PreVFP " << is2016PreVFP << "\n";
+    metadataFile << "is2016PostVFP " << is2016PostVFP << "\n";
+    metadataFile << "is2017 " << is2017 << "\n";
+    metadataFile << "is2018 " << is2018 << "\n";
+    metadataFile << "sumOfSimulatedEventWeights " << std::setprecision( 17 ) << sumOfSimulatedEventWeights << "\n";
+    metadataFile << "branchProfile " << branchProfile << "\n";
+    for( const auto& column : columns ){
+        metadataFile << "column " << column.name << " " << column.typeCode << " " << column.valueSize << " ";
+        metadataFile << ( column.isArray() ? column.sizeName : "-" ) << " " << column.valuesPerObject << "\n";
+    }
+    if( !metadataFile ){
+        throw std::runtime_error( "ERROR in ColumnarCacheMetadata::write: could not write '" + metadataPath( directory ) + "'." );
+    }
+}
+
+
+ColumnarCacheMetadata ColumnarCacheMetadata::read( const std::string& directory ){
+    std::ifstream metadataFile( metadataPath( directory ) );
+    if( !metadataFile ){
+        throw std::invalid_argument( "ERROR in ColumnarCacheMetadata::read: '" + directory + "' does not contain a columnar cache." );
+    }
+    ColumnarCacheMetadata metadata;
+    std::string line;
+    while( std::getline( metadataFile, line ) ){
+        if( line.empty() || line[0] == '#' ) continue;
+        std::istringstream lineStream( line );
+        std::string key;
+        lineStream >> key;
+        if( key == "format" ){
+            unsigned format;
+            lineStream >> format;
+            if( format != 1 ){
+                throw std::invalid_argument( "ERROR in ColumnarCacheMetadata::read: unknown format " + std::to_string( format ) + " of cache in '" + directory + "'." );
+            }
+        } else if( key == "source" || key == "branchProfile" ){
+            std::string value;
+            std::getline( lineStream >> std::ws, value );
+
+            //an empty value sets the fail bit without being an error
+            lineStream.clear();
+            ( key == "source" ? metadata.source : metadata.branchProfile ) = value;
+        } else if( key == "sourceSize" ){
+            lineStream >> metadata.sourceSize;
+        } else if( key == "sourceModificationTime" ){
+            lineStream >> metadata.sourceModificationTime;
+        } else if( key == "entries" ){
+            lineStream >> metadata.numberOfEntries;
+        } else if( key == "isData" ){
+            lineStream >> metadata.isData;
+        } else if( key == "is2016" ){
+            lineStream >> metadata.is2016;
+        } else if( key == "is2016PreVFP" ){
+            lineStream >> metadata.is2016PreVFP;
+        } else if( key == "is2016PostVFP" ){
+            lineStream >> metadata.is2016PostVFP;
+        } else if( key == "is2017" ){
+            lineStream >> metadata.is2017;
+        } else if( key == "is2018" ){
+            lineStream >> metadata.is2018;
+        } else if( key == "sumOfSimulatedEventWeights" ){
+            lineStream >> metadata.sumOfSimulatedEventWeights;
+        } else if( key == "column" ){
+            ColumnInfo column;
+            lineStream >> column.name >> column.typeCode >> column.valueSize >> column.sizeName >> column.valuesPerObject;
+            if( column.sizeName == "-" ) column.sizeName = "";
+            metadata.columns.push_back( column );
+        } else {
+            throw std::invalid_argument( "ERROR in ColumnarCacheMetadata::read: unknown key '" + key + "' in metadata of cache in '" + directory + "'." );
+        }
+        if( lineStream.fail() ){
+            throw std::invalid_argument( "ERROR in ColumnarCacheMetadata::read: could not read line '" + line + "' in metadata of cache in '" + directory + "'." );
+        }
+    }
+    return metadata;
+}
+
+
+void ColumnarCacheMetadata::setSourceStatus( const std::string& sourcePath ){
+    struct stat fileStatus;
+    if( stat( sourcePath.c_str(), &fileStatus ) != 0 ){
+        throw std::runtime_error( "ERROR in ColumnarCacheMetadata::setSourceStatus: can not access source file '" + sourcePath + "'." );
+    }
+    sourceSize = static_cast< long long >( fileStatus.st_size );
+    sourceModificationTime = static_cast< long long >( fileStatus.st_mtime );
+}
+
+
+//caches written without the status of their source, or of which the source can no longer be accessed, are considered to be stale
+bool ColumnarCacheMetadata::sourceChanged( const std::string& sourcePath ) const{
+    struct stat fileStatus;
+    if( stat( sourcePath.c_str(), &fileStatus ) != 0 ) return true;
+    return ( sourceSize != static_cast< long long >( fileStatus.st_size ) 
+        || sourceModificationTime != static_cast< long long >( fileStatus.st_mtime ) );
+}
+
+
+ColumnarCacheWriter::ColumnarCacheWriter( const std::string& directory, const ColumnarCacheMetadata& metadata ) :
+    _directory( directory ),
+    _metadata( metadata ),
+    _valueBuffers( metadata.columns.size() ),
+    _sizeColumnIndices( metadata.columns.size(), metadata.columns.size() )
+{
+    _metadata.numberOfEntries = 0;
+    std::map< std::string, size_type > indices;
+    for( size_type c = 0; c < _metadata.columns.size(); ++c ){
+        indices[ _metadata.columns[ c ].name ] = c;
+    }
+    for( size_type c = 0; c < _metadata.columns.size(); ++c ){
+        const ColumnInfo& column = _metadata.columns[ c ];
+        if( !column.isArray() ) continue;
+        auto sizeIt = indices.find( column.sizeName );
+        if( sizeIt == indices.cend() || _metadata.columns[ sizeIt->second ].isArray() ){
+            throw std::invalid_argument( "ERROR in ColumnarCacheWriter::ColumnarCacheWriter: size '" + column.sizeName + "' of array column '"
+                + column.name + "' is not a scalar column of the cache." );
+        }
+        _sizeColumnIndices[ c ] = sizeIt->second;
+        _offsetBuffers[ column.sizeName ] = { 0 };
+        _numberOfObjects[ column.sizeName ] = 0;
+    }
+    systemTools::makeDirectory( _directory );
+}
+
+
+void ColumnarCacheWriter::fill( const std::vector< const void* >& addresses ){
+    if( addresses.size() != _metadata.columns.size() ){
+        throw std::invalid_argument( "ERROR in ColumnarCacheWriter::fill: " + std::to_string( addresses.size() ) + " addresses are given for "
+            + std::to_string( _metadata.columns.size() ) + " columns." );
+    }
+    for( size_type c = 0; c < _metadata.columns.size(); ++c ){
+        const ColumnInfo& column = _metadata.columns[ c ];
+        std::size_t numberOfValues = column.valuesPerObject;
+        if( column.isArray() ){
+            const size_type sizeIndex = _sizeColumnIndices[ c ];
+            numberOfValues *= sizeValue( addresses[ sizeIndex ], _metadata.columns[ sizeIndex ] );
+        }
+        const char* begin = static_cast< const char* >( addresses[ c ] );
+        const std::size_t numberOfBytes = numberOfValues*column.valueSize;
+        _valueBuffers[ c ].insert( _valueBuffers[ c ].end(), begin, begin + numberOfBytes );
+        _bufferedBytes += numberOfBytes;
+    }
+
+    //offsets of the objects in the arrays of each size
+    for( size_type c = 0; c < _metadata.columns.size(); ++c ){
+        auto offsetIt = _offsetBuffers.find( _metadata.columns[ c ].name );
+        if( offsetIt == _offsetBuffers.end() ) continue;
+        std::uint64_t& numberOfObjects = _numberOfObjects[ offsetIt->first ];
+        numberOfObjects += sizeValue( addresses[ c ], _metadata.columns[ c ] );
+        offsetIt->second.push_back( numberOfObjects );
+        _bufferedBytes += sizeof( std::uint64_t );
+    }
+    ++_metadata.numberOfEntries;
+
+    static const std::size_t maximumBufferedBytes = 64*1024*1024;
+    if( _bufferedBytes > maximumBufferedBytes ) flush();
+}
+
+
+void ColumnarCacheWriter::flush(){
+    const std::ios::openmode mode = std::ios::binary | ( _filesCreated ? std::ios::app : std::ios::trunc );
+    auto writeBuffer = [&]( const std::string& path, const char* data, const std::size_t numberOfBytes ){
+        std::ofstream file( path, mode );
+        file.write( data, numberOfBytes );
+        if( !file ){
+            throw std::runtime_error( "ERROR in ColumnarCacheWriter::flush: could not write '" + path + "'." );
+        }
+        _numberOfBytesWritten += numberOfBytes;
+    };
+    for( size_type c = 0; c < _metadata.columns.size(); ++c ){
+        writeBuffer( valuesPath( _directory, _metadata.columns[ c ].name ), _valueBuffers[ c ].data(), _valueBuffers[ c ].size() );
+        _valueBuffers[ c ].clear();
+    }
+    for( auto& offsets : _offsetBuffers ){
+        writeBuffer( offsetsPath( _directory, offsets.first ), reinterpret_cast< const char* >( offsets.second.data() ),
+            offsets.second.size()*sizeof( std::uint64_t ) );
+        offsets.second.clear();
+    }
+    _filesCreated = true;
+    _bufferedBytes = 0;
+}
+
+
+void ColumnarCacheWriter::close(){
+    if( _closed ) return;
+    flush();
+
+    //the metadata is written last, so a cache of which the writing was interrupted is not used
+    _metadata.write( _directory );
+    _closed = true;
+}
+
+
+ColumnarCache::MappedFile ColumnarCache::mapFile( const std::string& path ){
+    MappedFile mappedFile;
+    int fileDescriptor = open( path.c_str(), O_RDONLY );
+    if( fileDescriptor < 0 ){
+        throw std::runtime_error( "ERROR in ColumnarCache::mapFile: could not open '" + path + "'." );
+    }
+    struct stat fileStatus;
+    if( fstat( fileDescriptor, &fileStatus ) != 0 ){
+        ::close( fileDescriptor );
+        throw std::runtime_error( "ERROR in ColumnarCache::mapFile: could not determine the size of '" + path + "'." );
+    }
+    mappedFile.size = static_cast< std::size_t >( fileStatus.st_size );
+
+    //empty files can not be mapped, and are never read
+    if( mappedFile.size != 0 ){
+        void* data = mmap( nullptr, mappedFile.size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+        if( data == MAP_FAILED ){
+            ::close( fileDescriptor );
+            throw std::runtime_error( "ERROR in ColumnarCache::mapFile: could not map '" + path + "'." );
+        }
+        mappedFile.data = data;
+    }
+    ::close( fileDescriptor );
+    return mappedFile;
+}
+
+
+void ColumnarCache::unmapFile( MappedFile& mappedFile ){
+    if( mappedFile.data ) munmap( const_cast< void* >( mappedFile.data ), mappedFile.size );
+    mappedFile.data = nullptr;
+    mappedFile.size = 0;
+}
+
+
+ColumnarCache::ColumnarCache( const std::string& directory ) :
+    _directory( directory ),
+    _metadata( ColumnarCacheMetadata::read( directory ) )
+{
+    const long unsigned numberOfEntries = _metadata.numberOfEntries;
+    try{
+        for( size_type c = 0; c < _metadata.columns.size(); ++c ){
+            const ColumnInfo& column = _metadata.columns[ c ];
+            _columnIndices[ column.name ] = c;
+            if( column.isArray() && _offsetFiles.find( column.sizeName ) == _offsetFiles.cend() ){
+                MappedFile offsetFile = mapFile( offsetsPath( _directory, column.sizeName ) );
+                _offsetFiles[ column.sizeName ] = offsetFile;
+                if( offsetFile.size != ( numberOfEntries + 1 )*sizeof( std::uint64_t ) ){
+                    throw std::runtime_error( "ERROR in ColumnarCache::ColumnarCache: offsets of '" + column.sizeName + "' in cache '"
+                        + _directory + "' do not match the number of entries." );
+                }
+            }
+            _offsets.push_back( column.isArray() ? static_cast< const std::uint64_t* >( _offsetFiles[ column.sizeName ].data ) : nullptr );
+            _values.push_back( mapFile( valuesPath( _directory, column.name ) ) );
+
+            std::uint64_t numberOfValues = ( column.isArray() ? _offsets.back()[ numberOfEntries ] : numberOfEntries );
+            if( _values.back().size != numberOfValues*column.valuesPerObject*column.valueSize ){
+                throw std::runtime_error( "ERROR in ColumnarCache::ColumnarCache: size of column '" + column.name + "' in cache '"
+                    + _directory + "' does not match its metadata." );
+            }
+        }
+    } catch( ... ){
+        for( auto& mappedFile : _values ) unmapFile( mappedFile );
+        for( auto& offsetFile : _offsetFiles ) unmapFile( offsetFile.second );
+        throw;
+    }
+}
+
+
+ColumnarCache::~ColumnarCache(){
+    for( auto& mappedFile : _values ) unmapFile( mappedFile );
+    for( auto& offsetFile : _offsetFiles ) unmapFile( offsetFile.second );
+}
+
+
+bool ColumnarCache::exists( const std::string& directory ){
+    return systemTools::fileExists( metadataPath( directory ) );
+}
+
+
+std::vector< std::string > ColumnarCache::columnNames() const{
+    std::vector< std::string > names;
+    for( const auto& column : _metadata.columns ){
+        names.push_back( column.name );
+    }
+    return names;
+}
+
+
+ColumnarCache::size_type ColumnarCache::columnIndex( const std::string& name ) const{
+    auto indexIt = _columnIndices.find( name );
+    if( indexIt == _columnIndices.cend() ){
+        throw std::out_of_range( "ERROR in ColumnarCache::columnIndex: cache '" + _directory + "' has no column '" + name + "'." );
+    }
+    return indexIt->second;
+}
+
+
+std::size_t ColumnarCache::copyEntry( const size_type columnIndex, const long unsigned entry, void* address, const std::size_t maximumNumberOfValues ) const{
+    const ColumnInfo& column = _metadata.columns[ columnIndex ];
+    std::uint64_t first = entry;
+    std::uint64_t numberOfValues = column.valuesPerObject;
+    if( column.isArray() ){
+        const std::uint64_t* offsets = _offsets[ columnIndex ];
+        first = offsets[ entry ];
+        numberOfValues *= ( offsets[ entry + 1 ] - first );
+    }
+    if( numberOfValues > maximumNumberOfValues ){
+        throw std::out_of_range( "ERROR in ColumnarCache::copyEntry: entry " + std::to_string( entry ) + " of column '" + column.name + "' in cache '"
+            + _directory + "' holds " + std::to_string( numberOfValues ) + " values, while its variable can only hold " 
+            + std::to_string( maximumNumberOfValues ) + "." );
+    }
+    const char* begin = static_cast< const char* >( _values[ columnIndex ].data ) + first*column.valuesPerObject*column.valueSize;
+    if( numberOfValues != 0 ) std::memcpy( address, begin, numberOfValues*column.valueSize );
+    return numberOfValues;
+}
+
+
+std::size_t ColumnarCache::mappedBytes() const{
+    std::size_t numberOfBytes = 0;
+    for( const auto& mappedFile : _values ) numberOfBytes += mappedFile.size;
+    for( const auto& offsetFile : _offsetFiles ) numberOfBytes += offsetFile.second.size;
+    return numberOfBytes;
+}
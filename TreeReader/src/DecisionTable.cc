@@ -0,0 +1,76 @@
+#include "../interface/DecisionTable.h"
+
+//include c++ library classes
+#include <stdexcept>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+DecisionTable::DecisionTable( const std::map< std::string, bool >& decisionMap ){
+    _names.reserve( decisionMap.size() );
+    for( const auto& decision : decisionMap ){
+        std::string name( decision.first );
+
+        //remove leading _ from trigger and filter names
+        if( stringTools::stringStartsWith( name, "_" ) ){
+            name.erase( 0, 1 );
+        }
+        _indices[ name ] = _names.size();
+        _names.push_back( name );
+    }
+}
+
+
+DecisionTable::size_type DecisionTable::index( const std::string& name ) const{
+    auto indexIt = _indices.find( name );
+    if( indexIt == _indices.cend() ) return size();
+    return indexIt->second;
+}
+
+
+DecisionTable::Bits DecisionTable::mask( const std::vector< std::string >& names ) const{
+    Bits ret( numberOfWords(), 0 );
+    for( const auto& name : names ){
+        size_type decisionIndex = index( name );
+        if( decisionIndex == size() ){
+            throw std::invalid_argument( "Requested trigger or MET filter '" + name + "' does not exist." );
+        }
+        ret[ decisionIndex / wordSize ] |= ( Word( 1 ) << ( decisionIndex % wordSize ) );
+    }
+    return ret;
+}
+
+
+void DecisionTable::fillBits( const std::map< std::string, bool >& decisionMap, Bits& bits ) const{
+    bits.assign( numberOfWords(), 0 );
+    size_type decisionIndex = 0;
+    for( const auto& decision : decisionMap ){
+        if( decision.second ){
+            bits[ decisionIndex / wordSize ] |= ( Word( 1 ) << ( decisionIndex % wordSize ) );
+        }
+        ++decisionIndex;
+    }
+}
+
+
+bool DecisionTable::passAny( const Bits& bits, const Bits& mask ){
+    for( Bits::size_type i = 0; i < mask.size(); ++i ){
+        if( bits[ i ] & mask[ i ] ) return true;
+    }
+    return false;
+}
+
+
+const DecisionTable::Bits& DecisionSelection::mask( const std::shared_ptr< const DecisionTable >& tablePtr ) const{
+
+    //no table means the individual decisions were not read
+    if( !tablePtr ){
+        throw std::invalid_argument( "Requested trigger or MET filter '" + ( _names.empty() ? std::string() : _names.front() ) + "' does not exist." );
+    }
+    if( tablePtr != _tablePtr ){
+        _mask = tablePtr->mask( _names );
+        _tablePtr = tablePtr;
+    }
+    return _mask;
+}
@@ -0,0 +1,85 @@
+#include "../interface/JECVariationTable.h"
+
+//include c++ library classes
+#include <algorithm>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+JECVariationTable::JECVariationTable( const std::vector< std::string >& sourceNames, const std::vector< std::string >& groupedNames ) :
+    _names( sourceNames ),
+    _numberOfSources( sourceNames.size() )
+{
+    _names.insert( _names.end(), groupedNames.cbegin(), groupedNames.cend() );
+    for( size_type i = 0; i < _names.size(); ++i ){
+        if( isGrouped( i ) ){
+            _groupedIndices[ _names[ i ] ] = i;
+        } else {
+            _sourceIndices[ _names[ i ] ] = i;
+        }
+    }
+}
+
+
+namespace{
+
+    //name of the variation if the branch is a smeared jet pT variation of the given type, empty otherwise
+    std::string variationName( const std::string& branchName, const std::string& type ){
+        static const std::string prefix = "_jetSmearedPt_";
+        const std::string suffix = "_" + type + "Up";
+        if( !( stringTools::stringStartsWith( branchName, prefix ) && stringTools::stringEndsWith( branchName, suffix ) ) ) return "";
+        if( branchName.size() <= prefix.size() + suffix.size() ) return "";
+        return branchName.substr( prefix.size(), branchName.size() - prefix.size() - suffix.size() );
+    }
+}
+
+
+//the up and down variations of jets and MET are assumed to have the same names as the up variations of the smeared jet pT
+JECVariationTable JECVariationTable::fromBranchNames( const std::vector< std::string >& branchNames ){
+    std::vector< std::string > sourceNames;
+    std::vector< std::string > groupedNames;
+    for( const auto& branchName : branchNames ){
+        std::string sourceName = variationName( branchName, "JECSources" );
+        if( !sourceName.empty() ){
+            sourceNames.push_back( sourceName );
+            continue;
+        }
+        std::string groupedName = variationName( branchName, "JECGrouped" );
+        if( !groupedName.empty() ){
+            groupedNames.push_back( groupedName );
+        }
+    }
+
+    //variations are listed alphabetically (e.g. by JetInfo)
+    std::sort( sourceNames.begin(), sourceNames.end() );
+    std::sort( groupedNames.begin(), groupedNames.end() );
+    return JECVariationTable( sourceNames, groupedNames );
+}
+
+
+JECVariationTable::size_type JECVariationTable::sourceIndex( const std::string& name ) const{
+    auto it = _sourceIndices.find( name );
+    return ( it == _sourceIndices.cend() ) ? size() : it->second;
+}
+
+
+JECVariationTable::size_type JECVariationTable::groupedIndex( const std::string& name ) const{
+    auto it = _groupedIndices.find( name );
+    return ( it == _groupedIndices.cend() ) ? size() : it->second;
+}
+
+
+std::vector< std::string > JECVariationTable::sourceNames() const{
+    return std::vector< std::string >( _names.cbegin(), _names.cbegin() + _numberOfSources );
+}
+
+
+std::vector< std::string > JECVariationTable::groupedNames() const{
+    return std::vector< std::string >( _names.cbegin() + _numberOfSources, _names.cend() );
+}
+
+
+std::string JECVariationTable::branchName( const std::string& quantity, const size_type index, const std::string& direction ) const{
+    return quantity + "_" + _names[ index ] + ( isGrouped( index ) ? "_JECGrouped" : "_JECSources" ) + direction;
+}
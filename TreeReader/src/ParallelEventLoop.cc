@@ -0,0 +1,84 @@
+#include "../interface/ParallelEventLoop.h"
+
+//include c++ library classes
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+//include ROOT classes
+#include "TROOT.h"
+
+
+ParallelEventLoop::ParallelEventLoop( const Sample& sample, const unsigned numberOfThreads ) :
+    _samplePtr( std::make_shared< Sample >( sample ) ),
+    _numberOfThreads( resolveNumberOfThreads( numberOfThreads ) )
+{}
+
+
+ParallelEventLoop::ParallelEventLoop( const std::string& pathToFile, const unsigned numberOfThreads ) :
+    _pathToFile( pathToFile ),
+    _numberOfThreads( resolveNumberOfThreads( numberOfThreads ) )
+{}
+
+
+void ParallelEventLoop::setEventOptions( const bool readIndividualTriggers,
+        const bool readIndividualMetFilters,
+        const bool readAllJECVariations,
+        const bool readGroupedJECVariations ){
+    _readIndividualTriggers = readIndividualTriggers;
+    _readIndividualMetFilters = readIndividualMetFilters;
+    _readAllJECVariations = readAllJECVariations;
+    _readGroupedJECVariations = readGroupedJECVariations;
+}
+
+
+void ParallelEventLoop::setEntriesPerRange( const long unsigned entriesPerRange ){
+    if( entriesPerRange == 0 ){
+        throw std::invalid_argument( "ERROR in ParallelEventLoop::setEntriesPerRange: number of entries per range must be larger than 0." );
+    }
+    _entriesPerRange = entriesPerRange;
+}
+
+
+void ParallelEventLoop::initializeTreeReader( TreeReader& treeReader ) const{
+    treeReader.setBranchProfile( _branchProfile );
+    treeReader.setLazyReading( _lazyReading );
+    if( _samplePtr ){
+        treeReader.initSample( *_samplePtr );
+    } else {
+        treeReader.initSampleFromFile( _pathToFile );
+    }
+}
+
+
+long unsigned ParallelEventLoop::numberOfEntries() const{
+    TreeReader treeReader;
+    initializeTreeReader( treeReader );
+    long unsigned numberOfEntries = treeReader.numberOfEntries();
+    if( _maximumNumberOfEntries != 0 ){
+        numberOfEntries = std::min( numberOfEntries, _maximumNumberOfEntries );
+    }
+    return numberOfEntries;
+}
+
+
+std::vector< std::pair< long unsigned, long unsigned > > ParallelEventLoop::entryRanges() const{
+    long unsigned totalNumberOfEntries = numberOfEntries();
+    std::vector< std::pair< long unsigned, long unsigned > > ranges;
+    for( long unsigned first = 0; first < totalNumberOfEntries; first += _entriesPerRange ){
+        ranges.push_back( { first, std::min( first + _entriesPerRange, totalNumberOfEntries ) } );
+    }
+    return ranges;
+}
+
+
+unsigned ParallelEventLoop::resolveNumberOfThreads( const unsigned numberOfThreads ){
+    if( numberOfThreads != 0 ) return numberOfThreads;
+    return std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+
+void ParallelEventLoop::enableThreadSafety(){
+    static std::once_flag threadSafetyFlag;
+    std::call_once( threadSafetyFlag, [](){ ROOT::EnableThreadSafety(); } );
+}
@@ -0,0 +1,127 @@
+#include "../interface/PreSelection.h"
+
+
+PreSelection::PreSelection( const Condition& condition ) :
+    _conditions( { condition } )
+{}
+
+
+PreSelection& PreSelection::operator&=( const PreSelection& rhs ){
+    _conditions.insert( _conditions.end(), rhs._conditions.cbegin(), rhs._conditions.cend() );
+    return *this;
+}
+
+
+PreSelection operator&( PreSelection lhs, const PreSelection& rhs ){
+    return lhs &= rhs;
+}
+
+
+void PreSelection::apply( const EventBatch& batch, Mask& mask ) const{
+    mask.assign( batch.size(), 1 );
+    for( const auto& condition : _conditions ){
+        condition( batch, mask );
+    }
+}
+
+
+namespace{
+
+    //number of values in each row above the threshold, without a threshold this only needs the offsets
+    template< typename T > void requireCount( const JaggedColumn< T >& column, const unsigned number, const double minimumPt, 
+            PreSelection::Mask& mask ){
+        const std::vector< unsigned >& offsets = column.offsets();
+        if( minimumPt <= 0. ){
+            for( PreSelection::Mask::size_type row = 0; row < mask.size(); ++row ){
+                mask[ row ] &= ( offsets[ row + 1 ] - offsets[ row ] >= number );
+            }
+            return;
+        }
+        const std::vector< T >& values = column.values();
+        for( PreSelection::Mask::size_type row = 0; row < mask.size(); ++row ){
+            unsigned count = 0;
+            for( unsigned i = offsets[ row ]; i < offsets[ row + 1 ]; ++i ){
+                count += ( values[ i ] > minimumPt );
+            }
+            mask[ row ] &= ( count >= number );
+        }
+    }
+
+
+    //number of leptons of the accepted flavors above the threshold
+    PreSelection::Condition leptonCountCondition( const unsigned number, const double minimumPt, const unsigned maximumFlavor, 
+            const unsigned minimumFlavor = 0 ){
+        return [=]( const EventBatch& batch, PreSelection::Mask& mask ){
+            const std::vector< unsigned >& offsets = batch.leptonPt().offsets();
+            const std::vector< double >& pt = batch.leptonPt().values();
+            const std::vector< unsigned >& flavor = batch.leptonFlavor().values();
+            for( PreSelection::Mask::size_type row = 0; row < mask.size(); ++row ){
+                unsigned count = 0;
+                for( unsigned i = offsets[ row ]; i < offsets[ row + 1 ]; ++i ){
+                    count += ( flavor[ i ] >= minimumFlavor && flavor[ i ] <= maximumFlavor && pt[ i ] > minimumPt );
+                }
+                mask[ row ] &= ( count >= number );
+            }
+        };
+    }
+}
+
+
+PreSelection PreSelection::minimumNumberOfLeptons( const unsigned number, const double minimumPt ){
+    return PreSelection( [=]( const EventBatch& batch, Mask& mask ){ requireCount( batch.leptonPt(), number, minimumPt, mask ); } );
+}
+
+
+//flavors in the ntuples are 0 for electrons, 1 for muons and 2 for taus
+PreSelection PreSelection::minimumNumberOfLightLeptons( const unsigned number, const double minimumPt ){
+    return PreSelection( leptonCountCondition( number, minimumPt, 1 ) );
+}
+
+
+PreSelection PreSelection::minimumNumberOfElectrons( const unsigned number, const double minimumPt ){
+    return PreSelection( leptonCountCondition( number, minimumPt, 0 ) );
+}
+
+
+PreSelection PreSelection::minimumNumberOfMuons( const unsigned number, const double minimumPt ){
+    return PreSelection( leptonCountCondition( number, minimumPt, 1, 1 ) );
+}
+
+
+PreSelection PreSelection::minimumNumberOfJets( const unsigned number, const double minimumPt ){
+    return PreSelection( [=]( const EventBatch& batch, Mask& mask ){ requireCount( batch.jetPt(), number, minimumPt, mask ); } );
+}
+
+
+PreSelection PreSelection::passAnyTriggerBit( const std::uint16_t bits ){
+    return PreSelection( [=]( const EventBatch& batch, Mask& mask ){
+        const std::vector< std::uint16_t >& triggerBits = batch.triggerBits();
+        for( Mask::size_type row = 0; row < mask.size(); ++row ){
+            mask[ row ] &= ( ( triggerBits[ row ] & bits ) != 0 );
+        }
+    } );
+}
+
+
+double PreSelectionResult::rejectionFraction() const{
+    if( _numberOfProcessedEntries == 0 ) return 0.;
+    return 1. - static_cast< double >( _entries.size() ) / _numberOfProcessedEntries;
+}
+
+
+double PreSelectionResult::timeSaved( const double buildTimePerEvent ) const{
+    return ( _numberOfProcessedEntries - _entries.size() )*buildTimePerEvent - _preSelectionTime;
+}
+
+
+void PreSelectionResult::print( std::ostream& os ) const{
+    os << "pre-selection : " << _entries.size() << " of " << _numberOfProcessedEntries << " entries pass";
+    os << " (rejection fraction " << rejectionFraction() << ")";
+    os << ", pre-selection time " << _preSelectionTime << " s" << std::endl;
+}
+
+
+void PreSelectionResult::print( std::ostream& os, const double buildTimePerEvent ) const{
+    print( os );
+    os << "pre-selection : estimated time saved by not building rejected events " << timeSaved( buildTimePerEvent ) << " s" << std::endl;
+}
@@ -0,0 +1,101 @@
+#include "../interface/ReadCacheSettings.h"
+
+//include c++ library classes
+#include <stdexcept>
+#include <algorithm>
+
+//include ROOT classes
+#include "TEnv.h"
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+ReadCacheSettings::ReadCacheSettings( const double cacheSizeInMB, const bool asyncPrefetching, const unsigned learnEntries ) :
+    _cacheSize( static_cast< long long >( cacheSizeInMB*1e6 ) ),
+    _learnEntries( learnEntries ),
+    _asyncPrefetching( asyncPrefetching )
+{
+    if( cacheSizeInMB < 0 ){
+        throw std::invalid_argument( "ERROR in ReadCacheSettings::ReadCacheSettings: cache size can not be negative." );
+    }
+    if( learnEntries == 0 ){
+        throw std::invalid_argument( "ERROR in ReadCacheSettings::ReadCacheSettings: number of learning entries must be larger than 0." );
+    }
+}
+
+
+namespace{
+
+    //value of an option of the form --name=value, empty if the argument is not this option
+    std::string optionValue( const std::string& argument, const std::string& optionName ){
+        const std::string prefix = "--" + optionName + "=";
+        if( !stringTools::stringStartsWith( argument, prefix ) ) return "";
+        std::string value = argument.substr( prefix.size() );
+        if( value.empty() ){
+            throw std::invalid_argument( "ERROR in ReadCacheSettings::fromCommandLine: no value given for option '" + argument + "'." );
+        }
+        return value;
+    }
+}
+
+
+ReadCacheSettings ReadCacheSettings::fromCommandLine( std::vector< std::string >& arguments ){
+    double cacheSizeInMB = -1;
+    unsigned learnEntries = 100;
+    bool asyncPrefetching = false;
+    std::string columnarCacheDirectory;
+    std::vector< std::string > remainingArguments;
+    for( const auto& argument : arguments ){
+        std::string value;
+        if( !( value = optionValue( argument, "cacheSize" ) ).empty() ){
+            cacheSizeInMB = std::stod( value );
+            if( cacheSizeInMB < 0 ){
+                throw std::invalid_argument( "ERROR in ReadCacheSettings::fromCommandLine: cache size can not be negative." );
+            }
+        } else if( !( value = optionValue( argument, "cacheLearnEntries" ) ).empty() ){
+            learnEntries = static_cast< unsigned >( std::stoul( value ) );
+        } else if( argument == "--prefetch" ){
+            asyncPrefetching = true;
+        } else if( !( value = optionValue( argument, "columnarCache" ) ).empty() ){
+            columnarCacheDirectory = value;
+        } else {
+            remainingArguments.push_back( argument );
+        }
+    }
+    arguments = remainingArguments;
+
+    //without a given cache size only the other settings are applied
+    ReadCacheSettings settings( std::max( cacheSizeInMB, 0. ), asyncPrefetching, learnEntries );
+    if( cacheSizeInMB < 0 ) settings._cacheSize = -1;
+    settings._columnarCacheDirectory = columnarCacheDirectory;
+    return settings;
+}
+
+
+std::string ReadCacheSettings::commandLineOptions() const{
+    std::string options;
+    if( setsCacheSize() ){
+        options += " --cacheSize=" + std::to_string( _cacheSize/1e6 );
+        options += " --cacheLearnEntries=" + std::to_string( _learnEntries );
+    }
+    if( _asyncPrefetching ) options += " --prefetch";
+    if( !_columnarCacheDirectory.empty() ) options += " --columnarCache=" + _columnarCacheDirectory;
+    return options;
+}
+
+
+//ROOT reads this setting when a file is opened
+void ReadCacheSettings::enableAsyncPrefetching() const{
+    if( _asyncPrefetching ) gEnv->SetValue( "TFile.AsyncPrefetching", 1 );
+}
+
+
+std::string ReadCacheSettings::commandLineUsage(){
+    std::string usage = "optional read cache settings:\n";
+    usage += "  --cacheSize=<MB>  size of the TTreeCache (0 switches the cache off)\n";
+    usage += "  --cacheLearnEntries=<n>  entries used to learn the branches to cache when reading lazily\n";
+    usage += "  --prefetch  asynchronous prefetching of the next entries\n";
+    usage += "  --columnarCache=<directory>  read samples from their columnar cache in this directory when it exists";
+    return usage;
+}
@@ -0,0 +1,137 @@
+#include "../interface/SampleListScheduler.h"
+
+//include c++ library classes
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace{
+
+    //cost of building and processing an event, in units of compressed bytes read
+    constexpr double eventProcessingCost = 1000.;
+}
+
+
+SampleListScheduler::SampleListScheduler( const std::vector< Sample >& samples, const unsigned numberOfThreads ) :
+    _samples( samples ),
+    _numberOfThreads( ParallelEventLoop::resolveNumberOfThreads( numberOfThreads ) )
+{}
+
+
+SampleListScheduler::SampleListScheduler( const std::string& sampleListFile, const std::string& sampleDirectory,
+        const unsigned numberOfThreads ) :
+    SampleListScheduler( readSampleList( sampleListFile, sampleDirectory ), numberOfThreads )
+{}
+
+
+void SampleListScheduler::setEventOptions( const bool readIndividualTriggers,
+        const bool readIndividualMetFilters,
+        const bool readAllJECVariations,
+        const bool readGroupedJECVariations ){
+    _readIndividualTriggers = readIndividualTriggers;
+    _readIndividualMetFilters = readIndividualMetFilters;
+    _readAllJECVariations = readAllJECVariations;
+    _readGroupedJECVariations = readGroupedJECVariations;
+}
+
+
+void SampleListScheduler::setTaskSize( const long long compressedBytesPerTask, const long unsigned maximumEntriesPerTask ){
+    if( compressedBytesPerTask <= 0 || maximumEntriesPerTask == 0 ){
+        throw std::invalid_argument( "ERROR in SampleListScheduler::setTaskSize: task sizes must be larger than 0." );
+    }
+    _compressedBytesPerTask = compressedBytesPerTask;
+    _maximumEntriesPerTask = maximumEntriesPerTask;
+}
+
+
+void SampleListScheduler::initializeTreeReader( TreeReader& treeReader, const Sample& sample ) const{
+    treeReader.setBranchProfile( _branchProfile );
+    treeReader.setLazyReading( _lazyReading );
+    treeReader.initSample( sample );
+}
+
+
+std::vector< SampleListScheduler::Task > SampleListScheduler::makeTasks() const{
+    std::vector< Task > tasks;
+    for( std::vector< Sample >::size_type sampleIndex = 0; sampleIndex < _samples.size(); ++sampleIndex ){
+        TreeReader treeReader;
+        initializeTreeReader( treeReader, _samples[ sampleIndex ] );
+        long unsigned totalEntries = treeReader.numberOfEntries();
+        if( totalEntries == 0 ) continue;
+        double bytesPerEntry = static_cast< double >( treeReader.compressedTreeSize() ) / totalEntries;
+        if( _maximumNumberOfEntries != 0 ){
+            totalEntries = std::min( totalEntries, _maximumNumberOfEntries );
+        }
+
+        //tasks have a similar compressed size, but are limited in number of entries for samples with small events
+        long unsigned entriesPerTask = _maximumEntriesPerTask;
+        if( bytesPerEntry > 0 ){
+            entriesPerTask = std::min( entriesPerTask,
+                static_cast< long unsigned >( std::max( 1., _compressedBytesPerTask / bytesPerEntry ) ) );
+        }
+        for( long unsigned first = 0; first < totalEntries; first += entriesPerTask ){
+            long unsigned last = std::min( first + entriesPerTask, totalEntries );
+            double cost = ( last - first )*( bytesPerEntry + eventProcessingCost );
+            tasks.push_back( { sampleIndex, first, last, cost } );
+        }
+    }
+    return tasks;
+}
+
+
+SampleListScheduler::TaskQueues::TaskQueues( const std::vector< Task >& tasks, const unsigned numberOfQueues ) :
+    _queues( numberOfQueues )
+{
+    for( unsigned i = 0; i < numberOfQueues; ++i ){
+        _mutexes.push_back( std::unique_ptr< std::mutex >( new std::mutex ) );
+    }
+
+    //give each queue a contiguous block of tasks with a similar total cost
+    //so that threads mostly stay on the same sample and do not have to reopen files
+    double totalCost = 0.;
+    for( const auto& task : tasks ){
+        totalCost += task.cost;
+    }
+    double costPerQueue = totalCost / numberOfQueues;
+    double accumulatedCost = 0.;
+    for( const auto& task : tasks ){
+        unsigned queueIndex = std::min( numberOfQueues - 1,
+            static_cast< unsigned >( ( accumulatedCost + 0.5*task.cost ) / costPerQueue ) );
+        _queues[ queueIndex ].push_back( task );
+        accumulatedCost += task.cost;
+    }
+}
+
+
+bool SampleListScheduler::TaskQueues::nextTask( const unsigned queueIndex, Task& task ){
+
+    //own queue first
+    {
+        std::lock_guard< std::mutex > lock( *_mutexes[ queueIndex ] );
+        if( !_queues[ queueIndex ].empty() ){
+            task = _queues[ queueIndex ].front();
+            _queues[ queueIndex ].pop_front();
+            return true;
+        }
+    }
+
+    //steal from the back of the other queues
+    for( unsigned offset = 1; offset < _queues.size(); ++offset ){
+        unsigned otherIndex = ( queueIndex + offset ) % _queues.size();
+        std::lock_guard< std::mutex > lock( *_mutexes[ otherIndex ] );
+        if( !_queues[ otherIndex ].empty() ){
+            task = _queues[ otherIndex ].back();
+            _queues[ otherIndex ].pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void SampleListScheduler::TaskQueues::clear(){
+    for( std::vector< std::deque< Task > >::size_type i = 0; i < _queues.size(); ++i ){
+        std::lock_guard< std::mutex > lock( *_mutexes[ i ] );
+        _queues[ i ].clear();
+    }
+}
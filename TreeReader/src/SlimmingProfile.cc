@@ -0,0 +1,138 @@
+#include "../interface/SlimmingProfile.h"
+
+//include c++ library classes
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+//include other parts of framework
+#include "../../Tools/interface/stringTools.h"
+
+
+SlimmingProfile::SlimmingProfile( const std::string& name, const std::vector< std::string >& keepPatterns,
+        const std::vector< std::string >& dropPatterns, const std::vector< std::string >& narrowPatterns ) :
+    _name( name ),
+    _keepAll( false ),
+    _keepPatterns( keepPatterns ),
+    _dropPatterns( dropPatterns ),
+    _narrowPatterns( narrowPatterns )
+{}
+
+
+bool SlimmingProfile::matches( const std::string& pattern, const std::string& branchName ){
+
+    //greedy matching with backtracking to the last '*'
+    std::string::size_type p = 0, n = 0;
+    std::string::size_type starPosition = std::string::npos, starMatch = 0;
+    while( n < branchName.size() ){
+        if( p < pattern.size() && pattern[ p ] == '*' ){
+            starPosition = p++;
+            starMatch = n;
+        } else if( p < pattern.size() && pattern[ p ] == branchName[ n ] ){
+            ++p;
+            ++n;
+        } else if( starPosition != std::string::npos ){
+            p = starPosition + 1;
+            n = ++starMatch;
+        } else {
+            return false;
+        }
+    }
+    while( p < pattern.size() && pattern[ p ] == '*' ) ++p;
+    return ( p == pattern.size() );
+}
+
+
+bool SlimmingProfile::matchesAny( const std::vector< std::string >& patterns, const std::string& branchName ){
+    for( const auto& pattern : patterns ){
+        if( matches( pattern, branchName ) ) return true;
+    }
+    return false;
+}
+
+
+bool SlimmingProfile::keeps( const std::string& branchName ) const{
+    if( _keepAll ) return true;
+    return ( matchesAny( _keepPatterns, branchName ) && !matchesAny( _dropPatterns, branchName ) );
+}
+
+
+bool SlimmingProfile::narrows( const std::string& branchName ) const{
+    return matchesAny( _narrowPatterns, branchName );
+}
+
+
+namespace{
+
+    //line without comments and surrounding whitespace
+    std::string cleanLine( const std::string& line ){
+        std::string content = line.substr( 0, line.find( '#' ) );
+        auto begin = content.find_first_not_of( " \t\r" );
+        if( begin == std::string::npos ) return "";
+        return content.substr( begin, content.find_last_not_of( " \t\r" ) - begin + 1 );
+    }
+
+
+    //name of the profile if the line is a profile header, empty otherwise
+    std::string profileHeader( const std::string& line ){
+        if( stringTools::stringStartsWith( line, "[" ) && stringTools::stringEndsWith( line, "]" ) ){
+            return line.substr( 1, line.size() - 2 );
+        }
+        return "";
+    }
+}
+
+
+std::vector< std::string > SlimmingProfile::profilesInFile( const std::string& configPath ){
+    std::ifstream configStream( configPath );
+    if( !configStream.is_open() ){
+        throw std::invalid_argument( "ERROR in SlimmingProfile::profilesInFile: can not open file '" + configPath + "'." );
+    }
+    std::vector< std::string > profileNames;
+    std::string line;
+    while( std::getline( configStream, line ) ){
+        std::string name = profileHeader( cleanLine( line ) );
+        if( !name.empty() ) profileNames.push_back( name );
+    }
+    return profileNames;
+}
+
+
+SlimmingProfile SlimmingProfile::fromFile( const std::string& configPath, const std::string& profileName ){
+    std::ifstream configStream( configPath );
+    if( !configStream.is_open() ){
+        throw std::invalid_argument( "ERROR in SlimmingProfile::fromFile: can not open file '" + configPath + "'." );
+    }
+    std::vector< std::string > keepPatterns, dropPatterns, narrowPatterns;
+    bool found = false;
+    bool inProfile = false;
+    std::string line;
+    while( std::getline( configStream, line ) ){
+        line = cleanLine( line );
+        if( line.empty() ) continue;
+        std::string header = profileHeader( line );
+        if( !header.empty() ){
+            inProfile = ( header == profileName );
+            found = ( found || inProfile );
+            continue;
+        }
+        if( !inProfile ) continue;
+
+        std::istringstream lineStream( line );
+        std::string keyword;
+        lineStream >> keyword;
+        std::vector< std::string >* patterns = nullptr;
+        if( keyword == "keep" ) patterns = &keepPatterns;
+        else if( keyword == "drop" ) patterns = &dropPatterns;
+        else if( keyword == "narrow" ) patterns = &narrowPatterns;
+        else {
+            throw std::invalid_argument( "ERROR in SlimmingProfile::fromFile: unknown keyword '" + keyword + "' in profile '" + profileName + "' of file '" + configPath + "'." );
+        }
+        std::string pattern;
+        while( lineStream >> pattern ) patterns->push_back( pattern );
+    }
+    if( !found ){
+        throw std::invalid_argument( "ERROR in SlimmingProfile::fromFile: no profile '" + profileName + "' in file '" + configPath + "'." );
+    }
+    return SlimmingProfile( profileName, keepPatterns, dropPatterns, narrowPatterns );
+}
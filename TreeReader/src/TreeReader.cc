@@ -4,6 +4,17 @@
 #include <fstream>
 #include <iostream>
 #include <typeinfo>
+#include <iomanip>
+#include <chrono>
+#include <set>
+
+//include ROOT classes
+#include "TTreeCache.h"
+#include "TLeaf.h"
+#include "TNamed.h"
+#include "TBasket.h"
+#include "TBuffer.h"
+#include "TMath.h"
 
 //include other parts of analysis framework
 #include "../../Tools/interface/analysisTools.h"
@@ -95,10 +106,10 @@ void TreeReader::readSamples2018( const std::string& list, const std::string& di
 // functions for initializing maps of branches rather than hard-coded names //
 
 std::pair< std::map< std::string, bool >, std::map< std::string, TBranch* > > buildBranchMap( 
-	TTree* treePtr, 
+	const std::vector< std::string >& branchNames, 
 	const std::vector< std::string> nameIdentifiers, 
 	const std::string& antiIdentifier = "" ){
-    // build a map of branches from a given tree
+    // build a map of branches from the branch names of a tree
     // all branches whose name contains nameIdentifier and not antiIdentifier will be added
     // the return type is a pair of two objects:
     // - map of branch name to boolean 
@@ -109,9 +120,7 @@ std::pair< std::map< std::string, bool >, std::map< std::string, TBranch* > > bu
     //   (branch pointers are set to nullptr everywhere)
     std::map< std::string, bool > decisionMap;
     std::map< std::string, TBranch* > branchMap;
-    TObjArray* branch_list = treePtr->GetListOfBranches();
-    for( const auto& branchPtr : *branch_list ){
-        std::string branchName = branchPtr->GetName();
+    for( const auto& branchName : branchNames ){
 	bool select = true;
 	for( std::string nameIdentifier: nameIdentifiers ){
 	    if( !stringTools::stringContains( branchName, nameIdentifier ) ) select = false;
@@ -126,125 +135,222 @@ std::pair< std::map< std::string, bool >, std::map< std::string, TBranch* > > bu
 }
 
 
-void TreeReader::initializeTriggerMap( TTree* treePtr ){
-    auto triggerMaps = buildBranchMap( treePtr, {"HLT"}, "prescale" );
+void TreeReader::initializeTriggerMap(){
+    auto triggerMaps = buildBranchMap( _branchNameIndex.names(), {"HLT"}, "prescale" );
     _triggerMap = triggerMaps.first;
     b__triggerMap = triggerMaps.second;
+    _triggerTable = std::make_shared< const DecisionTable >( _triggerMap );
 }
 
 
-void TreeReader::initializeMetFilterMap( TTree* treePtr ){
+void TreeReader::initializeMetFilterMap(){
     //WARNING: Currently one MET filter contains 'updated' rather than 'Flag' in the name. 
     //If this changes, make sure to modify the code here!
-    auto filterMaps = buildBranchMap( treePtr, {"Flag"} );
-    auto filterMaps_part2 = buildBranchMap( treePtr , {"updated"} );
+    auto filterMaps = buildBranchMap( _branchNameIndex.names(), {"Flag"} );
+    auto filterMaps_part2 = buildBranchMap( _branchNameIndex.names(), {"updated"} );
     filterMaps.first.insert( filterMaps_part2.first.cbegin(), filterMaps_part2.first.cend() );
     filterMaps.second.insert( filterMaps_part2.second.cbegin(), filterMaps_part2.second.cend() );
 
     _MetFilterMap = filterMaps.first;
     b__MetFilterMap = filterMaps.second;
+    _MetFilterTable = std::make_shared< const DecisionTable >( _MetFilterMap );
 }
 
 
-void TreeReader::initializeJecSourcesMaps( TTree* treePtr ){
-    // initialize jetPt branches
-    b__jetPt_JECSourcesUp = buildBranchMap( treePtr, {"_jetPt_","_JECSourcesUp"}).second;
-    for( auto mapEl: b__jetPt_JECSourcesUp ){ _jetPt_JECSourcesUp[mapEl.first]; }
-    b__jetPt_JECSourcesDown = buildBranchMap( treePtr, {"_jetPt","_JECSourcesDown"}).second;
-    for( auto mapEl: b__jetPt_JECSourcesDown ){ _jetPt_JECSourcesDown[mapEl.first]; }
-    // initialize jetSmearedPt branches
-    b__jetSmearedPt_JECSourcesUp = buildBranchMap( treePtr, 
-	{"_jetSmearedPt","JECSourcesUp"}).second;
-    for( auto mapEl: b__jetSmearedPt_JECSourcesUp ){ 
-	_jetSmearedPt_JECSourcesUp[mapEl.first]; 
-    }
-    b__jetSmearedPt_JECSourcesDown = buildBranchMap( treePtr, 
-	{"_jetSmearedPt","JECSourcesDown"}).second;
-    for( auto mapEl: b__jetSmearedPt_JECSourcesDown ){ 
-	_jetSmearedPt_JECSourcesDown[mapEl.first]; 
-    }
-    // initialize met x branches
-    b__corrMETx_JECSourcesUp = buildBranchMap( treePtr, {"_corrMETx","_JECSourcesUp"}).second;
-    for( auto mapEl: b__corrMETx_JECSourcesUp ){ _corrMETx_JECSourcesUp[mapEl.first]; }
-    b__corrMETx_JECSourcesDown = buildBranchMap( treePtr, {"_corrMETx","_JECSourcesDown"}).second;
-    for( auto mapEl: b__corrMETx_JECSourcesDown ){ _corrMETx_JECSourcesDown[mapEl.first]; }
-    // initialize met y branches
-    b__corrMETy_JECSourcesUp = buildBranchMap( treePtr, {"_corrMETy","_JECSourcesUp"}).second;
-    for( auto mapEl: b__corrMETy_JECSourcesUp ){ _corrMETy_JECSourcesUp[mapEl.first]; }
-    b__corrMETy_JECSourcesDown = buildBranchMap( treePtr, {"_corrMETy","_JECSourcesDown"}).second;
-    for( auto mapEl: b__corrMETy_JECSourcesDown ){ _corrMETy_JECSourcesDown[mapEl.first]; }
-}
-
-
-void TreeReader::initializeJecSourcesGroupedMaps( TTree* treePtr ){
-    // initialize jetPt branches
-    b__jetPt_JECGroupedUp = buildBranchMap( treePtr, {"_jetPt_","_JECGroupedUp"}).second;
-    for( auto mapEl: b__jetPt_JECGroupedUp ){ _jetPt_JECGroupedUp[mapEl.first]; }
-    b__jetPt_JECGroupedDown = buildBranchMap( treePtr, {"_jetPt","_JECGroupedDown"}).second;
-    for( auto mapEl: b__jetPt_JECGroupedDown ){ _jetPt_JECGroupedDown[mapEl.first]; }
-    // initialize jetSmearedPt branches
-    b__jetSmearedPt_JECGroupedUp = buildBranchMap( treePtr, 
-	{"_jetSmearedPt","JECGroupedUp"}).second;
-    for( auto mapEl: b__jetSmearedPt_JECGroupedUp ){ 
-	_jetSmearedPt_JECGroupedUp[mapEl.first]; 
-    }
-    b__jetSmearedPt_JECGroupedDown = buildBranchMap( treePtr, 
-	{"_jetSmearedPt","JECGroupedDown"}).second;
-    for( auto mapEl: b__jetSmearedPt_JECGroupedDown ){ 
-	_jetSmearedPt_JECGroupedDown[mapEl.first]; 
-    }
-    // initialize met x branches
-    b__corrMETx_JECGroupedUp = buildBranchMap( treePtr, {"_corrMETx","_JECGroupedUp"}).second;
-    for( auto mapEl: b__corrMETx_JECGroupedUp ){ _corrMETx_JECGroupedUp[mapEl.first]; }
-    b__corrMETx_JECGroupedDown = buildBranchMap( treePtr, {"_corrMETx","_JECGroupedDown"}).second;
-    for( auto mapEl: b__corrMETx_JECGroupedDown ){ _corrMETx_JECGroupedDown[mapEl.first]; }
-    // initialize met y branches
-    b__corrMETy_JECGroupedUp = buildBranchMap( treePtr, {"_corrMETy","_JECGroupedUp"}).second;
-    for( auto mapEl: b__corrMETy_JECGroupedUp ){ _corrMETy_JECGroupedUp[mapEl.first]; }
-    b__corrMETy_JECGroupedDown = buildBranchMap( treePtr, {"_corrMETy","_JECGroupedDown"}).second;
-    for( auto mapEl: b__corrMETy_JECGroupedDown ){ _corrMETy_JECGroupedDown[mapEl.first]; }
+void TreeReader::initializeJECVariations(){
+
+    // the names of the variations are extracted from the branch names only once per tree
+    _JECVariationTable = std::make_shared< const JECVariationTable >( JECVariationTable::fromBranchNames( _branchNameIndex.names() ) );
+
+    // flat storage for all variations
+    const JECVariationTable::size_type numberOfVariations = _JECVariationTable->size();
+    _jetPt_JECVariationsDown.assign( numberOfVariations*nJets_max, 0. );
+    _jetPt_JECVariationsUp.assign( numberOfVariations*nJets_max, 0. );
+    _jetSmearedPt_JECVariationsDown.assign( numberOfVariations*nJets_max, 0. );
+    _jetSmearedPt_JECVariationsUp.assign( numberOfVariations*nJets_max, 0. );
+    _corrMETx_JECVariationsDown.assign( numberOfVariations, 0. );
+    _corrMETx_JECVariationsUp.assign( numberOfVariations, 0. );
+    _corrMETy_JECVariationsDown.assign( numberOfVariations, 0. );
+    _corrMETy_JECVariationsUp.assign( numberOfVariations, 0. );
 }
 
 
-// functions to find if a tree has branches with certain types of info //
+void TreeReader::setInputBranchAddress( const char* name, Double_t* address, TBranch** branchPtrPtr ){
+    *branchPtrPtr = nullptr;
+    if( !_branchNameIndex.contains( name ) ){
+        *address = 0.;
+        if( !_isSlimmedTree && !_columnarCachePtr ) _currentTreePtr->SetBranchAddress( name, address, branchPtrPtr );
+        return;
+    }
+    addInputColumn( name, address, columnTypeCode< Double_t >(), sizeof( Double_t ) );
+    if( _columnarCachePtr ) return;
+    TBranch* branchPtr = _currentTreePtr->GetBranch( name );
+    TLeaf* leafPtr = branchPtr->GetLeaf( name );
+    if( leafPtr == nullptr || std::string( leafPtr->GetTypeName() ) != "Float_t" ){
+        _currentTreePtr->SetBranchAddress( name, address, branchPtrPtr );
+        return;
+    }
 
-bool treeHasBranchWithName( TTree* treePtr, const std::string& nameToFind ){
-    TObjArray* branch_list = treePtr->GetListOfBranches();
-    for( const auto& branchPtr : *branch_list ){
-	std::string branchName = branchPtr->GetName();
-	    if( stringTools::stringContains( branchName, nameToFind ) ){
-		return true;
-	    }
+    //the buffer holds arrays of the largest size stored in the tree
+    const std::size_t valuesPerObject = leafPtr->GetLenStatic();
+    const TLeaf* sizeLeafPtr = leafPtr->GetLeafCount();
+    const std::size_t numberOfValues = valuesPerObject*( sizeLeafPtr ? sizeLeafPtr->GetMaximum() : 1 );
+    _narrowedInputBranches.push_back( { std::vector< Float_t >( numberOfValues ), address, valuesPerObject, 
+        sizeLeafPtr, BranchProfile::groupOfBranch( name ) } );
+    _currentTreePtr->SetBranchAddress( name, _narrowedInputBranches.back().values.data(), branchPtrPtr );
+    _narrowedInputBranchIndices[ *branchPtrPtr ] = _narrowedInputBranches.size() - 1;
+}
+
+
+//only the values of the objects in the entry that was read are converted
+//(in MakeClass mode the leaf holding the size of the array reads the variable it is bound to)
+void TreeReader::convertNarrowedInputBranch( const NarrowedInputBranch& branch ) const{
+    std::size_t numberOfValues = branch.valuesPerObject;
+    if( branch.sizeLeafPtr ) numberOfValues *= static_cast< std::size_t >( branch.sizeLeafPtr->GetValue() );
+    numberOfValues = std::min( numberOfValues, branch.values.size() );
+    std::copy( branch.values.cbegin(), branch.values.cbegin() + numberOfValues, branch.target );
+}
+
+
+//branches of the enabled groups, after reading all of them
+void TreeReader::convertNarrowedInputBranches() const{
+    for( const auto& branch : _narrowedInputBranches ){
+        if( _branchProfile.isEnabled( branch.group ) ) convertNarrowedInputBranch( branch );
+    }
+}
+
+
+//branches of one group, after reading the group
+void TreeReader::convertNarrowedInputBranches( const BranchProfile::Group group ) const{
+    for( const auto& branch : _narrowedInputBranches ){
+        if( branch.group == group ) convertNarrowedInputBranch( branch );
     }
-    return false;
 }
 
 
-bool TreeReader::containsTauInfo() const{
-    return treeHasBranchWithName( _currentTreePtr, "_tau_" );
+//nullptr if the branch is not narrowed
+const TreeReader::NarrowedInputBranch* TreeReader::narrowedInputBranch( const TBranch* branchPtr ) const{
+    auto it = _narrowedInputBranchIndices.find( branchPtr );
+    if( it == _narrowedInputBranchIndices.cend() ) return nullptr;
+    return &_narrowedInputBranches[ it->second ];
 }
 
 
-bool TreeReader::containsGeneratorInfo() const{
-    // to do: find a more suitable check than only checking the _weight branch;
-    //        but more difficult than in other cases since the relevant branch names
-    //         have little in common...
-    return treeHasBranchWithName( _currentTreePtr, "_weight");
+void TreeReader::addInputColumn( const char* name, void* address, const char typeCode, const std::size_t valueSize ){
+    InputColumn column{ { name, typeCode, valueSize, "", 1 }, address, BranchProfile::groupOfBranch( name ), 0, 0 };
+    if( _columnarCachePtr ){
+        column.cacheIndex = _columnarCachePtr->columnIndex( name );
+        const ColumnInfo& cachedColumn = _columnarCachePtr->column( column.cacheIndex );
+        if( cachedColumn.typeCode != typeCode ){
+            throw std::invalid_argument( std::string( "ERROR in TreeReader::addInputColumn: column '" ) + name + "' of cache '" 
+                + _columnarCachePtr->directory() + "' has type '" + cachedColumn.typeCode + "' while its variable has type '" + typeCode + "'." );
+        }
+        column.info = cachedColumn;
+    } else {
+
+        //arrays have a leaf holding their size, fixed-size arrays only a static length
+        TLeaf* leafPtr = _currentTreePtr->GetBranch( name )->GetLeaf( name );
+        if( leafPtr ){
+            column.info.valuesPerObject = leafPtr->GetLenStatic();
+            if( leafPtr->GetLeafCount() ) column.info.sizeName = leafPtr->GetLeafCount()->GetName();
+        }
+    }
+
+    //values are only copied to the variable when reading from the cache
+    if( _columnarCachePtr ){
+        column.capacity = column.info.valuesPerObject*( column.info.isArray() ? maximumNumberOfObjects( column.info.sizeName ) : 1 );
+    }
+    _inputColumns.push_back( column );
+}
+
+
+std::size_t TreeReader::maximumNumberOfObjects( const std::string& sizeName ){
+    static const std::map< std::string, std::size_t > maximumMap = {
+        { "_nL", nL_max }, { "_nJets", nJets_max }, { "_gen_nL", gen_nL_max },
+        { "_nLheWeights", nLheWeights_max }, { "_nPsWeights", nPsWeights_max }
+    };
+    auto it = maximumMap.find( sizeName );
+    if( it == maximumMap.cend() ){
+        throw std::invalid_argument( "ERROR in TreeReader::maximumNumberOfObjects: no array size is known for '" + sizeName + "'." );
+    }
+    return it->second;
+}
+
+
+void TreeReader::setJECVariationBranchAddresses(){
+
+    // branches missing from the tree are skipped, their branch pointer stays nullptr
+    // (the variations are found from the branch names, so not every quantity exists for every variation)
+    auto setAddressIfPresent = [this]( const std::string& name, Double_t* address, TBranch** branchPtrPtr ){
+        if( _branchNameIndex.contains( name ) ) setInputBranchAddress( name.c_str(), address, branchPtrPtr );
+    };
+    const JECVariationTable::size_type numberOfVariations = _JECVariationTable->size();
+    b__jetPt_JECVariationsDown.assign( numberOfVariations, nullptr );
+    b__jetPt_JECVariationsUp.assign( numberOfVariations, nullptr );
+    b__jetSmearedPt_JECVariationsDown.assign( numberOfVariations, nullptr );
+    b__jetSmearedPt_JECVariationsUp.assign( numberOfVariations, nullptr );
+    b__corrMETx_JECVariationsDown.assign( numberOfVariations, nullptr );
+    b__corrMETx_JECVariationsUp.assign( numberOfVariations, nullptr );
+    b__corrMETy_JECVariationsDown.assign( numberOfVariations, nullptr );
+    b__corrMETy_JECVariationsUp.assign( numberOfVariations, nullptr );
+    for( JECVariationTable::size_type v = 0; v < numberOfVariations; ++v ){
+        const JECVariationTable& table = *_JECVariationTable;
+        setAddressIfPresent( table.branchName( "_jetPt", v, "Down" ), &_jetPt_JECVariationsDown[ v*nJets_max ], &b__jetPt_JECVariationsDown[ v ] );
+        setAddressIfPresent( table.branchName( "_jetPt", v, "Up" ), &_jetPt_JECVariationsUp[ v*nJets_max ], &b__jetPt_JECVariationsUp[ v ] );
+        setAddressIfPresent( table.branchName( "_jetSmearedPt", v, "Down" ), &_jetSmearedPt_JECVariationsDown[ v*nJets_max ], &b__jetSmearedPt_JECVariationsDown[ v ] );
+        setAddressIfPresent( table.branchName( "_jetSmearedPt", v, "Up" ), &_jetSmearedPt_JECVariationsUp[ v*nJets_max ], &b__jetSmearedPt_JECVariationsUp[ v ] );
+        setAddressIfPresent( table.branchName( "_corrMETx", v, "Down" ), &_corrMETx_JECVariationsDown[ v ], &b__corrMETx_JECVariationsDown[ v ] );
+        setAddressIfPresent( table.branchName( "_corrMETx", v, "Up" ), &_corrMETx_JECVariationsUp[ v ], &b__corrMETx_JECVariationsUp[ v ] );
+        setAddressIfPresent( table.branchName( "_corrMETy", v, "Down" ), &_corrMETy_JECVariationsDown[ v ], &b__corrMETy_JECVariationsDown[ v ] );
+        setAddressIfPresent( table.branchName( "_corrMETy", v, "Up" ), &_corrMETy_JECVariationsUp[ v ], &b__corrMETy_JECVariationsUp[ v ] );
+    }
 }
 
 
-bool TreeReader::containsGenParticles() const{
-    return treeHasBranchWithName( _currentTreePtr, "_gen_" );
+// functions to find if a tree has branches with certain types of info //
+
+void TreeReader::indexCurrentTree(){
+    std::vector< std::string > branchNames;
+    _isSlimmedTree = false;
+    if( _columnarCachePtr ){
+        branchNames = _columnarCachePtr->columnNames();
+    } else {
+        checkCurrentTree();
+        TObjArray* branch_list = _currentTreePtr->GetListOfBranches();
+        for( const auto& branchPtr : *branch_list ){
+            branchNames.push_back( branchPtr->GetName() );
+        }
+
+        // trees written with a slimming profile carry its name (see setOutputTree)
+        _isSlimmedTree = ( _currentTreePtr->GetUserInfo()->FindObject( SlimmingProfile::userInfoName() ) != nullptr );
+    }
+    _branchNameIndex = BranchNameIndex( branchNames );
+
+    _containsTauInfo = _branchNameIndex.containsSubstring( "_tau_" );
+
+    // to do: find a more suitable check than only checking the _weight branch;
+    //        but more difficult than in other cases since the relevant branch names
+    //         have little in common...
+    _containsGeneratorInfo = _branchNameIndex.containsSubstring( "_weight" );
+    _containsGenParticles = _branchNameIndex.containsSubstring( "_gen_" );
+    _containsSusyMassInfo = _branchNameIndex.containsSubstring( "_mChi" );
 }
 
 
-bool TreeReader::containsSusyMassInfo() const{
-    return treeHasBranchWithName( _currentTreePtr, "_mChi" );
+bool TreeReader::containsTriggerInfo( const std::string& triggerPath, const bool exactMatch ) const{
+    for( const std::string& name : { triggerPath, "_" + triggerPath } ){
+        if( exactMatch ? _branchNameIndex.contains( name ) : _branchNameIndex.containsPrefix( name ) ) return true;
+    }
+    return false;
 }
 
 
-bool TreeReader::containsTriggerInfo( const std::string& triggerPath ) const{
-    return treeHasBranchWithName( _currentTreePtr, triggerPath );
+DecisionTable::size_type TreeReader::triggerIndex( const std::string& triggerName ) const{
+    DecisionTable::size_type index = ( _triggerTable ? _triggerTable->index( triggerName ) : 0 );
+    if( !_triggerTable || index == _triggerTable->size() ){
+        throw std::invalid_argument( "ERROR in TreeReader::triggerIndex: requested trigger '" + triggerName + "' does not exist." );
+    }
+    return index;
 }
 
 
@@ -337,11 +443,18 @@ bool TreeReader::isNewPhysicsSignal() const{
 
 
 long unsigned TreeReader::numberOfEntries() const{
+    if( _columnarCachePtr ) return _columnarCachePtr->numberOfEntries();
     checkCurrentTree();
     return _currentTreePtr->GetEntries();
 }
 
 
+long long TreeReader::compressedTreeSize() const{
+    checkCurrentTree();
+    return _currentTreePtr->GetZipBytes();
+}
+
+
 void TreeReader::initSample( const Sample& samp ){ 
 
     //update current sample
@@ -355,24 +468,31 @@ void TreeReader::initSample( const Sample& samp ){
     // but this makes the entire TreeReader class unthreadsafe, 
     // so no parallel sample processing in one process can be done"
     _currentSamplePtr = std::make_shared< Sample >( samp );
-    _currentFilePtr = samp.filePtr();
 
-    // old comment from Willem:
-    // "Warning: this pointer is overwritten, but it is not a memory leak. 
-    // ROOT is dirty and deletes the previous tree upon closure of the TFile it belongs to.
-    // The previous TFile is closed by the std::shared_ptr destructor, 
-    // implicitly called above when opening a new TFile."
-    _currentTreePtr = (TTree*) _currentFilePtr->Get( "blackJackAndHookers/blackJackAndHookersTree" );
-    checkCurrentTree();
+    // read the sample from its columnar cache if there is one
+    if( !_columnarCacheDirectory.empty() && ColumnarCache::exists( columnarCachePath( _columnarCacheDirectory, samp ) ) ){
+        _currentTreePtr = nullptr;
+        _currentFilePtr.reset();
+        _columnarCachePtr = std::make_shared< const ColumnarCache >( columnarCachePath( _columnarCacheDirectory, samp ) );
+        checkCacheMatchesSample( samp );
+    } else {
+        _columnarCachePtr.reset();
+        _currentFilePtr = samp.filePtr();
+
+        // old comment from Willem:
+        // "Warning: this pointer is overwritten, but it is not a memory leak. 
+        // ROOT is dirty and deletes the previous tree upon closure of the TFile it belongs to.
+        // The previous TFile is closed by the std::shared_ptr destructor, 
+        // implicitly called above when opening a new TFile."
+        _currentTreePtr = (TTree*) _currentFilePtr->Get( "blackJackAndHookers/blackJackAndHookersTree" );
+    }
+    indexCurrentTree();
     initTree();
     if( !samp.isData() ){
 
         //read sum of simulated event weights
-        TH1D* hCounter = new TH1D( "hCounter", "Events counter", 1, 0, 1 );
-        _currentFilePtr->cd( "blackJackAndHookers" );
-        hCounter->Read( "hCounter" ); 
-        double sumSimulatedEventWeights = hCounter->GetBinContent(1);
-        delete hCounter;
+        double sumSimulatedEventWeights = ( _columnarCachePtr ? _columnarCachePtr->metadata().sumOfSimulatedEventWeights
+            : sumSimulatedEventWeightsFromFile() );
 
         //event weights set with lumi depending on sample's era 
         double dataLumi;
@@ -391,7 +511,29 @@ void TreeReader::initSample( const Sample& samp ){
 
 //initialize the next sample in the list
 void TreeReader::initSample(){
-    initSample( samples[ ++currentSampleIndex ] );
+    initSample( static_cast< std::vector< Sample >::size_type >( currentSampleIndex + 1 ) );
+}
+
+
+double TreeReader::sumSimulatedEventWeightsFromFile() const{
+    checkCurrentFile();
+    TH1D* hCounter = new TH1D( "hCounter", "Events counter", 1, 0, 1 );
+    _currentFilePtr->cd( "blackJackAndHookers" );
+    hCounter->Read( "hCounter" ); 
+    double sumSimulatedEventWeights = hCounter->GetBinContent(1);
+    delete hCounter;
+    return sumSimulatedEventWeights;
+}
+
+
+void TreeReader::initSample( const std::vector< Sample >::size_type sampleIndex ){
+    if( sampleIndex >= samples.size() ){
+        std::string message = "ERROR in TreeReader::initSample: sample index " + std::to_string( sampleIndex );
+        message += " is out of range for a sample list of size " + std::to_string( samples.size() ) + ".";
+        throw std::out_of_range( message );
+    }
+    currentSampleIndex = static_cast< int >( sampleIndex );
+    initSample( samples[ sampleIndex ] );
 }
 
 
@@ -409,6 +551,7 @@ void TreeReader::initSampleFromFile( const std::string& pathToFile,
         throw std::invalid_argument( "File '" + pathToFile + "' does not exist." );
     }
 
+    _columnarCachePtr.reset();
     _currentFilePtr = std::shared_ptr< TFile >( new TFile( pathToFile.c_str() ) );
 
     // check year
@@ -425,14 +568,14 @@ void TreeReader::initSampleFromFile( const std::string& pathToFile,
     // The previous TFile is closed by the std::shared_ptr destructor, 
     // implicitly called above when opening a new TFile."
     _currentTreePtr = (TTree*) _currentFilePtr->Get( "blackJackAndHookers/blackJackAndHookersTree" );
-    checkCurrentTree();
+    indexCurrentTree();
 
     // make a new sample, and make sure the pointer remains valid
     // old comment from Willem:
     // "new is no option here since this would also require a destructor for the class, 
     // which does not work for the other initSample case"
     _currentSamplePtr = std::make_shared< Sample >( pathToFile, is2016, is2016PreVFP,
-			    is2016PostVFP, is2017, is2018, isData() );
+			    is2016PostVFP, is2017, is2018, !containsGeneratorInfo() );
 
     //initialize tree
     initTree( resetTriggersAndFilters );
@@ -458,10 +601,128 @@ void TreeReader::initSampleFromFile( const std::string& pathToFile,
 }
 
 
-void TreeReader::GetEntry( const Sample& samp, long unsigned entry ){
+unsigned long long TreeReader::writeColumnarCache( const std::string& cacheDirectory, const long unsigned maximumNumberOfEntries ){
     checkCurrentTree();
+    checkCurrentSample();
+
+    // columns of the enabled branch groups, together with the sizes of their arrays
+    std::set< std::string > selectedNames;
+    for( const auto& column : _inputColumns ){
+        if( !_branchProfile.isEnabled( column.group ) ) continue;
+        selectedNames.insert( column.info.name );
+        if( column.info.isArray() ) selectedNames.insert( column.info.sizeName );
+    }
+
+    ColumnarCacheMetadata metadata;
+    metadata.source = _currentSamplePtr->filePath();
+    metadata.setSourceStatus( metadata.source );
+    metadata.isData = isData();
+    metadata.is2016 = is2016();
+    metadata.is2016PreVFP = is2016PreVFP();
+    metadata.is2016PostVFP = is2016PostVFP();
+    metadata.is2017 = is2017();
+    metadata.is2018 = is2018();
+    if( isMC() ) metadata.sumOfSimulatedEventWeights = sumSimulatedEventWeightsFromFile();
+    metadata.branchProfile = _branchProfile.toString();
+    std::vector< const void* > addresses;
+    for( const auto& column : _inputColumns ){
+        if( selectedNames.find( column.info.name ) == selectedNames.cend() ) continue;
+        metadata.columns.push_back( column.info );
+        addresses.push_back( column.address );
+
+        // the size of an array might belong to a disabled group
+        _currentTreePtr->SetBranchStatus( column.info.name.c_str(), 1 );
+    }
+
+    ColumnarCacheWriter writer( cacheDirectory, metadata );
+    const long unsigned numberOfEntriesToWrite = std::min( maximumNumberOfEntries, numberOfEntries() );
+    for( long unsigned entry = 0; entry < numberOfEntriesToWrite; ++entry ){
+        _currentTreePtr->GetEntry( entry );
+        convertNarrowedInputBranches();
+        writer.fill( addresses );
+    }
+    writer.close();
+
+    //the variables of the reader no longer hold the current entry after writing
+    ++_entryReadIndex;
+    applyBranchProfile();
+    applyReadCache();
+    return writer.numberOfBytesWritten();
+}
+
+
+void TreeReader::initSampleFromCache( const std::string& cacheDirectory ){
+    _currentTreePtr = nullptr;
+    _currentFilePtr.reset();
+    _columnarCachePtr = std::make_shared< const ColumnarCache >( cacheDirectory );
+    const ColumnarCacheMetadata& metadata = _columnarCachePtr->metadata();
+    checkCacheIsCurrent( metadata.source );
+    checkCacheContainsBranchProfile( _branchProfile );
+    indexCurrentTree();
+    _currentSamplePtr = std::make_shared< Sample >( metadata.source, metadata.is2016, metadata.is2016PreVFP,
+			    metadata.is2016PostVFP, metadata.is2017, metadata.is2018, metadata.isData );
+    initTree();
+    _isSusy = containsSusyMassInfo();
+
+    //as in initSampleFromFile, the weights are not scaled
+    scale = 1.;
+}
+
+
+std::string TreeReader::columnarCachePath( const std::string& directory, const Sample& samp ){
+    return stringTools::formatDirectoryName( directory ) + stringTools::fileNameWithoutExtension( samp.fileName() );
+}
+
+
+void TreeReader::checkCacheMatchesSample( const Sample& samp ) const{
+    const ColumnarCacheMetadata& metadata = _columnarCachePtr->metadata();
+    if( metadata.isData != samp.isData() || metadata.is2016 != samp.is2016() || metadata.is2016PreVFP != samp.is2016PreVFP()
+        || metadata.is2016PostVFP != samp.is2016PostVFP() || metadata.is2017 != samp.is2017() || metadata.is2018 != samp.is2018() ){
+        throw std::invalid_argument( "ERROR in TreeReader::checkCacheMatchesSample: columnar cache '" + _columnarCachePtr->directory()
+            + "' was written for a sample of another era or type than sample '" + samp.fileName() + "'." );
+    }
+    checkCacheIsCurrent( samp.filePath() );
+    checkCacheContainsBranchProfile( _branchProfile );
+}
+
+
+void TreeReader::checkCacheIsCurrent( const std::string& sourcePath ) const{
+    if( _columnarCachePtr->metadata().sourceChanged( sourcePath ) ){
+        throw std::invalid_argument( "ERROR in TreeReader::checkCacheIsCurrent: columnar cache '" + _columnarCachePtr->directory()
+            + "' is stale, file '" + sourcePath + "' changed since the cache was written; remove the cache to write it again." );
+    }
+}
+
+
+//only the groups of the branch profile the cache was written with are stored in it
+void TreeReader::checkCacheContainsBranchProfile( const BranchProfile& profile ) const{
+    const std::string& cacheProfile = _columnarCachePtr->metadata().branchProfile;
+    if( !BranchProfile( cacheProfile ).includes( profile ) ){
+        throw std::invalid_argument( "ERROR in TreeReader::checkCacheContainsBranchProfile: columnar cache '" + _columnarCachePtr->directory()
+            + "' was written with branch profile '" + cacheProfile + "', which does not contain all groups of the branch profile '" 
+            + profile.toString() + "' of the TreeReader; write the cache again with a wider profile." );
+    }
+}
+
 
-    _currentTreePtr->GetEntry( entry );
+void TreeReader::GetEntry( const Sample& samp, long unsigned entry ){
+    if( !_columnarCachePtr ) checkCurrentTree();
+
+    _currentEntry = entry;
+    ++_entryReadIndex;
+    ++_numberOfEntriesRead;
+    ++_numberOfEntriesReadFromTree;
+    if( _columnarCachePtr ){
+        readEntryFromCache( entry );
+    } else if( _lazyReading ){
+
+        //other branch groups are read when the event first needs them
+        _loadedGroups = 0;
+        loadBranchGroup( BranchProfile::eventInfo );
+    } else {
+        _bytesReadEagerly += _currentTreePtr->GetEntry( entry );
+        convertNarrowedInputBranches();
+    }
 
     //Set up correct event weight
     if( !samp.isData() ){
@@ -472,6 +733,21 @@ void TreeReader::GetEntry( const Sample& samp, long unsigned entry ){
 }
 
 
+void TreeReader::readEntryFromCache( const long unsigned entry ){
+    if( entry >= _columnarCachePtr->numberOfEntries() ){
+        throw std::out_of_range( "ERROR in TreeReader::readEntryFromCache: entry " + std::to_string( entry ) + " is out of range for cache '"
+            + _columnarCachePtr->directory() + "'." );
+    }
+    for( const auto& column : _inputColumns ){
+        if( !_branchProfile.isEnabled( column.group ) ) continue;
+        _bytesReadEagerly += _columnarCachePtr->copyEntry( column.cacheIndex, entry, column.address, column.capacity )*column.info.valueSize;
+    }
+
+    //there is nothing left to read for lazily read groups
+    _loadedGroups = std::numeric_limits< unsigned >::max();
+}
+
+
 //use the currently initialized sample when running in serial
 void TreeReader::GetEntry( long unsigned entry ){
     GetEntry( *_currentSamplePtr, entry );
@@ -496,23 +772,294 @@ Event TreeReader::buildEvent( long unsigned entry,
 }
 
 
-template< typename T > void setMapBranchAddresses( TTree* treePtr, 
-	std::map< std::string, T >& variableMap, 
-	std::map< std::string, TBranch* > branchMap ){
-    for( const auto& variable : variableMap ){
-        treePtr->SetBranchAddress( variable.first.c_str(), 
-	    &variableMap[ variable.first ], 
-	    &branchMap[ variable.first ] );
+namespace{
+
+    //call a function for each entry of a range, with the basket buffer of the branch positioned at the start of the entry
+    //every basket is read and decompressed once and its values are unpacked directly,
+    //instead of dispatching TBranch::GetEntry through the branch and its leaves for every entry
+    //baskets that have been read completely are dropped again so the memory use stays bounded
+    template< typename Function > void forEachBasketEntry( TBranch* branchPtr, const long unsigned firstEntry,
+            const long unsigned numberOfEntries, const Function& function ){
+        const Long64_t* basketEntries = branchPtr->GetBasketEntry();
+        const long unsigned lastEntry = firstEntry + numberOfEntries;
+        long unsigned entry = firstEntry;
+        while( entry < lastEntry ){
+            const Int_t basketIndex = static_cast< Int_t >( TMath::BinarySearch( branchPtr->GetWriteBasket() + 1, basketEntries, static_cast< Long64_t >( entry ) ) );
+            TBasket* basketPtr = branchPtr->GetBasket( basketIndex );
+            const long unsigned basketFirstEntry = static_cast< long unsigned >( basketEntries[ basketIndex ] );
+            const long unsigned basketLastEntry = static_cast< long unsigned >( basketIndex == branchPtr->GetWriteBasket() ? 
+                branchPtr->GetEntryNumber() : basketEntries[ basketIndex + 1 ] );
+            if( basketPtr == nullptr || basketLastEntry <= entry ){
+                throw std::runtime_error( "ERROR in TreeReader::readBatch: basket " + std::to_string( basketIndex ) + " of branch '" 
+                    + branchPtr->GetName() + "' can not be read." );
+            }
+
+            //same buffer positions as TBranch::GetEntry
+            TBuffer& buffer = *basketPtr->GetBufferRef();
+            const Int_t* entryOffsets = basketPtr->GetEntryOffset();
+            for( ; entry < std::min( lastEntry, basketLastEntry ); ++entry ){
+                const long unsigned entryInBasket = entry - basketFirstEntry;
+                buffer.SetBufferOffset( entryOffsets ? entryOffsets[ entryInBasket ] : 
+                    basketPtr->GetKeylen() + static_cast< Int_t >( entryInBasket )*basketPtr->GetNevBufSize() );
+                function( entry - firstEntry, buffer );
+            }
+            if( basketLastEntry <= lastEntry ) branchPtr->DropBaskets();
+        }
+    }
+
+
+    //read a scalar branch of which the values are stored as StoredType for a range of entries
+    //a branch missing from a slimmed tree (nullptr) is read as zero, as when building events
+    template< typename StoredType, typename ValueType > void readScalarBranch( TBranch* branchPtr, const long unsigned firstEntry, 
+            std::vector< ValueType >& values ){
+        if( branchPtr == nullptr ){
+            std::fill( values.begin(), values.end(), ValueType() );
+            return;
+        }
+        forEachBasketEntry( branchPtr, firstEntry, values.size(), [&values]( const long unsigned i, TBuffer& buffer ){
+            StoredType value;
+            buffer.ReadFastArray( &value, 1 );
+            values[ i ] = value;
+        } );
+    }
+
+
+    //read an array branch of which the values are stored as StoredType for a range of entries into a column of which the row sizes are already set
+    //the size branch is not read, the number of values of each entry is taken from the column
+    template< typename StoredType, typename ValueType > void readArrayBranch( TBranch* branchPtr, const long unsigned firstEntry, 
+            JaggedColumn< ValueType >& column ){
+        if( branchPtr == nullptr ){
+            for( typename JaggedColumn< ValueType >::size_type i = 0; i < column.numberOfRows(); ++i ){
+                std::fill( column.row( i ), column.row( i ) + column.count( i ), ValueType() );
+            }
+            return;
+        }
+        std::vector< StoredType > values;
+        forEachBasketEntry( branchPtr, firstEntry, column.numberOfRows(), [&values, &column]( const long unsigned i, TBuffer& buffer ){
+            values.resize( column.count( i ) );
+            buffer.ReadFastArray( values.data(), static_cast< Int_t >( values.size() ) );
+            std::copy( values.cbegin(), values.cend(), column.row( i ) );
+        } );
+    }
+}
+
+
+bool TreeReader::readBatch( EventBatch& batch, const long unsigned firstEntry, const long unsigned numberOfEntries ){
+    if( !_columnarCachePtr ) checkCurrentTree();
+    for( const auto group : { BranchProfile::triggers, BranchProfile::leptonKinematics, BranchProfile::jets, BranchProfile::met } ){
+        _branchProfile.require( group, "TreeReader::readBatch" );
+    }
+    const long unsigned lastEntry = std::min( firstEntry + numberOfEntries, this->numberOfEntries() );
+    const long unsigned batchSize = ( lastEntry > firstEntry ? lastEntry - firstEntry : 0 );
+
+    batch._firstEntry = firstEntry;
+    batch._met.resize( batchSize );
+    batch._metPhi.resize( batchSize );
+    batch._triggerBits.assign( batchSize, 0 );
+    if( batchSize == 0 ){
+        batch._leptonPt.resize( {} );
+        batch._leptonEta.resize( {} );
+        batch._leptonPhi.resize( {} );
+        batch._leptonFlavor.resize( {} );
+        batch._leptonCharge.resize( {} );
+        batch._jetPt.resize( {} );
+        batch._jetEta.resize( {} );
+        batch._jetPhi.resize( {} );
+        return false;
+    }
+    if( _columnarCachePtr ){
+        readBatchFromCache( batch, firstEntry, batchSize );
+        return true;
+    }
+
+    //branches missing from slimmed trees are read as zero, for other trees they can not be read
+    if( !_isSlimmedTree ){
+        const std::vector< std::pair< std::string, const TBranch* > > requiredBranches = {
+            { "_nL", b__nL }, { "_nJets", b__nJets }, { "_lPt", b__lPt }, { "_lEta", b__lEta }, { "_lPhi", b__lPhi },
+            { "_lFlavor", b__lFlavor }, { "_lCharge", b__lCharge }, { "_jetPt", b__jetPt }, { "_jetEta", b__jetEta },
+            { "_jetPhi", b__jetPhi }, { "_met", b__met }, { "_metPhi", b__metPhi }
+        };
+        for( const auto& branch : requiredBranches ){
+            if( branch.second == nullptr ){
+                throw std::invalid_argument( "ERROR in TreeReader::readBatch: branch '" + branch.first 
+                    + "' is missing from the tree of sample '" + _currentSamplePtr->fileName() + "'." );
+            }
+        }
+    }
+
+    //the values are unpacked straight from the baskets into the columns, the variables of the reader are not touched
+    //branches narrowed to Float_t in slimmed trees are converted while unpacking
+    auto readDoubleArrayBranch = [this, firstEntry]( TBranch* branchPtr, JaggedColumn< double >& column ){
+        if( narrowedInputBranch( branchPtr ) ) readArrayBranch< Float_t >( branchPtr, firstEntry, column );
+        else readArrayBranch< Double_t >( branchPtr, firstEntry, column );
+    };
+    auto readDoubleBranch = [this, firstEntry]( TBranch* branchPtr, std::vector< double >& values ){
+        if( narrowedInputBranch( branchPtr ) ) readScalarBranch< Float_t >( branchPtr, firstEntry, values );
+        else readScalarBranch< Double_t >( branchPtr, firstEntry, values );
+    };
+
+    //object multiplicities determine the layout of the jagged columns
+    std::vector< unsigned > leptonCounts( batchSize );
+    readScalarBranch< UInt_t >( b__nL, firstEntry, leptonCounts );
+    std::vector< unsigned > jetCounts( batchSize );
+    readScalarBranch< UInt_t >( b__nJets, firstEntry, jetCounts );
+    for( auto* columnPtr : { &batch._leptonPt, &batch._leptonEta, &batch._leptonPhi } ){
+        columnPtr->resize( leptonCounts );
+    }
+    batch._leptonFlavor.resize( leptonCounts );
+    batch._leptonCharge.resize( leptonCounts );
+    for( auto* columnPtr : { &batch._jetPt, &batch._jetEta, &batch._jetPhi } ){
+        columnPtr->resize( jetCounts );
+    }
+
+    readDoubleArrayBranch( b__lPt, batch._leptonPt );
+    readDoubleArrayBranch( b__lEta, batch._leptonEta );
+    readDoubleArrayBranch( b__lPhi, batch._leptonPhi );
+    readArrayBranch< UInt_t >( b__lFlavor, firstEntry, batch._leptonFlavor );
+    readArrayBranch< Int_t >( b__lCharge, firstEntry, batch._leptonCharge );
+    readDoubleArrayBranch( b__jetPt, batch._jetPt );
+    readDoubleArrayBranch( b__jetEta, batch._jetEta );
+    readDoubleArrayBranch( b__jetPhi, batch._jetPhi );
+    readDoubleBranch( b__met, batch._met );
+    readDoubleBranch( b__metPhi, batch._metPhi );
+
+    const std::vector< std::pair< EventBatch::TriggerBit, TBranch* > > triggerBranches = {
+        { EventBatch::trigger_e, b__passTrigger_e },
+        { EventBatch::trigger_m, b__passTrigger_m },
+        { EventBatch::trigger_ee, b__passTrigger_ee },
+        { EventBatch::trigger_em, b__passTrigger_em },
+        { EventBatch::trigger_et, b__passTrigger_et },
+        { EventBatch::trigger_mm, b__passTrigger_mm },
+        { EventBatch::trigger_mt, b__passTrigger_mt },
+        { EventBatch::trigger_eee, b__passTrigger_eee },
+        { EventBatch::trigger_eem, b__passTrigger_eem },
+        { EventBatch::trigger_emm, b__passTrigger_emm },
+        { EventBatch::trigger_mmm, b__passTrigger_mmm },
+        { EventBatch::trigger_FR, b__passTrigger_FR },
+        { EventBatch::trigger_FR_iso, b__passTrigger_FR_iso },
+        { EventBatch::metFilters, b__passMETFilters }
+    };
+    std::vector< char > decisions( batchSize );
+    for( const auto& trigger : triggerBranches ){
+        if( !trigger.second ) continue;
+        readScalarBranch< Bool_t >( trigger.second, firstEntry, decisions );
+        for( long unsigned i = 0; i < batchSize; ++i ){
+            if( decisions[ i ] ) batch._triggerBits[ i ] |= trigger.first;
+        }
+    }
+    return true;
+}
+
+
+namespace{
+
+    //copy a scalar column of a cache for a range of entries
+    template< typename CacheType, typename ValueType > void copyScalarColumn( const ColumnarCache& cache, const std::string& name,
+            const long unsigned firstEntry, std::vector< ValueType >& values ){
+        const CacheType* begin = cache.values< CacheType >( cache.columnIndex( name ) ) + firstEntry;
+        std::copy( begin, begin + values.size(), values.begin() );
+    }
+
+    //copy an array column of a cache for a range of entries, the row sizes are taken from the offsets in the cache
+    template< typename CacheType, typename ValueType > void copyArrayColumn( const ColumnarCache& cache, const std::string& name,
+            const long unsigned firstEntry, const long unsigned numberOfEntries, JaggedColumn< ValueType >& column ){
+        const ColumnarCache::size_type columnIndex = cache.columnIndex( name );
+        const std::uint64_t* offsets = cache.offsets( columnIndex ) + firstEntry;
+        std::vector< unsigned > counts( numberOfEntries );
+        for( long unsigned i = 0; i < numberOfEntries; ++i ){
+            counts[ i ] = static_cast< unsigned >( offsets[ i + 1 ] - offsets[ i ] );
+        }
+        column.resize( counts );
+        const CacheType* values = cache.values< CacheType >( columnIndex );
+        std::copy( values + offsets[ 0 ], values + offsets[ numberOfEntries ], column.row( 0 ) );
     }
 }
 
 
+void TreeReader::readBatchFromCache( EventBatch& batch, const long unsigned firstEntry, const long unsigned batchSize ) const{
+    const ColumnarCache& cache = *_columnarCachePtr;
+    copyArrayColumn< Double_t >( cache, "_lPt", firstEntry, batchSize, batch._leptonPt );
+    copyArrayColumn< Double_t >( cache, "_lEta", firstEntry, batchSize, batch._leptonEta );
+    copyArrayColumn< Double_t >( cache, "_lPhi", firstEntry, batchSize, batch._leptonPhi );
+    copyArrayColumn< UInt_t >( cache, "_lFlavor", firstEntry, batchSize, batch._leptonFlavor );
+    copyArrayColumn< Int_t >( cache, "_lCharge", firstEntry, batchSize, batch._leptonCharge );
+    copyArrayColumn< Double_t >( cache, "_jetPt", firstEntry, batchSize, batch._jetPt );
+    copyArrayColumn< Double_t >( cache, "_jetEta", firstEntry, batchSize, batch._jetEta );
+    copyArrayColumn< Double_t >( cache, "_jetPhi", firstEntry, batchSize, batch._jetPhi );
+    copyScalarColumn< Double_t >( cache, "_met", firstEntry, batch._met );
+    copyScalarColumn< Double_t >( cache, "_metPhi", firstEntry, batch._metPhi );
+
+    static const std::vector< std::pair< EventBatch::TriggerBit, std::string > > triggerColumns = {
+        { EventBatch::trigger_e, "_passTrigger_e" }, { EventBatch::trigger_m, "_passTrigger_m" },
+        { EventBatch::trigger_ee, "_passTrigger_ee" }, { EventBatch::trigger_em, "_passTrigger_em" },
+        { EventBatch::trigger_et, "_passTrigger_et" }, { EventBatch::trigger_mm, "_passTrigger_mm" },
+        { EventBatch::trigger_mt, "_passTrigger_mt" }, { EventBatch::trigger_eee, "_passTrigger_eee" },
+        { EventBatch::trigger_eem, "_passTrigger_eem" }, { EventBatch::trigger_emm, "_passTrigger_emm" },
+        { EventBatch::trigger_mmm, "_passTrigger_mmm" }, { EventBatch::trigger_FR, "_passTrigger_FR" },
+        { EventBatch::trigger_FR_iso, "_passTrigger_FR_iso" }, { EventBatch::metFilters, "_passMETFilters" }
+    };
+    for( const auto& trigger : triggerColumns ){
+        if( !cache.contains( trigger.second ) ) continue;
+        const Bool_t* decisions = cache.values< Bool_t >( cache.columnIndex( trigger.second ) ) + firstEntry;
+        for( long unsigned i = 0; i < batchSize; ++i ){
+            if( decisions[ i ] ) batch._triggerBits[ i ] |= trigger.first;
+        }
+    }
+}
+
+
+PreSelectionResult TreeReader::preSelectEntries( const PreSelection& preSelection, const long unsigned maximumNumberOfEntries,
+        const long unsigned batchSize ){
+    if( batchSize == 0 ){
+        throw std::invalid_argument( "ERROR in TreeReader::preSelectEntries: batch size must be larger than 0." );
+    }
+    auto begin = std::chrono::steady_clock::now();
+    PreSelectionResult result;
+    const long unsigned numberOfEntriesToProcess = std::min( maximumNumberOfEntries, numberOfEntries() );
+    result._numberOfProcessedEntries = numberOfEntriesToProcess;
+
+    //without conditions there is no need to read anything
+    if( preSelection.empty() ){
+        result._entries.resize( numberOfEntriesToProcess );
+        for( long unsigned entry = 0; entry < numberOfEntriesToProcess; ++entry ){
+            result._entries[ entry ] = entry;
+        }
+    } else {
+        EventBatch batch;
+        PreSelection::Mask mask;
+        for( long unsigned firstEntry = 0; firstEntry < numberOfEntriesToProcess; firstEntry += batchSize ){
+            readBatch( batch, firstEntry, std::min( batchSize, numberOfEntriesToProcess - firstEntry ) );
+            preSelection.apply( batch, mask );
+            for( EventBatch::size_type row = 0; row < batch.size(); ++row ){
+                if( mask[ row ] ) result._entries.push_back( batch.entry( row ) );
+            }
+        }
+    }
+    result._preSelectionTime = std::chrono::duration< double >( std::chrono::steady_clock::now() - begin ).count();
+    return result;
+}
+
+
+void TreeReader::refillEvent( Event& event, const Sample& samp, long unsigned entry ){
+    GetEntry( samp, entry );
+    event.refill( *this );
+}
+
+
+void TreeReader::refillEvent( Event& event, long unsigned entry ){
+    GetEntry( entry );
+    event.refill( *this );
+}
+
+
 template< typename T> void setMapOutputBranches( TTree* treePtr, 
 			    std::map< std::string, T >& variableMap,
-			    std::string branchDataType ){
+			    std::string branchDataType,
+			    const SlimmingProfile& slimmingProfile ){
     // note: branchDataType should be e.g. "/O" for boolean, "[nJets]/D" for an array of doubles.
     // mind the slash!
     for( const auto& variable : variableMap ){
+        if( !slimmingProfile.keeps( variable.first ) ) continue;
         treePtr->Branch( variable.first.c_str(), 
 	    &variableMap[ variable.first ], 
 	    ( variable.first + branchDataType ).c_str() );
@@ -520,256 +1067,517 @@ template< typename T> void setMapOutputBranches( TTree* treePtr,
 }
 
 
+// write a JEC variation to the output tree if it was present in the input tree
+void TreeReader::setJECVariationOutputBranch( TTree* treePtr,
+			    const std::string& quantity,
+			    const JECVariationTable::size_type variationIndex,
+			    const std::string& direction,
+			    Double_t* address,
+			    const TBranch* inputBranchPtr,
+			    const bool isJetArray ){
+    if( inputBranchPtr == nullptr ) return;
+    std::string branchName = _JECVariationTable->branchName( quantity, variationIndex, direction );
+    addOutputBranch( treePtr, branchName, address, branchName + ( isJetArray ? "[_nJets]/D" : "/D" ), ( isJetArray ? nJets_max : 1 ) );
+}
+
+
+void TreeReader::addOutputBranch( TTree* outputTree, const std::string& name, void* address, const std::string& leafList,
+	const std::size_t numberOfValues ){
+    if( !_slimmingProfile.keeps( name ) ) return;
+
+    // the size of an array branch has to be written as well
+    auto sizeBegin = leafList.find( '[' );
+    if( sizeBegin != std::string::npos ){
+        std::string sizeName = leafList.substr( sizeBegin + 1, leafList.find( ']' ) - sizeBegin - 1 );
+        if( !_slimmingProfile.keeps( sizeName ) ){
+            throw std::invalid_argument( "ERROR in TreeReader::addOutputBranch: slimming profile '" + _slimmingProfile.name()
+                + "' keeps branch '" + name + "' but not its size '" + sizeName + "'." );
+        }
+    }
+
+    if( stringTools::stringEndsWith( leafList, "/D" ) && _slimmingProfile.narrows( name ) ){
+        _narrowedOutputBranches.push_back( { static_cast< const Double_t* >( address ), std::vector< Float_t >( numberOfValues ) } );
+        std::string narrowedLeafList = leafList.substr( 0, leafList.size() - 1 ) + "F";
+        outputTree->Branch( name.c_str(), _narrowedOutputBranches.back().values.data(), narrowedLeafList.c_str() );
+    } else {
+        outputTree->Branch( name.c_str(), address, leafList.c_str() );
+    }
+}
+
+
+SlimmingProfile TreeReader::slimmingProfileOfCurrentTree() const{
+    if( !_isSlimmedTree ) return SlimmingProfile();
+    const TObject* profileNamePtr = _currentTreePtr->GetUserInfo()->FindObject( SlimmingProfile::userInfoName() );
+    std::vector< std::string > keptBranches;
+    std::vector< std::string > narrowedBranches;
+    for( const auto& branchPtr : *_currentTreePtr->GetListOfBranches() ){
+        const std::string name = branchPtr->GetName();
+        keptBranches.push_back( name );
+        const TLeaf* leafPtr = static_cast< TBranch* >( branchPtr )->GetLeaf( name.c_str() );
+        if( leafPtr != nullptr && std::string( leafPtr->GetTypeName() ) == "Float_t" ){
+            narrowedBranches.push_back( name );
+        }
+    }
+    return SlimmingProfile( profileNamePtr->GetTitle(), keptBranches, {}, narrowedBranches );
+}
+
+
+void TreeReader::fillOutputTree( TTree* outputTree ){
+    for( auto& branch : _narrowedOutputBranches ){
+        std::copy( branch.source, branch.source + branch.values.size(), branch.values.begin() );
+    }
+    outputTree->Fill();
+}
+
+
 void TreeReader::initTree( const bool resetTriggersAndFilters ){
 
     // Set branch addresses and branch pointers
-    checkCurrentTree();
-
-    _currentTreePtr->SetMakeClass(1);
-
-    _currentTreePtr->SetBranchAddress("_runNb", &_runNb, &b__runNb);
-    _currentTreePtr->SetBranchAddress("_lumiBlock", &_lumiBlock, &b__lumiBlock);
-    _currentTreePtr->SetBranchAddress("_eventNb", &_eventNb, &b__eventNb);
-    _currentTreePtr->SetBranchAddress("_nVertex", &_nVertex, &b__nVertex);    
-
-    _currentTreePtr->SetBranchAddress("_passTrigger_e", &_passTrigger_e, &b__passTrigger_e);
-    _currentTreePtr->SetBranchAddress("_passTrigger_ee", &_passTrigger_ee, &b__passTrigger_ee);
-    _currentTreePtr->SetBranchAddress("_passTrigger_eee", &_passTrigger_eee, &b__passTrigger_eee);
-    _currentTreePtr->SetBranchAddress("_passTrigger_em", &_passTrigger_em, &b__passTrigger_em);
-    _currentTreePtr->SetBranchAddress("_passTrigger_m", &_passTrigger_m, &b__passTrigger_m);
-    _currentTreePtr->SetBranchAddress("_passTrigger_eem", &_passTrigger_eem, &b__passTrigger_eem);
-    _currentTreePtr->SetBranchAddress("_passTrigger_mm", &_passTrigger_mm, &b__passTrigger_mm);
-    _currentTreePtr->SetBranchAddress("_passTrigger_emm", &_passTrigger_emm, &b__passTrigger_emm);
-    _currentTreePtr->SetBranchAddress("_passTrigger_mmm", &_passTrigger_mmm, &b__passTrigger_mmm);
-    _currentTreePtr->SetBranchAddress("_passTrigger_et", &_passTrigger_et, &b__passTrigger_et);
-    _currentTreePtr->SetBranchAddress("_passTrigger_mt", &_passTrigger_mt, &b__passTrigger_mt);
-    _currentTreePtr->SetBranchAddress("_passTrigger_FR", &_passTrigger_FR, &b__passTrigger_FR);
-    _currentTreePtr->SetBranchAddress("_passTrigger_FR_iso", &_passTrigger_FR_iso, &b__passTrigger_FR_iso);
-    _currentTreePtr->SetBranchAddress("_passMETFilters", &_passMETFilters, &b__passMETFilters);
-
-    _currentTreePtr->SetBranchAddress("_nL", &_nL, &b__nL);
-    _currentTreePtr->SetBranchAddress("_nMu", &_nMu, &b__nMu);
-    _currentTreePtr->SetBranchAddress("_nEle", &_nEle, &b__nEle);
-    _currentTreePtr->SetBranchAddress("_nLight", &_nLight, &b__nLight);
-    _currentTreePtr->SetBranchAddress("_nTau", &_nTau, &b__nTau);
-    _currentTreePtr->SetBranchAddress("_lPt", _lPt, &b__lPt);
-    _currentTreePtr->SetBranchAddress("_lPtCorr", _lPtCorr, &b__lPtCorr);
-    _currentTreePtr->SetBranchAddress("_lPtScaleUp", _lPtScaleUp, &b__lPtScaleUp);
-    _currentTreePtr->SetBranchAddress("_lPtScaleDown", _lPtScaleDown, &b__lPtScaleDown);
-    _currentTreePtr->SetBranchAddress("_lPtResUp", _lPtResUp, &b__lPtResUp);
-    _currentTreePtr->SetBranchAddress("_lPtResDown", _lPtResDown, &b__lPtResDown);
-    _currentTreePtr->SetBranchAddress("_lEta", _lEta, &b__lEta);
-    _currentTreePtr->SetBranchAddress("_lEtaSC", _lEtaSC, &b__lEtaSC);
-    _currentTreePtr->SetBranchAddress("_lPhi", _lPhi, &b__lPhi);
-    _currentTreePtr->SetBranchAddress("_lE", _lE, &b__lE);
-    _currentTreePtr->SetBranchAddress("_lECorr", _lECorr, &b__lECorr);
-    _currentTreePtr->SetBranchAddress("_lEScaleUp", _lEScaleUp, &b__lEScaleUp);
-    _currentTreePtr->SetBranchAddress("_lEScaleDown", _lEScaleDown, &b__lEScaleDown);
-    _currentTreePtr->SetBranchAddress("_lEResUp", _lEResUp, &b__lEResUp);
-    _currentTreePtr->SetBranchAddress("_lEResDown", _lEResDown, &b__lEResDown);
-    _currentTreePtr->SetBranchAddress("_lFlavor", _lFlavor, &b__lFlavor);
-    _currentTreePtr->SetBranchAddress("_lCharge", _lCharge, &b__lCharge);
-    _currentTreePtr->SetBranchAddress("_dxy", _dxy, &b__dxy);
-    _currentTreePtr->SetBranchAddress("_dz", _dz, &b__dz);
-    _currentTreePtr->SetBranchAddress("_3dIP", _3dIP, &b__3dIP);
-    _currentTreePtr->SetBranchAddress("_3dIPSig", _3dIPSig, &b__3dIPSig);
-    _currentTreePtr->SetBranchAddress("_lElectronSummer16MvaGP", _lElectronSummer16MvaGP, &b__lElectronSummer16MvaGP);
-    _currentTreePtr->SetBranchAddress("_lElectronSummer16MvaHZZ", _lElectronSummer16MvaHZZ, &b__lElectronSummer16MvaHZZ);
-    _currentTreePtr->SetBranchAddress("_lElectronMvaFall17Iso", _lElectronMvaFall17Iso, &b__lElectronMvaFall17Iso);
-    _currentTreePtr->SetBranchAddress("_lElectronMvaFall17NoIso", _lElectronMvaFall17NoIso, &b__lElectronMvaFall17NoIso);
-    _currentTreePtr->SetBranchAddress("_lElectronPassMVAFall17NoIsoWPLoose", _lElectronPassMVAFall17NoIsoWPLoose, &b__lElectronPassMVAFall17NoIsoWPLoose);
-    _currentTreePtr->SetBranchAddress("_lElectronPassMVAFall17NoIsoWP90", _lElectronPassMVAFall17NoIsoWP90, &b__lElectronPassMVAFall17NoIsoWP90);
-    _currentTreePtr->SetBranchAddress("_lElectronPassMVAFall17NoIsoWP80", _lElectronPassMVAFall17NoIsoWP80, &b__lElectronPassMVAFall17NoIsoWP80);
-    _currentTreePtr->SetBranchAddress("_lElectronPassEmu", _lElectronPassEmu, &b__lElectronPassEmu);
-    _currentTreePtr->SetBranchAddress("_lElectronPassConvVeto", _lElectronPassConvVeto, &b__lElectronPassConvVeto);
-    _currentTreePtr->SetBranchAddress("_lElectronChargeConst", _lElectronChargeConst, &b__lElectronChargeConst);
-    _currentTreePtr->SetBranchAddress("_lElectronMissingHits", _lElectronMissingHits, &b__lElectronMissingHits);
-    _currentTreePtr->SetBranchAddress("_lElectronEInvMinusPInv", _lElectronEInvMinusPInv, &b__lElectronEInvMinusPInv);
-    _currentTreePtr->SetBranchAddress("_lElectronHOverE", _lElectronHOverE, &b__lElectronHOverE);
-    _currentTreePtr->SetBranchAddress("_lElectronSigmaIetaIeta", _lElectronSigmaIetaIeta, &b__lElectronSigmaIetaIeta);
-    _currentTreePtr->SetBranchAddress("_leptonMvaTTH", _leptonMvaTTH, &b__leptonMvaTTH);
-    _currentTreePtr->SetBranchAddress("_leptonMvatZq", _leptonMvatZq, &b__leptonMvatZq);
-    _currentTreePtr->SetBranchAddress("_leptonMvaTOP", _leptonMvaTOP, &b__leptonMvaTOP);
-    _currentTreePtr->SetBranchAddress("_leptonMvaTOPUL", _leptonMvaTOPUL, &b__leptonMvaTOPUL);
-    _currentTreePtr->SetBranchAddress("_leptonMvaTOPv2UL", _leptonMvaTOPv2UL, &b__leptonMvaTOPv2UL);
-    _currentTreePtr->SetBranchAddress("_lPOGVeto", _lPOGVeto, &b__lPOGVeto);
-    _currentTreePtr->SetBranchAddress("_lPOGLoose", _lPOGLoose, &b__lPOGLoose);
-    _currentTreePtr->SetBranchAddress("_lPOGMedium", _lPOGMedium, &b__lPOGMedium);
-    _currentTreePtr->SetBranchAddress("_lPOGTight", _lPOGTight, &b__lPOGTight);
-    _currentTreePtr->SetBranchAddress("_relIso", _relIso, &b__relIso);
-    _currentTreePtr->SetBranchAddress("_relIso0p4", _relIso0p4, &b__relIso0p4);
-    _currentTreePtr->SetBranchAddress("_relIso0p4MuDeltaBeta", _relIso0p4MuDeltaBeta, &b__relIso0p4MuDeltaBeta);
-    _currentTreePtr->SetBranchAddress("_miniIso", _miniIso, &b__miniIso);
-    _currentTreePtr->SetBranchAddress("_miniIsoCharged", _miniIsoCharged, &b__miniIsoCharged);
-    _currentTreePtr->SetBranchAddress("_ptRel", _ptRel, &b__ptRel);
-    _currentTreePtr->SetBranchAddress("_ptRatio", _ptRatio, &b__ptRatio);
-    _currentTreePtr->SetBranchAddress("_closestJetCsvV2", _closestJetCsvV2, &b__closestJetCsvV2);
-    _currentTreePtr->SetBranchAddress("_closestJetDeepCsv_b", _closestJetDeepCsv_b, &b__closestJetDeepCsv_b);
-    _currentTreePtr->SetBranchAddress("_closestJetDeepCsv_bb", _closestJetDeepCsv_bb, &b__closestJetDeepCsv_bb);
-    _currentTreePtr->SetBranchAddress("_closestJetDeepFlavor_b", _closestJetDeepFlavor_b, &b__closestJetDeepFlavor_b);
-    _currentTreePtr->SetBranchAddress("_closestJetDeepFlavor_bb", _closestJetDeepFlavor_bb, &b__closestJetDeepFlavor_bb);
-    _currentTreePtr->SetBranchAddress("_closestJetDeepFlavor_lepb", _closestJetDeepFlavor_lepb, &b__closestJetDeepFlavor_lepb);
-    _currentTreePtr->SetBranchAddress("_selectedTrackMult", _selectedTrackMult, &b__selectedTrackMult);
-    _currentTreePtr->SetBranchAddress("_lMuonSegComp", _lMuonSegComp, &b__lMuonSegComp);
-    _currentTreePtr->SetBranchAddress("_lMuonTrackPt", _lMuonTrackPt, &b__lMuonTrackPt);
-    _currentTreePtr->SetBranchAddress("_lMuonTrackPtErr", _lMuonTrackPtErr, &b__lMuonTrackPtErr);
-
-    _currentTreePtr->SetBranchAddress("_nJets", &_nJets, &b__nJets);
-    _currentTreePtr->SetBranchAddress("_jetPt", _jetPt, &b__jetPt);
-    _currentTreePtr->SetBranchAddress("_jetSmearedPt", _jetSmearedPt, &b__jetSmearedPt);
-    _currentTreePtr->SetBranchAddress("_jetSmearedPt_JECDown", _jetSmearedPt_JECDown, &b__jetSmearedPt_JECDown);
-    _currentTreePtr->SetBranchAddress("_jetSmearedPt_JECUp", _jetSmearedPt_JECUp, &b__jetSmearedPt_JECUp);
-    _currentTreePtr->SetBranchAddress("_jetSmearedPt_JERDown", _jetSmearedPt_JERDown, &b__jetSmearedPt_JERDown);
-    _currentTreePtr->SetBranchAddress("_jetSmearedPt_JERUp", _jetSmearedPt_JERUp, &b__jetSmearedPt_JERUp);
-    _currentTreePtr->SetBranchAddress("_jetPt_JECUp", _jetPt_JECUp, &b__jetPt_JECUp);
-    _currentTreePtr->SetBranchAddress("_jetPt_JECDown", _jetPt_JECDown, &b__jetPt_JECDown);
-    _currentTreePtr->SetBranchAddress("_jetEta", _jetEta, &b__jetEta);
-    _currentTreePtr->SetBranchAddress("_jetPhi", _jetPhi, &b__jetPhi);
-    _currentTreePtr->SetBranchAddress("_jetE", _jetE, &b__jetE);
-    _currentTreePtr->SetBranchAddress("_jetPt_Uncorrected",_jetPt_Uncorrected, &b__jetPt_Uncorrected);
-    _currentTreePtr->SetBranchAddress("_jetPt_L1", _jetPt_L1, &b__jetPt_L1);
-    _currentTreePtr->SetBranchAddress("_jetPt_L2", _jetPt_L2, &b__jetPt_L2);
-    _currentTreePtr->SetBranchAddress("_jetPt_L3", _jetPt_L3, &b__jetPt_L3);
-    _currentTreePtr->SetBranchAddress("_jetCsvV2", _jetCsvV2, &b__jetCsvV2);
-    _currentTreePtr->SetBranchAddress("_jetDeepCsv_udsg", _jetDeepCsv_udsg, &b__jetDeepCsv_udsg);
-    _currentTreePtr->SetBranchAddress("_jetDeepCsv_b", _jetDeepCsv_b, &b__jetDeepCsv_b);
-    _currentTreePtr->SetBranchAddress("_jetDeepCsv_c", _jetDeepCsv_c, &b__jetDeepCsv_c);
-    _currentTreePtr->SetBranchAddress("_jetDeepCsv_bb", _jetDeepCsv_bb, &b__jetDeepCsv_bb);
-    _currentTreePtr->SetBranchAddress("_jetDeepFlavor_b", _jetDeepFlavor_b, &b__jetDeepFlavor_b);
-    _currentTreePtr->SetBranchAddress("_jetDeepFlavor_bb", _jetDeepFlavor_bb, &b__jetDeepFlavor_bb);
-    _currentTreePtr->SetBranchAddress("_jetDeepFlavor_lepb", _jetDeepFlavor_lepb, &b__jetDeepFlavor_lepb);
-    _currentTreePtr->SetBranchAddress("_jetHadronFlavor", _jetHadronFlavor, &b__jetHadronFlavor);
-    _currentTreePtr->SetBranchAddress("_jetIsTight", _jetIsTight, &b__jetIsTight);
-    _currentTreePtr->SetBranchAddress("_jetIsTightLepVeto", _jetIsTightLepVeto, &b__jetIsTightLepVeto);
-    _currentTreePtr->SetBranchAddress("_jetNeutralHadronFraction", _jetNeutralHadronFraction, &b__jetNeutralHadronFraction);
-    _currentTreePtr->SetBranchAddress("_jetChargedHadronFraction", _jetChargedHadronFraction, &b__jetChargedHadronFraction);
-    _currentTreePtr->SetBranchAddress("_jetNeutralEmFraction", _jetNeutralEmFraction, &b__jetNeutralEmFraction);
-    _currentTreePtr->SetBranchAddress("_jetChargedEmFraction", _jetChargedEmFraction, &b__jetChargedEmFraction);
-    _currentTreePtr->SetBranchAddress("_jetHFHadronFraction", _jetHFHadronFraction, &b__jetHFHadronFraction);
-    _currentTreePtr->SetBranchAddress("_jetHFEmFraction", _jetHFEmFraction, &b__jetHFEmFraction);
-
-    _currentTreePtr->SetBranchAddress("_met", &_met, &b__met);
-    _currentTreePtr->SetBranchAddress("_met_JECDown", &_met_JECDown, &b__met_JECDown);
-    _currentTreePtr->SetBranchAddress("_met_JECUp", &_met_JECUp, &b__met_JECUp);
-    _currentTreePtr->SetBranchAddress("_met_UnclDown", &_met_UnclDown, &b__met_UnclDown);
-    _currentTreePtr->SetBranchAddress("_met_UnclUp", &_met_UnclUp, &b__met_UnclUp);
-    _currentTreePtr->SetBranchAddress("_metPhi", &_metPhi, &b__metPhi);
-    _currentTreePtr->SetBranchAddress("_metPhi_JECDown", &_metPhi_JECDown, &b__metPhi_JECDown);
-    _currentTreePtr->SetBranchAddress("_metPhi_JECUp", &_metPhi_JECUp, &b__metPhi_JECUp);
-    _currentTreePtr->SetBranchAddress("_metPhi_UnclDown", &_metPhi_UnclDown, &b__metPhi_UnclDown);
-    _currentTreePtr->SetBranchAddress("_metPhi_UnclUp", &_metPhi_UnclUp, &b__metPhi_UnclUp);
-    _currentTreePtr->SetBranchAddress("_metSignificance", &_metSignificance, &b__metSignificance);
+    // (when reading from a columnar cache the variables are only bound to the columns of the cache)
+    if( !_columnarCachePtr ){
+        checkCurrentTree();
+        _currentTreePtr->SetMakeClass(1);
+    }
+    _narrowedInputBranches.clear();
+    _narrowedInputBranchIndices.clear();
+    _inputColumns.clear();
+
+    setInputBranchAddress("_runNb", &_runNb, &b__runNb);
+    setInputBranchAddress("_lumiBlock", &_lumiBlock, &b__lumiBlock);
+    setInputBranchAddress("_eventNb", &_eventNb, &b__eventNb);
+    setInputBranchAddress("_nVertex", &_nVertex, &b__nVertex);    
+
+    setInputBranchAddress("_passTrigger_e", &_passTrigger_e, &b__passTrigger_e);
+    setInputBranchAddress("_passTrigger_ee", &_passTrigger_ee, &b__passTrigger_ee);
+    setInputBranchAddress("_passTrigger_eee", &_passTrigger_eee, &b__passTrigger_eee);
+    setInputBranchAddress("_passTrigger_em", &_passTrigger_em, &b__passTrigger_em);
+    setInputBranchAddress("_passTrigger_m", &_passTrigger_m, &b__passTrigger_m);
+    setInputBranchAddress("_passTrigger_eem", &_passTrigger_eem, &b__passTrigger_eem);
+    setInputBranchAddress("_passTrigger_mm", &_passTrigger_mm, &b__passTrigger_mm);
+    setInputBranchAddress("_passTrigger_emm", &_passTrigger_emm, &b__passTrigger_emm);
+    setInputBranchAddress("_passTrigger_mmm", &_passTrigger_mmm, &b__passTrigger_mmm);
+    setInputBranchAddress("_passTrigger_et", &_passTrigger_et, &b__passTrigger_et);
+    setInputBranchAddress("_passTrigger_mt", &_passTrigger_mt, &b__passTrigger_mt);
+    setInputBranchAddress("_passTrigger_FR", &_passTrigger_FR, &b__passTrigger_FR);
+    setInputBranchAddress("_passTrigger_FR_iso", &_passTrigger_FR_iso, &b__passTrigger_FR_iso);
+    setInputBranchAddress("_passMETFilters", &_passMETFilters, &b__passMETFilters);
+
+    setInputBranchAddress("_nL", &_nL, &b__nL);
+    setInputBranchAddress("_nMu", &_nMu, &b__nMu);
+    setInputBranchAddress("_nEle", &_nEle, &b__nEle);
+    setInputBranchAddress("_nLight", &_nLight, &b__nLight);
+    setInputBranchAddress("_nTau", &_nTau, &b__nTau);
+    setInputBranchAddress("_lPt", _lPt, &b__lPt);
+    setInputBranchAddress("_lPtCorr", _lPtCorr, &b__lPtCorr);
+    setInputBranchAddress("_lPtScaleUp", _lPtScaleUp, &b__lPtScaleUp);
+    setInputBranchAddress("_lPtScaleDown", _lPtScaleDown, &b__lPtScaleDown);
+    setInputBranchAddress("_lPtResUp", _lPtResUp, &b__lPtResUp);
+    setInputBranchAddress("_lPtResDown", _lPtResDown, &b__lPtResDown);
+    setInputBranchAddress("_lEta", _lEta, &b__lEta);
+    setInputBranchAddress("_lEtaSC", _lEtaSC, &b__lEtaSC);
+    setInputBranchAddress("_lPhi", _lPhi, &b__lPhi);
+    setInputBranchAddress("_lE", _lE, &b__lE);
+    setInputBranchAddress("_lECorr", _lECorr, &b__lECorr);
+    setInputBranchAddress("_lEScaleUp", _lEScaleUp, &b__lEScaleUp);
+    setInputBranchAddress("_lEScaleDown", _lEScaleDown, &b__lEScaleDown);
+    setInputBranchAddress("_lEResUp", _lEResUp, &b__lEResUp);
+    setInputBranchAddress("_lEResDown", _lEResDown, &b__lEResDown);
+    setInputBranchAddress("_lFlavor", _lFlavor, &b__lFlavor);
+    setInputBranchAddress("_lCharge", _lCharge, &b__lCharge);
+    setInputBranchAddress("_dxy", _dxy, &b__dxy);
+    setInputBranchAddress("_dz", _dz, &b__dz);
+    setInputBranchAddress("_3dIP", _3dIP, &b__3dIP);
+    setInputBranchAddress("_3dIPSig", _3dIPSig, &b__3dIPSig);
+    setInputBranchAddress("_lElectronSummer16MvaGP", _lElectronSummer16MvaGP, &b__lElectronSummer16MvaGP);
+    setInputBranchAddress("_lElectronSummer16MvaHZZ", _lElectronSummer16MvaHZZ, &b__lElectronSummer16MvaHZZ);
+    setInputBranchAddress("_lElectronMvaFall17Iso", _lElectronMvaFall17Iso, &b__lElectronMvaFall17Iso);
+    setInputBranchAddress("_lElectronMvaFall17NoIso", _lElectronMvaFall17NoIso, &b__lElectronMvaFall17NoIso);
+    setInputBranchAddress("_lElectronPassMVAFall17NoIsoWPLoose", _lElectronPassMVAFall17NoIsoWPLoose, &b__lElectronPassMVAFall17NoIsoWPLoose);
+    setInputBranchAddress("_lElectronPassMVAFall17NoIsoWP90", _lElectronPassMVAFall17NoIsoWP90, &b__lElectronPassMVAFall17NoIsoWP90);
+    setInputBranchAddress("_lElectronPassMVAFall17NoIsoWP80", _lElectronPassMVAFall17NoIsoWP80, &b__lElectronPassMVAFall17NoIsoWP80);
+    setInputBranchAddress("_lElectronPassEmu", _lElectronPassEmu, &b__lElectronPassEmu);
+    setInputBranchAddress("_lElectronPassConvVeto", _lElectronPassConvVeto, &b__lElectronPassConvVeto);
+    setInputBranchAddress("_lElectronChargeConst", _lElectronChargeConst, &b__lElectronChargeConst);
+    setInputBranchAddress("_lElectronMissingHits", _lElectronMissingHits, &b__lElectronMissingHits);
+    setInputBranchAddress("_lElectronEInvMinusPInv", _lElectronEInvMinusPInv, &b__lElectronEInvMinusPInv);
+    setInputBranchAddress("_lElectronHOverE", _lElectronHOverE, &b__lElectronHOverE);
+    setInputBranchAddress("_lElectronSigmaIetaIeta", _lElectronSigmaIetaIeta, &b__lElectronSigmaIetaIeta);
+    setInputBranchAddress("_leptonMvaTTH", _leptonMvaTTH, &b__leptonMvaTTH);
+    setInputBranchAddress("_leptonMvatZq", _leptonMvatZq, &b__leptonMvatZq);
+    setInputBranchAddress("_leptonMvaTOP", _leptonMvaTOP, &b__leptonMvaTOP);
+    setInputBranchAddress("_leptonMvaTOPUL", _leptonMvaTOPUL, &b__leptonMvaTOPUL);
+    setInputBranchAddress("_leptonMvaTOPv2UL", _leptonMvaTOPv2UL, &b__leptonMvaTOPv2UL);
+    setInputBranchAddress("_lPOGVeto", _lPOGVeto, &b__lPOGVeto);
+    setInputBranchAddress("_lPOGLoose", _lPOGLoose, &b__lPOGLoose);
+    setInputBranchAddress("_lPOGMedium", _lPOGMedium, &b__lPOGMedium);
+    setInputBranchAddress("_lPOGTight", _lPOGTight, &b__lPOGTight);
+    setInputBranchAddress("_relIso", _relIso, &b__relIso);
+    setInputBranchAddress("_relIso0p4", _relIso0p4, &b__relIso0p4);
+    setInputBranchAddress("_relIso0p4MuDeltaBeta", _relIso0p4MuDeltaBeta, &b__relIso0p4MuDeltaBeta);
+    setInputBranchAddress("_miniIso", _miniIso, &b__miniIso);
+    setInputBranchAddress("_miniIsoCharged", _miniIsoCharged, &b__miniIsoCharged);
+    setInputBranchAddress("_ptRel", _ptRel, &b__ptRel);
+    setInputBranchAddress("_ptRatio", _ptRatio, &b__ptRatio);
+    setInputBranchAddress("_closestJetCsvV2", _closestJetCsvV2, &b__closestJetCsvV2);
+    setInputBranchAddress("_closestJetDeepCsv_b", _closestJetDeepCsv_b, &b__closestJetDeepCsv_b);
+    setInputBranchAddress("_closestJetDeepCsv_bb", _closestJetDeepCsv_bb, &b__closestJetDeepCsv_bb);
+    setInputBranchAddress("_closestJetDeepFlavor_b", _closestJetDeepFlavor_b, &b__closestJetDeepFlavor_b);
+    setInputBranchAddress("_closestJetDeepFlavor_bb", _closestJetDeepFlavor_bb, &b__closestJetDeepFlavor_bb);
+    setInputBranchAddress("_closestJetDeepFlavor_lepb", _closestJetDeepFlavor_lepb, &b__closestJetDeepFlavor_lepb);
+    setInputBranchAddress("_selectedTrackMult", _selectedTrackMult, &b__selectedTrackMult);
+    setInputBranchAddress("_lMuonSegComp", _lMuonSegComp, &b__lMuonSegComp);
+    setInputBranchAddress("_lMuonTrackPt", _lMuonTrackPt, &b__lMuonTrackPt);
+    setInputBranchAddress("_lMuonTrackPtErr", _lMuonTrackPtErr, &b__lMuonTrackPtErr);
+
+    setInputBranchAddress("_nJets", &_nJets, &b__nJets);
+    setInputBranchAddress("_jetPt", _jetPt, &b__jetPt);
+    setInputBranchAddress("_jetSmearedPt", _jetSmearedPt, &b__jetSmearedPt);
+    setInputBranchAddress("_jetSmearedPt_JECDown", _jetSmearedPt_JECDown, &b__jetSmearedPt_JECDown);
+    setInputBranchAddress("_jetSmearedPt_JECUp", _jetSmearedPt_JECUp, &b__jetSmearedPt_JECUp);
+    setInputBranchAddress("_jetSmearedPt_JERDown", _jetSmearedPt_JERDown, &b__jetSmearedPt_JERDown);
+    setInputBranchAddress("_jetSmearedPt_JERUp", _jetSmearedPt_JERUp, &b__jetSmearedPt_JERUp);
+    setInputBranchAddress("_jetPt_JECUp", _jetPt_JECUp, &b__jetPt_JECUp);
+    setInputBranchAddress("_jetPt_JECDown", _jetPt_JECDown, &b__jetPt_JECDown);
+    setInputBranchAddress("_jetEta", _jetEta, &b__jetEta);
+    setInputBranchAddress("_jetPhi", _jetPhi, &b__jetPhi);
+    setInputBranchAddress("_jetE", _jetE, &b__jetE);
+    setInputBranchAddress("_jetPt_Uncorrected",_jetPt_Uncorrected, &b__jetPt_Uncorrected);
+    setInputBranchAddress("_jetPt_L1", _jetPt_L1, &b__jetPt_L1);
+    setInputBranchAddress("_jetPt_L2", _jetPt_L2, &b__jetPt_L2);
+    setInputBranchAddress("_jetPt_L3", _jetPt_L3, &b__jetPt_L3);
+    setInputBranchAddress("_jetCsvV2", _jetCsvV2, &b__jetCsvV2);
+    setInputBranchAddress("_jetDeepCsv_udsg", _jetDeepCsv_udsg, &b__jetDeepCsv_udsg);
+    setInputBranchAddress("_jetDeepCsv_b", _jetDeepCsv_b, &b__jetDeepCsv_b);
+    setInputBranchAddress("_jetDeepCsv_c", _jetDeepCsv_c, &b__jetDeepCsv_c);
+    setInputBranchAddress("_jetDeepCsv_bb", _jetDeepCsv_bb, &b__jetDeepCsv_bb);
+    setInputBranchAddress("_jetDeepFlavor_b", _jetDeepFlavor_b, &b__jetDeepFlavor_b);
+    setInputBranchAddress("_jetDeepFlavor_bb", _jetDeepFlavor_bb, &b__jetDeepFlavor_bb);
+    setInputBranchAddress("_jetDeepFlavor_lepb", _jetDeepFlavor_lepb, &b__jetDeepFlavor_lepb);
+    setInputBranchAddress("_jetHadronFlavor", _jetHadronFlavor, &b__jetHadronFlavor);
+    setInputBranchAddress("_jetIsTight", _jetIsTight, &b__jetIsTight);
+    setInputBranchAddress("_jetIsTightLepVeto", _jetIsTightLepVeto, &b__jetIsTightLepVeto);
+    setInputBranchAddress("_jetNeutralHadronFraction", _jetNeutralHadronFraction, &b__jetNeutralHadronFraction);
+    setInputBranchAddress("_jetChargedHadronFraction", _jetChargedHadronFraction, &b__jetChargedHadronFraction);
+    setInputBranchAddress("_jetNeutralEmFraction", _jetNeutralEmFraction, &b__jetNeutralEmFraction);
+    setInputBranchAddress("_jetChargedEmFraction", _jetChargedEmFraction, &b__jetChargedEmFraction);
+    setInputBranchAddress("_jetHFHadronFraction", _jetHFHadronFraction, &b__jetHFHadronFraction);
+    setInputBranchAddress("_jetHFEmFraction", _jetHFEmFraction, &b__jetHFEmFraction);
+
+    setInputBranchAddress("_met", &_met, &b__met);
+    setInputBranchAddress("_met_JECDown", &_met_JECDown, &b__met_JECDown);
+    setInputBranchAddress("_met_JECUp", &_met_JECUp, &b__met_JECUp);
+    setInputBranchAddress("_met_UnclDown", &_met_UnclDown, &b__met_UnclDown);
+    setInputBranchAddress("_met_UnclUp", &_met_UnclUp, &b__met_UnclUp);
+    setInputBranchAddress("_metPhi", &_metPhi, &b__metPhi);
+    setInputBranchAddress("_metPhi_JECDown", &_metPhi_JECDown, &b__metPhi_JECDown);
+    setInputBranchAddress("_metPhi_JECUp", &_metPhi_JECUp, &b__metPhi_JECUp);
+    setInputBranchAddress("_metPhi_UnclDown", &_metPhi_UnclDown, &b__metPhi_UnclDown);
+    setInputBranchAddress("_metPhi_UnclUp", &_metPhi_UnclUp, &b__metPhi_UnclUp);
+    setInputBranchAddress("_metSignificance", &_metSignificance, &b__metSignificance);
 
     if( containsTauInfo() ){
-	_currentTreePtr->SetBranchAddress("_tauDecayMode", _tauDecayMode, &b__tauDecayMode);
-        _currentTreePtr->SetBranchAddress("_decayModeFinding", _decayModeFinding, &b__decayModeFinding);
-	_currentTreePtr->SetBranchAddress("_decayModeFindingNew", _decayModeFindingNew, &b__decayModeFindingNew);
-	_currentTreePtr->SetBranchAddress("_tauMuonVetoLoose", _tauMuonVetoLoose, &b__tauMuonVetoLoose);
-	_currentTreePtr->SetBranchAddress("_tauMuonVetoTight", _tauMuonVetoTight, &b__tauMuonVetoTight);
-	_currentTreePtr->SetBranchAddress("_tauEleVetoVLoose", _tauEleVetoVLoose, &b__tauEleVetoVLoose);
-	_currentTreePtr->SetBranchAddress("_tauEleVetoLoose", _tauEleVetoLoose, &b__tauEleVetoLoose);
-	_currentTreePtr->SetBranchAddress("_tauEleVetoMedium", _tauEleVetoMedium, &b__tauEleVetoMedium);
-	_currentTreePtr->SetBranchAddress("_tauEleVetoTight", _tauEleVetoTight, &b__tauEleVetoTight);
-	_currentTreePtr->SetBranchAddress("_tauEleVetoVTight", _tauEleVetoVTight, &b__tauEleVetoVTight);
-	_currentTreePtr->SetBranchAddress("_tauPOGVLoose2015", _tauPOGVLoose2015, &b__tauPOGVLoose2015);
-	_currentTreePtr->SetBranchAddress("_tauPOGLoose2015", _tauPOGLoose2015, &b__tauPOGLoose2015);
-	_currentTreePtr->SetBranchAddress("_tauPOGMedium2015", _tauPOGMedium2015, &b__tauPOGMedium2015);
-	_currentTreePtr->SetBranchAddress("_tauPOGTight2015", _tauPOGTight2015, &b__tauPOGTight2015);
-	_currentTreePtr->SetBranchAddress("_tauPOGVTight2015", _tauPOGVTight2015, &b__tauPOGVTight2015);
-	_currentTreePtr->SetBranchAddress("_tauVLooseMvaNew2015", _tauVLooseMvaNew2015, &b__tauVLooseMvaNew2015);
-	_currentTreePtr->SetBranchAddress("_tauLooseMvaNew2015", _tauLooseMvaNew2015, &b__tauLooseMvaNew2015);
-	_currentTreePtr->SetBranchAddress("_tauMediumMvaNew2015", _tauMediumMvaNew2015, &b__tauMediumMvaNew2015);
-	_currentTreePtr->SetBranchAddress("_tauTightMvaNew2015", _tauTightMvaNew2015, &b__tauTightMvaNew2015);
-	_currentTreePtr->SetBranchAddress("_tauVTightMvaNew2015", _tauVTightMvaNew2015, &b__tauVTightMvaNew2015);
-	_currentTreePtr->SetBranchAddress("_tauPOGVVLoose2017v2", _tauPOGVVLoose2017v2, &b__tauPOGVVLoose2017v2);
-	_currentTreePtr->SetBranchAddress("_tauPOGVTight2017v2", _tauPOGVTight2017v2, &b__tauPOGVTight2017v2);
-	_currentTreePtr->SetBranchAddress("_tauPOGVVTight2017v2", _tauPOGVVTight2017v2, &b__tauPOGVVTight2017v2);
-	_currentTreePtr->SetBranchAddress("_tauVLooseMvaNew2017v2", _tauVLooseMvaNew2017v2, &b__tauVLooseMvaNew2017v2);
-	_currentTreePtr->SetBranchAddress("_tauLooseMvaNew2017v2", _tauLooseMvaNew2017v2, &b__tauLooseMvaNew2017v2);
-	_currentTreePtr->SetBranchAddress("_tauMediumMvaNew2017v2", _tauMediumMvaNew2017v2, &b__tauMediumMvaNew2017v2);
-	_currentTreePtr->SetBranchAddress("_tauTightMvaNew2017v2", _tauTightMvaNew2017v2, &b__tauTightMvaNew2017v2);
-	_currentTreePtr->SetBranchAddress("_tauVTightMvaNew2017v2", _tauVTightMvaNew2017v2, &b__tauVTightMvaNew2017v2);
+	setInputBranchAddress("_tauDecayMode", _tauDecayMode, &b__tauDecayMode);
+        setInputBranchAddress("_decayModeFinding", _decayModeFinding, &b__decayModeFinding);
+	setInputBranchAddress("_decayModeFindingNew", _decayModeFindingNew, &b__decayModeFindingNew);
+	setInputBranchAddress("_tauMuonVetoLoose", _tauMuonVetoLoose, &b__tauMuonVetoLoose);
+	setInputBranchAddress("_tauMuonVetoTight", _tauMuonVetoTight, &b__tauMuonVetoTight);
+	setInputBranchAddress("_tauEleVetoVLoose", _tauEleVetoVLoose, &b__tauEleVetoVLoose);
+	setInputBranchAddress("_tauEleVetoLoose", _tauEleVetoLoose, &b__tauEleVetoLoose);
+	setInputBranchAddress("_tauEleVetoMedium", _tauEleVetoMedium, &b__tauEleVetoMedium);
+	setInputBranchAddress("_tauEleVetoTight", _tauEleVetoTight, &b__tauEleVetoTight);
+	setInputBranchAddress("_tauEleVetoVTight", _tauEleVetoVTight, &b__tauEleVetoVTight);
+	setInputBranchAddress("_tauPOGVLoose2015", _tauPOGVLoose2015, &b__tauPOGVLoose2015);
+	setInputBranchAddress("_tauPOGLoose2015", _tauPOGLoose2015, &b__tauPOGLoose2015);
+	setInputBranchAddress("_tauPOGMedium2015", _tauPOGMedium2015, &b__tauPOGMedium2015);
+	setInputBranchAddress("_tauPOGTight2015", _tauPOGTight2015, &b__tauPOGTight2015);
+	setInputBranchAddress("_tauPOGVTight2015", _tauPOGVTight2015, &b__tauPOGVTight2015);
+	setInputBranchAddress("_tauVLooseMvaNew2015", _tauVLooseMvaNew2015, &b__tauVLooseMvaNew2015);
+	setInputBranchAddress("_tauLooseMvaNew2015", _tauLooseMvaNew2015, &b__tauLooseMvaNew2015);
+	setInputBranchAddress("_tauMediumMvaNew2015", _tauMediumMvaNew2015, &b__tauMediumMvaNew2015);
+	setInputBranchAddress("_tauTightMvaNew2015", _tauTightMvaNew2015, &b__tauTightMvaNew2015);
+	setInputBranchAddress("_tauVTightMvaNew2015", _tauVTightMvaNew2015, &b__tauVTightMvaNew2015);
+	setInputBranchAddress("_tauPOGVVLoose2017v2", _tauPOGVVLoose2017v2, &b__tauPOGVVLoose2017v2);
+	setInputBranchAddress("_tauPOGVTight2017v2", _tauPOGVTight2017v2, &b__tauPOGVTight2017v2);
+	setInputBranchAddress("_tauPOGVVTight2017v2", _tauPOGVVTight2017v2, &b__tauPOGVVTight2017v2);
+	setInputBranchAddress("_tauVLooseMvaNew2017v2", _tauVLooseMvaNew2017v2, &b__tauVLooseMvaNew2017v2);
+	setInputBranchAddress("_tauLooseMvaNew2017v2", _tauLooseMvaNew2017v2, &b__tauLooseMvaNew2017v2);
+	setInputBranchAddress("_tauMediumMvaNew2017v2", _tauMediumMvaNew2017v2, &b__tauMediumMvaNew2017v2);
+	setInputBranchAddress("_tauTightMvaNew2017v2", _tauTightMvaNew2017v2, &b__tauTightMvaNew2017v2);
+	setInputBranchAddress("_tauVTightMvaNew2017v2", _tauVTightMvaNew2017v2, &b__tauVTightMvaNew2017v2);
     }
     
     if( containsGeneratorInfo() ){
-        _currentTreePtr->SetBranchAddress("_weight", &_weight, &b__weight);
-        _currentTreePtr->SetBranchAddress("_nLheWeights", &_nLheWeights, &b__nLheWeights);
-        _currentTreePtr->SetBranchAddress("_lheWeight", _lheWeight, &b__lheWeight);
-        _currentTreePtr->SetBranchAddress("_nPsWeights", &_nPsWeights, &b__nPsWeights);
-        _currentTreePtr->SetBranchAddress("_psWeight", _psWeight, &b__psWeight);
-        _currentTreePtr->SetBranchAddress("_nTrueInt", &_nTrueInt, &b__nTrueInt);
-        _currentTreePtr->SetBranchAddress("_lheHTIncoming", &_lheHTIncoming, &b__lheHTIncoming);
-        _currentTreePtr->SetBranchAddress("_lIsPrompt", _lIsPrompt, &b__lIsPrompt);
-        _currentTreePtr->SetBranchAddress("_lMatchPdgId", _lMatchPdgId, &b__lMatchPdgId);
-        _currentTreePtr->SetBranchAddress("_lMatchCharge", _lMatchCharge, &b__lMatchCharge);
-        _currentTreePtr->SetBranchAddress("_lMomPdgId",  _lMomPdgId, &b__lMomPdgId);
-        _currentTreePtr->SetBranchAddress("_lProvenance", _lProvenance, &b__lProvenance);
-        _currentTreePtr->SetBranchAddress("_lProvenanceCompressed", _lProvenanceCompressed, &b__lProvenanceCompressed);
-        _currentTreePtr->SetBranchAddress("_lProvenanceConversion", _lProvenanceConversion, &b__lProvenanceConversion);
-        _currentTreePtr->SetBranchAddress("_ttgEventType", &_ttgEventType, &b__ttgEventType);
-        _currentTreePtr->SetBranchAddress("_zgEventType", &_zgEventType, &b__zgEventType);
+        setInputBranchAddress("_weight", &_weight, &b__weight);
+        setInputBranchAddress("_nLheWeights", &_nLheWeights, &b__nLheWeights);
+        setInputBranchAddress("_lheWeight", _lheWeight, &b__lheWeight);
+        setInputBranchAddress("_nPsWeights", &_nPsWeights, &b__nPsWeights);
+        setInputBranchAddress("_psWeight", _psWeight, &b__psWeight);
+        setInputBranchAddress("_nTrueInt", &_nTrueInt, &b__nTrueInt);
+        setInputBranchAddress("_lheHTIncoming", &_lheHTIncoming, &b__lheHTIncoming);
+        setInputBranchAddress("_lIsPrompt", _lIsPrompt, &b__lIsPrompt);
+        setInputBranchAddress("_lMatchPdgId", _lMatchPdgId, &b__lMatchPdgId);
+        setInputBranchAddress("_lMatchCharge", _lMatchCharge, &b__lMatchCharge);
+        setInputBranchAddress("_lMomPdgId",  _lMomPdgId, &b__lMomPdgId);
+        setInputBranchAddress("_lProvenance", _lProvenance, &b__lProvenance);
+        setInputBranchAddress("_lProvenanceCompressed", _lProvenanceCompressed, &b__lProvenanceCompressed);
+        setInputBranchAddress("_lProvenanceConversion", _lProvenanceConversion, &b__lProvenanceConversion);
+        setInputBranchAddress("_ttgEventType", &_ttgEventType, &b__ttgEventType);
+        setInputBranchAddress("_zgEventType", &_zgEventType, &b__zgEventType);
     }
 
     if( containsGenParticles() ){
-        _currentTreePtr->SetBranchAddress("_gen_met", &_gen_met, &b__gen_met);
-        _currentTreePtr->SetBranchAddress("_gen_metPhi", &_gen_metPhi, &b__gen_metPhi);
-        _currentTreePtr->SetBranchAddress("_gen_nL", &_gen_nL, &b__gen_nL);
-        _currentTreePtr->SetBranchAddress("_gen_lPt", _gen_lPt, &b__gen_lPt);
-        _currentTreePtr->SetBranchAddress("_gen_lEta", _gen_lEta, &b__gen_lEta);
-        _currentTreePtr->SetBranchAddress("_gen_lPhi", _gen_lPhi, &b__gen_lPhi);
-        _currentTreePtr->SetBranchAddress("_gen_lE", _gen_lE, &b__gen_lE);
-        _currentTreePtr->SetBranchAddress("_gen_lFlavor", _gen_lFlavor, &b__gen_lFlavor);
-        _currentTreePtr->SetBranchAddress("_gen_lCharge", _gen_lCharge, &b__gen_lCharge);
-        _currentTreePtr->SetBranchAddress("_gen_lMomPdg", _gen_lMomPdg, &b__gen_lMomPdg);
-        _currentTreePtr->SetBranchAddress("_gen_lIsPrompt", _gen_lIsPrompt, &b__gen_lIsPrompt);
+        setInputBranchAddress("_gen_met", &_gen_met, &b__gen_met);
+        setInputBranchAddress("_gen_metPhi", &_gen_metPhi, &b__gen_metPhi);
+        setInputBranchAddress("_gen_nL", &_gen_nL, &b__gen_nL);
+        setInputBranchAddress("_gen_lPt", _gen_lPt, &b__gen_lPt);
+        setInputBranchAddress("_gen_lEta", _gen_lEta, &b__gen_lEta);
+        setInputBranchAddress("_gen_lPhi", _gen_lPhi, &b__gen_lPhi);
+        setInputBranchAddress("_gen_lE", _gen_lE, &b__gen_lE);
+        setInputBranchAddress("_gen_lFlavor", _gen_lFlavor, &b__gen_lFlavor);
+        setInputBranchAddress("_gen_lCharge", _gen_lCharge, &b__gen_lCharge);
+        setInputBranchAddress("_gen_lMomPdg", _gen_lMomPdg, &b__gen_lMomPdg);
+        setInputBranchAddress("_gen_lIsPrompt", _gen_lIsPrompt, &b__gen_lIsPrompt);
     }
 
     if( isMC() ){
-        _currentTreePtr->SetBranchAddress("_prefireWeight", &_prefireWeight, &b__prefireWeight);
-        _currentTreePtr->SetBranchAddress("_prefireWeightDown", &_prefireWeightDown, &b__prefireWeightDown);
-        _currentTreePtr->SetBranchAddress("_prefireWeightUp", &_prefireWeightUp, &b__prefireWeightUp);
+        setInputBranchAddress("_prefireWeight", &_prefireWeight, &b__prefireWeight);
+        setInputBranchAddress("_prefireWeightDown", &_prefireWeightDown, &b__prefireWeightDown);
+        setInputBranchAddress("_prefireWeightUp", &_prefireWeightUp, &b__prefireWeightUp);
     }
 
     if( containsSusyMassInfo() ){
-	_currentTreePtr->SetBranchAddress("_mChi1", &_mChi1, &b__mChi1);
-	_currentTreePtr->SetBranchAddress("_mChi2", &_mChi2, &b__mChi2);
+	setInputBranchAddress("_mChi1", &_mChi1, &b__mChi1);
+	setInputBranchAddress("_mChi2", &_mChi2, &b__mChi2);
     }
 
     //add all individually stored triggers 
     // always reset triggers instead of rare case of combining primary datasets 
     // to prevent invalidating addresses set by setOutputTree
     if( resetTriggersAndFilters || _triggerMap.empty() ){
-        initializeTriggerMap( _currentTreePtr );
+        initializeTriggerMap();
+    }
+    for( auto& trigger : _triggerMap ){
+        setInputBranchAddress( trigger.first.c_str(), &trigger.second, &b__triggerMap[ trigger.first ] );
     }
-    setMapBranchAddresses( _currentTreePtr, _triggerMap, b__triggerMap );
 
     //add all individually stored MET filters
     // always reset filters instead of rare case of combining primary datasets 
     // to prevent invalidating addresses set by setOutputTree
     if( resetTriggersAndFilters || _MetFilterMap.empty() ){
-        initializeMetFilterMap( _currentTreePtr );
-    }
-    setMapBranchAddresses( _currentTreePtr, _MetFilterMap, b__MetFilterMap );
-
-    // add split JEC uncertainties
-    initializeJecSourcesMaps( _currentTreePtr );
-    setMapBranchAddresses( _currentTreePtr, _jetPt_JECSourcesUp, b__jetPt_JECSourcesUp );
-    setMapBranchAddresses( _currentTreePtr, _jetPt_JECSourcesDown, b__jetPt_JECSourcesDown );
-    setMapBranchAddresses( _currentTreePtr, _jetSmearedPt_JECSourcesUp, b__jetSmearedPt_JECSourcesUp );
-    setMapBranchAddresses( _currentTreePtr, _jetSmearedPt_JECSourcesDown, b__jetSmearedPt_JECSourcesDown );
-    setMapBranchAddresses( _currentTreePtr, _corrMETx_JECSourcesUp, b__corrMETx_JECSourcesUp );
-    setMapBranchAddresses( _currentTreePtr, _corrMETx_JECSourcesDown, b__corrMETx_JECSourcesDown );
-    setMapBranchAddresses( _currentTreePtr, _corrMETy_JECSourcesUp, b__corrMETy_JECSourcesUp );
-    setMapBranchAddresses( _currentTreePtr, _corrMETy_JECSourcesDown, b__corrMETy_JECSourcesDown );
-    initializeJecSourcesGroupedMaps( _currentTreePtr );
-    setMapBranchAddresses( _currentTreePtr, _jetPt_JECGroupedUp, b__jetPt_JECGroupedUp );
-    setMapBranchAddresses( _currentTreePtr, _jetPt_JECGroupedDown, b__jetPt_JECGroupedDown );
-    setMapBranchAddresses( _currentTreePtr, _jetSmearedPt_JECGroupedUp, b__jetSmearedPt_JECGroupedUp );
-    setMapBranchAddresses( _currentTreePtr, _jetSmearedPt_JECGroupedDown, b__jetSmearedPt_JECGroupedDown );
-    setMapBranchAddresses( _currentTreePtr, _corrMETx_JECGroupedUp, b__corrMETx_JECGroupedUp );
-    setMapBranchAddresses( _currentTreePtr, _corrMETx_JECGroupedDown, b__corrMETx_JECGroupedDown );
-    setMapBranchAddresses( _currentTreePtr, _corrMETy_JECGroupedUp, b__corrMETy_JECGroupedUp );
-    setMapBranchAddresses( _currentTreePtr, _corrMETy_JECGroupedDown, b__corrMETy_JECGroupedDown );
+        initializeMetFilterMap();
+    }
+    for( auto& filter : _MetFilterMap ){
+        setInputBranchAddress( filter.first.c_str(), &filter.second, &b__MetFilterMap[ filter.first ] );
+    }
+
+    // add split and grouped JEC uncertainties
+    // as for the triggers, the storage is only reset when requested to keep the addresses set by setOutputTree valid
+    if( resetTriggersAndFilters || !_JECVariationTable ){
+        initializeJECVariations();
+    }
+    setJECVariationBranchAddresses();
+
+    // switch off branches that are not needed
+    // (the columns of a cache are only read for the enabled groups, see readEntryFromCache)
+    if( !_columnarCachePtr ){
+        applyBranchProfile();
+        applyReadCache();
+    }
+    _numberOfEntriesReadFromTree = 0;
+}
+
+
+TTree* TreeReader::copyEntries( const std::vector< long unsigned >& entries, const std::function< void( TTree* ) >& configureTree ){
+    checkCurrentTree();
+
+    //branches disabled by the branch profile would not be copied
+    _currentTreePtr->SetBranchStatus( "*", 1 );
+
+    //cloned baskets keep the compression of the input file, so they are only cloned when the output file uses the same
+    const TFile* inputFilePtr = _currentTreePtr->GetCurrentFile();
+    const TFile* outputFilePtr = gDirectory->GetFile();
+    const int inputCompression = ( inputFilePtr ? inputFilePtr->GetCompressionSettings() : -1 );
+    const int outputCompression = ( outputFilePtr ? outputFilePtr->GetCompressionSettings() : inputCompression );
+    std::string reason;
+    if( configureTree ){
+        reason = "the output tree is configured";
+    } else if( entries.size() != numberOfEntries() ){
+        reason = "only " + std::to_string( entries.size() ) + " of " + std::to_string( numberOfEntries() ) + " entries are copied";
+    } else if( outputCompression != inputCompression ){
+        reason = "the output file has compression settings " + std::to_string( outputCompression )
+            + " instead of " + std::to_string( inputCompression );
+    }
+
+    TTree* outputTreePtr = nullptr;
+    if( reason.empty() ){
+        outputTreePtr = _currentTreePtr->CloneTree( -1, "fast" );
+    } else {
+        std::cout << "WARNING in TreeReader::copyEntries: the baskets of the input tree are not cloned as they are, since " << reason;
+        std::cout << ", the copied entries are decompressed and compressed again." << std::endl;
+
+        //the empty clone shares the branch addresses of the current tree, but its branches have the compression of the input tree
+        outputTreePtr = _currentTreePtr->CloneTree( 0 );
+        if( outputTreePtr ){
+            for( const auto& branchPtr : *outputTreePtr->GetListOfBranches() ){
+                static_cast< TBranch* >( branchPtr )->SetCompressionSettings( outputCompression );
+            }
+            if( configureTree ) configureTree( outputTreePtr );
+            for( long unsigned entry : entries ){
+                _currentTreePtr->GetEntry( entry );
+                outputTreePtr->Fill();
+            }
+        }
+    }
+
+    //the variables of the reader no longer hold the current entry after copying
+    ++_entryReadIndex;
+    applyBranchProfile();
+    applyReadCache();
+    if( !outputTreePtr ){
+        throw std::runtime_error( "ERROR in TreeReader::copyEntries: copying the entries of the current tree failed." );
+    }
+    return outputTreePtr;
+}
+
+
+void TreeReader::setBranchProfile( const BranchProfile& profile ){
+    if( _columnarCachePtr ) checkCacheContainsBranchProfile( profile );
+    _branchProfile = profile;
+    if( _currentTreePtr && !_columnarCachePtr ){
+        applyBranchProfile();
+        applyReadCache();
+    }
+}
+
+
+void TreeReader::applyBranchProfile(){
+    checkCurrentTree();
+    _branchesPerGroup.clear();
+    _loadedGroups = 0;
+    TObjArray* branch_list = _currentTreePtr->GetListOfBranches();
+    for( const auto& branchPtr : *branch_list ){
+        std::string branchName = branchPtr->GetName();
+        BranchProfile::Group group = BranchProfile::groupOfBranch( branchName );
+        bool enabled = _branchProfile.isEnabled( group );
+        _currentTreePtr->SetBranchStatus( branchName.c_str(), enabled );
+
+        //keep the order of the tree, so the size of an array is read before its content
+        if( enabled ) _branchesPerGroup[ group ].push_back( static_cast< TBranch* >( branchPtr ) );
+    }
+}
+
+
+void TreeReader::setReadCache( const ReadCacheSettings& settings ){
+    _readCacheSettings = settings;
+    _columnarCacheDirectory = settings.columnarCacheDirectory();
+    if( _currentTreePtr && !_columnarCachePtr ) applyReadCache();
+}
+
+
+void TreeReader::applyReadCache(){
+    checkCurrentTree();
+    if( !_readCacheSettings.setsCacheSize() ) return;
+    _currentTreePtr->SetCacheSize( _readCacheSettings.cacheSize() );
+    if( _readCacheSettings.cacheSize() == 0 ) return;
+
+    //when reading lazily only part of the enabled branches is read for most entries,
+    //so the branches to cache are learned from the first entries
+    if( _lazyReading ){
+        _currentTreePtr->SetCacheLearnEntries( _readCacheSettings.learnEntries() );
+    } else {
+
+        //branches of an earlier, wider branch profile are removed from the cache
+        _currentTreePtr->DropBranchFromCache( "*", true );
+        for( const auto& group : _branchesPerGroup ){
+            for( TBranch* branchPtr : group.second ){
+                _currentTreePtr->AddBranchToCache( branchPtr, true );
+            }
+        }
+        _currentTreePtr->StopCacheLearningPhase();
+    }
+}
+
+
+void TreeReader::printReadCacheStatistics( std::ostream& os ) const{
+    if( _columnarCachePtr ){
+        os << "read " << _numberOfEntriesReadFromTree << " entries from columnar cache '" << _columnarCachePtr->directory() << "' (";
+        os << std::fixed << std::setprecision( 2 ) << _columnarCachePtr->mappedBytes() / 1.e6 << " MB mapped)." << std::endl;
+        return;
+    }
+    checkCurrentTree();
+    os << "read cache for " << _numberOfEntriesReadFromTree << " entries of the current tree: ";
+    TTreeCache* cachePtr = _currentTreePtr->GetReadCache( _currentFilePtr.get() );
+    if( cachePtr ){
+        os << "hit rate " << std::fixed << std::setprecision( 3 ) << cachePtr->GetEfficiencyRel();
+        os << ", fraction of prefetched baskets used " << cachePtr->GetEfficiency();
+    } else {
+        os << "no cache";
+    }
+    double readCallsPerEntry = ( _numberOfEntriesReadFromTree == 0 ? 0. :
+        static_cast< double >( _currentFilePtr->GetReadCalls() ) / _numberOfEntriesReadFromTree );
+    os << ", " << _currentFilePtr->GetReadCalls() << " read calls (" << std::setprecision( 3 ) << readCallsPerEntry << " per entry)." << std::endl;
+}
+
+
+void TreeReader::loadBranchGroups( std::initializer_list< BranchProfile::Group > groups ) const{
+    if( !_lazyReading ) return;
+    for( const auto group : groups ){
+        loadBranchGroup( group );
+    }
+}
+
+
+void TreeReader::loadBranchGroup( const BranchProfile::Group group ) const{
+    if( _loadedGroups & group ) return;
+    _loadedGroups |= group;
+
+    //array branches can only be read once the branch holding their size was read
+    static const unsigned leptonArrayGroups = BranchProfile::leptonVariations 
+        | BranchProfile::leptonID | BranchProfile::leptonGenMatch | BranchProfile::taus;
+    static const unsigned jetArrayGroups = BranchProfile::jetVariations
+        | BranchProfile::JECSources | BranchProfile::JECGrouped;
+    if( group & leptonArrayGroups ) loadBranchGroup( BranchProfile::leptonKinematics );
+    if( group & jetArrayGroups ) loadBranchGroup( BranchProfile::jets );
+
+    auto groupIt = _branchesPerGroup.find( group );
+    if( groupIt == _branchesPerGroup.cend() ) return;
+    unsigned long long numberOfBytes = 0;
+    for( TBranch* branchPtr : groupIt->second ){
+        numberOfBytes += branchPtr->GetEntry( _currentEntry );
+    }
+    _bytesReadPerGroup[ group ] += numberOfBytes;
+    ++_entriesReadPerGroup[ group ];
+    convertNarrowedInputBranches( group );
+}
+
+
+void TreeReader::printReadStatistics( std::ostream& os ) const{
+    os << "TreeReader read " << _numberOfEntriesRead << " entries";
+    if( !_lazyReading ){
+        os << " and " << std::fixed << std::setprecision( 2 ) << _bytesReadEagerly / 1.e6;
+        os << " MB (all enabled branches are read for each entry)." << std::endl;
+        return;
+    }
+    os << ", bytes read per branch group:" << std::endl;
+    os << std::left << std::setw( 22 ) << "group" << std::right << std::setw( 16 ) << "entries read";
+    os << std::setw( 16 ) << "MB read" << std::endl;
+    unsigned long long totalBytes = 0;
+    for( const auto& entry : _bytesReadPerGroup ){
+        os << std::left << std::setw( 22 ) << BranchProfile::groupName( entry.first );
+        os << std::right << std::setw( 16 ) << _entriesReadPerGroup.at( entry.first );
+        os << std::setw( 16 ) << std::fixed << std::setprecision( 2 ) << entry.second / 1.e6 << std::endl;
+        totalBytes += entry.second;
+    }
+    os << std::left << std::setw( 22 ) << "total" << std::right << std::setw( 16 ) << "";
+    os << std::setw( 16 ) << std::fixed << std::setprecision( 2 ) << totalBytes / 1.e6 << std::endl;
+}
+
+
+void TreeReader::resetReadStatistics(){
+    _numberOfEntriesRead = 0;
+    _bytesReadEagerly = 0;
+    _bytesReadPerGroup.clear();
+    _entriesReadPerGroup.clear();
 }
 
 
@@ -779,138 +1587,158 @@ void TreeReader::setOutputTree( TTree* outputTree,
 				bool includeTauInfo,
 				bool includeGeneratorInfo,
 				bool includeGenParticles ){
-    outputTree->Branch("_runNb",                        &_runNb,                        "_runNb/l");
-    outputTree->Branch("_lumiBlock",                    &_lumiBlock,                    "_lumiBlock/l");
-    outputTree->Branch("_eventNb",                      &_eventNb,                      "_eventNb/l");
-    outputTree->Branch("_nVertex",                      &_nVertex,                      "_nVertex/i");
-
-    outputTree->Branch("_passTrigger_e", &_passTrigger_e, "_passTrigger_e/O");
-    outputTree->Branch("_passTrigger_ee", &_passTrigger_ee, "_passTrigger_ee/O");
-    outputTree->Branch("_passTrigger_eee", &_passTrigger_eee, "_passTrigger_eee/O");
-    outputTree->Branch("_passTrigger_em", &_passTrigger_em, "_passTrigger_em/O");
-    outputTree->Branch("_passTrigger_m", &_passTrigger_m, "_passTrigger_m/O");
-    outputTree->Branch("_passTrigger_eem", &_passTrigger_eem, "_passTrigger_eem/O");
-    outputTree->Branch("_passTrigger_mm", &_passTrigger_mm, "_passTrigger_mm/O");
-    outputTree->Branch("_passTrigger_emm", &_passTrigger_emm, "_passTrigger_emm/O");
-    outputTree->Branch("_passTrigger_mmm", &_passTrigger_mmm, "_passTrigger_mmm/O");
-    outputTree->Branch("_passTrigger_et", &_passTrigger_et, "_passTrigger_et/O");
-    outputTree->Branch("_passTrigger_mt", &_passTrigger_mt, "_passTrigger_mt/O");
-    outputTree->Branch("_passTrigger_FR", &_passTrigger_FR, "_passTrigger_FR/O");
-    outputTree->Branch("_passTrigger_FR_iso", &_passTrigger_FR_iso, "_passTrigger_FR_iso/O");
-    outputTree->Branch("_passMETFilters", &_passMETFilters, "_passMETFilters/O");
-
-    outputTree->Branch("_nL",                           &_nL,                           "_nL/i");
-    outputTree->Branch("_nMu",                          &_nMu,                          "_nMu/i");
-    outputTree->Branch("_nEle",                         &_nEle,                         "_nEle/i");
-    outputTree->Branch("_nLight",                       &_nLight,                       "_nLight/i");
-    outputTree->Branch("_nTau",                         &_nTau,                         "_nTau/i");
-    outputTree->Branch("_lPt",                          &_lPt,                          "_lPt[_nL]/D");
-    outputTree->Branch("_lPtCorr",                      &_lPtCorr,                      "_lPtCorr[_nLight]/D");
-    outputTree->Branch("_lPtScaleUp",			&_lPtScaleUp,                   "_lPtScaleUp[_nLight]/D");
-    outputTree->Branch("_lPtScaleDown",                 &_lPtScaleDown,                 "_lPtScaleDown[_nLight]/D");
-    outputTree->Branch("_lPtResUp",                     &_lPtResUp,                     "_lPtResUp[_nLight]/D");
-    outputTree->Branch("_lPtResDown",                   &_lPtResDown,                   "_lPtResDown[_nLight]/D");
-    outputTree->Branch("_lEta",                         &_lEta,                         "_lEta[_nL]/D");
-    outputTree->Branch("_lEtaSC",                       &_lEtaSC,                       "_lEtaSC[_nLight]/D");
-    outputTree->Branch("_lPhi",                         &_lPhi,                         "_lPhi[_nL]/D");
-    outputTree->Branch("_lE",                           &_lE,                           "_lE[_nL]/D");
-    outputTree->Branch("_lECorr",                       &_lECorr,                       "_lECorr[_nLight]/D");
-    outputTree->Branch("_lEScaleUp",                    &_lEScaleUp,                    "_lEScaleUp[_nLight]/D");
-    outputTree->Branch("_lEScaleDown",                  &_lEScaleDown,                  "_lEScaleDown[_nLight]/D");
-    outputTree->Branch("_lEResUp",                      &_lEResUp,                      "_lEResUp[_nLight]/D");
-    outputTree->Branch("_lEResDown",                    &_lEResDown,                    "_lEResDown[_nLight]/D");
-    outputTree->Branch("_lFlavor",                      &_lFlavor,                      "_lFlavor[_nL]/i");
-    outputTree->Branch("_lCharge",                      &_lCharge,                      "_lCharge[_nL]/I");
-    outputTree->Branch("_dxy",                          &_dxy,                          "_dxy[_nL]/D");
-    outputTree->Branch("_dz",                           &_dz,                           "_dz[_nL]/D");
-    outputTree->Branch("_3dIP",                         &_3dIP,                         "_3dIP[_nL]/D");
-    outputTree->Branch("_3dIPSig",                      &_3dIPSig,                      "_3dIPSig[_nL]/D");
-    outputTree->Branch("_lElectronSummer16MvaGP",       &_lElectronSummer16MvaGP,       "_lElectronSummer16MvaGP[_nLight]/F");
-    outputTree->Branch("_lElectronSummer16MvaHZZ",      &_lElectronSummer16MvaHZZ,      "_lElectronSummer16MvaHZZ[_nLight]/F");
-    outputTree->Branch("_lElectronMvaFall17Iso",        &_lElectronMvaFall17Iso,        "_lElectronMvaFall17Iso[_nLight]/F");
-    outputTree->Branch("_lElectronMvaFall17NoIso",      &_lElectronMvaFall17NoIso,      "_lElectronMvaFall17NoIso[_nLight]/F");
-    outputTree->Branch("_lElectronPassMVAFall17NoIsoWPLoose", &_lElectronPassMVAFall17NoIsoWPLoose, "_lElectronPassMVAFall17NoIsoWPLoose[_nLight]/O");
-    outputTree->Branch("_lElectronPassMVAFall17NoIsoWP90", &_lElectronPassMVAFall17NoIsoWP90, "_lElectronPassMVAFall17NoIsoWP90[_nLight]/O");
-    outputTree->Branch("_lElectronPassMVAFall17NoIsoWP80", &_lElectronPassMVAFall17NoIsoWP80, "_lElectronPassMVAFall17NoIsoWP80[_nLight]/O");
-    outputTree->Branch("_lElectronPassEmu",             &_lElectronPassEmu,             "_lElectronPassEmu[_nLight]/O");
-    outputTree->Branch("_lElectronPassConvVeto",        &_lElectronPassConvVeto,        "_lElectronPassConvVeto[_nLight]/O");
-    outputTree->Branch("_lElectronChargeConst",         &_lElectronChargeConst,         "_lElectronChargeConst[_nLight]/O");
-    outputTree->Branch("_lElectronMissingHits",         &_lElectronMissingHits,         "_lElectronMissingHits[_nLight]/i");
-    outputTree->Branch("_lElectronEInvMinusPInv",       &_lElectronEInvMinusPInv,       "_lElectronEInvMinusPInv[_nLight]/D");
-    outputTree->Branch("_lElectronHOverE",              &_lElectronHOverE,              "_lElectronHOverE[_nLight]/D");
-    outputTree->Branch("_lElectronSigmaIetaIeta",       &_lElectronSigmaIetaIeta,       "_lElectronSigmaIetaIeta[_nLight]/D");
-    outputTree->Branch("_leptonMvaTTH",                 &_leptonMvaTTH,                 "_leptonMvaTTH[_nLight]/D");
-    outputTree->Branch("_leptonMvatZq",                 &_leptonMvatZq,                 "_leptonMvatZq[_nLight]/D");
-    outputTree->Branch("_leptonMvaTOP",                 &_leptonMvaTOP,                 "_leptonMvaTOP[_nLight]/D");
-    outputTree->Branch("_leptonMvaTOPUL",		&_leptonMvaTOPUL,		"_leptonMvaTOPUL[_nLight]/D");
-    outputTree->Branch("_leptonMvaTOPv2UL",             &_leptonMvaTOPv2UL,		"_leptonMvaTOPv2UL[_nLight]/D");
-    outputTree->Branch("_lPOGVeto",                     &_lPOGVeto,                     "_lPOGVeto[_nL]/O");
-    outputTree->Branch("_lPOGLoose",                    &_lPOGLoose,                    "_lPOGLoose[_nL]/O");
-    outputTree->Branch("_lPOGMedium",                   &_lPOGMedium,                   "_lPOGMedium[_nL]/O");
-    outputTree->Branch("_lPOGTight",                    &_lPOGTight,                    "_lPOGTight[_nL]/O");
-    outputTree->Branch("_relIso",                       &_relIso,                       "_relIso[_nLight]/D");
-    outputTree->Branch("_relIso0p4",                    &_relIso0p4,                    "_relIso0p4[_nLight]/D");
-    outputTree->Branch("_relIso0p4MuDeltaBeta",         &_relIso0p4MuDeltaBeta,         "_relIso0p4MuDeltaBeta[_nMu]/D");
-    outputTree->Branch("_miniIso",                      &_miniIso,                      "_miniIso[_nLight]/D");
-    outputTree->Branch("_miniIsoCharged",               &_miniIsoCharged,               "_miniIsoCharged[_nLight]/D");
-    outputTree->Branch("_ptRel",                        &_ptRel,                        "_ptRel[_nLight]/D");
-    outputTree->Branch("_ptRatio",                      &_ptRatio,                      "_ptRatio[_nLight]/D");
-    outputTree->Branch("_closestJetCsvV2",              &_closestJetCsvV2,              "_closestJetCsvV2[_nLight]/D");
-    outputTree->Branch("_closestJetDeepCsv_b",          &_closestJetDeepCsv_b,          "_closestJetDeepCsv_b[_nLight]/D");
-    outputTree->Branch("_closestJetDeepCsv_bb",         &_closestJetDeepCsv_bb,         "_closestJetDeepCsv_bb[_nLight]/D");
-    outputTree->Branch("_closestJetDeepFlavor_b",       &_closestJetDeepFlavor_b,       "_closestJetDeepFlavor_b[_nLight]/D");
-    outputTree->Branch("_closestJetDeepFlavor_bb",      &_closestJetDeepFlavor_bb,      "_closestJetDeepFlavor_bb[_nLight]/D");
-    outputTree->Branch("_closestJetDeepFlavor_lepb",    &_closestJetDeepFlavor_lepb,    "_closestJetDeepFlavor_lepb[_nLight]/D");
-    outputTree->Branch("_selectedTrackMult",            &_selectedTrackMult,            "_selectedTrackMult[_nLight]/i");
-    outputTree->Branch("_lMuonSegComp",                 &_lMuonSegComp,                 "_lMuonSegComp[_nMu]/D");
-    outputTree->Branch("_lMuonTrackPt",                 &_lMuonTrackPt,                 "_lMuonTrackPt[_nMu]/D");
-    outputTree->Branch("_lMuonTrackPtErr",              &_lMuonTrackPtErr,              "_lMuonTrackPtErr[_nMu]/D");
-
-    outputTree->Branch("_nJets",                     &_nJets,                    "_nJets/i");
-    outputTree->Branch("_jetPt",                     &_jetPt,                    "_jetPt[_nJets]/D");
-    outputTree->Branch("_jetPt_JECUp",               &_jetPt_JECUp,              "_jetPt_JECUp[_nJets]/D");
-    outputTree->Branch("_jetPt_JECDown",             &_jetPt_JECDown,            "_jetPt_JECDown[_nJets]/D");
-    outputTree->Branch("_jetSmearedPt",              &_jetSmearedPt,             "_jetSmearedPt[_nJets]/D");
-    outputTree->Branch("_jetSmearedPt_JECDown",      &_jetSmearedPt_JECDown,     "_jetSmearedPt_JECDown[_nJets]/D");
-    outputTree->Branch("_jetSmearedPt_JECUp",        &_jetSmearedPt_JECUp,       "_jetSmearedPt_JECUp[_nJets]/D");
-    outputTree->Branch("_jetSmearedPt_JERDown",      &_jetSmearedPt_JERDown,     "_jetSmearedPt_JERDown[_nJets]/D");
-    outputTree->Branch("_jetSmearedPt_JERUp",        &_jetSmearedPt_JERUp,       "_jetSmearedPt_JERUp[_nJets]/D");
-    outputTree->Branch("_jetEta",                    &_jetEta,                   "_jetEta[_nJets]/D");
-    outputTree->Branch("_jetPhi",                    &_jetPhi,                   "_jetPhi[_nJets]/D");
-    outputTree->Branch("_jetE",                      &_jetE,                     "_jetE[_nJets]/D");
-    outputTree->Branch("_jetPt_Uncorrected",         &_jetPt_Uncorrected,        "_jetPt_Uncorrected[_nJets]/D");
-    outputTree->Branch("_jetPt_L1",                  &_jetPt_L1,                 "_jetPt_L1[_nJets]/D");
-    outputTree->Branch("_jetPt_L2",                  &_jetPt_L2,                 "_jetPt_L2[_nJets]/D");
-    outputTree->Branch("_jetPt_L3",                  &_jetPt_L3,                 "_jetPt_L3[_nJets]/D");
-    outputTree->Branch("_jetCsvV2",                  &_jetCsvV2,                 "_jetCsvV2[_nJets]/D");
-    outputTree->Branch("_jetDeepCsv_udsg",           &_jetDeepCsv_udsg,          "_jetDeepCsv_udsg[_nJets]/D");
-    outputTree->Branch("_jetDeepCsv_b",              &_jetDeepCsv_b,             "_jetDeepCsv_b[_nJets]/D");
-    outputTree->Branch("_jetDeepCsv_c",              &_jetDeepCsv_c,             "_jetDeepCsv_c[_nJets]/D");
-    outputTree->Branch("_jetDeepCsv_bb",             &_jetDeepCsv_bb,            "_jetDeepCsv_bb[_nJets]/D");
-    outputTree->Branch("_jetDeepFlavor_b",           &_jetDeepFlavor_b,          "_jetDeepFlavor_b[_nJets]/D");
-    outputTree->Branch("_jetDeepFlavor_bb",          &_jetDeepFlavor_bb,         "_jetDeepFlavor_bb[_nJets]/D");
-    outputTree->Branch("_jetDeepFlavor_lepb",        &_jetDeepFlavor_lepb,       "_jetDeepFlavor_lepb[_nJets]/D");
-    outputTree->Branch("_jetHadronFlavor",           &_jetHadronFlavor,          "_jetHadronFlavor[_nJets]/i");
-    outputTree->Branch("_jetIsTight",                &_jetIsTight,               "_jetIsTight[_nJets]/O");
-    outputTree->Branch("_jetIsTightLepVeto",         &_jetIsTightLepVeto,        "_jetIsTightLepVeto[_nJets]/O");
-    outputTree->Branch("_jetNeutralHadronFraction",  &_jetNeutralHadronFraction, "_jetNeutralHadronFraction[_nJets]/D");
-    outputTree->Branch("_jetChargedHadronFraction",  &_jetChargedHadronFraction, "_jetChargedHadronFraction[_nJets]/D");
-    outputTree->Branch("_jetNeutralEmFraction",      &_jetNeutralEmFraction,     "_jetNeutralEmFraction[_nJets]/D");
-    outputTree->Branch("_jetChargedEmFraction",      &_jetChargedEmFraction,     "_jetChargedEmFraction[_nJets]/D");
-    outputTree->Branch("_jetHFHadronFraction",       &_jetHFHadronFraction,      "_jetHFHadronFraction[_nJets]/D");
-    outputTree->Branch("_jetHFEmFraction",           &_jetHFEmFraction,          "_jetHFEmFraction[_nJets]/D");
-
-    outputTree->Branch("_met",                          &_met,                          "_met/D");
-    outputTree->Branch("_met_JECDown",                  &_met_JECDown,                  "_met_JECDown/D");
-    outputTree->Branch("_met_JECUp",                    &_met_JECUp,                    "_met_JECUp/D");
-    outputTree->Branch("_met_UnclDown",                 &_met_UnclDown,                 "_met_UnclDown/D");
-    outputTree->Branch("_met_UnclUp",                   &_met_UnclUp,                   "_met_UnclUp/D");
-    outputTree->Branch("_metPhi",                       &_metPhi,                       "_metPhi/D");
-    outputTree->Branch("_metPhi_JECDown",               &_metPhi_JECDown,               "_metPhi_JECDown/D");
-    outputTree->Branch("_metPhi_JECUp",                 &_metPhi_JECUp,                 "_metPhi_JECUp/D");
-    outputTree->Branch("_metPhi_UnclDown",              &_metPhi_UnclDown,              "_metPhi_UnclDown/D");
-    outputTree->Branch("_metPhi_UnclUp",                &_metPhi_UnclUp,                "_metPhi_UnclUp/D");
-    outputTree->Branch("_metSignificance",              &_metSignificance,              "_metSignificance/D");
+
+    // the output tree is filled from the reader's variables, which are not all read in lazy mode
+    if( _lazyReading ){
+        throw std::domain_error( "ERROR in TreeReader::setOutputTree: an output tree can not be filled from a TreeReader that reads branches lazily." );
+    }
+
+    // branches switched off by the branch profile would be written with stale values
+    if( !_branchProfile.enablesAll() ){
+        std::string msg = "WARNING in TreeReader.setOutputTree:";
+        msg.append(" the branch profile of this TreeReader does not enable all branches");
+        msg.append(" ('" + _branchProfile.toString() + "'),");
+        msg.append(" branches in disabled groups will not contain valid values in the output tree!");
+        std::cerr << msg << std::endl;
+    }
+
+    // trees that do not contain all branches are marked, so a reader only tolerates missing branches for them
+    _narrowedOutputBranches.clear();
+    if( !_slimmingProfile.keepsAll() ){
+        outputTree->GetUserInfo()->Add( new TNamed( SlimmingProfile::userInfoName(), _slimmingProfile.name().c_str() ) );
+    }
+    addOutputBranch(outputTree, "_runNb",                        &_runNb,                        "_runNb/l");
+    addOutputBranch(outputTree, "_lumiBlock",                    &_lumiBlock,                    "_lumiBlock/l");
+    addOutputBranch(outputTree, "_eventNb",                      &_eventNb,                      "_eventNb/l");
+    addOutputBranch(outputTree, "_nVertex",                      &_nVertex,                      "_nVertex/i");
+
+    addOutputBranch(outputTree, "_passTrigger_e", &_passTrigger_e, "_passTrigger_e/O");
+    addOutputBranch(outputTree, "_passTrigger_ee", &_passTrigger_ee, "_passTrigger_ee/O");
+    addOutputBranch(outputTree, "_passTrigger_eee", &_passTrigger_eee, "_passTrigger_eee/O");
+    addOutputBranch(outputTree, "_passTrigger_em", &_passTrigger_em, "_passTrigger_em/O");
+    addOutputBranch(outputTree, "_passTrigger_m", &_passTrigger_m, "_passTrigger_m/O");
+    addOutputBranch(outputTree, "_passTrigger_eem", &_passTrigger_eem, "_passTrigger_eem/O");
+    addOutputBranch(outputTree, "_passTrigger_mm", &_passTrigger_mm, "_passTrigger_mm/O");
+    addOutputBranch(outputTree, "_passTrigger_emm", &_passTrigger_emm, "_passTrigger_emm/O");
+    addOutputBranch(outputTree, "_passTrigger_mmm", &_passTrigger_mmm, "_passTrigger_mmm/O");
+    addOutputBranch(outputTree, "_passTrigger_et", &_passTrigger_et, "_passTrigger_et/O");
+    addOutputBranch(outputTree, "_passTrigger_mt", &_passTrigger_mt, "_passTrigger_mt/O");
+    addOutputBranch(outputTree, "_passTrigger_FR", &_passTrigger_FR, "_passTrigger_FR/O");
+    addOutputBranch(outputTree, "_passTrigger_FR_iso", &_passTrigger_FR_iso, "_passTrigger_FR_iso/O");
+    addOutputBranch(outputTree, "_passMETFilters", &_passMETFilters, "_passMETFilters/O");
+
+    addOutputBranch(outputTree, "_nL",                           &_nL,                           "_nL/i");
+    addOutputBranch(outputTree, "_nMu",                          &_nMu,                          "_nMu/i");
+    addOutputBranch(outputTree, "_nEle",                         &_nEle,                         "_nEle/i");
+    addOutputBranch(outputTree, "_nLight",                       &_nLight,                       "_nLight/i");
+    addOutputBranch(outputTree, "_nTau",                         &_nTau,                         "_nTau/i");
+    addOutputBranch(outputTree, "_lPt",                          &_lPt,                          "_lPt[_nL]/D");
+    addOutputBranch(outputTree, "_lPtCorr",                      &_lPtCorr,                      "_lPtCorr[_nLight]/D");
+    addOutputBranch(outputTree, "_lPtScaleUp",			&_lPtScaleUp,                   "_lPtScaleUp[_nLight]/D");
+    addOutputBranch(outputTree, "_lPtScaleDown",                 &_lPtScaleDown,                 "_lPtScaleDown[_nLight]/D");
+    addOutputBranch(outputTree, "_lPtResUp",                     &_lPtResUp,                     "_lPtResUp[_nLight]/D");
+    addOutputBranch(outputTree, "_lPtResDown",                   &_lPtResDown,                   "_lPtResDown[_nLight]/D");
+    addOutputBranch(outputTree, "_lEta",                         &_lEta,                         "_lEta[_nL]/D");
+    addOutputBranch(outputTree, "_lEtaSC",                       &_lEtaSC,                       "_lEtaSC[_nLight]/D");
+    addOutputBranch(outputTree, "_lPhi",                         &_lPhi,                         "_lPhi[_nL]/D");
+    addOutputBranch(outputTree, "_lE",                           &_lE,                           "_lE[_nL]/D");
+    addOutputBranch(outputTree, "_lECorr",                       &_lECorr,                       "_lECorr[_nLight]/D");
+    addOutputBranch(outputTree, "_lEScaleUp",                    &_lEScaleUp,                    "_lEScaleUp[_nLight]/D");
+    addOutputBranch(outputTree, "_lEScaleDown",                  &_lEScaleDown,                  "_lEScaleDown[_nLight]/D");
+    addOutputBranch(outputTree, "_lEResUp",                      &_lEResUp,                      "_lEResUp[_nLight]/D");
+    addOutputBranch(outputTree, "_lEResDown",                    &_lEResDown,                    "_lEResDown[_nLight]/D");
+    addOutputBranch(outputTree, "_lFlavor",                      &_lFlavor,                      "_lFlavor[_nL]/i");
+    addOutputBranch(outputTree, "_lCharge",                      &_lCharge,                      "_lCharge[_nL]/I");
+    addOutputBranch(outputTree, "_dxy",                          &_dxy,                          "_dxy[_nL]/D");
+    addOutputBranch(outputTree, "_dz",                           &_dz,                           "_dz[_nL]/D");
+    addOutputBranch(outputTree, "_3dIP",                         &_3dIP,                         "_3dIP[_nL]/D");
+    addOutputBranch(outputTree, "_3dIPSig",                      &_3dIPSig,                      "_3dIPSig[_nL]/D");
+    addOutputBranch(outputTree, "_lElectronSummer16MvaGP",       &_lElectronSummer16MvaGP,       "_lElectronSummer16MvaGP[_nLight]/F");
+    addOutputBranch(outputTree, "_lElectronSummer16MvaHZZ",      &_lElectronSummer16MvaHZZ,      "_lElectronSummer16MvaHZZ[_nLight]/F");
+    addOutputBranch(outputTree, "_lElectronMvaFall17Iso",        &_lElectronMvaFall17Iso,        "_lElectronMvaFall17Iso[_nLight]/F");
+    addOutputBranch(outputTree, "_lElectronMvaFall17NoIso",      &_lElectronMvaFall17NoIso,      "_lElectronMvaFall17NoIso[_nLight]/F");
+    addOutputBranch(outputTree, "_lElectronPassMVAFall17NoIsoWPLoose", &_lElectronPassMVAFall17NoIsoWPLoose, "_lElectronPassMVAFall17NoIsoWPLoose[_nLight]/O");
+    addOutputBranch(outputTree, "_lElectronPassMVAFall17NoIsoWP90", &_lElectronPassMVAFall17NoIsoWP90, "_lElectronPassMVAFall17NoIsoWP90[_nLight]/O");
+    addOutputBranch(outputTree, "_lElectronPassMVAFall17NoIsoWP80", &_lElectronPassMVAFall17NoIsoWP80, "_lElectronPassMVAFall17NoIsoWP80[_nLight]/O");
+    addOutputBranch(outputTree, "_lElectronPassEmu",             &_lElectronPassEmu,             "_lElectronPassEmu[_nLight]/O");
+    addOutputBranch(outputTree, "_lElectronPassConvVeto",        &_lElectronPassConvVeto,        "_lElectronPassConvVeto[_nLight]/O");
+    addOutputBranch(outputTree, "_lElectronChargeConst",         &_lElectronChargeConst,         "_lElectronChargeConst[_nLight]/O");
+    addOutputBranch(outputTree, "_lElectronMissingHits",         &_lElectronMissingHits,         "_lElectronMissingHits[_nLight]/i");
+    addOutputBranch(outputTree, "_lElectronEInvMinusPInv",       &_lElectronEInvMinusPInv,       "_lElectronEInvMinusPInv[_nLight]/D");
+    addOutputBranch(outputTree, "_lElectronHOverE",              &_lElectronHOverE,              "_lElectronHOverE[_nLight]/D");
+    addOutputBranch(outputTree, "_lElectronSigmaIetaIeta",       &_lElectronSigmaIetaIeta,       "_lElectronSigmaIetaIeta[_nLight]/D");
+    addOutputBranch(outputTree, "_leptonMvaTTH",                 &_leptonMvaTTH,                 "_leptonMvaTTH[_nLight]/D");
+    addOutputBranch(outputTree, "_leptonMvatZq",                 &_leptonMvatZq,                 "_leptonMvatZq[_nLight]/D");
+    addOutputBranch(outputTree, "_leptonMvaTOP",                 &_leptonMvaTOP,                 "_leptonMvaTOP[_nLight]/D");
+    addOutputBranch(outputTree, "_leptonMvaTOPUL",		&_leptonMvaTOPUL,		"_leptonMvaTOPUL[_nLight]/D");
+    addOutputBranch(outputTree, "_leptonMvaTOPv2UL",             &_leptonMvaTOPv2UL,		"_leptonMvaTOPv2UL[_nLight]/D");
+    addOutputBranch(outputTree, "_lPOGVeto",                     &_lPOGVeto,                     "_lPOGVeto[_nL]/O");
+    addOutputBranch(outputTree, "_lPOGLoose",                    &_lPOGLoose,                    "_lPOGLoose[_nL]/O");
+    addOutputBranch(outputTree, "_lPOGMedium",                   &_lPOGMedium,                   "_lPOGMedium[_nL]/O");
+    addOutputBranch(outputTree, "_lPOGTight",                    &_lPOGTight,                    "_lPOGTight[_nL]/O");
+    addOutputBranch(outputTree, "_relIso",                       &_relIso,                       "_relIso[_nLight]/D");
+    addOutputBranch(outputTree, "_relIso0p4",                    &_relIso0p4,                    "_relIso0p4[_nLight]/D");
+    addOutputBranch(outputTree, "_relIso0p4MuDeltaBeta",         &_relIso0p4MuDeltaBeta,         "_relIso0p4MuDeltaBeta[_nMu]/D");
+    addOutputBranch(outputTree, "_miniIso",                      &_miniIso,                      "_miniIso[_nLight]/D");
+    addOutputBranch(outputTree, "_miniIsoCharged",               &_miniIsoCharged,               "_miniIsoCharged[_nLight]/D");
+    addOutputBranch(outputTree, "_ptRel",                        &_ptRel,                        "_ptRel[_nLight]/D");
+    addOutputBranch(outputTree, "_ptRatio",                      &_ptRatio,                      "_ptRatio[_nLight]/D");
+    addOutputBranch(outputTree, "_closestJetCsvV2",              &_closestJetCsvV2,              "_closestJetCsvV2[_nLight]/D");
+    addOutputBranch(outputTree, "_closestJetDeepCsv_b",          &_closestJetDeepCsv_b,          "_closestJetDeepCsv_b[_nLight]/D");
+    addOutputBranch(outputTree, "_closestJetDeepCsv_bb",         &_closestJetDeepCsv_bb,         "_closestJetDeepCsv_bb[_nLight]/D");
+    addOutputBranch(outputTree, "_closestJetDeepFlavor_b",       &_closestJetDeepFlavor_b,       "_closestJetDeepFlavor_b[_nLight]/D");
+    addOutputBranch(outputTree, "_closestJetDeepFlavor_bb",      &_closestJetDeepFlavor_bb,      "_closestJetDeepFlavor_bb[_nLight]/D");
+    addOutputBranch(outputTree, "_closestJetDeepFlavor_lepb",    &_closestJetDeepFlavor_lepb,    "_closestJetDeepFlavor_lepb[_nLight]/D");
+    addOutputBranch(outputTree, "_selectedTrackMult",            &_selectedTrackMult,            "_selectedTrackMult[_nLight]/i");
+    addOutputBranch(outputTree, "_lMuonSegComp",                 &_lMuonSegComp,                 "_lMuonSegComp[_nMu]/D");
+    addOutputBranch(outputTree, "_lMuonTrackPt",                 &_lMuonTrackPt,                 "_lMuonTrackPt[_nMu]/D");
+    addOutputBranch(outputTree, "_lMuonTrackPtErr",              &_lMuonTrackPtErr,              "_lMuonTrackPtErr[_nMu]/D");
+
+    addOutputBranch(outputTree, "_nJets",                     &_nJets,                    "_nJets/i");
+    addOutputBranch(outputTree, "_jetPt",                     &_jetPt,                    "_jetPt[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPt_JECUp",               &_jetPt_JECUp,              "_jetPt_JECUp[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPt_JECDown",             &_jetPt_JECDown,            "_jetPt_JECDown[_nJets]/D");
+    addOutputBranch(outputTree, "_jetSmearedPt",              &_jetSmearedPt,             "_jetSmearedPt[_nJets]/D");
+    addOutputBranch(outputTree, "_jetSmearedPt_JECDown",      &_jetSmearedPt_JECDown,     "_jetSmearedPt_JECDown[_nJets]/D");
+    addOutputBranch(outputTree, "_jetSmearedPt_JECUp",        &_jetSmearedPt_JECUp,       "_jetSmearedPt_JECUp[_nJets]/D");
+    addOutputBranch(outputTree, "_jetSmearedPt_JERDown",      &_jetSmearedPt_JERDown,     "_jetSmearedPt_JERDown[_nJets]/D");
+    addOutputBranch(outputTree, "_jetSmearedPt_JERUp",        &_jetSmearedPt_JERUp,       "_jetSmearedPt_JERUp[_nJets]/D");
+    addOutputBranch(outputTree, "_jetEta",                    &_jetEta,                   "_jetEta[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPhi",                    &_jetPhi,                   "_jetPhi[_nJets]/D");
+    addOutputBranch(outputTree, "_jetE",                      &_jetE,                     "_jetE[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPt_Uncorrected",         &_jetPt_Uncorrected,        "_jetPt_Uncorrected[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPt_L1",                  &_jetPt_L1,                 "_jetPt_L1[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPt_L2",                  &_jetPt_L2,                 "_jetPt_L2[_nJets]/D");
+    addOutputBranch(outputTree, "_jetPt_L3",                  &_jetPt_L3,                 "_jetPt_L3[_nJets]/D");
+    addOutputBranch(outputTree, "_jetCsvV2",                  &_jetCsvV2,                 "_jetCsvV2[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepCsv_udsg",           &_jetDeepCsv_udsg,          "_jetDeepCsv_udsg[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepCsv_b",              &_jetDeepCsv_b,             "_jetDeepCsv_b[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepCsv_c",              &_jetDeepCsv_c,             "_jetDeepCsv_c[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepCsv_bb",             &_jetDeepCsv_bb,            "_jetDeepCsv_bb[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepFlavor_b",           &_jetDeepFlavor_b,          "_jetDeepFlavor_b[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepFlavor_bb",          &_jetDeepFlavor_bb,         "_jetDeepFlavor_bb[_nJets]/D");
+    addOutputBranch(outputTree, "_jetDeepFlavor_lepb",        &_jetDeepFlavor_lepb,       "_jetDeepFlavor_lepb[_nJets]/D");
+    addOutputBranch(outputTree, "_jetHadronFlavor",           &_jetHadronFlavor,          "_jetHadronFlavor[_nJets]/i");
+    addOutputBranch(outputTree, "_jetIsTight",                &_jetIsTight,               "_jetIsTight[_nJets]/O");
+    addOutputBranch(outputTree, "_jetIsTightLepVeto",         &_jetIsTightLepVeto,        "_jetIsTightLepVeto[_nJets]/O");
+    addOutputBranch(outputTree, "_jetNeutralHadronFraction",  &_jetNeutralHadronFraction, "_jetNeutralHadronFraction[_nJets]/D");
+    addOutputBranch(outputTree, "_jetChargedHadronFraction",  &_jetChargedHadronFraction, "_jetChargedHadronFraction[_nJets]/D");
+    addOutputBranch(outputTree, "_jetNeutralEmFraction",      &_jetNeutralEmFraction,     "_jetNeutralEmFraction[_nJets]/D");
+    addOutputBranch(outputTree, "_jetChargedEmFraction",      &_jetChargedEmFraction,     "_jetChargedEmFraction[_nJets]/D");
+    addOutputBranch(outputTree, "_jetHFHadronFraction",       &_jetHFHadronFraction,      "_jetHFHadronFraction[_nJets]/D");
+    addOutputBranch(outputTree, "_jetHFEmFraction",           &_jetHFEmFraction,          "_jetHFEmFraction[_nJets]/D");
+
+    addOutputBranch(outputTree, "_met",                          &_met,                          "_met/D");
+    addOutputBranch(outputTree, "_met_JECDown",                  &_met_JECDown,                  "_met_JECDown/D");
+    addOutputBranch(outputTree, "_met_JECUp",                    &_met_JECUp,                    "_met_JECUp/D");
+    addOutputBranch(outputTree, "_met_UnclDown",                 &_met_UnclDown,                 "_met_UnclDown/D");
+    addOutputBranch(outputTree, "_met_UnclUp",                   &_met_UnclUp,                   "_met_UnclUp/D");
+    addOutputBranch(outputTree, "_metPhi",                       &_metPhi,                       "_metPhi/D");
+    addOutputBranch(outputTree, "_metPhi_JECDown",               &_metPhi_JECDown,               "_metPhi_JECDown/D");
+    addOutputBranch(outputTree, "_metPhi_JECUp",                 &_metPhi_JECUp,                 "_metPhi_JECUp/D");
+    addOutputBranch(outputTree, "_metPhi_UnclDown",              &_metPhi_UnclDown,              "_metPhi_UnclDown/D");
+    addOutputBranch(outputTree, "_metPhi_UnclUp",                &_metPhi_UnclUp,                "_metPhi_UnclUp/D");
+    addOutputBranch(outputTree, "_metSignificance",              &_metSignificance,              "_metSignificance/D");
 
     if( includeTauInfo ){
         if( !containsTauInfo() ){
@@ -921,34 +1749,34 @@ void TreeReader::setOutputTree( TTree* outputTree,
             std::cerr << msg << std::endl;
         }
         else{
-            outputTree->Branch("_tauDecayMode",                 &_tauDecayMode,                 "_tauDecayMode[_nL]/i");
-            outputTree->Branch("_decayModeFinding",             &_decayModeFinding,             "_decayModeFinding[_nL]/O");
-            outputTree->Branch("_decayModeFindingNew",          &_decayModeFindingNew,          "_decayModeFindingNew[_nL]/O");
-            outputTree->Branch("_tauPOGVLoose2015",             &_tauPOGVLoose2015,             "_tauPOGVLoose2015[_nL]/O");
-            outputTree->Branch("_tauPOGLoose2015",              &_tauPOGLoose2015,              "_tauPOGLoose2015[_nL]/O");
-            outputTree->Branch("_tauPOGMedium2015",             &_tauPOGMedium2015,             "_tauPOGMedium2015[_nL]/O");
-            outputTree->Branch("_tauPOGTight2015",              &_tauPOGTight2015,              "_tauPOGTight2015[_nL]/O");
-            outputTree->Branch("_tauPOGVTight2015",             &_tauPOGVTight2015,             "_tauPOGVTight2015[_nL]/O");
-            outputTree->Branch("_tauVLooseMvaNew2015",          &_tauVLooseMvaNew2015,          "_tauVLooseMvaNew2015[_nL]/O");
-            outputTree->Branch("_tauLooseMvaNew2015",           &_tauLooseMvaNew2015,           "_tauLooseMvaNew2015[_nL]/O");
-            outputTree->Branch("_tauMediumMvaNew2015",          &_tauMediumMvaNew2015,          "_tauMediumMvaNew2015[_nL]/O");
-            outputTree->Branch("_tauTightMvaNew2015",           &_tauTightMvaNew2015,           "_tauTightMvaNew2015[_nL]/O");
-            outputTree->Branch("_tauVTightMvaNew2015",          &_tauVTightMvaNew2015,          "_tauVTightMvaNew2015[_nL]/O");
-            outputTree->Branch("_tauPOGVVLoose2017v2",          &_tauPOGVVLoose2017v2,          "_tauPOGVVLoose2017v2[_nL]/O");
-            outputTree->Branch("_tauPOGVTight2017v2",           &_tauPOGVTight2017v2,           "_tauPOGVTight2017v2[_nL]/O");
-            outputTree->Branch("_tauPOGVVTight2017v2",          &_tauPOGVVTight2017v2,          "_tauPOGVVTight2017v2[_nL]/O");
-            outputTree->Branch("_tauVLooseMvaNew2017v2",        &_tauVLooseMvaNew2017v2,        "_tauVLooseMvaNew2017v2[_nL]/O");
-            outputTree->Branch("_tauLooseMvaNew2017v2",         &_tauLooseMvaNew2017v2,         "_tauLooseMvaNew2017v2[_nL]/O");
-            outputTree->Branch("_tauMediumMvaNew2017v2",        &_tauMediumMvaNew2017v2,        "_tauMediumMvaNew2017v2[_nL]/O");
-            outputTree->Branch("_tauTightMvaNew2017v2",         &_tauTightMvaNew2017v2,         "_tauTightMvaNew2017v2[_nL]/O");
-            outputTree->Branch("_tauVTightMvaNew2017v2",        &_tauVTightMvaNew2017v2,        "_tauVTightMvaNew2017v2[_nL]/O");
-            outputTree->Branch("_tauMuonVetoLoose",             &_tauMuonVetoLoose,             "_tauMuonVetoLoose[_nL]/O");
-            outputTree->Branch("_tauMuonVetoTight",             &_tauMuonVetoTight,             "_tauMuonVetoTight[_nL]/O");
-            outputTree->Branch("_tauEleVetoVLoose",             &_tauEleVetoVLoose,             "_tauEleVetoVLoose[_nL]/O");
-            outputTree->Branch("_tauEleVetoLoose",              &_tauEleVetoLoose,              "_tauEleVetoLoose[_nL]/O");
-            outputTree->Branch("_tauEleVetoMedium",             &_tauEleVetoMedium,             "_tauEleVetoMedium[_nL]/O");
-            outputTree->Branch("_tauEleVetoTight",              &_tauEleVetoTight,              "_tauEleVetoTight[_nL]/O");
-            outputTree->Branch("_tauEleVetoVTight",             &_tauEleVetoVTight,             "_tauEleVetoVTight[_nL]/O");
+            addOutputBranch(outputTree, "_tauDecayMode",                 &_tauDecayMode,                 "_tauDecayMode[_nL]/i");
+            addOutputBranch(outputTree, "_decayModeFinding",             &_decayModeFinding,             "_decayModeFinding[_nL]/O");
+            addOutputBranch(outputTree, "_decayModeFindingNew",          &_decayModeFindingNew,          "_decayModeFindingNew[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGVLoose2015",             &_tauPOGVLoose2015,             "_tauPOGVLoose2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGLoose2015",              &_tauPOGLoose2015,              "_tauPOGLoose2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGMedium2015",             &_tauPOGMedium2015,             "_tauPOGMedium2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGTight2015",              &_tauPOGTight2015,              "_tauPOGTight2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGVTight2015",             &_tauPOGVTight2015,             "_tauPOGVTight2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauVLooseMvaNew2015",          &_tauVLooseMvaNew2015,          "_tauVLooseMvaNew2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauLooseMvaNew2015",           &_tauLooseMvaNew2015,           "_tauLooseMvaNew2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauMediumMvaNew2015",          &_tauMediumMvaNew2015,          "_tauMediumMvaNew2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauTightMvaNew2015",           &_tauTightMvaNew2015,           "_tauTightMvaNew2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauVTightMvaNew2015",          &_tauVTightMvaNew2015,          "_tauVTightMvaNew2015[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGVVLoose2017v2",          &_tauPOGVVLoose2017v2,          "_tauPOGVVLoose2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGVTight2017v2",           &_tauPOGVTight2017v2,           "_tauPOGVTight2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauPOGVVTight2017v2",          &_tauPOGVVTight2017v2,          "_tauPOGVVTight2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauVLooseMvaNew2017v2",        &_tauVLooseMvaNew2017v2,        "_tauVLooseMvaNew2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauLooseMvaNew2017v2",         &_tauLooseMvaNew2017v2,         "_tauLooseMvaNew2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauMediumMvaNew2017v2",        &_tauMediumMvaNew2017v2,        "_tauMediumMvaNew2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauTightMvaNew2017v2",         &_tauTightMvaNew2017v2,         "_tauTightMvaNew2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauVTightMvaNew2017v2",        &_tauVTightMvaNew2017v2,        "_tauVTightMvaNew2017v2[_nL]/O");
+            addOutputBranch(outputTree, "_tauMuonVetoLoose",             &_tauMuonVetoLoose,             "_tauMuonVetoLoose[_nL]/O");
+            addOutputBranch(outputTree, "_tauMuonVetoTight",             &_tauMuonVetoTight,             "_tauMuonVetoTight[_nL]/O");
+            addOutputBranch(outputTree, "_tauEleVetoVLoose",             &_tauEleVetoVLoose,             "_tauEleVetoVLoose[_nL]/O");
+            addOutputBranch(outputTree, "_tauEleVetoLoose",              &_tauEleVetoLoose,              "_tauEleVetoLoose[_nL]/O");
+            addOutputBranch(outputTree, "_tauEleVetoMedium",             &_tauEleVetoMedium,             "_tauEleVetoMedium[_nL]/O");
+            addOutputBranch(outputTree, "_tauEleVetoTight",              &_tauEleVetoTight,              "_tauEleVetoTight[_nL]/O");
+            addOutputBranch(outputTree, "_tauEleVetoVTight",             &_tauEleVetoVTight,             "_tauEleVetoVTight[_nL]/O");
         }
     }
 
@@ -961,22 +1789,22 @@ void TreeReader::setOutputTree( TTree* outputTree,
             std::cerr << msg << std::endl;
         }
 	else{
-	    outputTree->Branch("_weight",                    &_weight,                    "_weight/D");
-	    outputTree->Branch("_nLheWeights",               &_nLheWeights,               "_nLheWeights/i");
-	    outputTree->Branch("_lheWeight",                 &_lheWeight,                 "_lheWeight[_nLheWeights]/D");
-	    outputTree->Branch("_nPsWeights",                &_nPsWeights,                "_nPsWeights/i");
-	    outputTree->Branch("_psWeight",                  &_psWeight,                  "_psWeight[_nPsWeights]/D");
-	    outputTree->Branch("_nTrueInt",                  &_nTrueInt,                  "_nTrueInt/F");
-	    outputTree->Branch("_lheHTIncoming",             &_lheHTIncoming,             "_lheHTIncoming/D");
-	    outputTree->Branch("_lIsPrompt",                 &_lIsPrompt,                 "_lIsPrompt[_nL]/O");
-	    outputTree->Branch("_lMatchPdgId",               &_lMatchPdgId,               "_lMatchPdgId[_nL]/I");
-	    outputTree->Branch("_lMatchCharge",              &_lMatchCharge,              "_lMatchCharge[_nL]/I");
-	    outputTree->Branch("_lMomPdgId",                 &_lMomPdgId,                 "_lMomPdgId[_nL]/I");
-	    outputTree->Branch("_lProvenance",               &_lProvenance,               "_lProvenance[_nL]/i");
-	    outputTree->Branch("_lProvenanceCompressed",     &_lProvenanceCompressed,     "_lProvenanceCompressed[_nL]/i");
-	    outputTree->Branch("_lProvenanceConversion",     &_lProvenanceConversion,     "_lProvenanceConversion[_nL]/i");
-	    outputTree->Branch("_ttgEventType",              &_ttgEventType,              "_ttgEventType/i");
-	    outputTree->Branch("_zgEventType",               &_zgEventType,               "_zgEventType/i");
+	    addOutputBranch(outputTree, "_weight",                    &_weight,                    "_weight/D");
+	    addOutputBranch(outputTree, "_nLheWeights",               &_nLheWeights,               "_nLheWeights/i");
+	    addOutputBranch(outputTree, "_lheWeight",                 &_lheWeight,                 "_lheWeight[_nLheWeights]/D");
+	    addOutputBranch(outputTree, "_nPsWeights",                &_nPsWeights,                "_nPsWeights/i");
+	    addOutputBranch(outputTree, "_psWeight",                  &_psWeight,                  "_psWeight[_nPsWeights]/D");
+	    addOutputBranch(outputTree, "_nTrueInt",                  &_nTrueInt,                  "_nTrueInt/F");
+	    addOutputBranch(outputTree, "_lheHTIncoming",             &_lheHTIncoming,             "_lheHTIncoming/D");
+	    addOutputBranch(outputTree, "_lIsPrompt",                 &_lIsPrompt,                 "_lIsPrompt[_nL]/O");
+	    addOutputBranch(outputTree, "_lMatchPdgId",               &_lMatchPdgId,               "_lMatchPdgId[_nL]/I");
+	    addOutputBranch(outputTree, "_lMatchCharge",              &_lMatchCharge,              "_lMatchCharge[_nL]/I");
+	    addOutputBranch(outputTree, "_lMomPdgId",                 &_lMomPdgId,                 "_lMomPdgId[_nL]/I");
+	    addOutputBranch(outputTree, "_lProvenance",               &_lProvenance,               "_lProvenance[_nL]/i");
+	    addOutputBranch(outputTree, "_lProvenanceCompressed",     &_lProvenanceCompressed,     "_lProvenanceCompressed[_nL]/i");
+	    addOutputBranch(outputTree, "_lProvenanceConversion",     &_lProvenanceConversion,     "_lProvenanceConversion[_nL]/i");
+	    addOutputBranch(outputTree, "_ttgEventType",              &_ttgEventType,              "_ttgEventType/i");
+	    addOutputBranch(outputTree, "_zgEventType",               &_zgEventType,               "_zgEventType/i");
 	}
     }
 
@@ -989,57 +1817,48 @@ void TreeReader::setOutputTree( TTree* outputTree,
             std::cerr << msg << std::endl;
         }
 	else{
-	    outputTree->Branch("_gen_met",                   &_gen_met,                   "_gen_met/D");
-	    outputTree->Branch("_gen_metPhi",                &_gen_metPhi,                "_gen_metPhi/D");
-	    outputTree->Branch("_gen_nL",                    &_gen_nL,                    "_gen_nL/i");
-	    outputTree->Branch("_gen_lPt",                   &_gen_lPt,                   "_gen_lPt[_gen_nL]/D");
-	    outputTree->Branch("_gen_lEta",                  &_gen_lEta,                  "_gen_lEta[_gen_nL]/D");
-	    outputTree->Branch("_gen_lPhi",                  &_gen_lPhi,                  "_gen_lPhi[_gen_nL]/D");
-	    outputTree->Branch("_gen_lE",                    &_gen_lE,                    "_gen_lE[_gen_nL]/D");
-	    outputTree->Branch("_gen_lFlavor",               &_gen_lFlavor,               "_gen_lFlavor[_gen_nL]/i");
-	    outputTree->Branch("_gen_lCharge",               &_gen_lCharge,               "_gen_lCharge[_gen_nL]/I");
-	    outputTree->Branch("_gen_lMomPdg",               &_gen_lMomPdg,               "_gen_lMomPdg[_gen_nL]/I");
-	    outputTree->Branch("_gen_lIsPrompt",             &_gen_lIsPrompt,             "_gen_lIsPrompt[_gen_nL]/O");
+	    addOutputBranch(outputTree, "_gen_met",                   &_gen_met,                   "_gen_met/D");
+	    addOutputBranch(outputTree, "_gen_metPhi",                &_gen_metPhi,                "_gen_metPhi/D");
+	    addOutputBranch(outputTree, "_gen_nL",                    &_gen_nL,                    "_gen_nL/i");
+	    addOutputBranch(outputTree, "_gen_lPt",                   &_gen_lPt,                   "_gen_lPt[_gen_nL]/D");
+	    addOutputBranch(outputTree, "_gen_lEta",                  &_gen_lEta,                  "_gen_lEta[_gen_nL]/D");
+	    addOutputBranch(outputTree, "_gen_lPhi",                  &_gen_lPhi,                  "_gen_lPhi[_gen_nL]/D");
+	    addOutputBranch(outputTree, "_gen_lE",                    &_gen_lE,                    "_gen_lE[_gen_nL]/D");
+	    addOutputBranch(outputTree, "_gen_lFlavor",               &_gen_lFlavor,               "_gen_lFlavor[_gen_nL]/i");
+	    addOutputBranch(outputTree, "_gen_lCharge",               &_gen_lCharge,               "_gen_lCharge[_gen_nL]/I");
+	    addOutputBranch(outputTree, "_gen_lMomPdg",               &_gen_lMomPdg,               "_gen_lMomPdg[_gen_nL]/I");
+	    addOutputBranch(outputTree, "_gen_lIsPrompt",             &_gen_lIsPrompt,             "_gen_lIsPrompt[_gen_nL]/O");
 	}
     }
 
     if( isMC() ){
-       	outputTree->Branch("_prefireWeight",             &_prefireWeight,             "_prefireWeight/F");
-        outputTree->Branch("_prefireWeightUp",           &_prefireWeightUp,           "_prefireWeightUp/F");
-        outputTree->Branch("_prefireWeightDown",         &_prefireWeightDown,         "_prefireWeightDown/F"); 
+       	addOutputBranch(outputTree, "_prefireWeight",             &_prefireWeight,             "_prefireWeight/F");
+        addOutputBranch(outputTree, "_prefireWeightUp",           &_prefireWeightUp,           "_prefireWeightUp/F");
+        addOutputBranch(outputTree, "_prefireWeightDown",         &_prefireWeightDown,         "_prefireWeightDown/F"); 
     }
 
     if( containsSusyMassInfo() ){
-	outputTree->Branch("_mChi1", &_mChi1, "_mChi1/D");
-	outputTree->Branch("_mChi2", &_mChi2, "_mChi2/D");
+	addOutputBranch(outputTree, "_mChi1", &_mChi1, "_mChi1/D");
+	addOutputBranch(outputTree, "_mChi2", &_mChi2, "_mChi2/D");
     }
 
     //write individual trigger decisions to output tree 
-    setMapOutputBranches( outputTree, _triggerMap, "/O" );
+    setMapOutputBranches( outputTree, _triggerMap, "/O", _slimmingProfile );
 
     //write individual MET filters to output tree
-    setMapOutputBranches( outputTree, _MetFilterMap, "/O" );
-
-    // write split JEC uncertainties to output tree
-    if( includeJECSources ){
-	setMapOutputBranches( outputTree, _jetPt_JECSourcesUp, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _jetPt_JECSourcesDown, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _jetSmearedPt_JECSourcesUp, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _jetSmearedPt_JECSourcesDown, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _corrMETx_JECSourcesUp, "/D");
-        setMapOutputBranches( outputTree, _corrMETx_JECSourcesDown, "/D");
-        setMapOutputBranches( outputTree, _corrMETy_JECSourcesUp, "/D");
-        setMapOutputBranches( outputTree, _corrMETy_JECSourcesDown, "/D");
-    }
-    if( includeJECGrouped ){
-	setMapOutputBranches( outputTree, _jetPt_JECGroupedUp, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _jetPt_JECGroupedDown, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _jetSmearedPt_JECGroupedUp, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _jetSmearedPt_JECGroupedDown, "[_nJets]/D" );
-	setMapOutputBranches( outputTree, _corrMETx_JECGroupedUp, "/D");
-	setMapOutputBranches( outputTree, _corrMETx_JECGroupedDown, "/D");
-	setMapOutputBranches( outputTree, _corrMETy_JECGroupedUp, "/D");
-	setMapOutputBranches( outputTree, _corrMETy_JECGroupedDown, "/D");
+    setMapOutputBranches( outputTree, _MetFilterMap, "/O", _slimmingProfile );
+
+    // write split and grouped JEC uncertainties present in the input tree to output tree
+    for( JECVariationTable::size_type v = 0; v < _JECVariationTable->size(); ++v ){
+        if( _JECVariationTable->isGrouped( v ) ? !includeJECGrouped : !includeJECSources ) continue;
+        setJECVariationOutputBranch( outputTree, "_jetPt", v, "Up", &_jetPt_JECVariationsUp[ v*nJets_max ], b__jetPt_JECVariationsUp[ v ], true );
+        setJECVariationOutputBranch( outputTree, "_jetPt", v, "Down", &_jetPt_JECVariationsDown[ v*nJets_max ], b__jetPt_JECVariationsDown[ v ], true );
+        setJECVariationOutputBranch( outputTree, "_jetSmearedPt", v, "Up", &_jetSmearedPt_JECVariationsUp[ v*nJets_max ], b__jetSmearedPt_JECVariationsUp[ v ], true );
+        setJECVariationOutputBranch( outputTree, "_jetSmearedPt", v, "Down", &_jetSmearedPt_JECVariationsDown[ v*nJets_max ], b__jetSmearedPt_JECVariationsDown[ v ], true );
+        setJECVariationOutputBranch( outputTree, "_corrMETx", v, "Up", &_corrMETx_JECVariationsUp[ v ], b__corrMETx_JECVariationsUp[ v ], false );
+        setJECVariationOutputBranch( outputTree, "_corrMETx", v, "Down", &_corrMETx_JECVariationsDown[ v ], b__corrMETx_JECVariationsDown[ v ], false );
+        setJECVariationOutputBranch( outputTree, "_corrMETy", v, "Up", &_corrMETy_JECVariationsUp[ v ], b__corrMETy_JECVariationsUp[ v ], false );
+        setJECVariationOutputBranch( outputTree, "_corrMETy", v, "Down", &_corrMETy_JECVariationsDown[ v ], b__corrMETy_JECVariationsDown[ v ], false );
     }
 }
 
@@ -100,8 +100,10 @@ void deriveChargeFlipCorrections( const std::string& year,
     
     // make TreeReader and loop over samples
     TreeReader treeReader( sampleListFile, sampleDirectory );
+    // only read the branches needed for this measurement
+    treeReader.setBranchProfile( BranchProfile( "chargeflip" ) );
     for( unsigned i = 0; i < treeReader.numberOfSamples(); ++i ){
-        treeReader.initSample();
+        treeReader.initSample( i );
 
 	// loop over entries
         long unsigned numberOfEntries = treeReader.numberOfEntries();
@@ -12,6 +12,7 @@ Perform a charge flip measurement in MC
 
 // include other parts of framework
 #include "../TreeReader/interface/TreeReader.h"
+#include "../TreeReader/interface/ParallelEventLoop.h"
 #include "../Event/interface/Event.h"
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
@@ -27,7 +28,8 @@ Perform a charge flip measurement in MC
 void determineMCChargeFlipRate( const std::string& year, 
 				const std::string& sampleListFile, 
 				const std::string& sampleDirectory,
-				const long nEntries ){
+				const long nEntries,
+				const unsigned numberOfThreads ){
 
     // simple check on provided year identifier
     analysisTools::checkYearString( year );
@@ -50,24 +52,33 @@ void determineMCChargeFlipRate( const std::string& year,
 	ptBins.size() - 1, &ptBins[0], etaBins.size() - 1, &etaBins[0] ) );
     denominatorMap->Sumw2();
 
+    // histograms are owned by the shared pointers, and are filled in several threads
+    TH1::AddDirectory( false );
+
     // make TreeReader and loop over samples
     TreeReader treeReader( sampleListFile, sampleDirectory );
-    for( unsigned i = 0; i < treeReader.numberOfSamples(); ++i ){
-        treeReader.initSample();
-    
-	// loop over entries
-	long unsigned numberOfEntries = treeReader.numberOfEntries();
-	if( nEntries>0 && (unsigned)nEntries<numberOfEntries ){ 
-	    numberOfEntries = (unsigned) nEntries; 
-	}
-        for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
-
-	    // build the event
-            Event event = treeReader.buildEvent( entry );
+    for( const auto& sample : treeReader.sampleVector() ){
+
+	// split the entries of each sample over the threads
+	ParallelEventLoop eventLoop( sample, numberOfThreads );
+	// only read the branches needed for this measurement
+	eventLoop.setBranchProfile( BranchProfile( "chargeflip" ) );
+	if( nEntries > 0 ) eventLoop.setMaximumNumberOfEntries( nEntries );
+
+	// each thread fills its own copy of the numerator and denominator
+	using HistogramPair = std::pair< std::shared_ptr< TH2D >, std::shared_ptr< TH2D > >;
+	auto makeHistograms = [&](){
+	    std::shared_ptr< TH2D > numerator( dynamic_cast< TH2D* >( numeratorMap->Clone() ) );
+	    std::shared_ptr< TH2D > denominator( dynamic_cast< TH2D* >( denominatorMap->Clone() ) );
+	    numerator->Reset();
+	    denominator->Reset();
+	    return HistogramPair( numerator, denominator );
+	};
+	auto fillHistograms = []( Event& event, HistogramPair& histograms ){
 
             // apply electron selection
 	    // arguments are: diElectron, onZ, bVeto
-            if( ! chargeFlips::passChargeFlipEventSelection(event, false, false, false) ) continue;
+            if( ! chargeFlips::passChargeFlipEventSelection(event, false, false, false) ) return;
 
 	    // loop over electrons in the event
             for( auto& electronPtr : event.electronCollection() ){
@@ -80,14 +91,21 @@ void determineMCChargeFlipRate( const std::string& year,
                 if( electron.matchPdgId() == 22 ) continue;
 
                 // fill denominator histogram 
-                histogram::fillValues( denominatorMap.get(), electron.pt(), electron.absEta(), 1. );
+                histogram::fillValues( histograms.second.get(), electron.pt(), electron.absEta(), 1. );
     
                 //fill numerator histogram
                 if( electron.isChargeFlip() ){
-                    histogram::fillValues( numeratorMap.get(), electron.pt(), electron.absEta(), 1. );
+                    histogram::fillValues( histograms.first.get(), electron.pt(), electron.absEta(), 1. );
                 }
             }
-        }
+	};
+	auto mergeHistograms = []( HistogramPair& histograms, const HistogramPair& other ){
+	    histograms.first->Add( other.first.get() );
+	    histograms.second->Add( other.second.get() );
+	};
+	HistogramPair sampleHistograms = eventLoop.run( makeHistograms, fillHistograms, mergeHistograms );
+	numeratorMap->Add( sampleHistograms.first.get() );
+	denominatorMap->Add( sampleHistograms.second.get() );
     }
 
     // divide numerator by denominator to get charge flip rate
@@ -118,14 +136,15 @@ int main( int argc, char* argv[] ){
     std::cerr << "###starting###" << std::endl;
     // check command line arguments
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
-    if( !( argvStr.size() == 6 ) ){
+    if( !( argvStr.size() == 6 || argvStr.size() == 7 ) ){
         std::cerr << "ERROR: found " << argc-1 << " command line args,";
-	std::cerr << " while 5 are needed:" << std::endl;
+	std::cerr << " while 5 or 6 are needed:" << std::endl;
         std::cerr << "  - flavour (only 'electron' supported for now)" << std::endl;
 	std::cerr << "  - year" << std::endl;
 	std::cerr << "  - sample list" << std::endl;
 	std::cerr << "  - sample directory" << std::endl;
 	std::cerr << "  - number of entries" << std::endl;
+	std::cerr << "  - number of threads (optional, default 1, 0 means all cores)" << std::endl;
         return 1;
     }
     std::string flavor = argvStr[1];
@@ -133,9 +152,11 @@ int main( int argc, char* argv[] ){
     std::string sampleList = argvStr[3];
     std::string sampleDirectory = argvStr[4];
     long nEntries = std::stol(argvStr[5]);
+    unsigned numberOfThreads = 1;
+    if( argvStr.size() == 7 ) numberOfThreads = std::stoul(argvStr[6]);
     setTDRStyle();
     determineMCChargeFlipRate(
-	year, sampleList, sampleDirectory, nEntries);
+	year, sampleList, sampleDirectory, nEntries, numberOfThreads);
     std::cerr << "###done###" << std::endl;
     return 0;
 }
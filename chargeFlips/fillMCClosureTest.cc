@@ -11,6 +11,7 @@ Perform a closure test for the MC charge flip rates
 
 // include other parts of framework
 #include "../TreeReader/interface/TreeReader.h"
+#include "../TreeReader/interface/SampleListScheduler.h"
 #include "../Event/interface/Event.h"
 #include "../Tools/interface/HistInfo.h"
 #include "../plotting/plotCode.h"
@@ -62,7 +63,8 @@ void closureTest_MC( const std::string& process,
 		     const std::string& year, 
 		     const std::string& sampleListFile,
 		     const std::string& sampleDirectory,
-		     const long nEntries ){
+		     const long nEntries,
+		     const unsigned numberOfThreads ){
 
     // check process string
     if( ! (process == "TT" || process == "DY" ) ){
@@ -71,6 +73,8 @@ void closureTest_MC( const std::string& process,
     }
 
     // make collection of histograms
+    // (histograms are owned by the shared pointers, and are filled in several threads)
+    TH1::AddDirectory( false );
     std::vector< std::shared_ptr< TH1D > > observedHists; 
     std::vector< std::shared_ptr< TH1D > > predictedHists;
 
@@ -87,23 +91,28 @@ void closureTest_MC( const std::string& process,
     std::shared_ptr< TH2D > chargeFlipMap_electron = readChargeFlipMap( year );
 
 
-    // make TreeReader and loop over samples
-    TreeReader treeReader( sampleListFile, sampleDirectory );
-    for( unsigned i = 0; i < treeReader.numberOfSamples(); ++i ){
-        treeReader.initSample();
-    
-        // loop over entries
-        long unsigned numberOfEntries = treeReader.numberOfEntries();
-        if( nEntries>0 && (unsigned)nEntries<numberOfEntries ){
-            numberOfEntries = (unsigned) nEntries;
-        }
-        for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
- 
-	    // build event
-	    Event event = treeReader.buildEvent( entry );
+    // process all samples in parallel, keeping the histograms per sample
+    SampleListScheduler scheduler( sampleListFile, sampleDirectory, numberOfThreads );
+    // only read the branches needed for this measurement
+    scheduler.setBranchProfile( BranchProfile( "chargeflip" ) );
+    if( nEntries > 0 ) scheduler.setMaximumNumberOfEntries( nEntries );
+
+    using HistogramVectors = std::pair< std::vector< std::shared_ptr< TH1D > >,
+					std::vector< std::shared_ptr< TH1D > > >;
+    auto makeHistograms = [&]( const Sample& ){
+	HistogramVectors histograms;
+	for( const auto& histInfo : histInfoVec ){
+	    histograms.first.push_back( histInfo.makeHist( 
+		histInfo.name() + "_observed_" + process + "_" + year ) );
+	    histograms.second.push_back( histInfo.makeHist( 
+		histInfo.name() + "_predicted_"  + process + "_" + year ) );
+	}
+	return histograms;
+    };
+    auto fillHistograms = [&]( Event& event, HistogramVectors& histograms ){
 
             // apply event selection
-            if( !chargeFlips::passChargeFlipEventSelection( event, true, false, false ) ) continue;
+            if( !chargeFlips::passChargeFlipEventSelection( event, true, false, false ) ) return;
 
             // get electron collection
             ElectronCollection electrons = event.electronCollection();
@@ -116,7 +125,7 @@ void closureTest_MC( const std::string& process,
                     break;
                 }
             }
-            if( !promptElectrons ) continue;
+            if( !promptElectrons ) return;
 
             // compute plotting variables 
             std::vector< double > variables = { electrons[0].pt(), electrons[1].pt(),
@@ -141,7 +150,7 @@ void closureTest_MC( const std::string& process,
 
             if( isObserved ){
                 for( std::vector< double >::size_type v = 0; v < variables.size(); ++v ){
-                    observedHists[v]->Fill( std::min( variables[v],  
+                    histograms.first[v]->Fill( std::min( variables[v],  
 			histInfoVec[v].maxBinCenter() ), event.weight() );
                 }
 
@@ -150,11 +159,26 @@ void closureTest_MC( const std::string& process,
                 double weight = event.weight()*chargeFlips::chargeFlipWeight( 
 				    event, chargeFlipMap_electron );
                 for( std::vector< double >::size_type v = 0; v < variables.size(); ++v ){
-                    predictedHists[v]->Fill( std::min( variables[v],  
+                    histograms.second[v]->Fill( std::min( variables[v],  
 			histInfoVec[v].maxBinCenter() ), weight );
                 }
             }
-        }
+    };
+    auto mergeHistograms = []( HistogramVectors& histograms, const HistogramVectors& other ){
+	for( std::vector< std::shared_ptr< TH1D > >::size_type v = 0; v < histograms.first.size(); ++v ){
+	    histograms.first[v]->Add( other.first[v].get() );
+	    histograms.second[v]->Add( other.second[v].get() );
+	}
+    };
+    std::map< std::string, HistogramVectors > sampleHistograms = scheduler.run(
+	makeHistograms, fillHistograms, mergeHistograms );
+
+    // sum the samples
+    for( const auto& entry : sampleHistograms ){
+	for( std::vector< HistInfo >::size_type v = 0; v < histInfoVec.size(); ++v ){
+	    observedHists[v]->Add( entry.second.first[v].get() );
+	    predictedHists[v]->Add( entry.second.second[v].get() );
+	}
     }
 
     // make plot output directory
@@ -185,15 +209,16 @@ int main( int argc, char* argv[] ){
     std::cerr << "###starting###" << std::endl;
     // check command line arguments
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
-    if( !( argvStr.size() == 7 ) ){
+    if( !( argvStr.size() == 7 || argvStr.size() == 8 ) ){
         std::cerr << "ERROR: found " << argc-1 << " command line args,";
-        std::cerr << " while 6 are needed:" << std::endl;
+        std::cerr << " while 6 or 7 are needed:" << std::endl;
         std::cerr << "  - process" << std::endl;
 	std::cerr << "  - flavour (only 'electron' supported for now)" << std::endl;
         std::cerr << "  - year" << std::endl;
         std::cerr << "  - sample list" << std::endl;
         std::cerr << "  - sample directory" << std::endl;
         std::cerr << "  - number of entries" << std::endl;
+        std::cerr << "  - number of threads (optional, default 1, 0 means all cores)" << std::endl;
         return 1;
     }
     std::string process = argvStr[1];
@@ -202,9 +227,11 @@ int main( int argc, char* argv[] ){
     std::string sampleList = argvStr[4];
     std::string sampleDirectory = argvStr[5];
     long nEntries = std::stol(argvStr[6]);
+    unsigned numberOfThreads = 1;
+    if( argvStr.size() == 8 ) numberOfThreads = std::stoul(argvStr[7]);
     setTDRStyle();
     closureTest_MC(
-        process, year, sampleList, sampleDirectory, nEntries);
+        process, year, sampleList, sampleDirectory, nEntries, numberOfThreads);
     std::cerr << "###done###" << std::endl;
     return 0; 
 }
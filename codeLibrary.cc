@@ -28,6 +28,7 @@
 #include "Event/src/GeneratorInfo.cc"
 #include "Event/src/SusyMassInfo.cc"
 #include "Event/src/EventTags.cc"
+#include "Event/src/PhysicsObjectArrays.cc"
 #include "Event/src/Event.cc"
 
 //include Tools code 
@@ -37,6 +38,7 @@
 #include "Tools/src/IndexFlattener.cc"
 #include "Tools/src/Categorization.cc"
 #include "Tools/src/Sample.cc"
+#include "Tools/src/OutputFileSettings.cc"
 #include "Tools/src/mergeAndRemoveOverlap.cc"
 #include "Tools/src/histogramTools.cc"
 #include "Tools/src/SusyScan.cc"
@@ -45,9 +47,20 @@
 #include "Tools/src/SampleCrossSections.cc"
 #include "Tools/src/QuantileBinner.cc"
 #include "Tools/src/mt2.cc"
+#include "Tools/src/overlapRemoval.cc"
 
 //include TreeReader code 
 #include "TreeReader/src/TreeReader.cc"
+#include "TreeReader/src/BranchProfile.cc"
+#include "TreeReader/src/BranchNameIndex.cc"
+#include "TreeReader/src/ReadCacheSettings.cc"
+#include "TreeReader/src/JECVariationTable.cc"
+#include "TreeReader/src/DecisionTable.cc"
+#include "TreeReader/src/PreSelection.cc"
+#include "TreeReader/src/SlimmingProfile.cc"
+#include "TreeReader/src/ColumnarCache.cc"
+#include "TreeReader/src/ParallelEventLoop.cc"
+#include "TreeReader/src/SampleListScheduler.cc"
 #include "TreeReader/src/TreeReaderErrors.cc"
 
 //include plotting code 
@@ -57,6 +70,8 @@
 
 //include Reweighter code 
 #include "weights/bTagSFCode/BTagCalibrationStandaloneUL.cc"
+#include "weights/src/ScaleFactorTable.cc"
+#include "weights/src/ScaleFactorRegistry.cc"
 #include "weights/src/ReweighterBTag.cc"
 #include "weights/src/ReweighterBTagHeavyFlavor.cc"
 #include "weights/src/ReweighterBTagLightFlavor.cc"
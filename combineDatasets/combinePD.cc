@@ -8,6 +8,8 @@
 //include other parts of framework
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
+#include "../Tools/interface/OutputFileSettings.h"
+#include "../TreeReader/interface/ReadCacheSettings.h"
 
 
 int main( int argc, char* argv[] ){
@@ -15,6 +17,14 @@ int main( int argc, char* argv[] ){
     //convert all input to std::string format for easier handling
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
 
+    //read cache options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+
+    //merged datasets are final files that are rarely rewritten, so they are compressed as much as possible by default
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr, "archive" );
+    argc = static_cast< int >( argvStr.size() );
+
     //merge data files present in input directory ( separately for the years )
     if( argc == 3 && !stringTools::stringContains( argvStr[2], ".root" ) ){
         const std::string input_directory = argvStr[1];
@@ -46,7 +56,7 @@ int main( int argc, char* argv[] ){
             
             //submit job to merge files 
             const std::string outputPath = stringTools::formatDirectoryName( output_directory ) + "data_combined_" + year + ".root";
-            std::string mergeCommand = "./combinePD " + outputPath;
+            std::string mergeCommand = "./combinePD " + outputPath + readCacheSettings.commandLineOptions() + outputFileSettings.commandLineOptions();
             for( const auto& input : filesToMerge ){
                 mergeCommand += ( " " + input );
             }
@@ -60,13 +70,16 @@ int main( int argc, char* argv[] ){
         std::string outputPath = argvStr[1];
 
         std::vector< std::string > inputFiles( argvStr.begin() + 2, argvStr.end() );
-        mergeAndRemoveOverlap( inputFiles, outputPath );
+        outputFileSettings.enableParallelCompression();
+        mergeAndRemoveOverlap( inputFiles, outputPath, false, readCacheSettings, outputFileSettings );
 
 	    return 0;
     } else {
         std::cerr << argc - 1 << " command line arguments given, while at least 2 are expected." << std::endl;
         std::cerr << "Usage: ./combinePD < output_path > < space separated list of input files >" << std::endl;
         std::cerr << "Usage: ./combinePD < input_directory containing data sample > < space separated list of input files >" << std::endl;
+        std::cerr << ReadCacheSettings::commandLineUsage() << std::endl;
+        std::cerr << OutputFileSettings::commandLineUsage() << std::endl;
         return 1;
     }
 }
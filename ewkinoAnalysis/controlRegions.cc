@@ -109,7 +109,7 @@ std::vector< double > buildFillingVector( Event& event, const std::string& uncer
 
 
 
-void analyze( const std::string& modelName, const std::string& deltaM, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath ){
+void analyze( const std::string& modelName, const std::string& deltaM, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath, const ReadCacheSettings& readCacheSettings ){
 
 	analysisTools::checkYearString( year );
 
@@ -152,12 +152,29 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
     std::cout << "building treeReader" << std::endl;
     TreeReader treeReader( "sampleLists/samples_" + modelName + "_" + year + ".txt", sampleDirectoryPath );
     treeReader.removeBSMSignalSamples();
+    treeReader.setReadCache( readCacheSettings );
+
+    //most events fail the baseline selection, so only read the other branches when they are needed
+    treeReader.setLazyReading();
 
     //build ewkino reweighter
     std::cout << "building reweighter" << std::endl;
     std::shared_ptr< ReweighterFactory >reweighterFactory( new EwkinoReweighterFactory() );
     CombinedReweighter reweighter = reweighterFactory->buildReweighter( "../weights/", year, treeReader.sampleVector() );
 
+    //positions of the reweighters with shape uncertainties in the weight bank
+    const auto pileupIndex = reweighter.reweighterIndex( "pileup" );
+    const auto bTagIndex = reweighter.reweighterIndex( "bTag" );
+    const auto prefireIndex = reweighter.reweighterIndex( "prefire" );
+    std::vector< CombinedReweighter::size_type > recoIndices;
+    if( year != "2018" ){
+        recoIndices = { reweighter.reweighterIndex( "electronReco_pTBelow20" ), reweighter.reweighterIndex( "electronReco_pTAbove20" ) };
+    } else {
+        recoIndices = { reweighter.reweighterIndex( "electronReco" ) };
+    }
+    const std::vector< CombinedReweighter::size_type > leptonIDIndices = { reweighter.reweighterIndex( "muonID" ), reweighter.reweighterIndex( "electronID" ) };
+    WeightBank weightBank;
+
     //read FR maps
     std::cout << "building FR maps" << std::endl;
     TFile* frFileMuons = TFile::Open( ( "frMaps/fakeRateMap_data_muon_" + year + "_mT.root" ).c_str() );
@@ -242,7 +259,8 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
             //apply scale-factors and reweighting
             double weight = event.weight();
             if( event.isMC() ){
-                weight *= reweighter.totalWeight( event );
+                reweighter.computeWeights( event, weightBank );
+                weight *= weightBank.nominal();
             }
 
             //apply fake-rate weight
@@ -351,51 +369,48 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
             }
 
             //fill pileup down histograms
-            double weightPileupDown = reweighter[ "pileup" ]->weightDown( event ) / reweighter[ "pileup" ]->weight( event );
+            double weightPileupDown = weightBank.relativeWeightDown( pileupIndex );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncDown[ "pileup" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPileupDown );
             }
 
             //fill pileup up histograms
-            double weightPileupUp = reweighter[ "pileup" ]->weightUp( event ) / reweighter[ "pileup" ]->weight( event );
+            double weightPileupUp = weightBank.relativeWeightUp( pileupIndex );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncUp[ "pileup" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPileupUp );
             }
 
             //fill b-tag down histograms
             //WARNING : THESE SHOULD ACTUALLY BE SPLIT BETWEEN HEAVY AND LIGHT FLAVORS
-            double weightBTagDown = reweighter[ "bTag" ]->weightDown( event ) / reweighter[ "bTag" ]->weight( event );
+            double weightBTagDown = weightBank.relativeWeightDown( bTagIndex );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncDown[ "bTag_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightBTagDown );
             }
 
             //fill b-tag up histograms
             //WARNING : THESE SHOULD ACTUALLY BE SPLIT BETWEEN HEAVY AND LIGHT FLAVORS
-            double weightBTagUp = reweighter[ "bTag" ]->weightUp( event ) / reweighter[ "bTag" ]->weight( event );
+            double weightBTagUp = weightBank.relativeWeightUp( bTagIndex );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncUp[ "bTag_" + year ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightBTagUp );
             }
 
             //fill prefiring down histograms
-            double weightPrefireDown = reweighter[ "prefire" ]->weightDown( event ) / reweighter[ "prefire" ]->weight( event );
+            double weightPrefireDown = weightBank.relativeWeightDown( prefireIndex );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncDown[ "prefire" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPrefireDown );
             }
         
             //fill prefiring up histograms
-            double weightPrefireUp = reweighter[ "prefire" ]->weightUp( event ) / reweighter[ "prefire" ]->weight( event );
+            double weightPrefireUp = weightBank.relativeWeightUp( prefireIndex );
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
                 histogram::fillValue( histogramsUncUp[ "prefire" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * weightPrefireUp );
             }
 
-            double recoWeightDown;
-            double recoWeightUp;
-            if( !event.is2018() ){
-                recoWeightDown = reweighter[ "electronReco_pTBelow20" ]->weightDown( event ) * reweighter[ "electronReco_pTAbove20" ]->weightDown( event ) / ( reweighter[ "electronReco_pTBelow20" ]->weight( event ) * reweighter[ "electronReco_pTAbove20" ]->weight( event ) );
-                recoWeightUp = reweighter[ "electronReco_pTBelow20" ]->weightUp( event ) * reweighter[ "electronReco_pTAbove20" ]->weightUp( event ) / ( reweighter[ "electronReco_pTBelow20" ]->weight( event ) * reweighter[ "electronReco_pTAbove20" ]->weight( event ) );
-            } else {
-                recoWeightDown = reweighter[ "electronReco" ]->weightDown( event ) / ( reweighter[ "electronReco" ]->weight( event ) );
-                recoWeightUp = reweighter[ "electronReco" ]->weightUp( event ) / ( reweighter[ "electronReco" ]->weight( event ) );
+            double recoWeightDown = 1.;
+            double recoWeightUp = 1.;
+            for( auto index : recoIndices ){
+                recoWeightDown *= weightBank.relativeWeightDown( index );
+                recoWeightUp *= weightBank.relativeWeightUp( index );
             }
 
             //fill lepton reco down histograms 
@@ -408,8 +423,12 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
                 histogram::fillValue( histogramsUncUp[ "lepton_reco" ][ dist ][ fillIndex ].get(), fillValues[ dist ], weight * recoWeightUp );
             }
 
-            double leptonIDWeightDown = reweighter[ "muonID" ]->weightDown( event ) * reweighter[ "electronID" ]->weightDown( event ) / ( reweighter[ "muonID" ]->weight( event ) * reweighter[ "electronID" ]->weight( event ) );
-            double leptonIDWeightUp = reweighter[ "muonID" ]->weightUp( event ) * reweighter[ "electronID" ]->weightUp( event ) / ( reweighter[ "muonID" ]->weight( event ) * reweighter[ "electronID" ]->weight( event ) );
+            double leptonIDWeightDown = 1.;
+            double leptonIDWeightUp = 1.;
+            for( auto index : leptonIDIndices ){
+                leptonIDWeightDown *= weightBank.relativeWeightDown( index );
+                leptonIDWeightUp *= weightBank.relativeWeightUp( index );
+            }
 
             //fill lepton id down histograms
             for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
@@ -422,6 +441,7 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
             }
         }
     }
+    treeReader.printReadStatistics();
 
     //set negative contributions to zero
     for( size_t dist = 0; dist < histInfoVector.size(); ++dist ){
@@ -615,7 +635,7 @@ void analyze( const std::string& modelName, const std::string& deltaM, const std
 }
 
 
-void analyzeAllMasses( const std::string& modelName, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath ){
+void analyzeAllMasses( const std::string& modelName, const std::string& year, const std::string& controlRegion, const std::string& sampleDirectoryPath, const ReadCacheSettings& readCacheSettings ){
     TreeReader treeReader( "sampleLists/samples_" + modelName + "_" + year + ".txt", sampleDirectoryPath );
     SusyScan susyScan;
     for( const auto& sample : treeReader.sampleVector() ){
@@ -626,15 +646,15 @@ void analyzeAllMasses( const std::string& modelName, const std::string& year, co
 
     for( auto splitting : susyScan.massSplittings() ){
         std::string deltaM = std::to_string( splitting );
-        std::string commandString = "./controlRegions " + modelName + " " + deltaM + " " + year + " " + controlRegion;
+        std::string commandString = "./controlRegions " + modelName + " " + deltaM + " " + year + " " + controlRegion + readCacheSettings.commandLineOptions();
         std::string scriptName = controlRegion + "_" + modelName + "_" + deltaM + "_" + year + ".sh";
         systemTools::submitCommandAsJob( commandString, scriptName, "100:00:00" );
     }
 }
 
 
-void analyzeNominal( const std::string& year, const std::string& controlRegion ){
-    std::string commandString = "./controlRegions TChiWZ None " + year + " " + controlRegion;
+void analyzeNominal( const std::string& year, const std::string& controlRegion, const ReadCacheSettings& readCacheSettings ){
+    std::string commandString = "./controlRegions TChiWZ None " + year + " " + controlRegion + readCacheSettings.commandLineOptions();
     std::string scriptName = controlRegion + "_nominal_" + year + ".sh";
     systemTools::submitCommandAsJob( commandString, scriptName, "10:00:00" );
 }
@@ -644,6 +664,11 @@ int main( int argc, char* argv[] ){
     setTDRStyle();
     const std::string sampleDirectoryPath = "/pnfs/iihe/cms/store/user/wverbeke/ntuples_ewkino/";
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+
+    //read cache options (e.g. --columnarCache=<directory>) can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    argc = static_cast< int >( argvStr.size() );
     
     //run specific model and mass splitting and year
     if( argc > 4 ){
@@ -651,22 +676,22 @@ int main( int argc, char* argv[] ){
         std::string deltaM = argvStr[2];
         std::string year = argvStr[3];
         std::string controlRegion = argvStr[4];
-        analyze( model, deltaM, year, controlRegion, sampleDirectoryPath );
+        analyze( model, deltaM, year, controlRegion, sampleDirectoryPath, readCacheSettings );
 
     } else if( argc == 4 ){
         std::string model = argvStr[1];
         std::string year = argvStr[2];
         std::string controlRegion = argvStr[3];
-        analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath );
-        analyzeNominal( year, controlRegion );
+        analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath, readCacheSettings );
+        analyzeNominal( year, controlRegion, readCacheSettings );
 
     //run all mass splittings all years for a specific model and control region
     } else if( argc == 3 ){
         std::string model = argvStr[1];
         std::string controlRegion = argvStr[2];
         for( const auto& year : { "2016", "2017", "2018" } ){
-            analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath );
-            analyzeNominal( year, controlRegion );
+            analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath, readCacheSettings );
+            analyzeNominal( year, controlRegion, readCacheSettings );
         }
 
     //run all mass splittings for all years for all models and a specific control region
@@ -674,7 +699,7 @@ int main( int argc, char* argv[] ){
         if( argvStr[1] == "nominal" ){
             for( const auto& controlRegion : {"WZ", "XGamma", "TTZ", "NP" } ){
                 for( const auto& year : { "2016", "2017", "2018" } ){
-                    analyzeNominal( year, controlRegion );
+                    analyzeNominal( year, controlRegion, readCacheSettings );
                 }
             }
 
@@ -682,9 +707,9 @@ int main( int argc, char* argv[] ){
             std::string controlRegion = argvStr[1];
             for( const auto& year : { "2016", "2017", "2018" } ){
                 for( const auto& model : {"TChiWZ", "TChiSlepSnu_x0p95", "TChiSlepSnu_x0p5", "TChiSlepSnu_x0p05" } ){
-                    analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath );
+                    analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath, readCacheSettings );
                 }
-                analyzeNominal( year, controlRegion );
+                analyzeNominal( year, controlRegion, readCacheSettings );
             }
         }
 
@@ -693,9 +718,9 @@ int main( int argc, char* argv[] ){
         for( const auto& controlRegion : {"WZ", "XGamma", "TTZ", "NP" } ){
             for( const auto& year : { "2016", "2017", "2018" } ){
                 for( const auto& model : {"TChiWZ", "TChiSlepSnu_x0p95", "TChiSlepSnu_x0p5", "TChiSlepSnu_x0p05" } ){
-                    analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath );
+                    analyzeAllMasses( model, year, controlRegion, sampleDirectoryPath, readCacheSettings );
                 }
-                analyzeNominal( year, controlRegion );
+                analyzeNominal( year, controlRegion, readCacheSettings );
             }
         }
     }
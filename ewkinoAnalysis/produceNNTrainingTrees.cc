@@ -1,6 +1,7 @@
 
 
 //include c++ library classes
+#include <chrono>
 
 //include ROOT classes 
 #include "TTree.h"
@@ -9,13 +10,14 @@
 #include "../Tools/interface/analysisTools.h"
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
+#include "../Tools/interface/OutputFileSettings.h"
 
 //include ewkino specific code
 #include "interface/ewkinoSelection.h"
 #include "interface/ewkinoCategorization.h"
 
 
-void produceNNTrainingTrees( const std::string& year, const std::string& sampleDirectoryPath ){
+void produceNNTrainingTrees( const std::string& year, const std::string& sampleDirectoryPath, const OutputFileSettings& outputFileSettings, const ReadCacheSettings& readCacheSettings ){
 
 	analysisTools::checkYearString( year );
 
@@ -37,6 +39,10 @@ void produceNNTrainingTrees( const std::string& year, const std::string& sampleD
 
     //build TreeReader and loop over samples
     TreeReader treeReader( "sampleLists/samples_NNTraining_" + year + ".txt", sampleDirectoryPath );
+    treeReader.setReadCache( readCacheSettings );
+
+    //most events fail the baseline selection, so only read the other branches when they are needed
+    treeReader.setLazyReading();
 
 
     //use several WZTo3LNu samples at the same time for more statistics
@@ -80,11 +86,13 @@ void produceNNTrainingTrees( const std::string& year, const std::string& sampleD
 
         //make training tree for the current sample
         std::cout << "Sample : treeReader.currentSample().uniqueName() = " << treeReader.currentSample().uniqueName() << std::endl;
-        TFile* trainingFile = TFile::Open( ( stringTools::formatDirectoryName( outputDirectory ) + "trainingFile_" + treeReader.currentSample().uniqueName()  + ".root" ).c_str(), "RECREATE" );
+        TFile* trainingFile = outputFileSettings.openFile( stringTools::formatDirectoryName( outputDirectory ) + "trainingFile_" + treeReader.currentSample().uniqueName()  + ".root" );
         TTree* trainingTree = new TTree( treeName.c_str(), treeName.c_str() );
         for( const auto& entry : trainingVariables ){
             trainingTree->Branch( entry.first.c_str(), &trainingVariables[ entry.first ], ( entry.first + "/F" ).c_str() );
         }
+        outputFileSettings.configureTree( trainingTree );
+        std::chrono::duration< double > writeTime( 0. );
 
         for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
             Event event = treeReader.buildEvent( entry );
@@ -130,22 +138,33 @@ void produceNNTrainingTrees( const std::string& year, const std::string& sampleD
             if( treeReader.isSusy() ){
                 trainingVariables.at("susyMassSplitting") = ( event.susyMassInfo().massNLSP() - event.susyMassInfo().massLSP() );
             }
+            auto fillBegin = std::chrono::steady_clock::now();
             trainingTree->Fill();
+            writeTime += std::chrono::steady_clock::now() - fillBegin;
         }
+        auto writeBegin = std::chrono::steady_clock::now();
         trainingFile->Write();
+        writeTime += std::chrono::steady_clock::now() - writeBegin;
+        OutputFileSettings::printCompressionReport( trainingTree, writeTime.count() );
         trainingFile->Close();
     }
+    treeReader.printReadStatistics();
 }
 
 
 int main( int argc, char* argv[] ){
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    argc = static_cast< int >( argvStr.size() );
     if( argc == 2 ){
         std::string year = argvStr[1];
-        produceNNTrainingTrees( year, "/user/wverbeke/Work/ntuples_ewkino_new/" );
+        outputFileSettings.enableParallelCompression();
+        produceNNTrainingTrees( year, "/user/wverbeke/Work/ntuples_ewkino_new/", outputFileSettings, readCacheSettings );
     } else {
         for( const auto& year : { "2016", "2017", "2018" } ){
-            std::string command = std::string( "./produceNNTrainingTrees " ) + year;
+            std::string command = std::string( "./produceNNTrainingTrees " ) + year + outputFileSettings.commandLineOptions() + readCacheSettings.commandLineOptions();
             systemTools::submitCommandAsJob( command, std::string( "produceNNTrainingTrees_" ) + year + ".sh", "169:00:00" );
         }
     }
@@ -11,6 +11,7 @@ This is what the cone correction factor attempts to address.
 
 //include c++ library classes 
 #include <stdexcept>
+#include <chrono>
 
 //include ROOT classes
 #include "TH1D.h"
@@ -23,6 +24,7 @@ This is what the cone correction factor attempts to address.
 #include "../Tools/interface/analysisTools.h"
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
+#include "../Tools/interface/OutputFileSettings.h"
 
 
 void determineConeCorrectionFactor( 
@@ -33,7 +35,9 @@ void determineConeCorrectionFactor(
 	const double wpThreshold, 
 	const std::string& sampleDirectory, 
 	const std::string& sampleList,
-	const unsigned sampleIndex ){
+	const unsigned sampleIndex,
+	const ReadCacheSettings& readCacheSettings,
+	const OutputFileSettings& outputFileSettings ){
     // determine the 'cone correction factor' for a given lepton flavor, 
     // lepton MVA and threshold.
     // leptonMVA is an string to identifiy which MVA to use,
@@ -69,10 +73,8 @@ void determineConeCorrectionFactor(
     // make tree reader and set to correct sample
     std::cout << "creating TreeReader and setting to sample no. " << sampleIndex << std::endl;
     TreeReader treeReader( sampleList, sampleDirectory );
-    treeReader.initSample();
-    for( unsigned i=1; i<=sampleIndex; ++i){
-        treeReader.initSample();
-    }
+    treeReader.setReadCache( readCacheSettings );
+    treeReader.initSample( sampleIndex );
 
     // extra check on year
     if( (year=="2016" && !treeReader.is2016()) ||
@@ -122,14 +124,18 @@ void determineConeCorrectionFactor(
 	}
     }
     std::cout<<"finished event loop"<<std::endl;
+    if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
 
     std::string fileName = "coneCorrectionFactor_" + leptonMVA + "_" + wpName + "_" + leptonFlavor + "_" + year;
     fileName.append("_histograms_sample_"+std::to_string(sampleIndex)+".root");
-    TFile* histogramFile = TFile::Open( fileName.c_str(), "RECREATE" );
+    TFile* histogramFile = outputFileSettings.openFile( fileName );
+    auto writeBegin = std::chrono::steady_clock::now();
 
     pTWeightedLeptonMVAHistogram->Write();
     leptonMVAHistogram->Write();
 
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( histogramFile, writeTime.count() );
     histogramFile->Close();
 }
 
@@ -139,6 +145,12 @@ int main( int argc, char* argv[] ){
 
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
 
+    // read cache and output file options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    argc = static_cast< int >( argvStr.size() );
+
     if( argc != 9 ){
         std::cerr << argc - 1 << " command line arguments given, while 8 are expected." << std::endl;
         std::cerr << "  - lepton flavor" << std::endl;
@@ -161,7 +173,8 @@ int main( int argc, char* argv[] ){
     std::string sampleList = argvStr[7];
     int sampleIndex = std::stoi( argvStr[8] );
     determineConeCorrectionFactor( leptonFlavor, year, leptonMVA, wpName, wpThreshold,
-                                   sampleDirectory, sampleList, sampleIndex );
+                                   sampleDirectory, sampleList, sampleIndex, readCacheSettings,
+                                   outputFileSettings );
 
     std::cerr << "###done###" << std::endl;
     return 0;
@@ -16,6 +16,12 @@ int main( int argc, char* argv[] ){
 
     // check command line arguments
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+
+    // read cache and output file options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    argc = static_cast< int >( argvStr.size() );
     unsigned nargs = 7;
     if( !( argvStr.size() == nargs+1 ) ){
         std::cerr << "found " << argc-1 << " command line args,";
@@ -85,7 +91,8 @@ int main( int argc, char* argv[] ){
 	flavor, year, sampleDirectory, sampleList, sampleIndex,
 	triggerVectorMap[ year ], prescaleMap, 
 	mTUpperCut_fakeRateMeasurement, metUpperCut_fakeRateMeasurement, 
-	isTestRun, nEvents );
+	isTestRun, nEvents, readCacheSettings,
+	outputFileSettings );
 
     std::cerr << "###done###" << std::endl;
     return 0;
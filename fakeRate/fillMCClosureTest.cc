@@ -1,5 +1,6 @@
 // include c++ library classes 
 #include <memory>
+#include <chrono>
 
 //include other parts of framework
 #include "../TreeReader/interface/TreeReader.h"
@@ -11,6 +12,7 @@
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/stringTools.h"
 #include "../Tools/interface/analysisTools.h"
+#include "../Tools/interface/OutputFileSettings.h"
 
 std::vector< HistInfo > makeDistributionInfoDefault(){
     std::vector< HistInfo > histInfoVec = {
@@ -157,6 +159,12 @@ int main( int argc, char* argv[] ){
     
     // check command line arguments
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+
+    // read cache and output file options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    argc = static_cast< int >( argvStr.size() );
     unsigned nargs = 9;
     if( !(argvStr.size() == nargs+1) ){
         std::cerr << "found " << argc-1 << " command line args,";
@@ -213,6 +221,7 @@ int main( int argc, char* argv[] ){
 
     // make a TreeReader instance
     TreeReader treeReader( sampleListFile, sampleDirectory );
+    treeReader.setReadCache( readCacheSettings );
 
     // set number of samples
     unsigned numberOfSamples = treeReader.numberOfSamples();
@@ -221,7 +230,7 @@ int main( int argc, char* argv[] ){
     // loop over samples
     for( unsigned i = 0; i < numberOfSamples; ++i ){
 	std::cout<<"start processing sample n. "<<i+1<<" of "<<numberOfSamples<<std::endl;
-        treeReader.initSample();
+        treeReader.initSample( i );
 
 	// set number of entries
 	long unsigned numberOfEntries = treeReader.numberOfEntries();
@@ -316,6 +325,7 @@ int main( int argc, char* argv[] ){
 	    std::cout<<"(scaled) event weight: "<<event.weight()<<std::endl;
 	    std::cout<<"final event weight: "<<weight<<std::endl;*/
         }
+        if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
     }
     // printouts for testing
     /*std::cout<<"--- histogram ---"<<std::endl;
@@ -329,7 +339,8 @@ int main( int argc, char* argv[] ){
     std::string flavorInterpendix = (flavor=="")? "": "_"+flavor;
     std::string fileName = "closurePlots_MC_" + process + "_" + year;
     fileName += flavorInterpendix + ".root";
-    TFile* outputFilePtr = TFile::Open( fileName.c_str(), "RECREATE" );
+    TFile* outputFilePtr = outputFileSettings.openFile( fileName );
+    auto writeBegin = std::chrono::steady_clock::now();
     outputFilePtr->cd();
 
     for( std::vector< HistInfo >::size_type v = 0; v < histInfoVec.size(); ++v ){
@@ -345,6 +356,8 @@ int main( int argc, char* argv[] ){
 	observed->Write();
     }
 
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( outputFilePtr, writeTime.count() );
     outputFilePtr->Close();
     std::cerr << "###done###" << std::endl;
     return 0;
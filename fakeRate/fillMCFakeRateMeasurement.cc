@@ -14,6 +14,12 @@ int main( int argc, char* argv[] ){
     std::cerr << "###starting###" << std::endl;
     // check command line arguments
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+
+    // read cache and output file options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    argc = static_cast< int >( argvStr.size() );
     int nargs = 6;
     if( !( argvStr.size() == nargs+1 ) ){
         std::cerr<<"found "<<argc - 1<<" command line args, while "<<nargs<<" are needed."<<std::endl;
@@ -29,6 +35,7 @@ int main( int argc, char* argv[] ){
     bool isTestRun = (argvStr[6]=="True" || argvStr[6]=="true");
     setTDRStyle();
     fillMCFakeRateMeasurementHistograms(flavor, year, sampleDirectory, 
-					sampleList, sampleIndex, isTestRun);
+					sampleList, sampleIndex, isTestRun, readCacheSettings,
+					outputFileSettings );
     std::cerr << "###done###" << std::endl;
 }
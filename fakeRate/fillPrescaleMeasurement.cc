@@ -18,6 +18,12 @@ int main( int argc, char* argv[] ){
     std::cerr << "###starting###" << std::endl;
     // check number of command line arguments
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+
+    // read cache and output file options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    argc = static_cast< int >( argvStr.size() );
     unsigned nargs = 6;
     if( !( argvStr.size() == nargs+1 ) ){
         std::cerr << "found " << argc-1 << " command line args,";
@@ -76,7 +82,8 @@ int main( int argc, char* argv[] ){
 					isTestRun, nEvents,
 					triggerVectorMap[ year ], use_mT, 
 					metLowerCut_prescaleMeasurement, 
-					mTLowerCut_prescaleMeasurement );
+					mTLowerCut_prescaleMeasurement, readCacheSettings,
+					outputFileSettings );
     std::cerr << "###done###" << std::endl;
     return 0;
 }
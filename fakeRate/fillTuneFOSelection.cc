@@ -5,6 +5,7 @@ The goal of the tuning is having a fake-rate (tight/FO) that is equal for light
 
 //include c++ library classes
 #include <fstream>
+#include <chrono>
 
 //include ROOT classes
 #include "TF1.h"
@@ -19,6 +20,7 @@ The goal of the tuning is having a fake-rate (tight/FO) that is equal for light
 #include "../plotting/tdrStyle.h"
 #include "../Tools/interface/systemTools.h"
 #include "../Tools/interface/analysisTools.h"
+#include "../Tools/interface/OutputFileSettings.h"
 #include "interface/CutsFitInfo.h"
 #include "interface/fakeRateTools.h"
 #include "interface/SlidingCut.h"
@@ -28,7 +30,9 @@ The goal of the tuning is having a fake-rate (tight/FO) that is equal for light
 
 void fillTuneFOSelection( const std::string& leptonFlavor, const std::string& year, 
 			const std::string& sampleList, const std::string& sampleDirectory,
-			const unsigned int sampleIndex ){
+			const unsigned int sampleIndex,
+			const ReadCacheSettings& readCacheSettings,
+			const OutputFileSettings& outputFileSettings ){
 
     bool isMuon;
     if( leptonFlavor == "muon" ){
@@ -73,10 +77,8 @@ void fillTuneFOSelection( const std::string& leptonFlavor, const std::string& ye
     // create TreeReader and set to right sample
     std::cout << "initializing TreeReader and setting to sample no. " << sampleIndex << std::endl;
     TreeReader treeReader( sampleList, sampleDirectory );
-    treeReader.initSample();
-    for( unsigned i = 1; i <= sampleIndex; ++i ){
-        treeReader.initSample();
-    }
+    treeReader.setReadCache( readCacheSettings );
+    treeReader.initSample( sampleIndex );
 
     // loop over events in sample
     long unsigned nentries = treeReader.numberOfEntries();
@@ -155,10 +157,12 @@ void fillTuneFOSelection( const std::string& leptonFlavor, const std::string& ye
     }
 
     std::cout<<"finished event loop"<<std::endl;
+    if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
 
     std::string file_name = "tuneFOSelection_" + leptonFlavor + "_" + year;
     file_name.append("_histograms_sample_"+std::to_string(sampleIndex)+".root");
-    TFile* histogram_file = TFile::Open( file_name.c_str(), "RECREATE" );
+    TFile* histogram_file = outputFileSettings.openFile( file_name );
+    auto writeBegin = std::chrono::steady_clock::now();
 
     for(unsigned i=0; i < heavyFlavorNumerator.size(); ++i){
 	heavyFlavorNumerator[i]->Write();
@@ -167,6 +171,8 @@ void fillTuneFOSelection( const std::string& leptonFlavor, const std::string& ye
 	lightFlavorDenominator[i]->Write();
     }   
 
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( histogram_file, writeTime.count() );
     histogram_file->Close();
     std::cout<<"done"<<std::endl;
 }
@@ -176,6 +182,12 @@ int main( int argc, char* argv[] ){
     std::cerr << "###starting###" << std::endl;
     std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
 
+    // read cache and output file options can be given anywhere on the command line
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr );
+    argc = static_cast< int >( argvStr.size() );
+
     if( argc != 6 ){
 	std::cout<<"### ERROR ###: unrecognized number of arguments."<<std::endl;
 	return -1;
@@ -188,7 +200,8 @@ int main( int argc, char* argv[] ){
     fakeRate::checkFlavorString( flavor );
     analysisTools::checkYearString( year );
 
-    fillTuneFOSelection( flavor, year, sampleList, sampleDirectory, sampleIndex );
+    fillTuneFOSelection( flavor, year, sampleList, sampleDirectory, sampleIndex, readCacheSettings,
+	outputFileSettings );
     std::cerr << "###done###" << std::endl;
     return 0;
 }
@@ -16,6 +16,7 @@
 #include "../../Tools/interface/analysisTools.h"
 #include "../../Tools/interface/systemTools.h"
 #include "../../Tools/interface/Prescale.h"
+#include "../../Tools/interface/OutputFileSettings.h"
 #include "fakeRateSelection.h"
 #include "fakeRateTools.h"
 #include "progressTracker.h"
@@ -38,9 +39,12 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
     const std::string& sampleDirectory, const std::string& sampleList, const unsigned sampleIndex,
     const std::vector< std::string >& triggerVector,
     const std::map< std::string, Prescale >& prescaleMap, double maxMT, double maxMet,
-    const bool isTestRun = false, const unsigned long nEvents = 0 );
+    const bool isTestRun = false, const unsigned long nEvents = 0,
+    const ReadCacheSettings& readCacheSettings = ReadCacheSettings(),
+    const OutputFileSettings& outputFileSettings = OutputFileSettings() );
 
 void fillMCFakeRateMeasurementHistograms(const std::string& leptonFlavor, const std::string& year,
     const std::string& sampleDirectory, const std::string& sampleList, const unsigned sampleIndex,
-    const bool isTestRun = false );
+    const bool isTestRun = false, const ReadCacheSettings& readCacheSettings = ReadCacheSettings(),
+    const OutputFileSettings& outputFileSettings = OutputFileSettings() );
 
@@ -17,6 +17,7 @@
 #include "../../Tools/interface/analysisTools.h"
 #include "../../Tools/interface/systemTools.h"
 #include "../../Tools/interface/Prescale.h"
+#include "../../Tools/interface/OutputFileSettings.h"
 #include "fakeRateSelection.h"
 #include "fakeRateTools.h"
 #include "CutsFitInfo.h"
@@ -36,4 +37,6 @@ void fillPrescaleMeasurementHistograms( const std::string& year,
     const std::string& sampleListPath, const unsigned sampleIndex,
     const bool isTestRun, const unsigned long nEvents,
     const std::vector< std::string >& triggerVector, const bool useMT = true,
-    const double metCut = 0, double mtCut = 0);
+    const double metCut = 0, double mtCut = 0,
+    const ReadCacheSettings& readCacheSettings = ReadCacheSettings(),
+    const OutputFileSettings& outputFileSettings = OutputFileSettings() );
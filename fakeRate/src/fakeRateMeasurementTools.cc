@@ -1,6 +1,9 @@
 // include header
 #include "../interface/fakeRateMeasurementTools.h"
 
+// include c++ library classes
+#include <chrono>
+
 // help function for creating a 2D histogram map
 RangedMap< RangedMap< std::shared_ptr< TH1D > > > build2DHistogramMap( 
     const std::vector< double >& ptBinBorders, const std::vector< double >& etaBinBorders, 
@@ -71,7 +74,9 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
     const std::string& sampleDirectory, const std::string& sampleList, const unsigned sampleIndex,
     const std::vector< std::string >& triggerVector, 
     const std::map< std::string, Prescale >& prescaleMap, double maxMT, double maxMet,
-    const bool isTestRun, const unsigned long nEvents ){ 
+    const bool isTestRun, const unsigned long nEvents,
+    const ReadCacheSettings& readCacheSettings,
+    const OutputFileSettings& outputFileSettings ){ 
  
     std::cout<<"start function fillFakeRateMeasurementHistograms"<<std::endl;
 
@@ -108,10 +113,10 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
     // initialize TreeReader and set to correct sample
     std::cout<<"initializing TreeReader and setting to sample n. "<<sampleIndex<<std::endl;
     TreeReader treeReader( sampleList , sampleDirectory );
-    treeReader.initSample();
-    for(unsigned idx=1; idx<=sampleIndex; ++idx){
-        treeReader.initSample();
-    }
+    // only read the branches needed for this measurement
+    treeReader.setBranchProfile( BranchProfile( "fakerate" ) );
+    treeReader.setReadCache( readCacheSettings );
+    treeReader.initSample( sampleIndex );
     const bool isData = treeReader.isData();
 
     // make histogram maps
@@ -155,6 +160,11 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
     }
     RangedMap< std::string > conePtToTriggerMap( conePtLowerBoundMap );
     std::map<std::string,double> triggerToJetPtMap = fakeRate::mapTriggerToJetPtThreshold(triggerVector);
+
+    // triggers used in the measurement, to skip events that pass none of them with a single check
+    std::vector< std::string > triggersToUse;
+    for( const auto& bound : conePtLowerBoundMap ) triggersToUse.push_back( bound.second );
+    DecisionSelection anyTriggerToUse( triggersToUse );
     
     // initialize a reweighter
     std::cout<<"building reweighter"<<std::endl;
@@ -181,16 +191,27 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
         numberOfEntries = nEvents;
     }
 
+    // reject entries without MET filters, a lepton of the measured flavor or a jet before building events
+    PreSelection preSelection = PreSelection::passAnyTriggerBit( EventBatch::metFilters )
+	& ( isMuonMeasurement ? PreSelection::minimumNumberOfMuons( 1 ) : PreSelection::minimumNumberOfElectrons( 1 ) )
+	& PreSelection::minimumNumberOfJets( 1 );
+    PreSelectionResult preSelected = treeReader.preSelectEntries( preSelection, numberOfEntries );
+    preSelected.print();
+
     // do event loop
-    std::cout<<"starting event loop for "<<numberOfEntries<<" events"<<std::endl;
-    for(long unsigned entry=0; entry<numberOfEntries; ++entry){
-	if( entry%50000 == 0 ) progress.writeProgress( static_cast<double>(entry)/numberOfEntries );
+    std::cout<<"starting event loop for "<<preSelected.size()<<" events"<<std::endl;
+    for(long unsigned i=0; i<preSelected.size(); ++i){
+	if( i%50000 == 0 ) progress.writeProgress( static_cast<double>(i)/preSelected.size() );
+	long unsigned entry = preSelected[i];
 
 	Event event = treeReader.buildEvent( entry, true, false );
 
 	// apply MET filters
 	if( !event.passMetFilters() ) continue; 
 
+	// apply trigger preselection
+	if( !event.passAnyTrigger( anyTriggerToUse ) ) continue;
+
 	// apply event selection
 	if( !fakeRate::passFakeRateEventSelection( event, isMuonMeasurement, 
 		!isMuonMeasurement, false, true, 0.7, 30 ) ) continue;
@@ -272,9 +293,11 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
     // write output file
     progress.close();
     std::cout<<"finished event loop"<<std::endl;
+    if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
     std::string file_name = "fakeRateMeasurement_data_" + leptonFlavor + "_" + year;
     file_name.append("_mT_histograms_sample_"+std::to_string(sampleIndex)+".root");
-    TFile* histogram_file = TFile::Open( file_name.c_str(), "RECREATE" );
+    TFile* histogram_file = outputFileSettings.openFile( file_name );
+    auto writeBegin = std::chrono::steady_clock::now();
     
     if( treeReader.isMC() ){
 	write2DHistogramMap( prompt_numerator_map );
@@ -287,6 +310,8 @@ void fillFakeRateMeasurementHistograms(const std::string& leptonFlavor, const st
 	write2DHistogramMap( data_denominator_map );
     }
 
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( histogram_file, writeTime.count() );
     histogram_file->Close();
     std::cout<<"finished function fillFakeRateMeasurementHistograms"<<std::endl;
 }  
@@ -296,7 +321,9 @@ void fillMCFakeRateMeasurementHistograms( const std::string& flavor, const std::
 					    const std::string& sampleDirectory, 
 					    const std::string& sampleList,
 					    const unsigned sampleIndex,
-					    const bool isTestRun ){
+					    const bool isTestRun,
+					    const ReadCacheSettings& readCacheSettings,
+					    const OutputFileSettings& outputFileSettings ){
 
     std::cout<<"starting function fillMCFakeRateMeasurementHistograms"<<std::endl;
     fakeRate::checkFlavorString( flavor );
@@ -377,10 +404,8 @@ void fillMCFakeRateMeasurementHistograms( const std::string& flavor, const std::
     // make TreeReader and set to correct sample
     std::cout<<"making TreeReader and setting to sample no. "<<sampleIndex<<"."<<std::endl;
     TreeReader treeReader( sampleList, sampleDirectory );
-    treeReader.initSample();
-    for( unsigned i = 1; i <= sampleIndex; ++i ){
-        treeReader.initSample();
-    }
+    treeReader.setReadCache( readCacheSettings );
+    treeReader.initSample( sampleIndex );
 
     // loop over events to fill histograms
     unsigned numberOfEntries = treeReader.numberOfEntries();
@@ -455,10 +480,12 @@ void fillMCFakeRateMeasurementHistograms( const std::string& flavor, const std::
     }
 
     std::cout<<"finished event loop"<<std::endl;
+    if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
 
     std::string file_name = "fakeRateMeasurement_MC_" + flavor + "_" + year;
     file_name.append("_histograms_sample_"+std::to_string(sampleIndex)+".root");
-    TFile* histogram_file = TFile::Open( file_name.c_str(), "RECREATE" );
+    TFile* histogram_file = outputFileSettings.openFile( file_name );
+    auto writeBegin = std::chrono::steady_clock::now();
 
     numeratorMap->Write();
     denominatorMap->Write();
@@ -470,6 +497,8 @@ void fillMCFakeRateMeasurementHistograms( const std::string& flavor, const std::
     lightNumerator->Write();
     lightDenominator->Write();
 
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( histogram_file, writeTime.count() );
     histogram_file->Close();
     std::cout<<"finished function fillMCFakeRateMeasurementHistograms"<<std::endl;
 }
@@ -1,6 +1,9 @@
 // import header
 #include "../interface/prescaleMeasurementTools.h"
 
+// include c++ library classes
+#include <chrono>
+
 // help function for histogram info
 HistInfo makeVarHistInfo( const unsigned numberOfBins, const double cut, const double max,
                             const bool useMT){
@@ -29,7 +32,9 @@ void fillPrescaleMeasurementHistograms(
 	const bool isTestRun,
 	const unsigned long nEvents,
 	const std::vector< std::string >& triggerVector,
-	const bool useMT, const double metCut, double mtCut ){
+	const bool useMT, const double metCut, double mtCut,
+	const ReadCacheSettings& readCacheSettings,
+	const OutputFileSettings& outputFileSettings ){
 
     progressTracker progress = progressTracker("fillPrescaleMeasurement_progress_"+year
                                 +"_sample_"+std::to_string(sampleIndex)+".txt");
@@ -52,10 +57,10 @@ void fillPrescaleMeasurementHistograms(
     // initialize TreeReader and select correct sample
     std::cout<<"creating TreeReader and set to sample n. "<<sampleIndex<<std::endl;
     TreeReader treeReader( sampleListPath, sampleDirectoryPath);
-    treeReader.initSample();
-    for(unsigned idx=1; idx<=sampleIndex; ++idx){
-        treeReader.initSample();
-    }
+    // only read the branches needed for this measurement
+    treeReader.setBranchProfile( BranchProfile( "fakerate" ) );
+    treeReader.setReadCache( readCacheSettings );
+    treeReader.initSample( sampleIndex );
     const bool isData = treeReader.isData();
     
     // printouts for testing
@@ -105,12 +110,22 @@ void fillPrescaleMeasurementHistograms(
 	numberOfEntries = nEvents;
     }
 
+    // triggers are resolved to their index in the trigger table once per sample instead of once per event
+    DecisionSelection anyTrigger( triggerVector );
+    std::vector< DecisionTable::size_type > triggerIndices;
+    for( const auto& trigger : triggerVector ){
+        triggerIndices.push_back( treeReader.triggerIndex( trigger ) );
+    }
+
     // do event loop
     std::cout<<"start event loop for "<<numberOfEntries<<" events"<<std::endl;
     for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
         if( entry%10000 == 0 ) progress.writeProgress( static_cast<double>(entry)/numberOfEntries );
         Event event = treeReader.buildEvent( entry, true, false );
 
+        // skip events that pass none of the triggers
+        if( !event.passAnyTrigger( anyTrigger ) ) continue;
+
         // check if event passes necessary selections
         // consider both electrons and muons, only tight leptons and events with a jet.
         if(!fakeRate::passFakeRateEventSelection(event,false,false,true,true,0.7,40)) continue;
@@ -126,9 +141,10 @@ void fillPrescaleMeasurementHistograms(
         else weight = 1;
 
 	// loop over triggers
-        for( const auto& trigger : triggerVector ){
+        for( std::vector< std::string >::size_type triggerIndex = 0; triggerIndex < triggerVector.size(); ++triggerIndex ){
+            const std::string& trigger = triggerVector[ triggerIndex ];
 	    // check if event passes trigger and if lepton is correct flavor
-            if( !event.passTrigger( trigger ) ) continue;
+            if( !event.passTrigger( triggerIndices[ triggerIndex ] ) ) continue;
             if( stringTools::stringContains( trigger, "Mu" ) ){
                     if( !lepton.isMuon() ) continue;
             } else if( stringTools::stringContains( trigger, "Ele" ) ){
@@ -168,11 +184,13 @@ void fillPrescaleMeasurementHistograms(
     // write output histograms to file
     progress.close();
     std::cout<<"finished event loop"<<std::endl;
+    if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
     std::string outfilename("prescaleMeasurement_");
     outfilename.append(useMT?"mT":"met");
     outfilename.append("_histograms_"+year+"_sample_"+std::to_string(sampleIndex)+".root");
     std::cout<<"writing to file "<<outfilename<<std::endl;
-    TFile* histogram_file = TFile::Open( outfilename.c_str(), "RECREATE" );
+    TFile* histogram_file = outputFileSettings.openFile( outfilename );
+    auto writeBegin = std::chrono::steady_clock::now();
     if( isData ){
         for( const auto& trigger : triggerVector ){
             data_map[ trigger ]->Write();
@@ -184,6 +202,8 @@ void fillPrescaleMeasurementHistograms(
             nonprompt_map[ trigger ]->Write();
         }
     }
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( histogram_file, writeTime.count() );
     histogram_file->Close();
     std::cout<<"finished function fillPrescaleMeasurementHistograms"<<std::endl;
 }
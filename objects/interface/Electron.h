@@ -19,6 +19,9 @@ class Electron : public LightLepton{
         Electron& operator=( const Electron& ) = default;
         Electron& operator=( Electron&& ) = default;
 
+        //read the lepton at the given index into this object (see Event::refill)
+        void refill( const TreeReader&, const unsigned );
+
         virtual bool isMuon() const override { return false; }
         virtual bool isElectron() const override { return true; }
 
@@ -5,6 +5,7 @@
 #include "PhysicsObject.h"
 #include "../../TreeReader/interface/TreeReader.h"
 #include "../../Tools/interface/stringTools.h"
+#include "SelectorStorage.h"
 //#include "JetSelector.h"
 
 
@@ -27,6 +28,10 @@ class Jet : public PhysicsObject{
         Jet& operator=( const Jet& );
         Jet& operator=( Jet&& ) noexcept;
 
+        //read the jet at the given index into this object (see Event::refill)
+        void refill( const TreeReader&, const unsigned,
+		const bool readAllJECVariations, const bool readGroupedJECVariations );
+
         double deepCSV() const{ return _deepCSV; }
         double deepFlavor() const{ return _deepFlavor; }
         unsigned hadronFlavor() const{ return _hadronFlavor; }
@@ -54,6 +59,12 @@ class Jet : public PhysicsObject{
 	Jet JetJECDown( const std::string source ) const;
 	Jet JetJECUp( const std::string source ) const;
 
+	// same as above, for a variation index obtained with JECVariationIndex
+	// (grouped variations take precedence over sources with the same name, unknown names give index JECVariationTable::size())
+	JECVariationTable::size_type JECVariationIndex( const std::string& source ) const;
+	Jet JetJECDown( const JECVariationTable::size_type variationIndex ) const;
+	Jet JetJECUp( const JECVariationTable::size_type variationIndex ) const;
+
         //check if any of the jet variations passes the selection
         bool isGoodAnyVariation() const;
 
@@ -74,12 +85,15 @@ class Jet : public PhysicsObject{
         double _pt_JERDown = 0;
         double _pt_JERUp = 0;
 
-	std::map< std::string, double > _pt_JECSourcesUp;
-	std::map< std::string, double > _pt_JECSourcesDown;
-	std::map< std::string, double > _pt_JECGroupedUp;
-	std::map< std::string, double > _pt_JECGroupedDown;
+	//split and grouped JEC uncertainties, indexed as in the JECVariationTable of the tree
+	std::shared_ptr< const JECVariationTable > _JECVariationTable;
+	bool _hasJECSources = false;
+	bool _hasJECGrouped = false;
+	std::vector< double > _pt_JECVariationsUp;
+	std::vector< double > _pt_JECVariationsDown;
 
-        //jet selector 
+        //jet selector, constructed inside the jet
+        SelectorStorage _selectorStorage;
         JetSelector* selector;
 
         Jet variedJet(const double) const;
@@ -10,6 +10,7 @@
 #include "../../TreeReader/interface/TreeReader.h"
 #include "LeptonGeneratorInfo.h"
 #include "LeptonSelector.h"
+#include "SelectorStorage.h"
 
 //class LeptonSelector;
 template< typename ObjectType > class PhysicsObjectCollection;
@@ -21,11 +22,7 @@ class Lepton : public PhysicsObject {
     friend class PhysicsObjectCollection<Lepton>;
     
     public: 
-        Lepton( const TreeReader&, const unsigned, LeptonSelector* ); 
-
-        //copying of lepton will only be allowed if appropriate selector is provided by derived class
-        Lepton( const Lepton& ) = delete;
-        Lepton( Lepton&& ) noexcept = delete;
+        Lepton( const TreeReader&, const unsigned ); 
 
         virtual ~Lepton();
         
@@ -78,22 +75,24 @@ class Lepton : public PhysicsObject {
         double _dz = 0;
         double _sip3d = 0;
 
-        //lepton generator information
-        LeptonGeneratorInfo* generatorInfo = nullptr;
+        //lepton generator information, held by value so leptons can be refilled without allocations
+        LeptonGeneratorInfo generatorInfo;
+        bool _hasGeneratorInfo = false;
 
         //check whether generator-level info was initialized 
-        bool hasGeneratorInfo() const{ return  generatorInfo != nullptr; }
+        bool hasGeneratorInfo() const{ return _hasGeneratorInfo; }
         bool checkGeneratorInfo() const;
 
-        //copy non-pointer attributes from other leptons, to be used in copy operations
+        //copy non-pointer attributes (including the generator information) from other leptons, to be used in copy operations
         void copyNonPointerAttributes( const Lepton& );
 
         //functions to facilitate dynamically typed dynamic memory allocation 
         virtual Lepton* clone() const & = 0;
         virtual Lepton* clone() && = 0;
 
-        //lepton selector object 
-        LeptonSelector* selector;
+        //lepton selector object, constructed inside the lepton by the final derived class (see constructSelector)
+        SelectorStorage _selectorStorage;
+        LeptonSelector* selector = nullptr;
 
         //check if lepton was already cone-corrected
         bool isConeCorrected = false;
@@ -104,8 +103,14 @@ class Lepton : public PhysicsObject {
         double _uncorrectedPt;
 	double _uncorrectedE;
 
-        Lepton( const Lepton&, LeptonSelector* );
-        Lepton( Lepton&&, LeptonSelector* ) noexcept;
+        //copying of a lepton is only allowed for derived classes, which have to construct the selector of the copy
+        Lepton( const Lepton& );
+        Lepton( Lepton&& ) noexcept;
+
+        //construct the selector of the final derived class, to be called in the body of all its constructors
+        template< typename SelectorType, typename LeptonType > void constructSelector( const LeptonType* leptonPtr ){
+            selector = _selectorStorage.construct< SelectorType >( leptonPtr );
+        }
 };
 
 //check whether two leptons have the same flavor
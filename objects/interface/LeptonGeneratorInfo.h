@@ -11,20 +11,25 @@ Class that collects the generator level information for a given reconstructed le
 class LeptonGeneratorInfo{
     
     public:
+        LeptonGeneratorInfo() = default;
         LeptonGeneratorInfo( const TreeReader&, const unsigned ); 
 
-        bool isPrompt() const{ return _isPrompt; }
-        int matchPdgId() const{ return _matchPdgId; }
-        int matchCharge() const{ return _matchCharge; }
-        int momPdgId() const{ return _momPdgId; }
-        unsigned provenance() const{ return _provenance; }
-        unsigned provenanceCompressed() const{ return _provenanceCompressed; }
-        unsigned provenanceConversion() const{ return _provenanceConversion; }
+        //the matching branches are only read when the leptonGenMatch group of the TreeReader is enabled
+        bool isPrompt() const{ checkGenMatch( "LeptonGeneratorInfo::isPrompt" ); return _isPrompt; }
+        int matchPdgId() const{ checkGenMatch( "LeptonGeneratorInfo::matchPdgId" ); return _matchPdgId; }
+        int matchCharge() const{ checkGenMatch( "LeptonGeneratorInfo::matchCharge" ); return _matchCharge; }
+        int momPdgId() const{ checkGenMatch( "LeptonGeneratorInfo::momPdgId" ); return _momPdgId; }
+        unsigned provenance() const{ checkGenMatch( "LeptonGeneratorInfo::provenance" ); return _provenance; }
+        unsigned provenanceCompressed() const{ checkGenMatch( "LeptonGeneratorInfo::provenanceCompressed" ); return _provenanceCompressed; }
+        unsigned provenanceConversion() const{ checkGenMatch( "LeptonGeneratorInfo::provenanceConversion" ); return _provenanceConversion; }
 
     private:
-        bool _isPrompt;
-        int _matchPdgId, _matchCharge, _momPdgId;
-        unsigned _provenance, _provenanceCompressed, _provenanceConversion;
+        BranchProfile _branchProfile;
+        void checkGenMatch( const std::string& accessorName ) const{ _branchProfile.require( BranchProfile::leptonGenMatch, accessorName ); }
+
+        bool _isPrompt = true;
+        int _matchPdgId = 0, _matchCharge = 0, _momPdgId = 0;
+        unsigned _provenance = 0, _provenanceCompressed = 0, _provenanceConversion = 0;
 
 }; 
 #endif 
@@ -12,9 +12,7 @@
 class LightLepton : public Lepton {
     
     public: 
-        LightLepton( const TreeReader&, const unsigned, LeptonSelector* ); 
-        LightLepton( const LightLepton& ) = delete;
-        LightLepton( LightLepton&& ) = delete;
+        LightLepton( const TreeReader&, const unsigned ); 
 
         LightLepton& operator=( const LightLepton& ) = default;
         LightLepton& operator=( LightLepton&& ) = default;
@@ -74,8 +72,8 @@ class LightLepton : public Lepton {
 
     protected: 
 
-        LightLepton( const LightLepton&, LeptonSelector* );
-        LightLepton( LightLepton&&, LeptonSelector* );
+        LightLepton( const LightLepton& );
+        LightLepton( LightLepton&& ) noexcept;
 };
 
 #endif
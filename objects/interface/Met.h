@@ -26,6 +26,12 @@ class Met : public PhysicsObject {
 	Met MetJECDown( const std::string source ) const;
 	Met MetJECUp( const std::string source) const;
 
+	// same as above, for a variation index obtained with JECVariationIndex
+	// (grouped variations take precedence over sources with the same name, unknown names give index JECVariationTable::size())
+	JECVariationTable::size_type JECVariationIndex( const std::string& source ) const;
+	Met MetJECDown( const JECVariationTable::size_type variationIndex ) const;
+	Met MetJECUp( const JECVariationTable::size_type variationIndex ) const;
+
 	Met getVariedMet( const std::string& variation ) const;
 
         //maximum variations of met pT
@@ -43,12 +49,12 @@ class Met : public PhysicsObject {
         double _pt_JECUp = 0;
         double _phi_JECUp = 0;
 
-	std::vector< std::string > _JECSources;
-	std::map< std::string, std::pair<double,double> > _pxy_JECSourcesUp;
-	std::map< std::string, std::pair<double,double> > _pxy_JECSourcesDown;
-	std::vector< std::string > _JECGrouped;
-        std::map< std::string, std::pair<double,double> > _pxy_JECGroupedUp;
-        std::map< std::string, std::pair<double,double> > _pxy_JECGroupedDown;
+	//split and grouped JEC uncertainties (px, py), indexed as in the JECVariationTable of the tree
+	std::shared_ptr< const JECVariationTable > _JECVariationTable;
+	bool _hasJECSources = false;
+	bool _hasJECGrouped = false;
+	std::vector< std::pair< double, double > > _pxy_JECVariationsUp;
+	std::vector< std::pair< double, double > > _pxy_JECVariationsDown;
 
         //unclustered energy uncertainties
         double _pt_UnclDown = 0;
@@ -20,6 +20,9 @@ class Muon : public LightLepton {
         Muon& operator=( const Muon& ) = default;
         Muon& operator=( Muon&& ) = default;
 
+        //read the lepton at the given index into this object (see Event::refill)
+        void refill( const TreeReader&, const unsigned );
+
         virtual bool isMuon() const override{ return true; }
         virtual bool isElectron() const override{ return false; }
 
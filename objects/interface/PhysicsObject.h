@@ -29,8 +29,9 @@ class PhysicsObject{
         PhysicsObject( const PhysicsObject& ) = default;
         PhysicsObject( PhysicsObject&& ) noexcept = default; 
 
-        PhysicsObject& operator=( const PhysicsObject& ) = default;
-        PhysicsObject& operator=( PhysicsObject&& ) noexcept = default;
+        //assignments advance the generation of the object (see generation)
+        PhysicsObject& operator=( const PhysicsObject& );
+        PhysicsObject& operator=( PhysicsObject&& ) noexcept;
 
 
         double pt() const{ return vector.pt(); }
@@ -55,6 +56,10 @@ class PhysicsObject{
         bool is2017() const{ return is2017Object; }
         bool is2018() const{ return is2018Object; }
 
+        //increases whenever the object is modified, also through another collection or event sharing it,
+        //so that information derived from the object can be cached (see PhysicsObjectCollection)
+        unsigned long generation() const{ return _generation; }
+
         virtual ~PhysicsObject() = default;
 
         virtual std::ostream& print( std::ostream& os = std::cout ) const;
@@ -73,6 +78,8 @@ class PhysicsObject{
         bool is2017Object = false;
 	bool is2018Object = false;
 
+        unsigned long _generation = 0;
+
         //virtual PhysicsObject* clone() const &{ return new PhysicsObject( *this ); } 
         //virtual PhysicsObject* clone() &&{ return new PhysicsObject( std::move( *this ) ); }
 };
@@ -0,0 +1,36 @@
+/*
+Storage inside a physics object in which its selector is constructed, so that the selector needs no separate allocation.
+A selector belongs to the object it points to, so the storage can not be copied:
+the class that holds the storage constructs the selector of each new object in it, and destroys it again.
+*/
+
+#ifndef SelectorStorage_H
+#define SelectorStorage_H
+
+//include c++ library classes
+#include <new>
+#include <type_traits>
+
+
+class SelectorStorage{
+
+    public:
+
+        SelectorStorage() = default;
+        SelectorStorage( const SelectorStorage& ) = delete;
+        SelectorStorage& operator=( const SelectorStorage& ) = delete;
+
+        template< typename SelectorType, typename ObjectType > SelectorType* construct( ObjectType* objectPtr ){
+            static_assert( sizeof( SelectorType ) <= sizeof( StorageType ), "selector does not fit in SelectorStorage" );
+            static_assert( alignof( SelectorType ) <= alignof( StorageType ), "selector alignment is larger than that of SelectorStorage" );
+            return new ( &_storage ) SelectorType( objectPtr );
+        }
+
+    private:
+
+        //selectors only hold a pointer to their object (and a virtual table pointer for lepton selectors)
+        using StorageType = typename std::aligned_storage< 2*sizeof( void* ), alignof( void* ) >::type;
+        StorageType _storage;
+};
+
+#endif
@@ -19,6 +19,9 @@ class Tau : public Lepton{
         Tau& operator=( const Tau& ) = default;
         Tau& operator=( Tau&& ) noexcept = default;
 
+        //read the lepton at the given index into this object (see Event::refill)
+        void refill( const TreeReader&, const unsigned );
+
         virtual bool isLightLepton() const override{ return false; }
         virtual bool isMuon() const override{ return false; }
         virtual bool isElectron() const override{ return false; }
@@ -4,8 +4,8 @@
 #include "../interface/ElectronSelector.h"
 
 
-Electron::Electron( const TreeReader& treeReader, const unsigned leptonIndex ):
-    LightLepton( treeReader, leptonIndex, new ElectronSelector( this ) ),
+Electron::Electron( const TreeReader& treeReader, const unsigned leptonIndex ) :
+    LightLepton( treeReader, leptonIndex ),
     _passChargeConsistency( treeReader._lElectronChargeConst[leptonIndex] ),
     _passDoubleEGEmulation( treeReader._lElectronPassEmu[leptonIndex] ),
     _passConversionVeto( treeReader._lElectronPassConvVeto[leptonIndex] ),
@@ -34,6 +34,7 @@ Electron::Electron( const TreeReader& treeReader, const unsigned leptonIndex ):
     _e_ResUp( treeReader._lEResUp[leptonIndex] ),
     _e_ResDown( treeReader._lEResDown[leptonIndex] )
 {
+    constructSelector< ElectronSelector >( this );
     
     // apply electron energy correction -> use lPtCorr instead of lPt
     setLorentzVector( treeReader._lPtCorr[ leptonIndex ], eta(), phi(), 
@@ -46,7 +47,7 @@ Electron::Electron( const TreeReader& treeReader, const unsigned leptonIndex ):
 
 
 Electron::Electron( const Electron& rhs ) :
-	LightLepton( rhs, new ElectronSelector( this ) ),
+	LightLepton( rhs ),
 	_passChargeConsistency( rhs._passChargeConsistency ),
 	_passDoubleEGEmulation( rhs._passDoubleEGEmulation ),
 	_passConversionVeto( rhs._passConversionVeto ),
@@ -74,11 +75,13 @@ Electron::Electron( const Electron& rhs ) :
         _e_ScaleDown( rhs._e_ScaleDown ),     
         _e_ResUp( rhs._e_ResUp ),
         _e_ResDown( rhs._e_ResDown )
-	{}
+{
+    constructSelector< ElectronSelector >( this );
+}
 
 
 Electron::Electron( Electron&& rhs ) noexcept : 
-	LightLepton( std::move( rhs ), new ElectronSelector( this ) ),
+	LightLepton( std::move( rhs ) ),
 	_passChargeConsistency( rhs._passChargeConsistency ),
     _passDoubleEGEmulation( rhs._passDoubleEGEmulation ),
     _passConversionVeto( rhs._passConversionVeto ),
@@ -106,7 +109,15 @@ Electron::Electron( Electron&& rhs ) noexcept :
     _e_ScaleDown( rhs._e_ScaleDown ),  
     _e_ResUp( rhs._e_ResUp ),
     _e_ResDown( rhs._e_ResDown )
-    {}
+{
+    constructSelector< ElectronSelector >( this );
+}
+
+
+//the assignment keeps the selector of this lepton
+void Electron::refill( const TreeReader& treeReader, const unsigned leptonIndex ){
+    *this = Electron( treeReader, leptonIndex );
+}
 
 
 std::ostream& Electron::print( std::ostream& os ) const{
@@ -36,34 +36,18 @@ Jet::Jet( const TreeReader& treeReader, const unsigned jetIndex,
     _pt_JECUp( treeReader._jetSmearedPt_JECUp[jetIndex] ),
     _pt_JERDown( treeReader._jetSmearedPt_JERDown[jetIndex] ),
     _pt_JERUp( treeReader._jetSmearedPt_JERUp[jetIndex] ),
-    selector( new JetSelector( this ) )
+    selector( _selectorStorage.construct< JetSelector >( this ) )
 {
-    if( readAllJECVariations ){
-	for( const auto mapEl: treeReader._jetSmearedPt_JECSourcesUp ){
-	    std::string key = mapEl.first;
-	    key = stringTools::removeOccurencesOf(key,"_jetSmearedPt_");
-	    key = stringTools::removeOccurencesOf(key,"_JECSourcesUp");
-	    _pt_JECSourcesUp.insert( {key,mapEl.second[jetIndex]} );
-	}
-	for( const auto mapEl: treeReader._jetSmearedPt_JECSourcesDown ){
-	    std::string key = mapEl.first;
-	    key = stringTools::removeOccurencesOf(key,"_jetSmearedPt_");
-	    key = stringTools::removeOccurencesOf(key,"_JECSourcesDown");
-	    _pt_JECSourcesDown.insert( {key,mapEl.second[jetIndex]} );
-	}
-    }
-    if( readGroupedJECVariations ){
-	for( const auto mapEl: treeReader._jetSmearedPt_JECGroupedUp ){
-	    std::string key = mapEl.first;
-	    key = stringTools::removeOccurencesOf(key,"_jetSmearedPt_");
-	    key = stringTools::removeOccurencesOf(key,"_JECGroupedUp");
-	    _pt_JECGroupedUp.insert( {key,mapEl.second[jetIndex]} );
-	}
-	for( const auto mapEl: treeReader._jetSmearedPt_JECGroupedDown ){
-	    std::string key = mapEl.first;
-	    key = stringTools::removeOccurencesOf(key,"_jetSmearedPt_");
-	    key = stringTools::removeOccurencesOf(key,"_JECGroupedDown");
-	    _pt_JECGroupedDown.insert( {key,mapEl.second[jetIndex]} );
+    if( readAllJECVariations || readGroupedJECVariations ){
+	_JECVariationTable = treeReader._JECVariationTable;
+	_hasJECSources = readAllJECVariations;
+	_hasJECGrouped = readGroupedJECVariations;
+	_pt_JECVariationsUp.assign( _JECVariationTable->size(), 0. );
+	_pt_JECVariationsDown.assign( _JECVariationTable->size(), 0. );
+	for( JECVariationTable::size_type v = 0; v < _JECVariationTable->size(); ++v ){
+	    if( _JECVariationTable->isGrouped( v ) ? !readGroupedJECVariations : !readAllJECVariations ) continue;
+	    _pt_JECVariationsUp[ v ] = treeReader._jetSmearedPt_JECVariationsUp[ v*TreeReader::nJets_max + jetIndex ];
+	    _pt_JECVariationsDown[ v ] = treeReader._jetSmearedPt_JECVariationsDown[ v*TreeReader::nJets_max + jetIndex ];
 	}
     }
 
@@ -100,11 +84,12 @@ Jet::Jet( const Jet& rhs ) :
     _pt_JECUp( rhs._pt_JECUp ),
     _pt_JERDown( rhs._pt_JERDown ),
     _pt_JERUp( rhs._pt_JERUp ),
-    _pt_JECSourcesUp( rhs._pt_JECSourcesUp ),
-    _pt_JECSourcesDown( rhs._pt_JECSourcesDown ),
-    _pt_JECGroupedUp( rhs._pt_JECGroupedUp ),
-    _pt_JECGroupedDown( rhs._pt_JECGroupedDown ),
-    selector( new JetSelector( this ) )
+    _JECVariationTable( rhs._JECVariationTable ),
+    _hasJECSources( rhs._hasJECSources ),
+    _hasJECGrouped( rhs._hasJECGrouped ),
+    _pt_JECVariationsUp( rhs._pt_JECVariationsUp ),
+    _pt_JECVariationsDown( rhs._pt_JECVariationsDown ),
+    selector( _selectorStorage.construct< JetSelector >( this ) )
     {}
 
 
@@ -119,16 +104,17 @@ Jet::Jet( Jet&& rhs ) noexcept :
     _pt_JECUp( rhs._pt_JECUp ),
     _pt_JERDown( rhs._pt_JERDown ),
     _pt_JERUp( rhs._pt_JERUp ),
-    _pt_JECSourcesUp( rhs._pt_JECSourcesUp ),
-    _pt_JECSourcesDown( rhs._pt_JECSourcesDown ),
-    _pt_JECGroupedUp( rhs._pt_JECGroupedUp ),
-    _pt_JECGroupedDown( rhs._pt_JECGroupedDown ),
-    selector( new JetSelector( this ) )
+    _JECVariationTable( rhs._JECVariationTable ),
+    _hasJECSources( rhs._hasJECSources ),
+    _hasJECGrouped( rhs._hasJECGrouped ),
+    _pt_JECVariationsUp( rhs._pt_JECVariationsUp ),
+    _pt_JECVariationsDown( rhs._pt_JECVariationsDown ),
+    selector( _selectorStorage.construct< JetSelector >( this ) )
     {}
 
 
 Jet::~Jet(){
-    delete selector;
+    selector->~JetSelector();
 }
 
 
@@ -142,10 +128,11 @@ void Jet::copyNonPointerAttributes( const Jet& rhs ){
     _pt_JECUp = rhs._pt_JECUp;
     _pt_JERDown = rhs._pt_JERDown;
     _pt_JERUp = rhs._pt_JERUp;
-    _pt_JECSourcesUp = rhs._pt_JECSourcesUp;
-    _pt_JECSourcesDown = rhs._pt_JECSourcesDown;
-    _pt_JECGroupedUp = rhs._pt_JECGroupedUp;
-    _pt_JECGroupedDown = rhs._pt_JECGroupedDown;
+    _JECVariationTable = rhs._JECVariationTable;
+    _hasJECSources = rhs._hasJECSources;
+    _hasJECGrouped = rhs._hasJECGrouped;
+    _pt_JECVariationsUp = rhs._pt_JECVariationsUp;
+    _pt_JECVariationsDown = rhs._pt_JECVariationsDown;
 }
 
 
@@ -174,6 +161,13 @@ Jet& Jet::operator=( Jet&& rhs ) noexcept {
 }
 
 
+//the assignment keeps the selector of this jet
+void Jet::refill( const TreeReader& treeReader, const unsigned jetIndex,
+	    const bool readAllJECVariations, const bool readGroupedJECVariations ){
+    *this = Jet( treeReader, jetIndex, readAllJECVariations, readGroupedJECVariations );
+}
+
+
 Jet Jet::variedJet(const double newPt) const{
     Jet variedJet( *this );
     variedJet.setLorentzVector( newPt, eta(), phi(), energy()*( newPt / pt() ) );
@@ -201,34 +195,44 @@ Jet Jet::JetJERUp() const{
 }
 
 
-Jet Jet::JetJECDown( const std::string source ) const{
-    // note: this function checks both all and grouped variations,
-    // need to check if there is no overlap in names between them!
-    double newpt = 0.;
-    for( auto mapEl: this->_pt_JECSourcesDown ){
-	if(source==mapEl.first){ newpt = mapEl.second; }
+JECVariationTable::size_type Jet::JECVariationIndex( const std::string& source ) const{
+    //no variations were read, so every index gives a jet with pt 0
+    if( !_JECVariationTable ) return 0;
+    if( _hasJECGrouped ){
+	JECVariationTable::size_type index = _JECVariationTable->groupedIndex( source );
+	if( index != _JECVariationTable->size() ) return index;
     }
-    for( auto mapEl: this->_pt_JECGroupedDown ){
-        if(source==mapEl.first) newpt = mapEl.second;
+    if( _hasJECSources ){
+	return _JECVariationTable->sourceIndex( source );
     }
+    return _JECVariationTable->size();
+}
+
+
+Jet Jet::JetJECDown( const JECVariationTable::size_type variationIndex ) const{
+    // note: unknown variations give a jet with pt 0
+    double newpt = ( variationIndex < _pt_JECVariationsDown.size() ) ? _pt_JECVariationsDown[ variationIndex ] : 0.;
     return variedJet( newpt );
 }
 
 
-Jet Jet::JetJECUp( const std::string source ) const{
-    // note: this function checks both all and grouped variations,
-    // need to check if there is no overlap in names between them!
-    double newpt = 0.;
-    for( auto mapEl: this->_pt_JECSourcesUp ){
-        if(source==mapEl.first) newpt = mapEl.second;
-    }
-    for( auto mapEl: this->_pt_JECGroupedUp ){
-        if(source==mapEl.first) newpt = mapEl.second;
-    }
+Jet Jet::JetJECUp( const JECVariationTable::size_type variationIndex ) const{
+    // note: unknown variations give a jet with pt 0
+    double newpt = ( variationIndex < _pt_JECVariationsUp.size() ) ? _pt_JECVariationsUp[ variationIndex ] : 0.;
     return variedJet( newpt );
 }
 
 
+Jet Jet::JetJECDown( const std::string source ) const{
+    return JetJECDown( JECVariationIndex( source ) );
+}
+
+
+Jet Jet::JetJECUp( const std::string source ) const{
+    return JetJECUp( JECVariationIndex( source ) );
+}
+
+
 bool Jet::isGood() const{
     return selector->isGood();
 }
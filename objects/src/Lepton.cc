@@ -5,7 +5,7 @@
 #include <stdexcept>
 
 
-Lepton::Lepton( const TreeReader& treeReader, const unsigned leptonIndex, LeptonSelector* leptonSelector ) :
+Lepton::Lepton( const TreeReader& treeReader, const unsigned leptonIndex ) :
     PhysicsObject( treeReader._lPt[leptonIndex], treeReader._lEta[leptonIndex], 
 		    treeReader._lPhi[leptonIndex], treeReader._lE[leptonIndex], 
 		    treeReader.is2016(), 
@@ -17,24 +17,24 @@ Lepton::Lepton( const TreeReader& treeReader, const unsigned leptonIndex, Lepton
     _dxy( treeReader._dxy[leptonIndex] ),
     _dz( treeReader._dz[leptonIndex] ), 
     _sip3d( treeReader._3dIPSig[leptonIndex] ),
-    generatorInfo( treeReader.isMC() ? new LeptonGeneratorInfo( treeReader, leptonIndex ) : nullptr ),
-    selector( leptonSelector ),
+    generatorInfo( treeReader.isMC() ? LeptonGeneratorInfo( treeReader, leptonIndex ) : LeptonGeneratorInfo() ),
+    _hasGeneratorInfo( treeReader.isMC() ),
     _uncorrectedPt( pt() ),
     _uncorrectedE( energy() )
     {}
 
 
 //Lepton has value-like behavior 
-Lepton::Lepton( const Lepton& rhs, LeptonSelector* leptonSelector ) : 
+Lepton::Lepton( const Lepton& rhs ) : 
     PhysicsObject( rhs ),
     _charge( rhs._charge ),
     _dxy( rhs._dxy ),
     _dz( rhs._dz ),
     _sip3d( rhs._sip3d ),
-    generatorInfo( new LeptonGeneratorInfo( *(rhs.generatorInfo) ) ),
+    generatorInfo( rhs.generatorInfo ),
+    _hasGeneratorInfo( rhs._hasGeneratorInfo ),
 
-    //WARNING: selector remains uninitialized, and has to be dynamically allocated in derived classes. Final derived copy constructur MUST CREATE A NEW SELECTOR
-    selector( leptonSelector ),
+    //WARNING: selector is not copied, and has to be constructed in derived classes. Final derived copy constructur MUST CREATE A NEW SELECTOR (see constructSelector)
 
     //make sure to copy "isConeCorrected" so a cone-correction can not be re-applied even after copying a lepton
     isConeCorrected( rhs.isConeCorrected ),
@@ -43,31 +43,27 @@ Lepton::Lepton( const Lepton& rhs, LeptonSelector* leptonSelector ) :
     {}
 
 
-Lepton::Lepton( Lepton&& rhs, LeptonSelector* leptonSelector ) noexcept :
+Lepton::Lepton( Lepton&& rhs ) noexcept :
     PhysicsObject( std::move( rhs ) ),
     _charge( rhs._charge ),
     _dxy( rhs._dxy ),
     _dz( rhs._dz ),
     _sip3d( rhs._sip3d ),
     generatorInfo( rhs.generatorInfo ),
+    _hasGeneratorInfo( rhs._hasGeneratorInfo ),
 
-    //WARNING: selector remains uninitialized, and has to be dynamically allocated in derived classes. Final derived copy constructur MUST CREATE A NEW SELECTOR
-    selector( leptonSelector ),
+    //WARNING: selector is not copied, and has to be constructed in derived classes. Final derived copy constructur MUST CREATE A NEW SELECTOR (see constructSelector)
 
     //make sure to copy "isConeCorrected" so a cone-correction can not be re-applied even after copying a lepton
     isConeCorrected( rhs.isConeCorrected ),
     _uncorrectedPt( rhs._uncorrectedPt ),
     _uncorrectedE( rhs._uncorrectedE )
-{
-    rhs.generatorInfo = nullptr;
-}
+    {}
 
 
+//the selector lives inside the lepton, so it is destroyed but not deleted
 Lepton::~Lepton(){
-    delete selector;
-    if( hasGeneratorInfo() ){
-        delete generatorInfo;
-    }
+    if( selector != nullptr ) selector->~LeptonSelector();
 }
 
 
@@ -76,6 +72,8 @@ void Lepton::copyNonPointerAttributes( const Lepton& rhs ){
     _dxy = rhs._dxy;
     _dz = rhs._dz;
     _sip3d = rhs._sip3d;
+    generatorInfo = rhs.generatorInfo;
+    _hasGeneratorInfo = rhs._hasGeneratorInfo;
 
     //make sure to copy "isConeCorrected" so a cone-correction can not be re-applied even after copying a lepton
     isConeCorrected = rhs.isConeCorrected;
@@ -93,13 +91,6 @@ Lepton& Lepton::operator=( const Lepton& rhs ){
     copyNonPointerAttributes( rhs );
 
     //selector can keep pointing to the current lepton and does not need to be copied!
-    
-    //need to create new LeptonGeneratorInfo object to ensure self assignment works 
-    if( hasGeneratorInfo() ){
-        LeptonGeneratorInfo* oldInfo = generatorInfo;
-        generatorInfo = new LeptonGeneratorInfo( *rhs.generatorInfo );
-        delete oldInfo;
-    }
     return *this;
 }
 
@@ -116,12 +107,6 @@ Lepton& Lepton::operator=( Lepton&& rhs ) noexcept{
         copyNonPointerAttributes( rhs );
 
         //selector can keep pointing to the current lepton and does not need to be moved!
-
-        //move pointer to generator information and make sure to free old memory
-        delete generatorInfo; 
-        generatorInfo = rhs.generatorInfo;
-        rhs.generatorInfo = nullptr;
-        
     }
     return *this;
 }
@@ -137,7 +122,7 @@ bool Lepton::checkGeneratorInfo() const{
 
 bool Lepton::isPrompt() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->isPrompt();
+        return generatorInfo.isPrompt();
     } else {
         return true;
     }
@@ -146,7 +131,7 @@ bool Lepton::isPrompt() const{
 
 int Lepton::momPdgId() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->momPdgId(); 
+        return generatorInfo.momPdgId(); 
     } else {
         return 0;
     }
@@ -155,7 +140,7 @@ int Lepton::momPdgId() const{
 
 int Lepton::matchPdgId() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->matchPdgId();
+        return generatorInfo.matchPdgId();
     } else {
         return 0;
     }
@@ -164,7 +149,7 @@ int Lepton::matchPdgId() const{
 
 int Lepton::matchCharge() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->matchCharge();
+        return generatorInfo.matchCharge();
     } else {
         return 0;
     }
@@ -173,7 +158,7 @@ int Lepton::matchCharge() const{
 
 unsigned Lepton::provenance() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->provenance();
+        return generatorInfo.provenance();
     } else {
         return 0;
     }
@@ -182,7 +167,7 @@ unsigned Lepton::provenance() const{
 
 unsigned Lepton::provenanceCompressed() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->provenanceCompressed();
+        return generatorInfo.provenanceCompressed();
     } else {
         return 0;
     }
@@ -191,7 +176,7 @@ unsigned Lepton::provenanceCompressed() const{
 
 unsigned Lepton::provenanceConversion() const{
     if( checkGeneratorInfo() ){
-        return generatorInfo->provenanceConversion();
+        return generatorInfo.provenanceConversion();
     } else {
         return 0;
     }
@@ -1,11 +1,14 @@
 #include "../interface/LeptonGeneratorInfo.h"
 
 LeptonGeneratorInfo::LeptonGeneratorInfo( const TreeReader& treeReader, const unsigned leptonIndex ):
-    _isPrompt( treeReader._lIsPrompt[leptonIndex] ),
-    _matchPdgId( treeReader._lMatchPdgId[leptonIndex] ),
-    _matchCharge( treeReader._lMatchCharge[leptonIndex] ),
-    _momPdgId( treeReader._lMomPdgId[leptonIndex] ),
-    _provenance( treeReader._lProvenance[leptonIndex] ), 
-    _provenanceCompressed( treeReader._lProvenanceCompressed[leptonIndex] ),
-    _provenanceConversion( treeReader._lProvenanceConversion[leptonIndex] ) 
-    {}
+    _branchProfile( treeReader.branchProfile() )
+{
+    if( !_branchProfile.isEnabled( BranchProfile::leptonGenMatch ) ) return;
+    _isPrompt = treeReader._lIsPrompt[leptonIndex];
+    _matchPdgId = treeReader._lMatchPdgId[leptonIndex];
+    _matchCharge = treeReader._lMatchCharge[leptonIndex];
+    _momPdgId = treeReader._lMomPdgId[leptonIndex];
+    _provenance = treeReader._lProvenance[leptonIndex];
+    _provenanceCompressed = treeReader._lProvenanceCompressed[leptonIndex];
+    _provenanceConversion = treeReader._lProvenanceConversion[leptonIndex];
+}
@@ -4,8 +4,8 @@
 #include <cmath>
 
 
-LightLepton::LightLepton( const TreeReader& treeReader, const unsigned leptonIndex, LeptonSelector* leptonSelector ) :
-    Lepton( treeReader, leptonIndex, leptonSelector ),
+LightLepton::LightLepton( const TreeReader& treeReader, const unsigned leptonIndex ) :
+    Lepton( treeReader, leptonIndex ),
     _relIso0p3( treeReader._relIso[leptonIndex] ),
     _relIso0p4( treeReader._relIso0p4[leptonIndex] ), 
     _miniIso( treeReader._miniIso[leptonIndex] ),
@@ -42,8 +42,8 @@ LightLepton::LightLepton( const TreeReader& treeReader, const unsigned leptonInd
 }
 
 
-LightLepton::LightLepton( const LightLepton& rhs, LeptonSelector* leptonSelector ):
-    Lepton( rhs, leptonSelector ),
+LightLepton::LightLepton( const LightLepton& rhs ):
+    Lepton( rhs ),
     _relIso0p3( rhs._relIso0p3 ),
     _relIso0p4( rhs._relIso0p4 ),
     _miniIso( rhs._miniIso ),
@@ -61,8 +61,8 @@ LightLepton::LightLepton( const LightLepton& rhs, LeptonSelector* leptonSelector
     {}
 
 
-LightLepton::LightLepton( LightLepton&& rhs, LeptonSelector* leptonSelector ):
-    Lepton( std::move( rhs ), leptonSelector ),
+LightLepton::LightLepton( LightLepton&& rhs ) noexcept:
+    Lepton( std::move( rhs ) ),
     _relIso0p3( rhs._relIso0p3 ),
     _relIso0p4( rhs._relIso0p4 ),
     _miniIso( rhs._miniIso ),
@@ -15,38 +15,18 @@ Met::Met( const TreeReader& treeReader,
     _pt_UnclUp( treeReader._met_UnclUp ),
     _phi_UnclUp( treeReader._metPhi_UnclUp )
 {
-    if( readAllJECVariations ){
-	for( const auto mapEl: treeReader._corrMETx_JECSourcesUp ){
-            std::string key = mapEl.first;
-            key = stringTools::removeOccurencesOf(key,"_corrMETx_");
-            key = stringTools::removeOccurencesOf(key,"_JECSourcesUp");
-            _JECSources.push_back( key ); // assume they are the same for Up/Down and x/y!
-        }
-	for( const std::string key: _JECSources ){
-	    _pxy_JECSourcesUp.insert( {key, std::make_pair( 
-		treeReader._corrMETx_JECSourcesUp.at("_corrMETx_"+key+"_JECSourcesUp"), 
-		treeReader._corrMETy_JECSourcesUp.at("_corrMETy_"+key+"_JECSourcesUp"))} );
-	    _pxy_JECSourcesDown.insert( {key, std::make_pair( 
-                treeReader._corrMETx_JECSourcesDown.at("_corrMETx_"+key+"_JECSourcesDown"),   
-                treeReader._corrMETy_JECSourcesDown.at("_corrMETy_"+key+"_JECSourcesDown"))} );
+    if( readAllJECVariations || readGroupedJECVariations ){
+	_JECVariationTable = treeReader._JECVariationTable;
+	_hasJECSources = readAllJECVariations;
+	_hasJECGrouped = readGroupedJECVariations;
+	_pxy_JECVariationsUp.assign( _JECVariationTable->size(), std::make_pair( 0., 0. ) );
+	_pxy_JECVariationsDown.assign( _JECVariationTable->size(), std::make_pair( 0., 0. ) );
+	for( JECVariationTable::size_type v = 0; v < _JECVariationTable->size(); ++v ){
+	    if( _JECVariationTable->isGrouped( v ) ? !readGroupedJECVariations : !readAllJECVariations ) continue;
+	    _pxy_JECVariationsUp[ v ] = std::make_pair( treeReader._corrMETx_JECVariationsUp[ v ], treeReader._corrMETy_JECVariationsUp[ v ] );
+	    _pxy_JECVariationsDown[ v ] = std::make_pair( treeReader._corrMETx_JECVariationsDown[ v ], treeReader._corrMETy_JECVariationsDown[ v ] );
 	}
     }
-    if( readGroupedJECVariations ){
-        for( const auto mapEl: treeReader._corrMETx_JECGroupedUp ){
-            std::string key = mapEl.first;
-            key = stringTools::removeOccurencesOf(key,"_corrMETx_");
-            key = stringTools::removeOccurencesOf(key,"_JECGroupedUp");
-            _JECGrouped.push_back( key ); // assume they are the same for Up/Down and x/y!
-        }
-	for( const std::string key: _JECGrouped ){
-            _pxy_JECGroupedUp.insert( {key, std::make_pair( 
-                treeReader._corrMETx_JECGroupedUp.at("_corrMETx_"+key+"_JECGroupedUp"),  
-                treeReader._corrMETy_JECGroupedUp.at("_corrMETy_"+key+"_JECGroupedUp"))} );
-            _pxy_JECGroupedDown.insert( {key, std::make_pair(  
-                treeReader._corrMETx_JECGroupedDown.at("_corrMETx_"+key+"_JECGroupedDown"),   
-                treeReader._corrMETy_JECGroupedDown.at("_corrMETy_"+key+"_JECGroupedDown"))} );
-        }
-    }
 }
 
 
@@ -80,32 +60,41 @@ Met Met::MetUnclusteredUp() const{
     return variedMet( _pt_UnclUp, _phi_UnclUp );
 }
 
-Met Met::MetJECDown( const std::string source ) const{
-    // note: this function checks both all and grouped variations,
-    // need to check if there is no overlap in names between them!
-    std::pair< double, double > newpxy = std::make_pair( 0,0 );
-    for( std::string test: this->_JECSources ){
-        if(source==test) newpxy = this->_pxy_JECSourcesDown.at(source);
+JECVariationTable::size_type Met::JECVariationIndex( const std::string& source ) const{
+    //no variations were read, so every index gives a met of 0
+    if( !_JECVariationTable ) return 0;
+    if( _hasJECGrouped ){
+	JECVariationTable::size_type index = _JECVariationTable->groupedIndex( source );
+	if( index != _JECVariationTable->size() ) return index;
     }
-    for( std::string test: this->_JECGrouped ){
-        if(source==test) newpxy = this->_pxy_JECGroupedDown.at(source);
+    if( _hasJECSources ){
+	return _JECVariationTable->sourceIndex( source );
     }
+    return _JECVariationTable->size();
+}
+
+
+Met Met::MetJECDown( const JECVariationTable::size_type variationIndex ) const{
+    std::pair< double, double > newpxy = std::make_pair( 0,0 );
+    if( variationIndex < _pxy_JECVariationsDown.size() ) newpxy = _pxy_JECVariationsDown[ variationIndex ];
     return variedMetPxPy( newpxy.first, newpxy.second );
 }
 
-Met Met::MetJECUp( const std::string source ) const{
-    // note: this function checks both all and grouped variations,
-    // need to check if there is no overlap in names between them!
+
+Met Met::MetJECUp( const JECVariationTable::size_type variationIndex ) const{
     std::pair< double, double > newpxy = std::make_pair( 0,0 );
-    for( std::string test: this->_JECSources ){
-        if(source==test) newpxy = this->_pxy_JECSourcesUp.at(source);
-    }
-    for( std::string test: this->_JECGrouped ){
-        if(source==test) newpxy = this->_pxy_JECGroupedUp.at(source);
-    }
+    if( variationIndex < _pxy_JECVariationsUp.size() ) newpxy = _pxy_JECVariationsUp[ variationIndex ];
     return variedMetPxPy( newpxy.first, newpxy.second );
 }
 
+Met Met::MetJECDown( const std::string source ) const{
+    return MetJECDown( JECVariationIndex( source ) );
+}
+
+Met Met::MetJECUp( const std::string source ) const{
+    return MetJECUp( JECVariationIndex( source ) );
+}
+
 Met Met::getVariedMet( const std::string& variation ) const{
     if( variation == "nominal" ){
         return *this;
@@ -4,8 +4,8 @@
 #include "../interface/MuonSelector.h"
 
 
-Muon::Muon( const TreeReader& treeReader, const unsigned leptonIndex ):
-    LightLepton( treeReader, leptonIndex, new MuonSelector( this ) ),
+Muon::Muon( const TreeReader& treeReader, const unsigned leptonIndex ) :
+    LightLepton( treeReader, leptonIndex ),
     _segmentCompatibility( treeReader._lMuonSegComp[leptonIndex] ),
     _trackPt( treeReader._lMuonTrackPt[leptonIndex] ),
     _trackPtError( treeReader._lMuonTrackPtErr[leptonIndex] ),
@@ -14,6 +14,8 @@ Muon::Muon( const TreeReader& treeReader, const unsigned leptonIndex ):
     _isMediumPOGMuon( treeReader._lPOGMedium[leptonIndex] ),
     _isTightPOGMuon( treeReader._lPOGTight[leptonIndex] )
 {
+    constructSelector< MuonSelector >( this );
+
     // apply muon rochester energy correction -> use lPtCorr instead of lPt
     setLorentzVector( treeReader._lPtCorr[ leptonIndex ], eta(), phi(),
                       treeReader._lECorr[ leptonIndex ] );
@@ -26,7 +28,7 @@ Muon::Muon( const TreeReader& treeReader, const unsigned leptonIndex ):
 
 
 Muon::Muon( const Muon& rhs ):
-    LightLepton( rhs, new MuonSelector( this ) ),
+    LightLepton( rhs ),
     _segmentCompatibility( rhs._segmentCompatibility ),
     _trackPt( rhs._trackPt ),
     _trackPtError( rhs._trackPtError ),
@@ -34,11 +36,13 @@ Muon::Muon( const Muon& rhs ):
     _isLoosePOGMuon( rhs._isLoosePOGMuon ),
     _isMediumPOGMuon( rhs._isMediumPOGMuon ),
     _isTightPOGMuon( rhs._isTightPOGMuon )
-    {}    
+{
+    constructSelector< MuonSelector >( this );
+}
 
 
 Muon::Muon( Muon&& rhs ) noexcept:
-    LightLepton( std::move( rhs ), new MuonSelector( this ) ),
+    LightLepton( std::move( rhs ) ),
     _segmentCompatibility( rhs._segmentCompatibility ),
     _trackPt( rhs._trackPt ),
     _trackPtError( rhs._trackPtError ),
@@ -46,7 +50,15 @@ Muon::Muon( Muon&& rhs ) noexcept:
     _isLoosePOGMuon( rhs._isLoosePOGMuon ),
     _isMediumPOGMuon( rhs._isMediumPOGMuon ),
     _isTightPOGMuon( rhs._isTightPOGMuon )
-    {}    
+{
+    constructSelector< MuonSelector >( this );
+}
+
+
+//the assignment keeps the selector of this lepton
+void Muon::refill( const TreeReader& treeReader, const unsigned leptonIndex ){
+    *this = Muon( treeReader, leptonIndex );
+}
 
 
 std::ostream& Muon::print( std::ostream& os ) const{
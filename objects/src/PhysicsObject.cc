@@ -31,6 +31,24 @@ void PhysicsObject::setLorentzVector( double transverseMomentum, double pseudoRa
 }
 
 
+//all modifications of an object (also by derived classes, through setLorentzVector or their own assignment) go through these assignments
+PhysicsObject& PhysicsObject::operator=( const PhysicsObject& rhs ){
+    vector = rhs.vector;
+    is2016Object = rhs.is2016Object;
+    is2016PreVFPObject = rhs.is2016PreVFPObject;
+    is2016PostVFPObject = rhs.is2016PostVFPObject;
+    is2017Object = rhs.is2017Object;
+    is2018Object = rhs.is2018Object;
+    ++_generation;
+    return *this;
+}
+
+
+PhysicsObject& PhysicsObject::operator=( PhysicsObject&& rhs ) noexcept{
+    return ( *this = static_cast< const PhysicsObject& >( rhs ) );
+}
+
+
 PhysicsObject PhysicsObject::operator-() const{
     PhysicsObject neg = *this;
     neg.vector = -neg.vector;
@@ -40,6 +58,7 @@ PhysicsObject PhysicsObject::operator-() const{
 
 PhysicsObject& PhysicsObject::operator+=( const PhysicsObject& rhs ){
     vector += rhs.vector;
+    ++_generation;
     return *this;
 }
 
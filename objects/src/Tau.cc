@@ -5,7 +5,7 @@
 
 
 Tau::Tau( const TreeReader& treeReader, const unsigned leptonIndex ) :
-    Lepton( treeReader, leptonIndex, new TauSelector( this ) ),
+    Lepton( treeReader, leptonIndex ),
     _decayMode( treeReader._tauDecayMode[ leptonIndex ] ),
     _passDecayModeFinding( treeReader._decayModeFinding[ leptonIndex ] ),
     _passDecayModeFindingNew( treeReader._decayModeFindingNew[ leptonIndex ] ),
@@ -43,11 +43,13 @@ Tau::Tau( const TreeReader& treeReader, const unsigned leptonIndex ) :
     _passTightMVANew2017( treeReader._tauTightMvaNew2017v2[ leptonIndex ] ),
     _passVTightMVANew2017( treeReader._tauVTightMvaNew2017v2[ leptonIndex ] )
         
-    {} 
+{
+    constructSelector< TauSelector >( this );
+}
 
 
 Tau::Tau( const Tau& rhs ) :
-    Lepton( rhs, new TauSelector( this) ),
+    Lepton( rhs ),
    	_decayMode( rhs._decayMode ),
     _passDecayModeFinding( rhs._passDecayModeFinding ),
     _passDecayModeFindingNew( rhs._passDecayModeFindingNew ),
@@ -84,11 +86,13 @@ Tau::Tau( const Tau& rhs ) :
     _passMediumMVANew2017( rhs._passMediumMVANew2017 ),
     _passTightMVANew2017( rhs._passTightMVANew2017 ),
     _passVTightMVANew2017( rhs._passVTightMVANew2017 )
-	{}
+{
+    constructSelector< TauSelector >( this );
+}
 
 
 Tau::Tau( Tau&& rhs ) noexcept :
-    Lepton( std::move( rhs ), new TauSelector( this ) ),
+    Lepton( std::move( rhs ) ),
 	_decayMode( rhs._decayMode ),
     _passDecayModeFinding( rhs._passDecayModeFinding ),
     _passDecayModeFindingNew( rhs._passDecayModeFindingNew ),
@@ -125,7 +129,15 @@ Tau::Tau( Tau&& rhs ) noexcept :
     _passMediumMVANew2017( rhs._passMediumMVANew2017 ),
     _passTightMVANew2017( rhs._passTightMVANew2017 ),
     _passVTightMVANew2017( rhs._passVTightMVANew2017 )
-	{}
+{
+    constructSelector< TauSelector >( this );
+}
+
+
+//the assignment keeps the selector of this lepton
+void Tau::refill( const TreeReader& treeReader, const unsigned leptonIndex ){
+    *this = Tau( treeReader, leptonIndex );
+}
 
 
 std::ostream& Tau::print( std::ostream& os ) const{
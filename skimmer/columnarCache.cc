@@ -0,0 +1,70 @@
+//include c++ library classes 
+#include <string>
+#include <vector>
+#include <iostream>
+#include <chrono>
+
+//include other parts of framework
+#include "../TreeReader/interface/TreeReader.h"
+#include "../Tools/interface/stringTools.h"
+
+
+// write the columnar cache of the current sample of the TreeReader
+void writeCache( TreeReader& treeReader, const std::string& cacheDirectory, const BranchProfile& branchProfile ){
+    treeReader.setBranchProfile( branchProfile );
+    const std::string cachePath = TreeReader::columnarCachePath( cacheDirectory, treeReader.currentSample() );
+    std::cout << "writing columnar cache of " << treeReader.currentSample().fileName() << " to " << cachePath << std::endl;
+
+    auto writeBegin = std::chrono::steady_clock::now();
+    unsigned long long numberOfBytes = treeReader.writeColumnarCache( cachePath );
+    std::chrono::duration< double > writeTime = std::chrono::steady_clock::now() - writeBegin;
+    std::cout << "wrote " << treeReader.numberOfEntries() << " entries (" << numberOfBytes / 1.e6 << " MB) in " << writeTime.count() << " s" << std::endl;
+}
+
+
+int main( int argc, char* argv[] ){
+    std::cerr << "###starting###" << std::endl;
+
+    std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+
+    // the cache holds the branch groups of the profile, analyses reading the cache can only use these branches
+    std::string profileName = "all";
+    std::vector< std::string > remainingArguments;
+    for( const auto& argument : argvStr ){
+        if( stringTools::stringStartsWith( argument, "--profile=" ) ){
+            profileName = argument.substr( std::string( "--profile=" ).size() );
+        } else {
+            remainingArguments.push_back( argument );
+        }
+    }
+    argvStr = remainingArguments;
+
+    if( argvStr.size() != 3 && argvStr.size() != 4 ){
+        std::cerr << "columnarCache requires two or three arguments to run : " << std::endl;
+        std::cerr << "cache_directory, input_file_path" << std::endl;
+        std::cerr << "or cache_directory, sample_list, sample_directory" << std::endl;
+        std::cerr << "optional settings:" << std::endl;
+        std::cerr << "  --profile=<groups>  branch groups to write, e.g. minimal,jets (default all)" << std::endl;
+        return -1;
+    }
+    const std::string& cacheDirectory = argvStr[1];
+    const BranchProfile branchProfile( profileName );
+
+    // a single ntuple
+    if( argvStr.size() == 3 ){
+        TreeReader treeReader;
+        treeReader.initSampleFromFile( argvStr[2] );
+        writeCache( treeReader, cacheDirectory, branchProfile );
+
+    // all samples of a sample list, with the same cache names as used when reading them with TreeReader::setColumnarCacheDirectory
+    } else {
+        TreeReader treeReader( argvStr[2], argvStr[3] );
+        for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+            treeReader.initSample();
+            writeCache( treeReader, cacheDirectory, branchProfile );
+        }
+    }
+
+    std::cerr << "###done###" << std::endl;
+    return 0;
+}
@@ -1,6 +1,8 @@
 /*
 Functions to apply a certain skimming condition. If you need new skimming conditions, add them here, and implement them in src/skimSelection.cc
 Make sure to always add new skim conditions to the std::map in the passSkim function for them to be able to be used!
+A skim condition can also declare a pre-selection in skimPreSelection, applied to the raw ntuple branches before the events are built.
+It has to be looser than the skim condition itself, since it only serves to avoid building events that are certain to fail.
 */
 
 
@@ -9,6 +11,7 @@ Make sure to always add new skim conditions to the std::map in the passSkim func
 
 //include other parts of framework
 #include "../../Event/interface/Event.h"
+#include "../../TreeReader/interface/PreSelection.h"
 
 bool passSingleLeptonSkim( Event& );
 bool passDileptonSkim( Event& );
@@ -16,5 +19,6 @@ bool passTrileptonSkim( Event& );
 bool passFourLeptonSkim( Event& );
 bool passFakeRateSkim( Event& );
 bool passSkim( Event&, const std::string& skimCondition );
+PreSelection skimPreSelection( const std::string& skimCondition );
 
 #endif
@@ -15,6 +15,7 @@
 # - optional: files per job
 # - optional: wall time per job
 # - optional: run mode (condor, qsub or local)
+# - optional: slimming profile (see slimmingProfiles.txt)
 
 import sys
 import os
@@ -39,6 +40,7 @@ if len(sys.argv) < 5:
     print('  - files per job = number of files per job [optional]')
     print('  - walltime = maximum wall time [optional]')
     print('  - runmode = run mode (condor, qsub or local) [optional]')
+    print('  - slimming = slimming profile defined in slimmingProfiles.txt [optional]')
     sys.exit()
 
 # read required command line args
@@ -52,6 +54,7 @@ version_name = None
 files_per_job = 50
 wall_time = '24:00:00'
 runmode = 'condor'
+slimming = None
 if len(sys.argv)>5:
     for sysarg in sys.argv[5:]:
         sysarg = sysarg.split('=')
@@ -59,6 +62,7 @@ if len(sys.argv)>5:
         elif sysarg[0]=='walltime': wall_time = sysarg[1]
         elif sysarg[0]=='version': version_name = sysarg[1]
 	elif sysarg[0]=='runmode': runmode = sysarg[1]
+	elif sysarg[0]=='slimming': slimming = sysarg[1]
         else: 
             raise Exception('ERROR: optional argument '+sysargi[0]+' not recognized!')
 
@@ -72,6 +76,7 @@ print('  - version: {}'.format(version_name))
 print('  - files per job: {}'.format(files_per_job))
 print('  - walltime: {}'.format(wall_time))
 print('  - runmode: {}'.format(runmode))
+print('  - slimming: {}'.format(slimming))
 
 # check if executable exists
 exe = './skimmer'
@@ -195,6 +200,7 @@ for sample_directory, sub_directory, output_directory in itlist:
 	commands.append( 'cd {}'.format(cwd) )
 	for f in chunk:
 	    command = './skimmer {} {} {}'.format(f,output_directory,skim_condition)
+	    if slimming is not None: command += ' --slimming={}'.format(slimming)
 	    commands.append(command)
         # submission via qsub or local
 	if( runmode=='qsub' or runmode=='local' ):
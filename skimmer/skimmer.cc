@@ -3,6 +3,7 @@
 #include <vector>
 #include <exception>
 #include <iostream>
+#include <chrono>
 
 //include ROOT classes 
 #include "TH1D.h"
@@ -12,16 +13,38 @@
 //include other parts of framework
 #include "../TreeReader/interface/TreeReader.h"
 #include "../Tools/interface/stringTools.h"
+#include "../Tools/interface/OutputFileSettings.h"
 #include "../Event/interface/Event.h"
 #include "interface/skimSelections.h"
 
 
-void skimFile( const std::string& pathToFile, const std::string& outputDirectory, const std::string& skimCondition ){
+// find the entries passing the skim condition, reading only the branches needed for the selection
+std::vector< long unsigned > passingEntries( TreeReader& treeReader, const std::string& skimCondition ){
+    treeReader.setBranchProfile( BranchProfile( "minimal,taus" ) );
+    PreSelectionResult preSelected = treeReader.preSelectEntries( skimPreSelection( skimCondition ) );
+    std::vector< long unsigned > entries;
+    std::chrono::duration< double > buildTime( 0. );
+    for( long unsigned entry : preSelected ){
+        auto buildBegin = std::chrono::steady_clock::now();
+        Event event = treeReader.buildEvent( entry );
+        buildTime += std::chrono::steady_clock::now() - buildBegin;
+        if( passSkim( event, skimCondition ) ) entries.push_back( entry );
+    }
+    preSelected.print( std::cout, ( preSelected.size() == 0 ? 0. : buildTime.count() / preSelected.size() ) );
+    treeReader.setBranchProfile( BranchProfile() );
+    return entries;
+}
+
+
+void skimFile( const std::string& pathToFile, const std::string& outputDirectory, const std::string& skimCondition,
+	const ReadCacheSettings& readCacheSettings, const bool fastClone, const SlimmingProfile& slimmingProfile,
+	const OutputFileSettings& outputFileSettings ){
 
     std::cout << "skimming " << pathToFile << std::endl;
 
     // initialize TreeReader, input files might be corrupt in rare cases
     TreeReader treeReader;
+    treeReader.setReadCache( readCacheSettings );
     try{
         treeReader.initSampleFromFile( pathToFile );
     } catch( std::domain_error& ){
@@ -35,7 +58,7 @@ void skimFile( const std::string& pathToFile, const std::string& outputDirectory
     std::string outputFileName = stringTools::split( pathToFile, "/heavyNeutrino/" ).back();
     outputFileName = stringTools::removeOccurencesOf( outputFileName, "/" );
     std::string outputFilePath = stringTools::formatDirectoryName( outputDirectory ) + outputFileName;
-    TFile* outputFilePtr = TFile::Open( outputFilePath.c_str() , "RECREATE" );
+    TFile* outputFilePtr = outputFileSettings.openFile( outputFilePath );
     outputFilePtr->mkdir( "blackJackAndHookers" );
     outputFilePtr->cd( "blackJackAndHookers" );
 
@@ -45,28 +68,65 @@ void skimFile( const std::string& pathToFile, const std::string& outputDirectory
         histPtr->Write();
     }
 
+    // in fast-clone mode the passing entries are copied with all branches of the input tree,
+    // instead of being written through the variables of the TreeReader
+    if( fastClone ){
+        long unsigned nentries = treeReader.numberOfEntries();
+        std::vector< long unsigned > entries = passingEntries( treeReader, skimCondition );
+        auto copyBegin = std::chrono::steady_clock::now();
+        TTree* outputTreePtr = ( outputFileSettings.configuresTree() ? 
+            treeReader.copyEntries( entries, [&outputFileSettings]( TTree* treePtr ){ outputFileSettings.configureTree( treePtr ); } ) 
+            : treeReader.copyEntries( entries ) );
+        outputTreePtr->Write( "",  BIT(2) );
+        std::chrono::duration< double > copyTime = std::chrono::steady_clock::now() - copyBegin;
+        if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
+        OutputFileSettings::printCompressionReport( outputTreePtr, copyTime.count() );
+        outputFilePtr->Close();
+
+        std::cout << "skimmed " << pathToFile << std::endl;
+        std::cout << "number of entries: " << nentries << std::endl;
+        std::cout << "number of passing entries: " << entries.size() << std::endl;
+        std::cout << "time to copy passing entries: " << copyTime.count() << " s" << std::endl;
+        return;
+    }
+
     // make output tree
     std::shared_ptr< TTree > outputTreePtr( std::make_shared< TTree >( 
 	"blackJackAndHookersTree","blackJackAndHookersTree" ) );
+    treeReader.setSlimmingProfile( slimmingProfile );
     treeReader.setOutputTree( outputTreePtr.get() );
+    outputFileSettings.configureTree( outputTreePtr.get() );
 
+    // reject entries that certainly fail the skim before building their events
     long unsigned nentries = treeReader.numberOfEntries();
+    PreSelectionResult preSelected = treeReader.preSelectEntries( skimPreSelection( skimCondition ) );
     long unsigned npass = 0;
-    for( long unsigned entry = 0; entry < nentries; ++entry ){
+    std::chrono::duration< double > buildTime( 0. );
+    std::chrono::duration< double > writeTime( 0. );
+    for( long unsigned entry : preSelected ){
 
         // build event
-        Event event = treeReader.buildEvent( entry, true, true, false, false );
+        auto buildBegin = std::chrono::steady_clock::now();
+        Event event = treeReader.buildEvent( entry );
+        buildTime += std::chrono::steady_clock::now() - buildBegin;
 
         // apply event selection
         if( !passSkim( event, skimCondition ) ) continue;
 
         // fill new tree
 	npass++;
-        outputTreePtr->Fill();
+        auto fillBegin = std::chrono::steady_clock::now();
+        treeReader.fillOutputTree( outputTreePtr.get() );
+        writeTime += std::chrono::steady_clock::now() - fillBegin;
     }
 
+    if( readCacheSettings.isSet() ) treeReader.printReadCacheStatistics();
+
     // write new tree
+    auto writeBegin = std::chrono::steady_clock::now();
     outputTreePtr->Write( "",  BIT(2) );
+    writeTime += std::chrono::steady_clock::now() - writeBegin;
+    OutputFileSettings::printCompressionReport( outputTreePtr.get(), writeTime.count() );
 
     // close output file
     outputFilePtr->Close();
@@ -75,24 +135,65 @@ void skimFile( const std::string& pathToFile, const std::string& outputDirectory
     std::cout << "skimmed " << pathToFile << std::endl;
     std::cout << "number of entries: " << nentries << std::endl;
     std::cout << "number of passing entries: " << npass << std::endl;
+    preSelected.print( std::cout, ( preSelected.size() == 0 ? 0. : buildTime.count() / preSelected.size() ) );
 }
 
 
 int main( int argc, char* argv[] ){
     std::cerr << "###starting###" << std::endl;
 
-    if( argc != 4 ){
+    std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+    const ReadCacheSettings readCacheSettings = ReadCacheSettings::fromCommandLine( argvStr );
+    readCacheSettings.enableAsyncPrefetching();
+
+    // skims are intermediate files that are read many times, so they are written for fast reading by default
+    const OutputFileSettings outputFileSettings = OutputFileSettings::fromCommandLine( argvStr, "fastread" );
+
+    // optional fast-clone mode and slimming
+    bool fastClone = false;
+    std::string slimmingProfileName;
+    std::string slimmingConfig = "slimmingProfiles.txt";
+    std::vector< std::string > remainingArguments;
+    for( const auto& argument : argvStr ){
+        if( argument == "--fastClone" ){
+            fastClone = true;
+        } else if( stringTools::stringStartsWith( argument, "--slimming=" ) ){
+            slimmingProfileName = argument.substr( std::string( "--slimming=" ).size() );
+        } else if( stringTools::stringStartsWith( argument, "--slimmingConfig=" ) ){
+            slimmingConfig = argument.substr( std::string( "--slimmingConfig=" ).size() );
+        } else {
+            remainingArguments.push_back( argument );
+        }
+    }
+    argvStr = remainingArguments;
+
+    if( argvStr.size() != 4 ){
         std::cerr << "skimmer requires exactly three arguments to run : " << std::endl;
 	std::cerr << "input_file_path, output_directory, skim_condition" << std::endl;
+	std::cerr << "optional skim settings:" << std::endl;
+	std::cerr << "  --fastClone  copy passing entries with all input branches instead of rewriting them" << std::endl;
+	std::cerr << "  --slimming=<profile>  write only the branches of a slimming profile" << std::endl;
+	std::cerr << "  --slimmingConfig=<file>  file defining the slimming profiles (default slimmingProfiles.txt)" << std::endl;
+	std::cerr << ReadCacheSettings::commandLineUsage() << std::endl;
+	std::cerr << OutputFileSettings::commandLineUsage() << std::endl;
         return -1;
     }
 
-    std::vector< std::string > argvStr( &argv[0], &argv[0] + argc );
+    // fast cloning copies the input branches as they are
+    SlimmingProfile slimmingProfile;
+    if( !slimmingProfileName.empty() ){
+        if( fastClone ){
+            std::cerr << "ERROR: a slimming profile can not be used with --fastClone." << std::endl;
+            return -1;
+        }
+        slimmingProfile = SlimmingProfile::fromFile( slimmingConfig, slimmingProfileName );
+    }
 
     std::string& input_file_path = argvStr[1];
     std::string& output_directory = argvStr[2];
     std::string& skimCondition = argvStr[3];
-    skimFile( input_file_path, output_directory, skimCondition );
+    outputFileSettings.enableParallelCompression();
+    skimFile( input_file_path, output_directory, skimCondition, readCacheSettings, fastClone, slimmingProfile, outputFileSettings );
 
     std::cerr << "###done###" << std::endl;
     return 0;
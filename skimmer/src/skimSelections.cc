@@ -61,3 +61,23 @@ bool passSkim( Event& event, const std::string& skimCondition ){
         return (it->second)(event);
     }
 }
+
+
+PreSelection skimPreSelection( const std::string& skimCondition ){
+
+    //loose lepton selection and cleaning only remove leptons, so the raw number of leptons is an upper bound
+    static std::map< std::string, PreSelection > preSelectionMap = {
+        { "noskim", PreSelection() },
+        { "singlelepton", PreSelection::minimumNumberOfLeptons( 1 ) },
+        { "dilepton", PreSelection::minimumNumberOfLeptons( 2 ) },
+        { "trilepton", PreSelection::minimumNumberOfLeptons( 3 ) },
+        { "fourlepton", PreSelection::minimumNumberOfLeptons( 4 ) },
+        { "fakerate", PreSelection::minimumNumberOfLightLeptons( 1 ) & PreSelection::minimumNumberOfJets( 1 ) }
+    };
+    auto it = preSelectionMap.find( skimCondition );
+    if( it == preSelectionMap.cend() ){
+        throw std::invalid_argument( "unknown skim condition " + skimCondition );
+    } else {
+        return it->second;
+    }
+}
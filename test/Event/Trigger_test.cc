@@ -40,6 +40,16 @@ int main(){
             triggerInfo.printAvailableMetFilters();
         }
 
+        //decisions looked up by name, by index and through a selection have to agree
+        const DecisionTable& triggerTable = *triggerInfo.triggerTable();
+        for( DecisionTable::size_type t = 0; t < triggerTable.size(); ++t ){
+            bool pass = triggerInfo.passTrigger( triggerTable.name( t ) );
+            if( pass != triggerInfo.passTrigger( t ) || pass != triggerInfo.passAnyTrigger( triggerTable.name( t ) ) ){
+                std::cerr << "Error: inconsistent decision for trigger " << triggerTable.name( t ) << std::endl;
+                return 1;
+            }
+        }
+
         copyMoveTest( triggerInfo );
     }
 
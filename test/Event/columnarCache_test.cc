@@ -0,0 +1,129 @@
+/*
+Check of the columnar cache (see TreeReader/interface/ColumnarCache.h).
+A cache is written from an ntuple, after which the values read from the cache with TreeReader::GetEntry and TreeReader::readBatch
+are compared to the values read from the tree, and the time needed to read all entries is compared for both.
+A second cache is written with the 'minimal' branch profile, which must be refused by readers that enable more branch groups.
+Usage: ./columnarCache_test <path to ntuple> <cache directory>
+*/
+
+//include class to test
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../TreeReader/interface/ColumnarCache.h"
+
+//include c++ library classes
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+
+
+template< typename T > void compareArray( const T* lhs, const T* rhs, const unsigned size, const long unsigned entry, const std::string& name ){
+    for( unsigned i = 0; i < size; ++i ){
+        if( lhs[ i ] != rhs[ i ] ){
+            throw std::runtime_error( "Value of " + name + " differs for entry " + std::to_string( entry ) + "." );
+        }
+    }
+}
+
+
+double readAllEntries( TreeReader& treeReader ){
+    double sum = 0.;
+    for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
+        treeReader.GetEntry( entry );
+        sum += treeReader._met;
+        for( unsigned l = 0; l < treeReader._nL; ++l ) sum += treeReader._lPt[ l ];
+        for( unsigned j = 0; j < treeReader._nJets; ++j ) sum += treeReader._jetPt[ j ];
+    }
+    return sum;
+}
+
+
+int main( int argc, char* argv[] ){
+    if( argc != 3 ){
+        std::cerr << "Usage: ./columnarCache_test <path to ntuple> <cache directory>" << std::endl;
+        return 1;
+    }
+
+    TreeReader treeReader;
+    treeReader.initSampleFromFile( argv[1] );
+    auto begin = std::chrono::high_resolution_clock::now();
+    unsigned long long numberOfBytes = treeReader.writeColumnarCache( argv[2] );
+    std::chrono::duration< double > writeTime = std::chrono::high_resolution_clock::now() - begin;
+    std::cout << "writing cache : " << writeTime.count() << " s, " << numberOfBytes / 1.e6 << " MB" << std::endl;
+
+    TreeReader cacheReader;
+    cacheReader.initSampleFromCache( argv[2] );
+    if( cacheReader.numberOfEntries() != treeReader.numberOfEntries() ){
+        std::cerr << "Number of entries of the cache and the tree differ." << std::endl;
+        return 1;
+    }
+
+    begin = std::chrono::high_resolution_clock::now();
+    double treeSum = readAllEntries( treeReader );
+    std::chrono::duration< double > treeTime = std::chrono::high_resolution_clock::now() - begin;
+    begin = std::chrono::high_resolution_clock::now();
+    double cacheSum = readAllEntries( cacheReader );
+    std::chrono::duration< double > cacheTime = std::chrono::high_resolution_clock::now() - begin;
+    std::cout << "reading tree : " << treeTime.count() << " s" << std::endl;
+    std::cout << "reading cache : " << cacheTime.count() << " s" << std::endl;
+    if( treeSum != cacheSum ){
+        std::cerr << "Sums of tree and cache reading differ." << std::endl;
+        return 1;
+    }
+
+    //compare the full content of the entries
+    for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
+        treeReader.GetEntry( entry );
+        cacheReader.GetEntry( entry );
+        if( treeReader._nL != cacheReader._nL || treeReader._nJets != cacheReader._nJets ){
+            throw std::runtime_error( "Number of objects differs for entry " + std::to_string( entry ) + "." );
+        }
+        if( treeReader._weight != cacheReader._weight || treeReader._metPhi != cacheReader._metPhi
+            || treeReader._passMETFilters != cacheReader._passMETFilters ){
+            throw std::runtime_error( "Event variables differ for entry " + std::to_string( entry ) + "." );
+        }
+        compareArray( treeReader._lEta, cacheReader._lEta, treeReader._nL, entry, "lepton eta" );
+        compareArray( treeReader._lFlavor, cacheReader._lFlavor, treeReader._nL, entry, "lepton flavor" );
+        compareArray( treeReader._lCharge, cacheReader._lCharge, treeReader._nL, entry, "lepton charge" );
+        compareArray( treeReader._jetEta, cacheReader._jetEta, treeReader._nJets, entry, "jet eta" );
+    }
+
+    //compare the batches read from the mapped columns
+    EventBatch treeBatch;
+    EventBatch cacheBatch;
+    const long unsigned batchSize = 1000;
+    for( long unsigned firstEntry = 0; treeReader.readBatch( treeBatch, firstEntry, batchSize ); firstEntry += batchSize ){
+        cacheReader.readBatch( cacheBatch, firstEntry, batchSize );
+        if( treeBatch.leptonPt().values() != cacheBatch.leptonPt().values() || treeBatch.jetPt().values() != cacheBatch.jetPt().values()
+            || treeBatch.met() != cacheBatch.met() || treeBatch.triggerBits() != cacheBatch.triggerBits() ){
+            throw std::runtime_error( "Batch starting at entry " + std::to_string( firstEntry ) + " differs." );
+        }
+    }
+    std::cout << "Cache content agrees with tree reading." << std::endl;
+
+    //a cache written with a narrower branch profile can only be read with a profile it contains
+    const std::string narrowCacheDirectory = std::string( argv[2] ) + "_minimal";
+    const BranchProfile narrowProfile( "minimal" );
+    treeReader.setBranchProfile( narrowProfile );
+    treeReader.writeColumnarCache( narrowCacheDirectory );
+    TreeReader narrowCacheReader;
+    narrowCacheReader.setBranchProfile( narrowProfile );
+    narrowCacheReader.initSampleFromCache( narrowCacheDirectory );
+    bool refused = false;
+    try{
+        narrowCacheReader.setBranchProfile( BranchProfile() );
+    } catch( std::invalid_argument& ){
+        refused = true;
+    }
+    TreeReader fullProfileReader;
+    try{
+        fullProfileReader.initSampleFromCache( narrowCacheDirectory );
+        refused = false;
+    } catch( std::invalid_argument& ){}
+    if( !refused ){
+        std::cerr << "Cache written with branch profile 'minimal' was not refused for a reader with all branches enabled." << std::endl;
+        return 1;
+    }
+    std::cout << "Cache with a narrower branch profile is refused." << std::endl;
+    return 0;
+}
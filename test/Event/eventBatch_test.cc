@@ -0,0 +1,97 @@
+/*
+Check of the columnar reading of entries into event batches (see TreeReader::readBatch).
+The values in the batches are compared to the values obtained by reading each entry with TreeReader::GetEntry,
+and the time needed to read the batch branches for all entries is compared for both ways of reading.
+Usage: ./eventBatch_test <path to ntuple> [batch size]
+*/
+
+//include class to test
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../TreeReader/interface/EventBatch.h"
+
+//include c++ library classes
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+
+
+template< typename ColumnType, typename ArrayType > void compareRow( const JaggedColumn< ColumnType >& column, const EventBatch::size_type row,
+        const ArrayType* array, const unsigned size, const std::string& name ){
+    if( column.count( row ) != size ){
+        throw std::runtime_error( "Number of values of " + name + " differs for row " + std::to_string( row ) + "." );
+    }
+    for( unsigned i = 0; i < size; ++i ){
+        if( column.row( row )[ i ] != static_cast< ColumnType >( array[ i ] ) ){
+            throw std::runtime_error( "Value of " + name + " differs for row " + std::to_string( row ) + "." );
+        }
+    }
+}
+
+
+int main( int argc, char* argv[] ){
+    if( argc < 2 ){
+        std::cerr << "Usage: ./eventBatch_test <path to ntuple> [batch size]" << std::endl;
+        return 1;
+    }
+    const long unsigned batchSize = ( argc > 2 ? std::stoul( argv[2] ) : 1000 );
+
+    TreeReader treeReader;
+    treeReader.initSampleFromFile( argv[1] );
+
+    EventBatch batch;
+    double batchSum = 0.;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for( long unsigned firstEntry = 0; treeReader.readBatch( batch, firstEntry, batchSize ); firstEntry += batchSize ){
+        for( EventBatch::size_type row = 0; row < batch.size(); ++row ){
+            batchSum += batch.met()[ row ] + batch.leptonPt().count( row ) + batch.jetPt().count( row );
+        }
+    }
+    std::chrono::duration< double > batchTime = std::chrono::high_resolution_clock::now() - begin;
+
+    double entrySum = 0.;
+    begin = std::chrono::high_resolution_clock::now();
+    for( long unsigned entry = 0; entry < treeReader.numberOfEntries(); ++entry ){
+        treeReader.GetEntry( entry );
+        entrySum += treeReader._met + treeReader._nL + treeReader._nJets;
+    }
+    std::chrono::duration< double > entryTime = std::chrono::high_resolution_clock::now() - begin;
+
+    std::cout << "reading batches : " << batchTime.count() << " s" << std::endl;
+    std::cout << "reading entries : " << entryTime.count() << " s" << std::endl;
+    if( batchSum != entrySum ){
+        std::cerr << "Sums of batch and entry reading differ." << std::endl;
+        return 1;
+    }
+
+    //compare the full content of the first batch
+    treeReader.readBatch( batch, 0, batchSize );
+    for( EventBatch::size_type row = 0; row < batch.size(); ++row ){
+        treeReader.GetEntry( batch.entry( row ) );
+        compareRow( batch.leptonPt(), row, treeReader._lPt, treeReader._nL, "lepton pT" );
+        compareRow( batch.leptonEta(), row, treeReader._lEta, treeReader._nL, "lepton eta" );
+        compareRow( batch.leptonPhi(), row, treeReader._lPhi, treeReader._nL, "lepton phi" );
+        compareRow( batch.leptonFlavor(), row, treeReader._lFlavor, treeReader._nL, "lepton flavor" );
+        compareRow( batch.leptonCharge(), row, treeReader._lCharge, treeReader._nL, "lepton charge" );
+        compareRow( batch.jetPt(), row, treeReader._jetPt, treeReader._nJets, "jet pT" );
+        compareRow( batch.jetEta(), row, treeReader._jetEta, treeReader._nJets, "jet eta" );
+        compareRow( batch.jetPhi(), row, treeReader._jetPhi, treeReader._nJets, "jet phi" );
+        if( batch.metPhi()[ row ] != treeReader._metPhi ){
+            throw std::runtime_error( "Value of MET phi differs for row " + std::to_string( row ) + "." );
+        }
+        if( batch.passTriggerBits( row, EventBatch::metFilters ) != treeReader._passMETFilters ){
+            throw std::runtime_error( "MET filter decision differs for row " + std::to_string( row ) + "." );
+        }
+    }
+
+    //reading a batch unpacks the baskets into the batch and leaves the variables of the current entry untouched
+    treeReader.GetEntry( 0 );
+    const double firstMet = treeReader._met;
+    const unsigned firstNumberOfLeptons = treeReader._nL;
+    treeReader.readBatch( batch, batchSize, batchSize );
+    if( treeReader._met != firstMet || treeReader._nL != firstNumberOfLeptons ){
+        throw std::runtime_error( "Reading a batch changed the variables of the current entry." );
+    }
+    std::cout << "Batch content agrees with entry reading." << std::endl;
+    return 0;
+}
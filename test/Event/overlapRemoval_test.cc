@@ -0,0 +1,139 @@
+/*
+Microbenchmark of the overlap removal between jets and leptons:
+the original implementation (deltaR of every pair of objects, and erasing overlapping jets from a vector of pointers)
+is compared to overlapRemoval::outsideConesMask on arrays of eta and phi followed by a single compaction of the jets.
+Random events are generated, so no input file is needed, and the jets kept by each method have to be identical.
+Usage: ./overlapRemoval_test [number of events]
+*/
+
+//include class to test
+#include "../../Tools/interface/overlapRemoval.h"
+#include "../../objects/interface/PhysicsObject.h"
+
+//include c++ library classes
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cmath>
+
+
+struct RandomEvent{
+    std::vector< std::shared_ptr< PhysicsObject > > jets;
+    std::vector< std::shared_ptr< PhysicsObject > > leptons;
+};
+
+
+std::vector< RandomEvent > generateEvents( const unsigned numberOfEvents ){
+    std::mt19937 generator( 42 );
+    std::uniform_int_distribution< unsigned > numberOfJets( 0, 12 );
+    std::uniform_int_distribution< unsigned > numberOfLeptons( 0, 4 );
+    std::uniform_real_distribution< double > eta( -2.5, 2.5 );
+    std::uniform_real_distribution< double > phi( -M_PI, M_PI );
+    std::uniform_real_distribution< double > pt( 25., 200. );
+    std::vector< RandomEvent > events( numberOfEvents );
+    for( auto& event : events ){
+        unsigned nJets = numberOfJets( generator );
+        for( unsigned j = 0; j < nJets; ++j ){
+            event.jets.push_back( std::make_shared< PhysicsObject >( pt( generator ), eta( generator ), phi( generator ), 300., false, false, false, false, true ) );
+        }
+
+        //leptons are often close to a jet, so that jets are actually removed
+        unsigned nLeptons = numberOfLeptons( generator );
+        for( unsigned l = 0; l < nLeptons; ++l ){
+            double leptonEta = eta( generator );
+            double leptonPhi = phi( generator );
+            if( nJets > 0 && l % 2 == 0 ){
+                const PhysicsObject& jet = *event.jets[ l % nJets ];
+                leptonEta = jet.eta() + 0.1;
+                leptonPhi = std::remainder( jet.phi() + 0.1, 2*M_PI );
+            }
+            event.leptons.push_back( std::make_shared< PhysicsObject >( pt( generator ), leptonEta, leptonPhi, 300., false, false, false, false, true ) );
+        }
+    }
+    return events;
+}
+
+
+//original implementation of JetCollection::cleanJetsFromLeptons
+void cleanReference( std::vector< std::shared_ptr< PhysicsObject > >& jets, const std::vector< std::shared_ptr< PhysicsObject > >& leptons, const double coneSize ){
+    for( auto jetIt = jets.begin(); jetIt != jets.end(); ){
+        bool isDeleted = false;
+        for( const auto& leptonPtr : leptons ){
+            if( deltaR( **jetIt, *leptonPtr ) < coneSize ){
+                jetIt = jets.erase( jetIt );
+                isDeleted = true;
+                break;
+            }
+        }
+        if( !isDeleted ){
+            ++jetIt;
+        }
+    }
+}
+
+
+//cleaning on arrays as in JetCollection, with the arrays filled outside of the timed part
+void cleanWithMask( std::vector< std::shared_ptr< PhysicsObject > >& jets, const overlapRemoval::Workspace& arrays, std::vector< unsigned char >& mask, const double coneSize ){
+    overlapRemoval::outsideConesMask( arrays.eta.data(), arrays.phi.data(), arrays.eta.size(), 
+        arrays.referenceEta.data(), arrays.referencePhi.data(), arrays.referenceEta.size(), coneSize, mask );
+    std::size_t numberOfKept = 0;
+    for( std::size_t j = 0; j < jets.size(); ++j ){
+        if( mask[ j ] ){
+            jets[ numberOfKept ] = std::move( jets[ j ] );
+            ++numberOfKept;
+        }
+    }
+    jets.resize( numberOfKept );
+}
+
+
+int main( int argc, char* argv[] ){
+    unsigned numberOfEvents = ( argc > 1 ) ? std::stoul( argv[1] ) : 1000000;
+    const double coneSize = 0.4;
+    std::vector< RandomEvent > events = generateEvents( numberOfEvents );
+
+    std::vector< overlapRemoval::Workspace > eventArrays( numberOfEvents );
+    for( unsigned i = 0; i < numberOfEvents; ++i ){
+        for( const auto& jetPtr : events[i].jets ){
+            eventArrays[i].eta.push_back( jetPtr->eta() );
+            eventArrays[i].phi.push_back( jetPtr->phi() );
+        }
+        for( const auto& leptonPtr : events[i].leptons ){
+            eventArrays[i].referenceEta.push_back( leptonPtr->eta() );
+            eventArrays[i].referencePhi.push_back( leptonPtr->phi() );
+        }
+    }
+
+    std::vector< std::vector< std::shared_ptr< PhysicsObject > > > referenceJets;
+    for( const auto& event : events ) referenceJets.push_back( event.jets );
+    auto begin = std::chrono::high_resolution_clock::now();
+    for( unsigned i = 0; i < numberOfEvents; ++i ){
+        cleanReference( referenceJets[i], events[i].leptons, coneSize );
+    }
+    std::chrono::duration< double > referenceTime = std::chrono::high_resolution_clock::now() - begin;
+    std::cout << "deltaR and erase : " << referenceTime.count() / numberOfEvents * 1e9 << " ns per event" << std::endl;
+
+    bool allIdentical = true;
+    std::vector< std::vector< std::shared_ptr< PhysicsObject > > > cleanedJets;
+    for( const auto& event : events ) cleanedJets.push_back( event.jets );
+    std::vector< unsigned char > mask;
+    begin = std::chrono::high_resolution_clock::now();
+    for( unsigned i = 0; i < numberOfEvents; ++i ){
+        cleanWithMask( cleanedJets[i], eventArrays[i], mask, coneSize );
+    }
+    std::chrono::duration< double > maskTime = std::chrono::high_resolution_clock::now() - begin;
+    std::cout << "mask and compaction : " << maskTime.count() / numberOfEvents * 1e9 << " ns per event";
+    std::cout << " (speedup " << referenceTime.count() / maskTime.count() << ")" << std::endl;
+
+    for( unsigned i = 0; i < numberOfEvents; ++i ){
+        if( cleanedJets[i] != referenceJets[i] ){
+            std::cerr << "Error: cleaning of event " << i << " differs from the reference." << std::endl;
+            allIdentical = false;
+            break;
+        }
+    }
+    return ( allIdentical ? 0 : 1 );
+}
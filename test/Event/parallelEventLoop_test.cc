@@ -0,0 +1,107 @@
+/*
+Check of ParallelEventLoop:
+the events of an ntuple are processed in several threads, in ranges that do not divide the number of entries,
+and the merged output is compared to the output of a serial loop over the same entries.
+This is done for all entries, for a maximum number of entries (see ParallelEventLoop::setMaximumNumberOfEntries),
+for a single range, in which case only one thread gets work,
+and with lazy reading of the branch groups (see TreeReader::setLazyReading) in the threads.
+Usage: ./parallelEventLoop_test <path to ntuple> [number of threads]
+*/
+
+//include class to test
+#include "../../TreeReader/interface/ParallelEventLoop.h"
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../Event/interface/Event.h"
+
+//include c++ library classes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <stdexcept>
+
+
+//values of one event that are compared between the loops
+using EventSummary = std::tuple< long unsigned, long unsigned, unsigned, unsigned, double >;
+using LoopSummary = std::vector< EventSummary >;
+
+
+EventSummary summarizeEvent( const Event& event ){
+    return EventSummary( event.eventTags().luminosityBlock(), event.eventTags().eventNumber(),
+        event.numberOfLeptons(), event.numberOfJets(), event.metPt() );
+}
+
+
+LoopSummary serialLoop( const std::string& pathToFile, const long unsigned numberOfEntries ){
+    TreeReader treeReader;
+    treeReader.initSampleFromFile( pathToFile );
+    LoopSummary summary;
+    for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+        summary.push_back( summarizeEvent( treeReader.buildEvent( entry ) ) );
+    }
+    std::sort( summary.begin(), summary.end() );
+    return summary;
+}
+
+
+LoopSummary parallelLoop( const ParallelEventLoop& eventLoop ){
+    LoopSummary summary = eventLoop.run(
+        [](){ return LoopSummary(); },
+        []( Event& event, LoopSummary& output ){ output.push_back( summarizeEvent( event ) ); },
+        []( LoopSummary& output, const LoopSummary& other ){ output.insert( output.end(), other.cbegin(), other.cend() ); } );
+    std::sort( summary.begin(), summary.end() );
+    return summary;
+}
+
+
+void compareLoops( const LoopSummary& serial, const LoopSummary& parallel, const std::string& description ){
+    if( parallel.size() != serial.size() ){
+        throw std::runtime_error( "Parallel loop (" + description + ") processed " + std::to_string( parallel.size() )
+            + " events instead of " + std::to_string( serial.size() ) + "." );
+    }
+    if( parallel != serial ){
+        throw std::runtime_error( "Parallel loop (" + description + ") does not process the same events as the serial loop." );
+    }
+    std::cout << "Parallel loop (" << description << ") agrees with the serial loop for " << serial.size() << " events." << std::endl;
+}
+
+
+int main( int argc, char* argv[] ){
+    if( argc < 2 ){
+        std::cerr << "Usage: ./parallelEventLoop_test <path to ntuple> [number of threads]" << std::endl;
+        return 1;
+    }
+    const std::string pathToFile = argv[1];
+    const unsigned numberOfThreads = ( argc > 2 ? std::stoul( argv[2] ) : 4 );
+
+    ParallelEventLoop eventLoop( pathToFile, numberOfThreads );
+    const long unsigned numberOfEntries = eventLoop.numberOfEntries();
+    const LoopSummary serial = serialLoop( pathToFile, numberOfEntries );
+
+    //ranges that do not divide the number of entries, so the last range is shorter
+    const long unsigned entriesPerRange = std::max( 1ul, numberOfEntries/( 5*numberOfThreads ) + 1 );
+    eventLoop.setEntriesPerRange( entriesPerRange );
+    compareLoops( serial, parallelLoop( eventLoop ), std::to_string( entriesPerRange ) + " entries per range" );
+
+    //only the first entries
+    const long unsigned maximumNumberOfEntries = numberOfEntries/3 + 1;
+    eventLoop.setMaximumNumberOfEntries( maximumNumberOfEntries );
+    if( eventLoop.numberOfEntries() != std::min( numberOfEntries, maximumNumberOfEntries ) ){
+        throw std::runtime_error( "ParallelEventLoop::numberOfEntries does not take the maximum number of entries into account." );
+    }
+    compareLoops( serialLoop( pathToFile, eventLoop.numberOfEntries() ), parallelLoop( eventLoop ), "maximum number of entries" );
+    eventLoop.setMaximumNumberOfEntries( 0 );
+
+    //a single range, there are more threads than ranges
+    eventLoop.setEntriesPerRange( std::max( 1ul, numberOfEntries ) );
+    compareLoops( serial, parallelLoop( eventLoop ), "single range" );
+
+    //lazily read branch groups give the same events as the eager serial loop
+    eventLoop.setEntriesPerRange( entriesPerRange );
+    eventLoop.setLazyReading();
+    compareLoops( serial, parallelLoop( eventLoop ), "lazy reading" );
+
+    std::cout << "ParallelEventLoop test passed." << std::endl;
+    return 0;
+}
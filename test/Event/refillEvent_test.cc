@@ -0,0 +1,112 @@
+/*
+Benchmark of building a new Event for every entry versus refilling a single Event (see Event::refill).
+The heap allocations made while building or refilling the events are counted by replacing the global operator new.
+The entries are processed twice when refilling, the second pass has to be free of allocations
+since all objects and collections have already grown to the size they need for these entries.
+Usage: ./refillEvent_test <path to ntuple> [number of entries]
+*/
+
+//include class to test
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../Event/interface/Event.h"
+
+//include c++ library classes
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <algorithm>
+
+
+long unsigned numberOfAllocations = 0;
+
+void* operator new( std::size_t size ){
+    ++numberOfAllocations;
+    void* ptr = std::malloc( size );
+    if( ptr == nullptr ) throw std::bad_alloc();
+    return ptr;
+}
+
+
+void operator delete( void* ptr ) noexcept{
+    std::free( ptr );
+}
+
+
+void operator delete( void* ptr, std::size_t ) noexcept{
+    std::free( ptr );
+}
+
+
+//use the objects of the event, so the reading can not be optimized away
+double useEvent( const Event& event ){
+    return ( event.leptonCollection().size() + event.jetCollection().size() + event.met().pt() + event.weight() );
+}
+
+
+void printResult( const std::string& name, const long unsigned allocations, const std::chrono::duration< double >& time, const long unsigned numberOfEntries ){
+    std::cout << name << " : " << static_cast< double >( allocations ) / numberOfEntries << " allocations per event, ";
+    std::cout << time.count() / numberOfEntries * 1e6 << " microseconds per event" << std::endl;
+}
+
+
+int main( int argc, char* argv[] ){
+    if( argc < 2 ){
+        std::cerr << "Usage: ./refillEvent_test <path to ntuple> [number of entries]" << std::endl;
+        return 1;
+    }
+
+    TreeReader treeReader;
+    treeReader.initSampleFromFile( argv[1] );
+    long unsigned numberOfEntries = treeReader.numberOfEntries();
+    if( argc > 2 ){
+        numberOfEntries = std::min( numberOfEntries, std::stoul( argv[2] ) );
+    }
+    if( numberOfEntries == 0 ){
+        std::cerr << "No entries to process." << std::endl;
+        return 1;
+    }
+
+    //only the building of the events is counted, reading the entries from the tree is not
+    double sum = 0.;
+    long unsigned buildAllocations = 0;
+    std::chrono::duration< double > buildTime( 0. );
+    for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+        treeReader.GetEntry( entry );
+        long unsigned allocationsBefore = numberOfAllocations;
+        auto begin = std::chrono::high_resolution_clock::now();
+        {
+            Event event( treeReader );
+            sum += useEvent( event );
+        }
+        buildTime += ( std::chrono::high_resolution_clock::now() - begin );
+        buildAllocations += ( numberOfAllocations - allocationsBefore );
+    }
+    printResult( "new Event per entry", buildAllocations, buildTime, numberOfEntries );
+
+    treeReader.GetEntry( 0 );
+    Event event( treeReader );
+    long unsigned refillAllocations[2] = { 0, 0 };
+    std::chrono::duration< double > refillTime[2] = { std::chrono::duration< double >( 0. ), std::chrono::duration< double >( 0. ) };
+    for( unsigned pass = 0; pass < 2; ++pass ){
+        for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+            treeReader.GetEntry( entry );
+            long unsigned allocationsBefore = numberOfAllocations;
+            auto begin = std::chrono::high_resolution_clock::now();
+            event.refill( treeReader );
+            sum += useEvent( event );
+            refillTime[pass] += ( std::chrono::high_resolution_clock::now() - begin );
+            refillAllocations[pass] += ( numberOfAllocations - allocationsBefore );
+        }
+    }
+    printResult( "refilled Event, first pass", refillAllocations[0], refillTime[0], numberOfEntries );
+    printResult( "refilled Event, second pass", refillAllocations[1], refillTime[1], numberOfEntries );
+    std::cout << "(checksum " << sum << ")" << std::endl;
+
+    if( refillAllocations[1] != 0 ){
+        std::cerr << "Error: refilling events still allocates memory after all objects were built once." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+Check of SampleListScheduler:
+the samples of a sample list are processed in several threads with small tasks,
+and the merged output of each sample is compared to the output of a serial loop over the sample list.
+To check the work stealing, the first thread that processes an event is blocked until the other threads stop making progress,
+by then the other threads should have taken over all tasks except the one the blocked thread is working on.
+Usage: ./sampleListScheduler_test <sample list> <sample directory> [number of threads] [maximum number of entries per sample]
+*/
+
+//include class to test
+#include "../../TreeReader/interface/SampleListScheduler.h"
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../Event/interface/Event.h"
+
+//include c++ library classes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+
+
+//values of one event that are compared between the loops
+using EventSummary = std::tuple< long unsigned, long unsigned, unsigned, unsigned, double, double >;
+using LoopSummary = std::vector< EventSummary >;
+
+
+EventSummary summarizeEvent( const Event& event ){
+    return EventSummary( event.eventTags().luminosityBlock(), event.eventTags().eventNumber(),
+        event.numberOfLeptons(), event.numberOfJets(), event.metPt(), event.weight() );
+}
+
+
+std::map< std::string, LoopSummary > serialLoop( const std::vector< Sample >& samples, const long unsigned maximumNumberOfEntries ){
+    TreeReader treeReader;
+    std::map< std::string, LoopSummary > summaries;
+    for( const auto& sample : samples ){
+        treeReader.initSample( sample );
+        LoopSummary& summary = summaries[ sample.uniqueName() ];
+        const long unsigned numberOfEntries = std::min( treeReader.numberOfEntries(), maximumNumberOfEntries );
+        for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+            summary.push_back( summarizeEvent( treeReader.buildEvent( sample, entry ) ) );
+        }
+        std::sort( summary.begin(), summary.end() );
+    }
+    return summaries;
+}
+
+
+int main( int argc, char* argv[] ){
+    if( argc < 3 ){
+        std::cerr << "Usage: ./sampleListScheduler_test <sample list> <sample directory> [number of threads] [maximum number of entries per sample]" << std::endl;
+        return 1;
+    }
+    const unsigned numberOfThreads = ( argc > 3 ? std::stoul( argv[3] ) : 4 );
+    const long unsigned maximumNumberOfEntries = ( argc > 4 ? std::stoul( argv[4] ) : 10000 );
+    const long unsigned entriesPerTask = 20;
+
+    SampleListScheduler scheduler( argv[1], argv[2], numberOfThreads );
+    scheduler.setMaximumNumberOfEntries( maximumNumberOfEntries );
+
+    //the tasks are limited by their number of entries rather than by their compressed size
+    scheduler.setTaskSize( 1000000000, entriesPerTask );
+
+    std::atomic< long unsigned > numberOfProcessedEvents( 0 );
+    std::atomic< long unsigned > processedWhileBlocked( 0 );
+    std::atomic< bool > blockTaken( false );
+    auto processEvent = [&]( Event& event, LoopSummary& output ){
+        output.push_back( summarizeEvent( event ) );
+        ++numberOfProcessedEvents;
+        bool expected = false;
+        if( numberOfThreads > 1 && blockTaken.compare_exchange_strong( expected, true ) ){
+            long unsigned previous;
+            do{
+                previous = numberOfProcessedEvents;
+                std::this_thread::sleep_for( std::chrono::seconds( 1 ) );
+            } while( numberOfProcessedEvents != previous );
+            processedWhileBlocked = numberOfProcessedEvents.load();
+        }
+    };
+    std::map< std::string, LoopSummary > parallel = scheduler.run(
+        []( const Sample& ){ return LoopSummary(); },
+        processEvent,
+        []( LoopSummary& output, const LoopSummary& other ){ output.insert( output.end(), other.cbegin(), other.cend() ); } );
+
+    const std::map< std::string, LoopSummary > serial = serialLoop( scheduler.sampleVector(), maximumNumberOfEntries );
+    long unsigned totalNumberOfEvents = 0;
+    for( const auto& sampleSummary : serial ){
+        auto parallelIt = parallel.find( sampleSummary.first );
+        if( parallelIt == parallel.end() ){
+            throw std::runtime_error( "SampleListScheduler did not return an output for sample " + sampleSummary.first + "." );
+        }
+        std::sort( parallelIt->second.begin(), parallelIt->second.end() );
+        if( parallelIt->second != sampleSummary.second ){
+            throw std::runtime_error( "SampleListScheduler does not process the same events as the serial loop for sample "
+                + sampleSummary.first + " (" + std::to_string( parallelIt->second.size() ) + " instead of "
+                + std::to_string( sampleSummary.second.size() ) + " events)." );
+        }
+        totalNumberOfEvents += sampleSummary.second.size();
+    }
+    if( parallel.size() != serial.size() ){
+        throw std::runtime_error( "SampleListScheduler returned outputs for samples that are not in the sample list." );
+    }
+    std::cout << "SampleListScheduler agrees with the serial loop for " << totalNumberOfEvents << " events in "
+        << serial.size() << " samples." << std::endl;
+
+    //the blocked thread can at most keep the rest of its current task
+    if( numberOfThreads > 1 ){
+        if( processedWhileBlocked + entriesPerTask - 1 < totalNumberOfEvents ){
+            throw std::runtime_error( "Only " + std::to_string( processedWhileBlocked ) + " of " + std::to_string( totalNumberOfEvents )
+                + " events were processed while one thread was blocked, the other threads did not steal its tasks." );
+        }
+        std::cout << "The other threads took over the tasks of a blocked thread." << std::endl;
+    }
+    std::cout << "SampleListScheduler test passed." << std::endl;
+    return 0;
+}
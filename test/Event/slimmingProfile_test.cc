@@ -0,0 +1,160 @@
+/*
+Check of the slimming of output trees (see SlimmingProfile.h):
+the matching of keep, drop and narrow patterns is checked on fixed branch names,
+then the first entries of an ntuple are written with a slimming profile through TreeReader::fillOutputTree,
+read back (the narrowed branches go through the Float_t buffers of the TreeReader) and compared to the original values,
+and the slimmed tree is written once more with the profile of the current tree, as done when merging slimmed files,
+which should reproduce its branches and narrowing.
+Usage: ./slimmingProfile_test <path to ntuple> [number of entries]
+*/
+
+//include class to test
+#include "../../TreeReader/interface/SlimmingProfile.h"
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../Tools/interface/stringTools.h"
+
+//include c++ library classes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+
+//include ROOT classes
+#include "TFile.h"
+#include "TTree.h"
+#include "TLeaf.h"
+
+
+void checkPatterns(){
+    const std::vector< std::pair< std::string, std::string > > matching = {
+        { "*", "_lPt" }, { "_lPt", "_lPt" }, { "_lPt*", "_lPtCorr" }, { "_jet*Pt", "_jetSmearedPt" }, { "*Pt*", "_jetPt_JECUp" }, { "_l*I*o", "_lPOGMediumIso" }
+    };
+    for( const auto& patternAndName : matching ){
+        if( !SlimmingProfile::matches( patternAndName.first, patternAndName.second ) ){
+            throw std::runtime_error( "Pattern '" + patternAndName.first + "' does not match '" + patternAndName.second + "'." );
+        }
+    }
+    const std::vector< std::pair< std::string, std::string > > notMatching = {
+        { "_lPt", "_lPtCorr" }, { "_lPt*", "_lEta" }, { "_jet*Pt", "_jetPt_JECUp" }, { "", "_lPt" }, { "_l*Iso", "_lPOGMediumIsoX" }
+    };
+    for( const auto& patternAndName : notMatching ){
+        if( SlimmingProfile::matches( patternAndName.first, patternAndName.second ) ){
+            throw std::runtime_error( "Pattern '" + patternAndName.first + "' matches '" + patternAndName.second + "'." );
+        }
+    }
+
+    SlimmingProfile profile( "test", { "_nJets", "_jet*", "_lPt" }, { "_jetSmeared*", "_jetDeepCsv_*" }, { "_jetPt*", "_lPt" } );
+    if( profile.keepsAll() || !profile.keeps( "_jetEta" ) || !profile.keeps( "_nJets" ) || !profile.keeps( "_lPt" ) ){
+        throw std::runtime_error( "Profile does not keep the branches matching its keep patterns." );
+    }
+    if( profile.keeps( "_jetSmearedPt" ) || profile.keeps( "_jetDeepCsv_b" ) || profile.keeps( "_lEta" ) ){
+        throw std::runtime_error( "Profile keeps branches that match a drop pattern or no keep pattern." );
+    }
+    if( !profile.narrows( "_jetPt" ) || !profile.narrows( "_jetPt_JECUp" ) || profile.narrows( "_jetEta" ) ){
+        throw std::runtime_error( "Profile does not narrow exactly the branches matching its narrow patterns." );
+    }
+    SlimmingProfile defaultProfile;
+    if( !defaultProfile.keepsAll() || !defaultProfile.keeps( "_anything" ) || defaultProfile.narrows( "_lPt" ) ){
+        throw std::runtime_error( "The default profile should keep all branches without narrowing." );
+    }
+}
+
+
+//write the first entries of the current tree of the reader to a new file, returns the path of the file
+std::string writeSlimmedFile( TreeReader& treeReader, const SlimmingProfile& profile, const std::string& outputPath, const long unsigned numberOfEntries ){
+    TFile* outputFilePtr = TFile::Open( outputPath.c_str(), "RECREATE" );
+    outputFilePtr->mkdir( "blackJackAndHookers" );
+    outputFilePtr->cd( "blackJackAndHookers" );
+    std::shared_ptr< TTree > outputTreePtr( std::make_shared< TTree >( "blackJackAndHookersTree", "blackJackAndHookersTree" ) );
+    treeReader.setSlimmingProfile( profile );
+    treeReader.setOutputTree( outputTreePtr.get() );
+    for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+        treeReader.GetEntry( entry );
+        treeReader.fillOutputTree( outputTreePtr.get() );
+    }
+    outputTreePtr->Write( "", BIT(2) );
+    outputFilePtr->Close();
+    return outputPath;
+}
+
+
+std::vector< std::pair< std::string, std::string > > branchTypes( const std::string& filePath ){
+    TFile file( filePath.c_str() );
+    TTree* treePtr = static_cast< TTree* >( file.Get( "blackJackAndHookers/blackJackAndHookersTree" ) );
+    std::vector< std::pair< std::string, std::string > > types;
+    for( const auto& branchPtr : *treePtr->GetListOfBranches() ){
+        const TLeaf* leafPtr = static_cast< TBranch* >( branchPtr )->GetLeaf( branchPtr->GetName() );
+        types.push_back( { branchPtr->GetName(), ( leafPtr ? leafPtr->GetTypeName() : "" ) } );
+    }
+    return types;
+}
+
+
+template< typename T > void compareNarrowed( const T& original, const T& slimmed, const std::string& name, const long unsigned entry ){
+    if( slimmed != static_cast< T >( static_cast< Float_t >( original ) ) ){
+        throw std::runtime_error( "Narrowed value of " + name + " does not match the original value for entry " + std::to_string( entry ) + "." );
+    }
+}
+
+
+int main( int argc, char* argv[] ){
+    if( argc < 2 ){
+        std::cerr << "Usage: ./slimmingProfile_test <path to ntuple> [number of entries]" << std::endl;
+        return 1;
+    }
+    checkPatterns();
+    std::cout << "Pattern matching of slimming profiles is correct." << std::endl;
+
+    TreeReader originalReader;
+    originalReader.initSampleFromFile( argv[1] );
+    const long unsigned numberOfEntries = std::min( originalReader.numberOfEntries(), ( argc > 2 ? std::stoul( argv[2] ) : 1000 ) );
+
+    //the output files keep the name of the ntuple, so the year of the sample can be determined from it
+    const std::string fileName = stringTools::fileNameFromPath( argv[1] );
+    SlimmingProfile profile( "test", { "*" }, { "_jetDeepCsv_*" }, { "_lPt", "_jetPt", "_jetEta", "_met", "_metPhi" } );
+    const std::string slimmedPath = writeSlimmedFile( originalReader, profile, "slimmed_" + fileName, numberOfEntries );
+
+    TreeReader slimmedReader;
+    slimmedReader.initSampleFromFile( slimmedPath );
+    if( slimmedReader.numberOfEntries() != numberOfEntries ){
+        throw std::runtime_error( "The slimmed tree has " + std::to_string( slimmedReader.numberOfEntries() ) + " entries instead of "
+            + std::to_string( numberOfEntries ) + "." );
+    }
+    for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+        originalReader.GetEntry( entry );
+        slimmedReader.GetEntry( entry );
+        if( slimmedReader._eventNb != originalReader._eventNb || slimmedReader._nL != originalReader._nL || slimmedReader._nJets != originalReader._nJets ){
+            throw std::runtime_error( "Branches that are not narrowed differ for entry " + std::to_string( entry ) + "." );
+        }
+        compareNarrowed( originalReader._met, slimmedReader._met, "_met", entry );
+        compareNarrowed( originalReader._metPhi, slimmedReader._metPhi, "_metPhi", entry );
+        for( unsigned l = 0; l < originalReader._nL; ++l ){
+            compareNarrowed( originalReader._lPt[l], slimmedReader._lPt[l], "_lPt", entry );
+            if( slimmedReader._lEta[l] != originalReader._lEta[l] ){
+                throw std::runtime_error( "Value of _lEta differs for entry " + std::to_string( entry ) + "." );
+            }
+        }
+        for( unsigned j = 0; j < originalReader._nJets; ++j ){
+            compareNarrowed( originalReader._jetPt[j], slimmedReader._jetPt[j], "_jetPt", entry );
+            compareNarrowed( originalReader._jetEta[j], slimmedReader._jetEta[j], "_jetEta", entry );
+            if( slimmedReader._jetDeepCsv_b[j] != 0. ){
+                throw std::runtime_error( "Dropped branch _jetDeepCsv_b is not zero for entry " + std::to_string( entry ) + "." );
+            }
+        }
+    }
+    std::cout << "Narrowed branches agree with the original values within float precision." << std::endl;
+
+    //writing the slimmed tree with the profile of the current tree should neither add branches nor widen narrowed ones
+    const SlimmingProfile currentProfile = slimmedReader.slimmingProfileOfCurrentTree();
+    if( currentProfile.name() != profile.name() ){
+        throw std::runtime_error( "Profile of the slimmed tree is named '" + currentProfile.name() + "' instead of '" + profile.name() + "'." );
+    }
+    const std::string rewrittenPath = writeSlimmedFile( slimmedReader, currentProfile, "rewritten_" + fileName, numberOfEntries );
+    if( branchTypes( rewrittenPath ) != branchTypes( slimmedPath ) ){
+        throw std::runtime_error( "Writing the slimmed tree with its own profile changed its branches or their types." );
+    }
+    std::cout << "Slimmed tree is reproduced when written with the profile of the current tree." << std::endl;
+    return 0;
+}
@@ -73,8 +73,8 @@ throw std::exception();
 
   // make formula
   formula = vec[10];
-  TF1 f1("", formula.c_str());  // compile formula to check validity
-  if (f1.IsZombie()) {
+  if (!BTagFormula::compiles(formula)
+      && TF1("", formula.c_str()).IsZombie()) {  // check validity
 std::cerr << "ERROR in BTagCalibration: "
           << "Invalid csv line; formula does not compile: "
           << csvLine;
@@ -227,8 +227,8 @@ BTagEntry::BTagEntry(const TH1* hist, BTagEntry::Parameters p):
   }
 
   // compile formula to check validity
-  TF1 f1("", formula.c_str());
-  if (f1.IsZombie()) {
+  if (!BTagFormula::compiles(formula)
+      && TF1("", formula.c_str()).IsZombie()) {
 std::cerr << "ERROR in BTagCalibration: "
           << "Invalid histogram; formula does not compile (>150 bins?): "
           << hist->GetName();
@@ -280,6 +280,435 @@ std::string BTagEntry::trimStr(std::string str) {
 }
 
 
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace {
+
+// recursive descent parser writing the stack program of a formula,
+// with the operator precedence of TFormula
+class BTagFormulaCompiler
+{
+public:
+  BTagFormulaCompiler(const std::string &formula): str_(formula) {}
+
+  bool compile(std::vector<BTagFormula::Instruction> &code)
+  {
+    if (!parseTernary()) {
+      return false;
+    }
+    skipSpaces();
+    if (pos_ != str_.size() || depth_ != 1) {
+      return false;
+    }
+    code = code_;
+    return true;
+  }
+
+private:
+  typedef BTagFormula::OpCode OpCode;
+
+  const std::string &str_;
+  std::size_t pos_ = 0;
+  std::vector<BTagFormula::Instruction> code_;
+  int depth_ = 0;  // number of values on the stack
+
+  bool emit(OpCode op, int depthChange, double value=0.)
+  {
+    code_.push_back({op, value});
+    depth_ += depthChange;
+    return (depth_ <= BTagFormula::maxStackSize);
+  }
+
+  void skipSpaces()
+  {
+    while (pos_ < str_.size() && std::isspace(str_[pos_])) {
+      ++pos_;
+    }
+  }
+
+  bool accept(const char *token)
+  {
+    skipSpaces();
+    std::size_t n = std::strlen(token);
+    if (str_.compare(pos_, n, token) != 0) {
+      return false;
+    }
+    // do not split '<=', '>=', '==', '!=', '&&' and '||'
+    if (n == 1 && pos_ + 1 < str_.size()) {
+      char next = str_[pos_ + 1];
+      if ((token[0] == '<' || token[0] == '>' || token[0] == '!') && next == '=') {
+        return false;
+      }
+    }
+    pos_ += n;
+    return true;
+  }
+
+  // condition ? a : b
+  bool parseTernary()
+  {
+    if (!parseOr()) {
+      return false;
+    }
+    if (!accept("?")) {
+      return true;
+    }
+    std::size_t jumpToElse = code_.size();
+    emit(BTagFormula::JUMP_IF_FALSE, -1);
+    if (!parseTernary() || !accept(":")) {
+      return false;
+    }
+    std::size_t jumpToEnd = code_.size();
+    emit(BTagFormula::JUMP, -1);  // the else branch replaces the value
+    code_[jumpToElse].value = code_.size();
+    if (!parseTernary()) {
+      return false;
+    }
+    code_[jumpToEnd].value = code_.size();
+    return true;
+  }
+
+  bool parseOr()
+  {
+    if (!parseAnd()) {
+      return false;
+    }
+    while (accept("||")) {
+      if (!parseAnd() || !emit(BTagFormula::OR, -1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool parseAnd()
+  {
+    if (!parseEquality()) {
+      return false;
+    }
+    while (accept("&&")) {
+      if (!parseEquality() || !emit(BTagFormula::AND, -1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool parseEquality()
+  {
+    if (!parseRelational()) {
+      return false;
+    }
+    while (true) {
+      OpCode op;
+      if (accept("==")) {
+        op = BTagFormula::EQ;
+      } else if (accept("!=")) {
+        op = BTagFormula::NE;
+      } else {
+        return true;
+      }
+      if (!parseRelational() || !emit(op, -1)) {
+        return false;
+      }
+    }
+  }
+
+  bool parseRelational()
+  {
+    if (!parseAdditive()) {
+      return false;
+    }
+    while (true) {
+      OpCode op;
+      if (accept("<=")) {
+        op = BTagFormula::LE;
+      } else if (accept(">=")) {
+        op = BTagFormula::GE;
+      } else if (accept("<")) {
+        op = BTagFormula::LT;
+      } else if (accept(">")) {
+        op = BTagFormula::GT;
+      } else {
+        return true;
+      }
+      if (!parseAdditive() || !emit(op, -1)) {
+        return false;
+      }
+    }
+  }
+
+  bool parseAdditive()
+  {
+    if (!parseMultiplicative()) {
+      return false;
+    }
+    while (true) {
+      OpCode op;
+      if (accept("+")) {
+        op = BTagFormula::ADD;
+      } else if (accept("-")) {
+        op = BTagFormula::SUB;
+      } else {
+        return true;
+      }
+      if (!parseMultiplicative() || !emit(op, -1)) {
+        return false;
+      }
+    }
+  }
+
+  bool parseMultiplicative()
+  {
+    if (!parseUnary()) {
+      return false;
+    }
+    while (true) {
+      OpCode op;
+      if (accept("*")) {
+        op = BTagFormula::MUL;
+      } else if (accept("/")) {
+        op = BTagFormula::DIV;
+      } else {
+        return true;
+      }
+      if (!parseUnary() || !emit(op, -1)) {
+        return false;
+      }
+    }
+  }
+
+  bool parseUnary()
+  {
+    if (accept("-")) {
+      return parseUnary() && emit(BTagFormula::NEG, 0);
+    }
+    if (accept("+")) {
+      return parseUnary();
+    }
+    if (accept("!")) {
+      return parseUnary() && emit(BTagFormula::NOT, 0);
+    }
+    return parsePower();
+  }
+
+  // a^b, right associative and binding stronger than a sign
+  bool parsePower()
+  {
+    if (!parsePrimary()) {
+      return false;
+    }
+    if (accept("^")) {
+      return parseUnary() && emit(BTagFormula::POW, -1);
+    }
+    return true;
+  }
+
+  bool parsePrimary()
+  {
+    skipSpaces();
+    if (pos_ == str_.size()) {
+      return false;
+    }
+    if (accept("(")) {
+      return parseTernary() && accept(")");
+    }
+    char c = str_[pos_];
+    if (std::isdigit(c) || c == '.') {
+      return parseNumber();
+    }
+    if (!std::isalpha(c)) {
+      return false;
+    }
+    std::size_t start = pos_;
+    while (pos_ < str_.size()
+           && (std::isalnum(str_[pos_]) || str_[pos_] == '_' || str_[pos_] == ':')) {
+      ++pos_;
+    }
+    std::string name = str_.substr(start, pos_ - start);
+    if (name == "x") {
+      return emit(BTagFormula::PUSH_X, 1);
+    }
+    return parseFunction(name);
+  }
+
+  bool parseNumber()
+  {
+    std::size_t start = pos_;
+    bool hasDigits = false;
+    while (pos_ < str_.size() && std::isdigit(str_[pos_])) {
+      ++pos_;
+      hasDigits = true;
+    }
+    if (pos_ < str_.size() && str_[pos_] == '.') {
+      ++pos_;
+      while (pos_ < str_.size() && std::isdigit(str_[pos_])) {
+        ++pos_;
+        hasDigits = true;
+      }
+    }
+    if (!hasDigits) {
+      return false;
+    }
+    if (pos_ < str_.size() && (str_[pos_] == 'e' || str_[pos_] == 'E')) {
+      std::size_t exponent = pos_ + 1;
+      if (exponent < str_.size() && (str_[exponent] == '+' || str_[exponent] == '-')) {
+        ++exponent;
+      }
+      if (exponent == str_.size() || !std::isdigit(str_[exponent])) {
+        return false;
+      }
+      pos_ = exponent;
+      while (pos_ < str_.size() && std::isdigit(str_[pos_])) {
+        ++pos_;
+      }
+    }
+    double value = std::strtod(str_.substr(start, pos_ - start).c_str(), nullptr);
+    return emit(BTagFormula::PUSH_CONST, 1, value);
+  }
+
+  bool parseFunction(const std::string &name)
+  {
+    struct Function {
+      const char *name;
+      OpCode op;
+      int numberOfArguments;
+    };
+    static const Function functions[] = {
+      {"log", BTagFormula::LOG, 1}, {"TMath::Log", BTagFormula::LOG, 1},
+      {"log10", BTagFormula::LOG10, 1}, {"TMath::Log10", BTagFormula::LOG10, 1},
+      {"exp", BTagFormula::EXP, 1}, {"TMath::Exp", BTagFormula::EXP, 1},
+      {"sqrt", BTagFormula::SQRT, 1}, {"TMath::Sqrt", BTagFormula::SQRT, 1},
+      {"abs", BTagFormula::ABS, 1}, {"fabs", BTagFormula::ABS, 1},
+      {"TMath::Abs", BTagFormula::ABS, 1},
+      {"tanh", BTagFormula::TANH, 1}, {"TMath::TanH", BTagFormula::TANH, 1},
+      {"sin", BTagFormula::SIN, 1}, {"TMath::Sin", BTagFormula::SIN, 1},
+      {"cos", BTagFormula::COS, 1}, {"TMath::Cos", BTagFormula::COS, 1},
+      {"pow", BTagFormula::POW, 2}, {"TMath::Power", BTagFormula::POW, 2},
+      {"min", BTagFormula::MIN, 2}, {"TMath::Min", BTagFormula::MIN, 2},
+      {"max", BTagFormula::MAX, 2}, {"TMath::Max", BTagFormula::MAX, 2},
+    };
+    for (const auto &f : functions) {
+      if (name != f.name) {
+        continue;
+      }
+      if (!accept("(")) {
+        return false;
+      }
+      for (int i = 0; i < f.numberOfArguments; ++i) {
+        if ((i > 0 && !accept(",")) || !parseTernary()) {
+          return false;
+        }
+      }
+      return accept(")") && emit(f.op, 1 - f.numberOfArguments);
+    }
+    return false;
+  }
+};
+
+}  // namespace
+
+
+BTagFormula::BTagFormula(const std::string &formula, double xMin, double xMax)
+{
+  if (!BTagFormulaCompiler(formula).compile(code_)) {
+    tf1_ = std::make_shared<TF1>("", formula.c_str(), xMin, xMax);
+    return;
+  }
+
+  // plain numbers can not differ from the TF1
+  if (code_.front().op == PUSH_CONST
+      && (code_.size() == 1 || (code_.size() == 2 && code_.back().op == NEG))) {
+    return;
+  }
+
+  // compare to the TF1 on the range of the function
+  auto f1 = std::make_shared<TF1>("", formula.c_str(), xMin, xMax);
+  const unsigned nPoints = 25;
+  for (unsigned i = 0; i < nPoints; ++i) {
+    double x = xMin + (xMax - xMin)*i/(nPoints - 1);
+    double compiled = eval(x);
+    double reference = f1->Eval(x);
+    if (std::isnan(compiled) && std::isnan(reference)) {
+      continue;
+    }
+    if (!(std::fabs(compiled - reference) <= 1e-9*std::max(1., std::fabs(reference)))) {
+std::cerr << "WARNING in BTagCalibration: "
+          << "compiled formula gives " << compiled << " instead of "
+          << reference << " at x = " << x << ", using TF1 for: "
+          << formula << std::endl;
+      code_.clear();
+      tf1_ = f1;
+      return;
+    }
+  }
+}
+
+bool BTagFormula::compiles(const std::string &formula)
+{
+  std::vector<Instruction> code;
+  return BTagFormulaCompiler(formula).compile(code);
+}
+
+double BTagFormula::eval(double x) const
+{
+  if (tf1_) {
+    return tf1_->Eval(x);
+  }
+  if (code_.empty()) {
+    return 0.;  // default-constructed formula, as for entries the reader does not find
+  }
+
+  double stack[maxStackSize];
+  int top = -1;
+  const std::size_t size = code_.size();
+  for (std::size_t i = 0; i < size; ++i) {
+    const Instruction &ins = code_[i];
+    switch (ins.op) {
+      case PUSH_CONST: stack[++top] = ins.value; break;
+      case PUSH_X: stack[++top] = x; break;
+      case ADD: --top; stack[top] += stack[top+1]; break;
+      case SUB: --top; stack[top] -= stack[top+1]; break;
+      case MUL: --top; stack[top] *= stack[top+1]; break;
+      case DIV: --top; stack[top] /= stack[top+1]; break;
+      case POW: --top; stack[top] = std::pow(stack[top], stack[top+1]); break;
+      case NEG: stack[top] = -stack[top]; break;
+      case NOT: stack[top] = (stack[top] == 0.); break;
+      case LT: --top; stack[top] = (stack[top] < stack[top+1]); break;
+      case GT: --top; stack[top] = (stack[top] > stack[top+1]); break;
+      case LE: --top; stack[top] = (stack[top] <= stack[top+1]); break;
+      case GE: --top; stack[top] = (stack[top] >= stack[top+1]); break;
+      case EQ: --top; stack[top] = (stack[top] == stack[top+1]); break;
+      case NE: --top; stack[top] = (stack[top] != stack[top+1]); break;
+      case AND: --top; stack[top] = (stack[top] != 0. && stack[top+1] != 0.); break;
+      case OR: --top; stack[top] = (stack[top] != 0. || stack[top+1] != 0.); break;
+      case LOG: stack[top] = std::log(stack[top]); break;
+      case LOG10: stack[top] = std::log10(stack[top]); break;
+      case EXP: stack[top] = std::exp(stack[top]); break;
+      case SQRT: stack[top] = std::sqrt(stack[top]); break;
+      case ABS: stack[top] = std::fabs(stack[top]); break;
+      case TANH: stack[top] = std::tanh(stack[top]); break;
+      case SIN: stack[top] = std::sin(stack[top]); break;
+      case COS: stack[top] = std::cos(stack[top]); break;
+      case MIN: --top; stack[top] = std::min(stack[top], stack[top+1]); break;
+      case MAX: --top; stack[top] = std::max(stack[top], stack[top+1]); break;
+      case JUMP: i = static_cast<std::size_t>(ins.value) - 1; break;
+      case JUMP_IF_FALSE:
+        if (stack[top--] == 0.) {
+          i = static_cast<std::size_t>(ins.value) - 1;
+        }
+        break;
+    }
+  }
+  return stack[0];
+}
+
+
 #include <fstream>
 #include <sstream>
 
@@ -367,6 +796,20 @@ std::string BTagCalibration::makeCSV() const
   return buff.str();
 }
 
+std::size_t BTagCalibration::memoryUsage() const
+{
+  std::size_t bytes = sizeof(*this);
+  for (const auto &tokenEntries : data_) {
+    bytes += tokenEntries.first.capacity();
+    for (const auto &entry : tokenEntries.second) {
+      bytes += sizeof(BTagEntry) + entry.formula.capacity()
+               + entry.params.measurementType.capacity()
+               + entry.params.sysType.capacity();
+    }
+  }
+  return bytes;
+}
+
 std::string BTagCalibration::token(const BTagEntry::Parameters &par)
 {
   std::stringstream buff;
@@ -391,7 +834,7 @@ public:
     float ptMax;
     float discrMin;
     float discrMax;
-    TF1 func;
+    BTagFormula func;
   };
 
 private:
@@ -414,15 +857,31 @@ private:
                           float pt,
                           float discr) const;
 
+  void eval_auto_bounds(BTagEntry::JetFlavor jf,
+                        float eta,
+                        float pt,
+                        float discr,
+                        std::vector<double> & sfs) const;
+
   std::pair<float, float> min_max_pt(BTagEntry::JetFlavor jf,
                                      float eta,
                                      float discr) const;
 
+  std::size_t memoryUsage() const;
+
+  // pt at which the scale factors are evaluated and whether it was moved inside the bounds
+  std::pair<float, bool> bounded_pt(BTagEntry::JetFlavor jf,
+                                    float eta,
+                                    float pt,
+                                    float discr) const;
+
   BTagEntry::OperatingPoint op_;
   std::string sysType_;
   std::vector<std::vector<TmpEntry> > tmpData_;  // first index: jetFlavor
   std::vector<bool> useAbsEta_;                  // first index: jetFlavor
   std::map<std::string, std::shared_ptr<BTagCalibrationReaderImpl>> otherSysTypeReaders_;
+  std::vector<std::string> otherSysTypes_;       // in the order given to the constructor
+  std::vector<std::shared_ptr<BTagCalibrationReaderImpl>> otherSysTypeReaderList_;
 };
 
 
@@ -446,9 +905,11 @@ std::cerr << "ERROR in BTagCalibration: "
             << ost;
 throw std::exception();
     }
-    otherSysTypeReaders_[ost] = std::unique_ptr<BTagCalibrationReaderImpl>(
+    otherSysTypeReaders_[ost] = std::shared_ptr<BTagCalibrationReaderImpl>(
         new BTagCalibrationReaderImpl(op, ost)
     );
+    otherSysTypes_.push_back(ost);
+    otherSysTypeReaderList_.push_back(otherSysTypeReaders_[ost]);
   }
 }
 
@@ -481,11 +942,11 @@ throw std::exception();
     te.discrMax = be.params.discrMax;
 
     if (op_ == BTagEntry::OP_RESHAPING) {
-      te.func = TF1("", be.formula.c_str(),
-                    be.params.discrMin, be.params.discrMax);
+      te.func = BTagFormula(be.formula,
+                            be.params.discrMin, be.params.discrMax);
     } else {
-      te.func = TF1("", be.formula.c_str(),
-                    be.params.ptMin, be.params.ptMax);
+      te.func = BTagFormula(be.formula,
+                            be.params.ptMin, be.params.ptMax);
     }
 
     tmpData_[be.params.jetFlavor].push_back(te);
@@ -521,10 +982,10 @@ double BTagCalibrationReader::BTagCalibrationReaderImpl::eval(
     ){
       if (use_discr) {                                    // discr. reshaping?
         if (e.discrMin <= discr && discr < e.discrMax) {  // check discr
-          return e.func.Eval(discr);
+          return e.func.eval(discr);
         }
       } else {
-        return e.func.Eval(pt);
+        return e.func.eval(pt);
       }
     }
   }
@@ -539,17 +1000,9 @@ double BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds(
                                              float pt,
                                              float discr) const
 {
-  auto sf_bounds = min_max_pt(jf, eta, discr);
-  float pt_for_eval = pt;
-  bool is_out_of_bounds = false;
-
-  if (pt < sf_bounds.first) {
-    pt_for_eval = sf_bounds.first + .0001;
-    is_out_of_bounds = true;
-  } else if (pt > sf_bounds.second) {
-    pt_for_eval = sf_bounds.second - .0001;
-    is_out_of_bounds = true;
-  }
+  auto pt_bounded = bounded_pt(jf, eta, pt, discr);
+  float pt_for_eval = pt_bounded.first;
+  bool is_out_of_bounds = pt_bounded.second;
 
   // get central SF (and maybe return)
   double sf = eval(jf, eta, pt_for_eval, discr);
@@ -574,6 +1027,45 @@ throw std::exception();
   return sf_err;
 }
 
+void BTagCalibrationReader::BTagCalibrationReaderImpl::eval_auto_bounds(
+                                             BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float pt,
+                                             float discr,
+                                             std::vector<double> & sfs) const
+{
+  // the bounds are only determined once for all sysTypes
+  auto pt_bounded = bounded_pt(jf, eta, pt, discr);
+  float pt_for_eval = pt_bounded.first;
+  bool is_out_of_bounds = pt_bounded.second;
+
+  sfs.resize(1 + otherSysTypeReaderList_.size());
+  double sf = eval(jf, eta, pt_for_eval, discr);
+  sfs[0] = sf;
+  for (unsigned i=0; i<otherSysTypeReaderList_.size(); ++i) {
+    double sf_err = otherSysTypeReaderList_[i]->eval(jf, eta, pt_for_eval, discr);
+    if (is_out_of_bounds) {  // double uncertainty on out-of-bounds
+      sf_err = sf + 2*(sf_err - sf);
+    }
+    sfs[i+1] = sf_err;
+  }
+}
+
+std::pair<float, bool> BTagCalibrationReader::BTagCalibrationReaderImpl::bounded_pt(
+                                             BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float pt,
+                                             float discr) const
+{
+  auto sf_bounds = min_max_pt(jf, eta, discr);
+  if (pt < sf_bounds.first) {
+    return std::make_pair(float(sf_bounds.first + .0001), true);
+  } else if (pt > sf_bounds.second) {
+    return std::make_pair(float(sf_bounds.second - .0001), true);
+  }
+  return std::make_pair(pt, false);
+}
+
 std::pair<float, float> BTagCalibrationReader::BTagCalibrationReaderImpl::min_max_pt(
                                                BTagEntry::JetFlavor jf,
                                                float eta,
@@ -612,6 +1104,19 @@ std::pair<float, float> BTagCalibrationReader::BTagCalibrationReaderImpl::min_ma
 }
 
 
+std::size_t BTagCalibrationReader::BTagCalibrationReaderImpl::memoryUsage() const
+{
+  std::size_t bytes = sizeof(*this);
+  for (const auto &entries : tmpData_) {
+    bytes += entries.capacity()*sizeof(TmpEntry);
+  }
+  for (const auto &reader : otherSysTypeReaderList_) {
+    bytes += reader->memoryUsage();
+  }
+  return bytes;
+}
+
+
 BTagCalibrationReader::BTagCalibrationReader(BTagEntry::OperatingPoint op,
                                              const std::string & sysType,
                                              const std::vector<std::string> & otherSysTypes):
@@ -641,6 +1146,25 @@ double BTagCalibrationReader::eval_auto_bounds(const std::string & sys,
   return pimpl->eval_auto_bounds(sys, jf, eta, pt, discr);
 }
 
+void BTagCalibrationReader::eval_auto_bounds(BTagEntry::JetFlavor jf,
+                                             float eta,
+                                             float pt,
+                                             float discr,
+                                             std::vector<double> & sfs) const
+{
+  pimpl->eval_auto_bounds(jf, eta, pt, discr, sfs);
+}
+
+const std::vector<std::string> & BTagCalibrationReader::sysTypes() const
+{
+  return pimpl->otherSysTypes_;
+}
+
+std::size_t BTagCalibrationReader::memoryUsage() const
+{
+  return sizeof(*this) + (pimpl ? pimpl->memoryUsage() : 0);
+}
+
 std::pair<float, float> BTagCalibrationReader::min_max_pt(BTagEntry::JetFlavor jf,
                                                           float eta,
                                                           float discr) const
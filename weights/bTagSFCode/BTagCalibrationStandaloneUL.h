@@ -126,6 +126,9 @@ public:
   void makeCSV(std::ostream &s) const;
   std::string makeCSV() const;
 
+  // approximate memory used by the entries in bytes
+  std::size_t memoryUsage() const;
+
 protected:
   static std::string token(const BTagEntry::Parameters &par);
 
@@ -137,6 +140,64 @@ protected:
 #endif  // BTagCalibration_H
 
 
+#ifndef BTagFormula_H
+#define BTagFormula_H
+
+/**
+ * BTagFormula
+ *
+ * Calibration function compiled once into a short stack program, so it can be
+ * evaluated without going through TF1/TFormula for every jet.
+ * Supported are numbers, the variable x, the operators + - * / ^, comparisons,
+ * && and ||, the ternary operator ?: and the functions log, log10, exp, sqrt,
+ * abs, fabs, tanh, sin, cos, pow, min and max (optionally prefixed by TMath::).
+ * Formulas using anything else are evaluated with a TF1, as are formulas of
+ * which the compiled version does not reproduce the TF1 on its range.
+ *
+ ************************************************************/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class BTagFormula
+{
+public:
+  BTagFormula() {}
+  BTagFormula(const std::string &formula, double xMin, double xMax);
+
+  // 0 for a default-constructed formula
+  double eval(double x) const;
+
+  // false if the formula is evaluated with a TF1
+  bool isCompiled() const {return !tf1_;}
+
+  // whether the formula only uses the supported syntax
+  static bool compiles(const std::string &formula);
+
+  enum OpCode : unsigned char {
+    PUSH_CONST, PUSH_X,
+    ADD, SUB, MUL, DIV, POW, NEG, NOT,
+    LT, GT, LE, GE, EQ, NE, AND, OR,
+    LOG, LOG10, EXP, SQRT, ABS, TANH, SIN, COS, MIN, MAX,
+    JUMP, JUMP_IF_FALSE,
+  };
+  struct Instruction {
+    OpCode op;
+    double value;  // constant, or target of a jump
+  };
+  static constexpr int maxStackSize = 32;
+
+private:
+  std::vector<Instruction> code_;
+  std::shared_ptr<TF1> tf1_;
+
+};
+
+#endif  // BTagFormula_H
+
+
 #ifndef BTagCalibrationReader_H
 #define BTagCalibrationReader_H
 
@@ -144,7 +205,8 @@ protected:
  * BTagCalibrationReader
  *
  * Helper class to pull out a specific set of BTagEntry's out of a
- * BTagCalibration. TF1 functions are set up at initialization time.
+ * BTagCalibration. The functions are compiled at initialization time
+ * (see BTagFormula).
  *
  ************************************************************/
 
@@ -178,6 +240,19 @@ public:
                           float pt,
                           float discr=0.) const;
 
+  // scale factors for all systematics at once: sfs[0] is the central value,
+  // followed by the values of the other sysTypes in the order of sysTypes()
+  void eval_auto_bounds(BTagEntry::JetFlavor jf,
+                        float eta,
+                        float pt,
+                        float discr,
+                        std::vector<double> & sfs) const;
+
+  const std::vector<std::string> & sysTypes() const;
+
+  // approximate memory used by the loaded entries in bytes
+  std::size_t memoryUsage() const;
+
   std::pair<float, float> min_max_pt(BTagEntry::JetFlavor jf,
                                      float eta,
                                      float discr=0.) const;
@@ -1,3 +1,11 @@
+/*
+Product of the weights of several reweighters.
+computeWeights fills a WeightBank with the nominal, down and up weights of every reweighter in a single pass over the reweighters,
+after which the total weight for a variation of one reweighter takes a single multiplication,
+instead of evaluating all reweighters again for every variation.
+The reweighters in a bank are indexed in the order in which they were added (see CombinedReweighter::reweighterIndex).
+*/
+
 #ifndef CombinedReweighter_H
 #define CombinedReweighter_H
 
@@ -5,15 +13,56 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 //include other parts of framework
 #include "Reweighter.h"
 
 
+class WeightBank{
+
+    friend class CombinedReweighter;
+
+    public:
+        using size_type = std::vector< WeightVariations >::size_type;
+
+        //product of the nominal weights of all reweighters
+        double nominal() const{ return _nominal; }
+        size_type size() const{ return _weights.size(); }
+
+        //weights of a single reweighter
+        double nominal( const size_type index ) const{ return _weights[ index ].nominal; }
+        double weightDown( const size_type index ) const{ return _weights[ index ].down; }
+        double weightUp( const size_type index ) const{ return _weights[ index ].up; }
+
+        //variation of a single reweighter relative to its nominal weight
+        double relativeWeightDown( const size_type index ) const{ return _weights[ index ].down / _weights[ index ].nominal; }
+        double relativeWeightUp( const size_type index ) const{ return _weights[ index ].up / _weights[ index ].nominal; }
+
+        //product of the weights of all reweighters when a single one is varied
+        double totalWeightDown( const size_type index ) const{ return _otherNominals[ index ] * _weights[ index ].down; }
+        double totalWeightUp( const size_type index ) const{ return _otherNominals[ index ] * _weights[ index ].up; }
+
+        //weights of the individual variations of a reweighter with several systematics (e.g. "up_hf" for the b-tag shape reweighting),
+        //empty for reweighters with a single down and up variation
+        const std::map< std::string, double >& systematicWeights( const size_type index ) const{ return _systematicWeights[ index ]; }
+        double totalSystematicWeight( const size_type index, const std::string& variation ) const{ return _otherNominals[ index ] * _systematicWeights[ index ].at( variation ); }
+
+    private:
+        double _nominal = 1.;
+        std::vector< WeightVariations > _weights;
+        std::vector< std::map< std::string, double > > _systematicWeights;
+
+        //product of the nominal weights of all other reweighters, which stays defined when a nominal weight is 0
+        std::vector< double > _otherNominals;
+};
+
 
 class CombinedReweighter{
 
     public:
+        using size_type = WeightBank::size_type;
+
         CombinedReweighter() = default;
 
         void addReweighter( const std::string&, const std::shared_ptr< Reweighter >& );
@@ -22,6 +71,13 @@ class CombinedReweighter{
         const Reweighter* operator[]( const std::string& ) const;
         double totalWeight( const Event& ) const;
 
+        //position of a reweighter in a WeightBank, which changes when reweighters are erased
+        size_type reweighterIndex( const std::string& ) const;
+
+        //evaluate all reweighters with their variations once, the second version reuses the memory of an existing bank
+        WeightBank computeWeights( const Event& ) const;
+        void computeWeights( const Event&, WeightBank& ) const;
+
     private:
         std::map< std::string, std::shared_ptr< Reweighter > > reweighterMap;
         std::vector< std::shared_ptr< Reweighter > > reweighterVector;
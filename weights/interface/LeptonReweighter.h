@@ -8,38 +8,45 @@
 #include "TH2.h"
 
 //include other parts of framework
+#include "Reweighter.h"
 #include "LeptonSelectionHelper.h"
-#include "../../Tools/interface/histogramTools.h"
+#include "ScaleFactorTable.h"
 
 
 template < typename LeptonType > class LeptonReweighter{
 
     public:
         LeptonReweighter( const std::shared_ptr< TH2 >&, LeptonSelectionHelper* );
+        LeptonReweighter( const std::shared_ptr< const ScaleFactorTable >&, LeptonSelectionHelper* );
 
         double weight( const LeptonType& ) const;
         double weightDown( const LeptonType& ) const;
         double weightUp( const LeptonType& ) const;
+        WeightVariations weightVariations( const LeptonType& ) const;
 
         virtual double ptVariable( const LeptonType& lepton ) const{ return lepton.uncorrectedPt(); }
         virtual double etaVariable( const LeptonType& lepton ) const{ return lepton.absEta(); }
 
     private:
-        std::shared_ptr< TH2 > weightMap;
+        //the scale factors are copied from the histogram into a table, which is shared between copies of the reweighter
+        std::shared_ptr< const ScaleFactorTable > weightMap;
         std::shared_ptr< LeptonSelectionHelper > selector;
         bool ptOnXAxis;
-
-        double weight( const LeptonType& lepton, double (&retrieveValue)( TH2*, const double, const double ) ) const;
 };
 
 
 template < typename LeptonType > LeptonReweighter< LeptonType >::LeptonReweighter( const std::shared_ptr< TH2 >& scaleFactorMap, LeptonSelectionHelper* selectionHelper ) :
-    weightMap( scaleFactorMap ),
+    LeptonReweighter( std::make_shared< const ScaleFactorTable >( *scaleFactorMap ), selectionHelper )
+{}
+
+
+template < typename LeptonType > LeptonReweighter< LeptonType >::LeptonReweighter( const std::shared_ptr< const ScaleFactorTable >& scaleFactorTable, LeptonSelectionHelper* selectionHelper ) :
+    weightMap( scaleFactorTable ),
     selector( selectionHelper )
 {
 
     //use the range of the weight histogram to determine whether the X or Y axis represents the pT 
-    if( histogram::maxXValue( scaleFactorMap.get() ) > 3. ){
+    if( weightMap->maxXValue() > 3. ){
         ptOnXAxis = true;
     } else {
         ptOnXAxis = false;
@@ -47,30 +54,32 @@ template < typename LeptonType > LeptonReweighter< LeptonType >::LeptonReweighte
 }
 
 
-template < typename LeptonType > double LeptonReweighter< LeptonType >::weight( const LeptonType& lepton, double (&retrieveValue)( TH2*, const double, const double ) ) const{
-    if( selector->passSelection( lepton ) ){
-        if( ptOnXAxis ){
-            return retrieveValue( weightMap.get(), ptVariable( lepton ), etaVariable( lepton ) );
-        } else {
-            return retrieveValue( weightMap.get(), etaVariable( lepton ), ptVariable( lepton ) );
-        }
+template < typename LeptonType > WeightVariations LeptonReweighter< LeptonType >::weightVariations( const LeptonType& lepton ) const{
+    if( !selector->passSelection( lepton ) ) return WeightVariations();
+    if( ptOnXAxis ){
+        return weightMap->variations( ptVariable( lepton ), etaVariable( lepton ) );
     } else {
-        return 1.;
+        return weightMap->variations( etaVariable( lepton ), ptVariable( lepton ) );
     }
 }
 
 
 template < typename LeptonType > double LeptonReweighter< LeptonType >::weight( const LeptonType& lepton ) const{
-    return weight( lepton, histogram::contentAtValues );
+    if( !selector->passSelection( lepton ) ) return 1.;
+    if( ptOnXAxis ){
+        return weightMap->value( ptVariable( lepton ), etaVariable( lepton ) );
+    } else {
+        return weightMap->value( etaVariable( lepton ), ptVariable( lepton ) );
+    }
 }
 
 
 template < typename LeptonType > double LeptonReweighter< LeptonType >::weightDown( const LeptonType& lepton ) const{
-    return weight( lepton, histogram::contentDownAtValues );
+    return weightVariations( lepton ).down;
 }
 
 
 template< typename LeptonType > double LeptonReweighter< LeptonType >::weightUp( const LeptonType& lepton ) const{
-    return weight( lepton, histogram::contentUpAtValues );
+    return weightVariations( lepton ).up;
 }
 #endif 
@@ -1,12 +1,21 @@
 /*
 Virtual class to compute the reweighting of an event. This should be overridden for specific cases such as pilup, lepton efficiency and b-tagging weights.
+weightVariations computes the nominal, down and up weights together, 
+reweighters looping over the objects in an event should override it to do this in a single loop.
+Reweighters with several independent systematics (such as the b-tag shape reweighting) override systematicWeightVariations
+to also give the weight of each of their variations.
 */
 
 #ifndef Reweighter_H
 #define Reweighter_H
 
+//include c++ library classes
+#include <map>
+#include <string>
+
 //include other parts of framework
 #include "../../Event/interface/Event.h"
+#include "WeightVariations.h"
 
 
 class Reweighter{
@@ -16,5 +25,14 @@ class Reweighter{
         virtual double weightDown( const Event& ) const = 0;
         virtual double weightUp( const Event& ) const = 0;
 
+        virtual WeightVariations weightVariations( const Event& event ) const{
+            return { weight( event ), weightDown( event ), weightUp( event ) };
+        }
+
+        //the weights of the individual variations are keyed by their name, and cleared for reweighters with a single down and up variation
+        virtual WeightVariations systematicWeightVariations( const Event& event, std::map< std::string, double >& systematicWeights ) const{
+            systematicWeights.clear();
+            return weightVariations( event );
+        }
 };
 #endif
@@ -12,6 +12,7 @@
 
 //include other parts of framework
 #include "Reweighter.h"
+#include "ScaleFactorRegistry.h"
 #include "../../Tools/interface/histogramTools.h"
 #include "../../Tools/interface/stringTools.h"
 
@@ -27,19 +28,23 @@ class ReweighterBTag : public Reweighter {
         virtual double weight( const Event& ) const override;
         virtual double weightDown( const Event& ) const override;
         virtual double weightUp( const Event& ) const override;
+        virtual WeightVariations weightVariations( const Event& ) const override;
 
         double weight( const Jet& ) const;
         double weightDown( const Jet& ) const;
         double weightUp( const Jet& ) const;
+        WeightVariations weightVariations( const Jet& ) const;
     private:
-        std::shared_ptr< BTagCalibration > bTagSFCalibration;
-        std::shared_ptr< BTagCalibrationReader > bTagSFReader;
+        std::shared_ptr< const BTagCalibrationReader > bTagSFReader;
         bool _heavyFlavor;
         
         bool (Jet::*passBTag)() const = nullptr;
 
         virtual double CSVValue( const Jet& ) const = 0;
         virtual double efficiencyMC( const Jet& ) const = 0;
+        bool isReweighted( const Jet& ) const;
+        double scaleFactor( const Jet&, const std::string& ) const;
+        double weightFromScaleFactor( const Jet&, const double scaleFactor, const double efficiency ) const;
         double weight( const Jet&, const std::string& ) const; 
         double weight( const Event&, double (ReweighterBTag::*jetWeight)( const Jet& ) const ) const;
 
@@ -2,6 +2,7 @@
 #define ReweighterBTagHeavyFlavor_H
 
 #include "ReweighterBTag.h"
+#include "ScaleFactorTable.h"
 
 //include ROOT classes
 #include "TH2.h"
@@ -15,10 +16,15 @@ class ReweighterBTagHeavyFlavor : public ReweighterBTag {
 				    const std::string& workingPoint, 
 				    const std::shared_ptr< TH2 >& efficiencyC, 
 				    const std::shared_ptr< TH2 >& efficiencyB );
+        ReweighterBTagHeavyFlavor(  const std::string& weightDirectory, 
+				    const std::string& sfFilePath, 
+				    const std::string& workingPoint, 
+				    const std::shared_ptr< const ScaleFactorTable >& efficiencyC, 
+				    const std::shared_ptr< const ScaleFactorTable >& efficiencyB );
 
     private:
-        std::shared_ptr< TH2 > bTagEfficiencyC;
-        std::shared_ptr< TH2 > bTagEfficiencyB; 
+        std::shared_ptr< const ScaleFactorTable > bTagEfficiencyC;
+        std::shared_ptr< const ScaleFactorTable > bTagEfficiencyB; 
         virtual double efficiencyMC( const Jet& ) const override;
 };
 
@@ -1,6 +1,9 @@
 #ifndef ReweighterBTagLightFlavor_H
 #define ReweighterBTagLightFlavor_H
 
+#include "ReweighterBTag.h"
+#include "ScaleFactorTable.h"
+
 
 class ReweighterBTagLightFlavor : public ReweighterBTag {
 
@@ -9,10 +12,14 @@ class ReweighterBTagLightFlavor : public ReweighterBTag {
 				    const std::string& sfFilePath, 
 				    const std::string& workingPoint, 
 				    const std::shared_ptr< TH2 >& efficiencyUDSG );
+        ReweighterBTagLightFlavor(  const std::string& weightDirectory, 
+				    const std::string& sfFilePath, 
+				    const std::string& workingPoint, 
+				    const std::shared_ptr< const ScaleFactorTable >& efficiencyUDSG );
 
 
     private:
-        std::shared_ptr< TH2 > bTagEfficiencyUDSG;
+        std::shared_ptr< const ScaleFactorTable > bTagEfficiencyUDSG;
         virtual double efficiencyMC( const Jet& ) const override;
 };
 
@@ -2,6 +2,7 @@
 #define ReweighterBTagShape_H
 
 #include "Reweighter.h"
+#include "ScaleFactorRegistry.h"
 
 // include C++ classes
 #include <vector>
@@ -28,11 +29,21 @@ class ReweighterBTagShape: public Reweighter{
 	bool hasVariation( const std::string& variation ) const;
 	bool hasSystematic( const std::string systematic ) const;
 	bool considerVariation( const Jet& jet, const std::string& variation ) const;
+	bool considerVariation( const unsigned hadronFlavor, const std::string& variation ) const;
 
 	void setNormFactors( const Sample& sample, std::map<int,double> normFactors );
 	double getNormFactor( const Event&, const std::string& jecVariation="nominal" ) const;
 	std::map<std::string,std::map<int,double>> getNormFactors() const;
 	void printNormFactors() const;
+
+	// directory in which the normalization factors of each sample are cached by initialize,
+	// so they are only calculated once for a given sample file, scale factor file and settings
+	void setNormFactorCache( const std::string& cacheDirectory ){ _normFactorCacheDirectory = cacheDirectory; }
+	// set the normalization factors of a sample from the cache, returns false if no valid cache exists
+	bool loadNormFactors( const Sample& sample, long unsigned numberOfEntries=0 );
+	void storeNormFactors( const Sample& sample, long unsigned numberOfEntries=0 ) const;
+	// number of threads used to calculate the normalization factors (0 means all hardware threads)
+	void setNumberOfThreads( const unsigned numberOfThreads ){ _numberOfThreads = numberOfThreads; }
 	
 	double weight( const Jet& jet ) const;
 	double weightUp( const Jet& jet, const std::string& systematic ) const;
@@ -43,27 +54,45 @@ class ReweighterBTagShape: public Reweighter{
         double weightDown( const Event&, const std::string& systematic ) const;
 	double weightJecVar( const Event& event, const std::string& jecVariation ) const;
 	double weightNoNorm( const Event& event) const;
+	// nominal weight ("central") and the weights for all up and down variations (e.g. "up_hf"),
+	// evaluating all scale factors of a jet at once
+	std::map<std::string,double> weightsAllVariations( const Event& event ) const;
 	std::vector<std::string> availableVariations() const{ return _variations; }
 	std::vector<std::string> availableSystematics() const{ return _systematics; }
 	// following functions are needed for correct inheritance, but meaningless
 	double weightUp( const Event& ) const{ return 0.; } 
         double weightDown( const Event& ) const{ return 0.; } 
+	// the shape uncertainties are not a single up and down variation (see weightUp( event, systematic )),
+	// the up and down weights shift the nominal weight by the quadrature sum of the shifts of all systematics,
+	// while the weights of the individual variations are given by systematicWeightVariations (as in a weight bank)
+	WeightVariations weightVariations( const Event& event ) const;
+	WeightVariations systematicWeightVariations( const Event& event, 
+						     std::map<std::string,double>& systematicWeights ) const;
 
     private:
 
 	//std::string _weightDirectory;
-	std::shared_ptr<BTagCalibration> bTagSFCalibration;
-	std::shared_ptr<BTagCalibrationReader> bTagSFReader;
+	std::string _sfFile;
+	std::shared_ptr<const BTagCalibrationReader> bTagSFReader;
 	std::string _flavor;
 	std::string _bTagAlgo;
 	std::vector<std::string> _variations;
 	std::vector<std::string> _systematics;
 	std::map<std::string,std::map<int,double>> _normFactors;
+	std::string _normFactorCacheDirectory;
+	unsigned _numberOfThreads = 0;
+	// whether each sysType of the reader applies to c-jets and to b- and light jets
+	std::vector<bool> _considerSysTypeForCJets;
+	std::vector<bool> _considerSysTypeForOtherJets;
 
+	bool isReweighted( const Jet& jet ) const;
+	double bTagScore( const Jet& jet ) const;
 	double weight( const Jet& jet, const std::string& variation ) const;
 	double weight( const Event& event, const std::string& variation ) const;
 	std::map< int, double > calcAverageOfWeights( const Sample& sample,
 				    long unsigned numberOfEntries=0 ) const;
+	std::string normFactorCacheKey( const Sample& sample, long unsigned numberOfEntries ) const;
+	std::string normFactorCacheFile( const std::string& cacheKey, const Sample& sample ) const;
 };
 
 #endif
@@ -2,6 +2,8 @@
 #define ReweighterPileup_H
 
 #include "Reweighter.h"
+#include "ScaleFactorTable.h"
+#include "ScaleFactorRegistry.h"
 
 //include c++ library classes
 #include <map>
@@ -25,16 +27,17 @@ class ReweighterPileup : public Reweighter {
 
     private:
 	bool isUL = false; // set to true if UL constructor is used
+	// the weights are copied from the histograms into tables
 	// for pre-UL:
-        std::map< std::string, std::shared_ptr< TH1 > > puWeightsCentral;
-        std::map< std::string, std::shared_ptr< TH1 > > puWeightsDown;
-        std::map< std::string, std::shared_ptr< TH1 > > puWeightsUp;
-	double weight( const Event&, const std::map< std::string, std::shared_ptr< TH1 > >& ) const;
+        std::map< std::string, std::shared_ptr< const ScaleFactorTable > > puWeightsCentral;
+        std::map< std::string, std::shared_ptr< const ScaleFactorTable > > puWeightsDown;
+        std::map< std::string, std::shared_ptr< const ScaleFactorTable > > puWeightsUp;
+	double weight( const Event&, const std::map< std::string, std::shared_ptr< const ScaleFactorTable > >& ) const;
 	// for UL:
-	std::shared_ptr< TH1 > puWeightsCentralUL;
-        std::shared_ptr< TH1 > puWeightsDownUL;
-        std::shared_ptr< TH1 > puWeightsUpUL;
-        double weight( const Event&, const std::shared_ptr< TH1 >& ) const;
+	std::shared_ptr< const ScaleFactorTable > puWeightsCentralUL;
+        std::shared_ptr< const ScaleFactorTable > puWeightsDownUL;
+        std::shared_ptr< const ScaleFactorTable > puWeightsUpUL;
+        double weight( const Event&, const std::shared_ptr< const ScaleFactorTable >& ) const;
 };
 
 
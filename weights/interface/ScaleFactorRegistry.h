@@ -0,0 +1,142 @@
+/*
+Process-wide registry of the scale factor resources read by the reweighters (scale factor and efficiency tables,
+pileup weights, b-tag calibrations and their loaded readers), keyed by the path of the file and the name of the object in it.
+Every resource is read only once per process, and the same immutable object is handed out to all reweighters
+that need it, e.g. when reweighters are built for several years or in several threads.
+
+The registry can be used from several threads at once: lookups of loaded resources only hold a lock for the lookup itself,
+while resources are loaded one at a time, so ROOT files are never opened (and TF1s never built) by two threads of the registry at once.
+ROOT's own thread safety is enabled when the registry is first used.
+The time needed to load each resource and an estimate of its memory use are recorded (see printSummary).
+
+Other types of resources can be registered with get, given a function that loads the resource
+and an overload of resourceMemoryUsage for the type.
+*/
+
+#ifndef ScaleFactorRegistry_H
+#define ScaleFactorRegistry_H
+
+//include c++ library classes
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <typeindex>
+#include <stdexcept>
+#include <iostream>
+
+//include ROOT classes
+#include "TH1.h"
+
+//include other parts of framework
+#include "ScaleFactorTable.h"
+#include "../bTagSFCode/BTagCalibrationStandaloneUL.h"
+
+
+//approximate memory used by a resource in bytes
+inline std::size_t resourceMemoryUsage( const ScaleFactorTable& table ){ return table.memoryUsage(); }
+inline std::size_t resourceMemoryUsage( const BTagCalibration& calibration ){ return calibration.memoryUsage(); }
+inline std::size_t resourceMemoryUsage( const BTagCalibrationReader& reader ){ return reader.memoryUsage(); }
+std::size_t resourceMemoryUsage( const TH1& );
+
+
+class ScaleFactorRegistry{
+
+    public:
+
+        //the registry shared by the whole process
+        static ScaleFactorRegistry& instance();
+
+        ScaleFactorRegistry( const ScaleFactorRegistry& ) = delete;
+        ScaleFactorRegistry& operator=( const ScaleFactorRegistry& ) = delete;
+
+        //1D or 2D histogram of the given name in a ROOT file as a table
+        std::shared_ptr< const ScaleFactorTable > table( const std::string& filePath, const std::string& histogramName );
+
+        //copy of a histogram in a ROOT file, not attached to any directory
+        std::shared_ptr< const TH1 > histogram( const std::string& filePath, const std::string& histogramName );
+
+        //copy of a histogram in a ROOT file that is not attached to any directory and not registered,
+        //e.g. to build a resource from a processed histogram in a function given to get
+        static std::unique_ptr< TH1 > readHistogram( const std::string& filePath, const std::string& histogramName );
+
+        //b-tag scale factors in a csv file
+        std::shared_ptr< const BTagCalibration > bTagCalibration( const std::string& csvFilePath );
+
+        //reader of the b-tag scale factors in a csv file, loaded for the given flavors
+        //(loading builds the scale factor formulas, so readers are shared as well)
+        std::shared_ptr< const BTagCalibrationReader > bTagCalibrationReader( const std::string& csvFilePath, 
+            const BTagEntry::OperatingPoint operatingPoint, const std::vector< std::string >& otherSysTypes,
+            const std::vector< BTagEntry::JetFlavor >& flavors, const std::string& measurementType );
+
+        //resource of the given name, loaded with the given function if it is not yet in the registry
+        //objectName can describe how the resource is derived from the file, e.g. to register a processed histogram
+        template< typename T > std::shared_ptr< const T > get( const std::string& filePath, const std::string& objectName,
+            const std::function< std::shared_ptr< const T >() >& load );
+
+        struct ResourceInfo{
+            std::string filePath;
+            std::string objectName;
+            double loadTime;            //seconds
+            std::size_t memoryUsage;    //bytes
+            unsigned long requests;
+        };
+
+        //information on all resources in the registry, in the order in which they were loaded
+        std::vector< ResourceInfo > resources() const;
+        double totalLoadTime() const;
+        std::size_t totalMemoryUsage() const;
+        void printSummary( std::ostream& os = std::cout ) const;
+
+        //remove all resources from the registry, they stay alive as long as they are used
+        void clear();
+
+    private:
+        ScaleFactorRegistry() = default;
+
+        struct Resource{
+            std::shared_ptr< const void > object;
+            std::type_index type;
+            ResourceInfo info;
+        };
+
+        mutable std::mutex _resourceMutex;
+        std::recursive_mutex _loadMutex;
+        std::map< std::pair< std::string, std::string >, Resource > _resources;
+        std::vector< std::pair< std::string, std::string > > _loadOrder;
+
+        //returns nullptr if the resource is not yet loaded
+        std::shared_ptr< const void > find( const std::pair< std::string, std::string >& key, const std::type_index& type );
+};
+
+
+template< typename T > std::shared_ptr< const T > ScaleFactorRegistry::get( const std::string& filePath, const std::string& objectName,
+    const std::function< std::shared_ptr< const T >() >& load ){
+    const std::pair< std::string, std::string > key( filePath, objectName );
+    const std::type_index type( typeid( T ) );
+    std::shared_ptr< const void > object = find( key, type );
+    if( object ) return std::static_pointer_cast< const T >( object );
+
+    //the resource might have been loaded by another thread while waiting for the lock
+    //(the load lock is recursive, since loading a resource can use other resources of the registry)
+    std::lock_guard< std::recursive_mutex > loadLock( _loadMutex );
+    object = find( key, type );
+    if( object ) return std::static_pointer_cast< const T >( object );
+
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr< const T > resource = load();
+    std::chrono::duration< double > loadTime = std::chrono::steady_clock::now() - start;
+    if( !resource ){
+        throw std::runtime_error( "ERROR in ScaleFactorRegistry::get: loading '" + objectName + "' from '" + filePath + "' failed." );
+    }
+
+    std::lock_guard< std::mutex > resourceLock( _resourceMutex );
+    _resources.emplace( key, Resource{ resource, type, { filePath, objectName, loadTime.count(), resourceMemoryUsage( *resource ), 1 } } );
+    _loadOrder.push_back( key );
+    return resource;
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*
+Immutable lookup table of the content and the lower and upper uncertainties of a 1D or 2D histogram,
+built once from the histogram and used instead of it by the reweighters.
+The bin edges, contents and uncertainties are stored in flat arrays, 
+and the bin of a value is found directly for uniform binning and with a binary search otherwise.
+Values outside the histogram range are assigned to the first or last bin, as in histogram::contentAtValue(s).
+Lookups do not modify the table, so a table can be shared between threads.
+*/
+
+#ifndef ScaleFactorTable_H
+#define ScaleFactorTable_H
+
+//include c++ library classes
+#include <vector>
+#include <algorithm>
+
+//include ROOT classes
+#include "TH1.h"
+#include "TH2.h"
+
+//include other parts of framework
+#include "WeightVariations.h"
+
+
+class ScaleFactorTable{
+
+    public:
+        using size_type = std::vector< double >::size_type;
+
+        ScaleFactorTable( const TH1& );
+        ScaleFactorTable( const TH2& );
+
+        //content of the bin containing the value(s)
+        double value( const double x ) const{ return _content[ binIndex( x ) ]; }
+        double value( const double x, const double y ) const{ return _content[ binIndex( x, y ) ]; }
+
+        //content of the bin minus its lower uncertainty and plus its upper uncertainty, from a single bin search
+        WeightVariations variations( const double x ) const{ return variationsInBin( binIndex( x ) ); }
+        WeightVariations variations( const double x, const double y ) const{ return variationsInBin( binIndex( x, y ) ); }
+
+        double minXValue() const{ return _xAxis.minValue(); }
+        double maxXValue() const{ return _xAxis.maxValue(); }
+        double minYValue() const{ return _yAxis.minValue(); }
+        double maxYValue() const{ return _yAxis.maxValue(); }
+
+        //approximate memory used by the table in bytes
+        std::size_t memoryUsage() const{
+            return sizeof( *this ) + sizeof( double )*( _xAxis.numberOfBins() + _yAxis.numberOfBins() + 2 + 3*_content.size() );
+        }
+
+    private:
+        class Axis{
+
+            public:
+                Axis() = default;
+                Axis( const TAxis& );
+
+                size_type numberOfBins() const{ return _edges.size() - 1; }
+                double minValue() const{ return _edges.front(); }
+                double maxValue() const{ return _edges.back(); }
+
+                //values beyond the outer bin centers are moved to these centers, as in histogram::boundedValue
+                size_type binIndex( double value ) const{
+                    value = std::max( _minCenter, std::min( value, _maxCenter ) );
+                    if( _uniform ){
+                        return static_cast< size_type >( numberOfBins()*( value - minValue() )/( maxValue() - minValue() ) );
+                    }
+                    return static_cast< size_type >( std::upper_bound( _edges.cbegin(), _edges.cend(), value ) - _edges.cbegin() ) - 1;
+                }
+
+            private:
+                std::vector< double > _edges = { 0., 1. };
+                bool _uniform = true;
+                double _minCenter = 0.5;
+                double _maxCenter = 0.5;
+        };
+
+        Axis _xAxis;
+        Axis _yAxis;
+        std::vector< double > _content;
+        std::vector< double > _errorLow;
+        std::vector< double > _errorUp;
+
+        size_type binIndex( const double x ) const{ return _xAxis.binIndex( x ); }
+        size_type binIndex( const double x, const double y ) const{ return _yAxis.binIndex( y )*_xAxis.numberOfBins() + _xAxis.binIndex( x ); }
+        WeightVariations variationsInBin( const size_type index ) const{
+            return { _content[ index ], _content[ index ] - _errorLow[ index ], _content[ index ] + _errorUp[ index ] };
+        }
+        void fill( const TH1& );
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef WeightVariations_H
+#define WeightVariations_H
+
+
+//nominal weight together with its down and up variations
+struct WeightVariations{
+    double nominal = 1.;
+    double down = 1.;
+    double up = 1.;
+
+    WeightVariations& operator*=( const WeightVariations& rhs ){
+        nominal *= rhs.nominal;
+        down *= rhs.down;
+        up *= rhs.up;
+        return *this;
+    }
+};
+
+#endif
@@ -53,3 +53,42 @@ double CombinedReweighter::totalWeight( const Event& event ) const{
     }
     return weight;
 }
+
+
+CombinedReweighter::size_type CombinedReweighter::reweighterIndex( const std::string& name ) const{
+    const Reweighter* address = findAndCheckReweighter( name, reweighterMap )->second.get();
+    for( size_type index = 0; index < reweighterVector.size(); ++index ){
+        if( reweighterVector[ index ].get() == address ) return index;
+    }
+    throw std::logic_error( "Reweighter '" + name + "' is present in the map but not in the vector of reweighters." );
+}
+
+
+WeightBank CombinedReweighter::computeWeights( const Event& event ) const{
+    WeightBank bank;
+    computeWeights( event, bank );
+    return bank;
+}
+
+
+void CombinedReweighter::computeWeights( const Event& event, WeightBank& bank ) const{
+    const size_type numberOfReweighters = reweighterVector.size();
+    bank._weights.resize( numberOfReweighters );
+    bank._systematicWeights.resize( numberOfReweighters );
+    bank._otherNominals.resize( numberOfReweighters );
+
+    //the product of the other nominal weights is the product of the nominal weights before and after each reweighter
+    double productBefore = 1.;
+    for( size_type index = 0; index < numberOfReweighters; ++index ){
+        bank._weights[ index ] = reweighterVector[ index ]->systematicWeightVariations( event, bank._systematicWeights[ index ] );
+        bank._otherNominals[ index ] = productBefore;
+        productBefore *= bank._weights[ index ].nominal;
+    }
+    bank._nominal = productBefore;
+
+    double productAfter = 1.;
+    for( size_type index = numberOfReweighters; index-- > 0; ){
+        bank._otherNominals[ index ] *= productAfter;
+        productAfter *= bank._weights[ index ].nominal;
+    }
+}
@@ -1,7 +1,9 @@
 #include "../interface/ConcreteReweighterFactory.h"
 
+//include c++ library classes
+#include <stdexcept>
+
 //include ROOT classes
-#include "TFile.h"
 #include "TH2.h"
 
 //include other parts of framework
@@ -13,6 +15,7 @@
 #include "../interface/ReweighterPileup.h"
 #include "../interface/ConcreteReweighterBTag.h"
 #include "../interface/ReweighterPrefire.h"
+#include "../interface/ScaleFactorRegistry.h"
 
 
 // --------------------------------------
@@ -74,24 +77,20 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter(
     //reweighter to return
     CombinedReweighter combinedReweighter;
 
+    //all scale factors are read through the registry, so they are shared with other reweighters
+    ScaleFactorRegistry& registry = ScaleFactorRegistry::instance();
+    std::string leptonSFDirectory = stringTools::formatDirectoryName( weightDirectory ) 
+	+ "weightFiles/leptonSF/";
+
     //make muon ID Reweighter
-    TFile* muonSFFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) 
-			+ "weightFiles/leptonSF/looseToTight_" + year + "_m_3l.root" ).c_str() );
-    std::shared_ptr< TH2 > muonSFHist( dynamic_cast< TH2* >( muonSFFile->Get( "EGamma_SF2D" ) ) );
-    muonSFHist->SetDirectory( gROOT );
-    muonSFFile->Close();
-    MuonReweighter muonReweighter( muonSFHist, new TightSelector );
+    MuonReweighter muonReweighter( registry.table( leptonSFDirectory 
+	+ "looseToTight_" + year + "_m_3l.root", "EGamma_SF2D" ), new TightSelector );
     combinedReweighter.addReweighter( "muonID", 
 	std::make_shared< ReweighterMuons >( muonReweighter ) );
 
     //make electron ID Reweighter
-    TFile* eleSFFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) 
-			+ "weightFiles/leptonSF/looseToTight_" + year + "_e_3l.root" ).c_str() );
-    std::shared_ptr< TH2 > electronSFHist( dynamic_cast< TH2* >( eleSFFile->Get( "EGamma_SF2D" ) ) );
-    electronSFHist->SetDirectory( gROOT );
-    eleSFFile->Close();
-
-    ElectronIDReweighter electronIDReweighter( electronSFHist, new TightSelector );
+    ElectronIDReweighter electronIDReweighter( registry.table( leptonSFDirectory 
+	+ "looseToTight_" + year + "_e_3l.root", "EGamma_SF2D" ), new TightSelector );
     combinedReweighter.addReweighter( "electronID", 
 	std::make_shared< ReweighterElectronsID >( electronIDReweighter ) );
 
@@ -99,29 +98,15 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter(
     if( year == "2016" || year == "2017" ){
 
         //pT below 20 GeV
-        TFile* eleRecoSFFile_pTBelow20 = TFile::Open( ( stringTools::formatDirectoryName( 
-	    weightDirectory ) + "weightFiles/leptonSF/egamma_recoEff_" 
-	    + year + "_pTBelow20.root" ).c_str() );
-        std::shared_ptr< TH2 > electronRecoSFHist_pTBelow20( dynamic_cast< TH2* >( 
-	    eleRecoSFFile_pTBelow20->Get( "EGamma_SF2D" ) ) );
-        electronRecoSFHist_pTBelow20->SetDirectory( gROOT );
-        eleRecoSFFile_pTBelow20->Close();
-
-        ElectronIDReweighter electronRecoReweighter_pTBelow20( electronRecoSFHist_pTBelow20, 
+        ElectronIDReweighter electronRecoReweighter_pTBelow20( registry.table( leptonSFDirectory 
+	    + "egamma_recoEff_" + year + "_pTBelow20.root", "EGamma_SF2D" ), 
 	    new LooseMaxPtSelector< 20 > );
         combinedReweighter.addReweighter( "electronReco_pTBelow20", 
 	    std::make_shared< ReweighterElectronsID >( electronRecoReweighter_pTBelow20 ) );
 
         //pT above 20 GeV
-        TFile* eleRecoSFFile_pTAbove20 = TFile::Open( ( stringTools::formatDirectoryName( 
-	    weightDirectory ) + "weightFiles/leptonSF/egamma_recoEff_" 
-	    + year + "_pTAbove20.root" ).c_str() );
-        std::shared_ptr< TH2 > electronRecoSFHist_pTAbove20( dynamic_cast< TH2* >( 
-	    eleRecoSFFile_pTAbove20->Get( "EGamma_SF2D" ) ) );
-        electronRecoSFHist_pTAbove20->SetDirectory( gROOT );
-        eleRecoSFFile_pTAbove20->Close();
-
-        ElectronIDReweighter electronRecoReweighter_pTAbove20( electronRecoSFHist_pTAbove20, 
+        ElectronIDReweighter electronRecoReweighter_pTAbove20( registry.table( leptonSFDirectory 
+	    + "egamma_recoEff_" + year + "_pTAbove20.root", "EGamma_SF2D" ), 
 	    new LooseMinPtSelector< 20 > );
         combinedReweighter.addReweighter( "electronReco_pTAbove20", 
 	    std::make_shared< ReweighterElectronsID >( electronRecoReweighter_pTAbove20 ) );
@@ -129,14 +114,8 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter(
     } else if( year == "2018" ){
 
         //inclusive pT 
-        TFile* eleRecoSFFile = TFile::Open( ( stringTools::formatDirectoryName( 
-	    weightDirectory ) + "weightFiles/leptonSF/egamma_recoEff_" + year + ".root" ).c_str() );
-        std::shared_ptr< TH2 > electronRecoSFHist ( dynamic_cast< TH2* >(
-	    eleRecoSFFile->Get( "EGamma_SF2D" ) ) );
-        electronRecoSFHist->SetDirectory( gROOT );
-        eleRecoSFFile->Close();
-
-        ElectronIDReweighter electronRecoReweighter( electronRecoSFHist, new LooseSelector );
+        ElectronIDReweighter electronRecoReweighter( registry.table( leptonSFDirectory 
+	    + "egamma_recoEff_" + year + ".root", "EGamma_SF2D" ), new LooseSelector );
         combinedReweighter.addReweighter( "electronReco", 
 	    std::make_shared< ReweighterElectronsID >( electronRecoReweighter ) );
 
@@ -151,18 +130,14 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter(
 
     //read MC b-tagging efficiency histograms
     const std::string& leptonCleaning = "looseLeptonCleaned";
-    TFile* bTagEffMCFile = TFile::Open( ( stringTools::formatDirectoryName( weightDirectory ) 
-	+ "weightFiles/bTagEff/bTagEff_" + leptonCleaning + "_" + year + ".root" ).c_str() );
-    std::shared_ptr< TH2 > bTagEffMCHist_udsg( dynamic_cast< TH2* >( bTagEffMCFile->Get( 
-	( "bTagEff_" + bTagWP + "_udsg" ).c_str() ) ) );
-    bTagEffMCHist_udsg->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > bTagEffMCHist_c( dynamic_cast< TH2* >( bTagEffMCFile->Get( 
-	( "bTagEff_" + bTagWP + "_charm" ).c_str() ) ) );
-    bTagEffMCHist_c->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > bTagEffMCHist_b( dynamic_cast< TH2* >( bTagEffMCFile->Get( 
-	( "bTagEff_" + bTagWP + "_beauty" ).c_str() ) ) );
-    bTagEffMCHist_b->SetDirectory( gROOT );
-    bTagEffMCFile->Close();
+    std::string bTagEffMCPath = stringTools::formatDirectoryName( weightDirectory ) 
+	+ "weightFiles/bTagEff/bTagEff_" + leptonCleaning + "_" + year + ".root";
+    std::shared_ptr< const ScaleFactorTable > bTagEffMC_udsg = registry.table( bTagEffMCPath, 
+	"bTagEff_" + bTagWP + "_udsg" );
+    std::shared_ptr< const ScaleFactorTable > bTagEffMC_c = registry.table( bTagEffMCPath, 
+	"bTagEff_" + bTagWP + "_charm" );
+    std::shared_ptr< const ScaleFactorTable > bTagEffMC_b = registry.table( bTagEffMCPath, 
+	"bTagEff_" + bTagWP + "_beauty" );
 
     //path of b-tagging SF 
     std::string bTagSFFileName;
@@ -177,10 +152,10 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter(
 
     combinedReweighter.addReweighter( "bTag_heavy", 
 	std::make_shared< ReweighterBTagHeavyFlavorDeepCSV >( weightDirectory, bTagSFPath, 
-	bTagWP, bTagEffMCHist_c, bTagEffMCHist_b ) );
+	bTagWP, bTagEffMC_c, bTagEffMC_b ) );
     combinedReweighter.addReweighter( "bTag_light", 
 	std::make_shared< ReweighterBTagLightFlavorDeepCSV >( weightDirectory, bTagSFPath, 
-	bTagWP, bTagEffMCHist_udsg ) );
+	bTagWP, bTagEffMC_udsg ) );
 
     //make prefire Reweighter
     combinedReweighter.addReweighter( "prefire", std::make_shared< ReweighterPrefire >() );
@@ -188,6 +163,56 @@ CombinedReweighter EwkinoReweighterFactory::buildReweighter(
     return combinedReweighter;
 }
 
+namespace{
+
+    // 2D histogram of the given name in a ROOT file, not attached to any directory
+    std::unique_ptr< TH2 > read2DScaleFactorHistogram( const std::string& filePath, 
+	    const std::string& histogramName ){
+	std::unique_ptr< TH1 > hist = ScaleFactorRegistry::readHistogram( filePath, histogramName );
+	if( dynamic_cast< TH2* >( hist.get() ) == nullptr ){
+	    throw std::invalid_argument( "ERROR in ConcreteReweighterFactory: histogram '" 
+		+ histogramName + "' in file '" + filePath + "' is not two-dimensional." );
+	}
+	return std::unique_ptr< TH2 >( dynamic_cast< TH2* >( hist.release() ) );
+    }
+
+    // scale factors of the given histogram with their errors set to zero
+    std::shared_ptr< const ScaleFactorTable > nominalScaleFactorTable( 
+	    const std::string& filePath, const std::string& nominalName ){
+	return ScaleFactorRegistry::instance().get< ScaleFactorTable >( 
+	    filePath, nominalName + " (without errors)", [&](){
+	    std::unique_ptr< TH2 > nominal = read2DScaleFactorHistogram( filePath, nominalName );
+	    for(int i = 0; i <= nominal->GetNbinsX()+1; ++i){
+		for(int j = 0; j <= nominal->GetNbinsY()+1; ++j){
+		    nominal->SetBinError(i,j,0.);
+		}
+	    }
+	    return std::make_shared< const ScaleFactorTable >( *nominal );
+	} );
+    }
+
+    // table of ones with the absolute uncertainties of the given histogram, 
+    // stored as bin contents or bin errors, as errors relative to the nominal scale factors
+    std::shared_ptr< const ScaleFactorTable > relativeUncertaintyTable( 
+	    const std::string& filePath, const std::string& nominalName, 
+	    const std::string& uncertaintyName, const bool uncertaintyInContents ){
+	return ScaleFactorRegistry::instance().get< ScaleFactorTable >( 
+	    filePath, uncertaintyName + " (relative to " + nominalName + ")", [&](){
+	    std::unique_ptr< TH2 > nominal = read2DScaleFactorHistogram( filePath, nominalName );
+	    std::unique_ptr< TH2 > uncertainty = read2DScaleFactorHistogram( filePath, uncertaintyName );
+	    for(int i = 0; i <= nominal->GetNbinsX()+1; ++i){
+		for(int j = 0; j <= nominal->GetNbinsY()+1; ++j){
+		    double absoluteUncertainty = ( uncertaintyInContents ? 
+			uncertainty->GetBinContent(i,j) : uncertainty->GetBinError(i,j) );
+		    uncertainty->SetBinError(i,j,absoluteUncertainty/nominal->GetBinContent(i,j));
+		    uncertainty->SetBinContent(i,j,1.);
+		}
+	    }
+	    return std::make_shared< const ScaleFactorTable >( *uncertainty );
+	} );
+    }
+}
+
 // ------------------------------------------
 // reweighter for run-2 ultralegacy analyses 
 // ------------------------------------------
@@ -210,117 +235,65 @@ CombinedReweighter Run2ULReweighterFactory::buildReweighter(
     // initiaize reweighter to return
     CombinedReweighter combinedReweighter;
 
+    // all scale factors are read through the registry, so they are shared with other reweighters
+    ScaleFactorRegistry& registry = ScaleFactorRegistry::instance();
+    std::string leptonSFDirectory = stringTools::formatDirectoryName( weightDirectory ) 
+	+ "weightFilesUL/leptonSF/";
+
     // electron reco reweighter
     // pT below 20 GeV
-    TFile* eleRecoSFFile_pTBelow20 = TFile::Open( 
-	( stringTools::formatDirectoryName( weightDirectory ) 
-	+ "weightFilesUL/leptonSF/electronRECO_SF_" + year + "_ptBelow20.root" ).c_str() );
-    std::shared_ptr< TH2 > electronRecoSFHist_pTBelow20( 
-	dynamic_cast< TH2* >( eleRecoSFFile_pTBelow20->Get( "EGamma_SF2D" ) ) );
-    electronRecoSFHist_pTBelow20->SetDirectory( gROOT );
-    eleRecoSFFile_pTBelow20->Close();
-    ElectronIDReweighter electronRecoReweighter_pTBelow20( electronRecoSFHist_pTBelow20, 
+    ElectronIDReweighter electronRecoReweighter_pTBelow20( registry.table( leptonSFDirectory
+	+ "electronRECO_SF_" + year + "_ptBelow20.root", "EGamma_SF2D" ), 
 	new LooseMaxPtSelector< 20 > );
     combinedReweighter.addReweighter( "electronReco_pTBelow20", 
 	std::make_shared< ReweighterElectronsID >( electronRecoReweighter_pTBelow20 ) );
 
     // electron reco reweighter
     // pT above 20 GeV
-    TFile* eleRecoSFFile_pTAbove20 = TFile::Open( 
-	( stringTools::formatDirectoryName( weightDirectory ) 
-	+ "weightFilesUL/leptonSF/electronRECO_SF_" + year + "_ptAbove20.root" ).c_str() );
-    std::shared_ptr< TH2 > electronRecoSFHist_pTAbove20( 
-	dynamic_cast< TH2* >( eleRecoSFFile_pTAbove20->Get( "EGamma_SF2D" ) ) );
-    electronRecoSFHist_pTAbove20->SetDirectory( gROOT );
-    eleRecoSFFile_pTAbove20->Close();
-    ElectronIDReweighter electronRecoReweighter_pTAbove20( electronRecoSFHist_pTAbove20, 
+    ElectronIDReweighter electronRecoReweighter_pTAbove20( registry.table( leptonSFDirectory
+	+ "electronRECO_SF_" + year + "_ptAbove20.root", "EGamma_SF2D" ), 
 	new LooseMinPtSelector< 20 > );
     combinedReweighter.addReweighter( "electronReco_pTAbove20", 
 	std::make_shared< ReweighterElectronsID >( electronRecoReweighter_pTAbove20 ) );
     
     // make muon ID reweighter
-    std::string muonSFFileName = stringTools::formatDirectoryName( weightDirectory )
-        + "weightFilesUL/leptonSF/leptonMVAUL_SF_muons_Medium_"+year+".root";
-    TFile* muonSFFile = TFile::Open( (muonSFFileName).c_str() );
-    // load the scalefactor histogram and set the errors to zero,
-    // load the systematic errors and set the bin contents to one and errors relative
-    // (note: the histogram _combined_syst contains the absolute uncertainties as bin contents!),
-    // load the statistical errors and set the bin contents to one and the errors relative
-    // (note: the histogram _stat contains the absolute uncertainties as bin errors!).
-    std::shared_ptr< TH2 > muonSFHist_nom( dynamic_cast< TH2* >( 
-	muonSFFile->Get( "NUM_LeptonMvaMedium_DEN_TrackerMuons_abseta_pt" ) ) );
-    muonSFHist_nom->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > muonSFHist_syst( dynamic_cast< TH2* >( 
-        muonSFFile->Get( "NUM_LeptonMvaMedium_DEN_TrackerMuons_abseta_pt_combined_syst" ) ) );
-    muonSFHist_syst->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > muonSFHist_stat( dynamic_cast< TH2* >( 
-        muonSFFile->Get( "NUM_LeptonMvaMedium_DEN_TrackerMuons_abseta_pt_stat" ) ) );
-    muonSFHist_stat->SetDirectory( gROOT );
-    muonSFFile->Close();
-    for(int i = 0; i <= muonSFHist_nom->GetNbinsX()+1; ++i){
-        for(int j = 0; j <= muonSFHist_nom->GetNbinsY()+1; ++j){
-            // process values
-            muonSFHist_nom->SetBinError(i,j,0.);
-            muonSFHist_syst->SetBinError(i,j,
-		muonSFHist_syst->GetBinContent(i,j)/muonSFHist_nom->GetBinContent(i,j));
-            muonSFHist_syst->SetBinContent(i,j,1.);
-            muonSFHist_stat->SetBinError(i,j,
-		muonSFHist_stat->GetBinError(i,j)/muonSFHist_nom->GetBinContent(i,j));
-            muonSFHist_stat->SetBinContent(i,j,1.);
-        }
-    }
-
-    MuonReweighter muonReweighter_nom( muonSFHist_nom, new TightSelector );
+    // the scale factors are used without errors,
+    // the systematic and statistical errors as relative errors on a table of ones
+    // (note: the histogram _combined_syst contains the absolute uncertainties as bin contents!,
+    // the histogram _stat contains the absolute uncertainties as bin errors!).
+    std::string muonSFFileName = leptonSFDirectory 
+	+ "leptonMVAUL_SF_muons_Medium_" + year + ".root";
+    std::string muonSFHistName = "NUM_LeptonMvaMedium_DEN_TrackerMuons_abseta_pt";
+    MuonReweighter muonReweighter_nom( nominalScaleFactorTable( 
+	muonSFFileName, muonSFHistName ), new TightSelector );
     combinedReweighter.addReweighter("muonID",
 	std::make_shared<ReweighterMuons>(muonReweighter_nom));
-    MuonReweighter muonReweighter_syst( muonSFHist_syst, new TightSelector );
+    MuonReweighter muonReweighter_syst( relativeUncertaintyTable( muonSFFileName, 
+	muonSFHistName, muonSFHistName + "_combined_syst", true ), new TightSelector );
     combinedReweighter.addReweighter("muonIDSyst",
 	std::make_shared<ReweighterMuons>(muonReweighter_syst));
-    MuonReweighter muonReweighter_stat( muonSFHist_stat, new TightSelector );
+    MuonReweighter muonReweighter_stat( relativeUncertaintyTable( muonSFFileName, 
+	muonSFHistName, muonSFHistName + "_stat", false ), new TightSelector );
     combinedReweighter.addReweighter("muonIDStat",
 	std::make_shared<ReweighterMuons>(muonReweighter_stat));
-    muonSFFile->Close();
 
     // make electron ID reweighter
-    std::string eleSFFileName = stringTools::formatDirectoryName( weightDirectory )
-      + "weightFilesUL/leptonSF/leptonMVAUL_SF_electrons_Tight_"+year+".root";
-    TFile* eleSFFile = TFile::Open( (eleSFFileName).c_str() );
-    // load the scalefactor histogram and set the errors to zero,
-    // load the systematic errors and set the bin contents to one and errors relative
-    // (note: the histogram syst contains the absolute uncertainties as bin contents!),
-    // load the statistical errors and set the bin contents to one and errors relative
-    // (note: the histogram stat contains the absolute uncertainties as bin contents!).
-    std::shared_ptr< TH2 > electronSFHist_nom( dynamic_cast< TH2* >
-    ( eleSFFile->Get( "EGamma_SF2D" ) ) );
-    electronSFHist_nom->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > electronSFHist_syst( dynamic_cast< TH2* >
-        ( eleSFFile->Get( "sys" ) ) );
-    electronSFHist_syst->SetDirectory( gROOT );
-    std::shared_ptr< TH2 > electronSFHist_stat( dynamic_cast< TH2* >
-        ( eleSFFile->Get( "stat" ) ) );
-    electronSFHist_stat->SetDirectory( gROOT );
-    for(int i = 0; i <= electronSFHist_nom->GetNbinsX()+1; ++i){
-        for(int j = 0; j <= electronSFHist_nom->GetNbinsY()+1; ++j){
-            electronSFHist_nom->SetBinError(i,j,0.);
-            electronSFHist_syst->SetBinError(i,j,
-		electronSFHist_syst->GetBinContent(i,j)/electronSFHist_nom->GetBinContent(i,j));
-            electronSFHist_syst->SetBinContent(i,j,1.);
-            electronSFHist_stat->SetBinError(i,j,
-		electronSFHist_stat->GetBinContent(i,j)/electronSFHist_nom->GetBinContent(i,j));
-            electronSFHist_stat->SetBinContent(i,j,1.);
-        }
-    }
-
-    ElectronIDReweighter electronIDReweighter_nom( electronSFHist_nom, new TightSelector );
+    // same as for muons
+    // (note: the histograms syst and stat both contain the absolute uncertainties as bin contents!).
+    std::string eleSFFileName = leptonSFDirectory 
+	+ "leptonMVAUL_SF_electrons_Tight_" + year + ".root";
+    ElectronIDReweighter electronIDReweighter_nom( nominalScaleFactorTable( 
+	eleSFFileName, "EGamma_SF2D" ), new TightSelector );
     combinedReweighter.addReweighter( "electronID", 
 	std::make_shared<ReweighterElectronsID>(electronIDReweighter_nom) );
-    ElectronIDReweighter electronIDReweighter_syst( electronSFHist_syst, new TightSelector );
+    ElectronIDReweighter electronIDReweighter_syst( relativeUncertaintyTable( eleSFFileName, 
+	"EGamma_SF2D", "sys", true ), new TightSelector );
     combinedReweighter.addReweighter( "electronIDSyst", 
 	std::make_shared<ReweighterElectronsID>(electronIDReweighter_syst) );
-    ElectronIDReweighter electronIDReweighter_stat( electronSFHist_stat, new TightSelector );
+    ElectronIDReweighter electronIDReweighter_stat( relativeUncertaintyTable( eleSFFileName, 
+	"EGamma_SF2D", "stat", true ), new TightSelector );
     combinedReweighter.addReweighter( "electronIDStat", 
 	std::make_shared<ReweighterElectronsID>(electronIDReweighter_stat) );
-    eleSFFile->Close();
     
     // make the b-tag shape reweighter
     // step 1: set correct csv file
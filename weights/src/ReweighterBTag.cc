@@ -57,9 +57,6 @@ ReweighterBTag::ReweighterBTag( const std::string& weightDirectory,
         throw std::invalid_argument( "Unknown b-tagging working point string given." );
     }
 
-    //make the scale factor reader
-    bTagSFReader.reset( new BTagCalibrationReader( wp, "central", {"up", "down"}) );
-
     //method for extracting scale factors
     std::string fitMethod;
     if( workingPoint == "reshaping" ){
@@ -70,15 +67,16 @@ ReweighterBTag::ReweighterBTag( const std::string& weightDirectory,
         fitMethod = "incl";
     }
 
-    //calibrate the reader
-    bTagSFCalibration = std::shared_ptr< BTagCalibration >( 
-	new BTagCalibration( "", stringTools::formatDirectoryName(weightDirectory)+sfFilePath ) );
+    //make and calibrate the scale factor reader
+    //(the csv file is read and the reader is loaded only once per process, see ScaleFactorRegistry)
+    std::vector< BTagEntry::JetFlavor > flavors;
     if( heavyFlavor ){
-        bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_B, fitMethod );
-        bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_C, fitMethod );
+        flavors = { BTagEntry::FLAV_B, BTagEntry::FLAV_C };
     } else {
-        bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_UDSG, fitMethod );
+        flavors = { BTagEntry::FLAV_UDSG };
     }
+    bTagSFReader = ScaleFactorRegistry::instance().bTagCalibrationReader( 
+	stringTools::formatDirectoryName(weightDirectory)+sfFilePath, wp, {"up", "down"}, flavors, fitMethod );
 }
 
 
@@ -98,41 +96,63 @@ BTagEntry::JetFlavor jetFlavorEntry( const Jet& jet ){
 }
 
 
-double ReweighterBTag::weight( const Jet& jet, const std::string& uncertainty ) const{
-    // calculate the weight (either central, up or down) for a single jet
-    // the weight is calculated as follows:
+bool ReweighterBTag::isReweighted( const Jet& jet ) const{
+    // check whether a jet gets a weight different from 1:
     // - if the jet is a light jet and this reweighter is for heavy flavour, the weight is 1.
     // - if the jet is a b- or a c-jet and this reweighter is for light flavour, the weight is 1.
     // - if the jet is not in b-tag acceptance, the weight is 1.
-    // - the correct scalefactor is read from the csv file.
-    // - if the jet passes the given working point, weight = scalefactor.
-    // - if not, weight = (1 - efficiency*scalefactor) / (1 - efficiency)
 
     // check flavour
     if( _heavyFlavor ){
-	if( !( jet.hadronFlavor() == 4 || jet.hadronFlavor() == 5 ) ) return 1.;
+	if( !( jet.hadronFlavor() == 4 || jet.hadronFlavor() == 5 ) ) return false;
     } else{
-	if( !( jet.hadronFlavor() == 0 ) ) return 1.;
+	if( !( jet.hadronFlavor() == 0 ) ) return false;
     }
 
     // make sure jet passes b-tag selection
-    if( ! jet.inBTagAcceptance() ) return 1.;
+    return jet.inBTagAcceptance();
+}
+
 
-    // read the scale factor
-    double scaleFactor = bTagSFReader->eval_auto_bounds( uncertainty, 
+double ReweighterBTag::scaleFactor( const Jet& jet, const std::string& uncertainty ) const{
+    // read the scale factor from the csv file
+    return bTagSFReader->eval_auto_bounds( uncertainty, 
 			    jetFlavorEntry( jet ), jet.eta(), jet.pt(), CSVValue( jet ) );
-    
-    // check if jet passes chosen b-tag working point
+}
+
+
+double ReweighterBTag::weightFromScaleFactor( const Jet& jet, const double scaleFactor, const double efficiency ) const{
+    // - if the jet passes the given working point, weight = scalefactor.
+    // - if not, weight = (1 - efficiency*scalefactor) / (1 - efficiency)
     // in case of reweighting of the full shape, no selection is required
     if( ( passBTag == nullptr ) || ( jet.* passBTag )() ){
         return scaleFactor;
     } else {
-        double efficiency = efficiencyMC( jet );
         return ( 1. - efficiency * scaleFactor ) / ( 1. - efficiency );
     }
 }
 
 
+double ReweighterBTag::weight( const Jet& jet, const std::string& uncertainty ) const{
+    // calculate the weight (either central, up or down) for a single jet
+    if( !isReweighted( jet ) ) return 1.;
+    bool usesEfficiency = !( ( passBTag == nullptr ) || ( jet.* passBTag )() );
+    return weightFromScaleFactor( jet, scaleFactor( jet, uncertainty ), usesEfficiency ? efficiencyMC( jet ) : 0. );
+}
+
+
+WeightVariations ReweighterBTag::weightVariations( const Jet& jet ) const{
+    // calculate the central, down and up weights for a single jet,
+    // checking the jet and reading its efficiency only once
+    if( !isReweighted( jet ) ) return WeightVariations();
+    bool usesEfficiency = !( ( passBTag == nullptr ) || ( jet.* passBTag )() );
+    double efficiency = ( usesEfficiency ? efficiencyMC( jet ) : 0. );
+    return { weightFromScaleFactor( jet, scaleFactor( jet, "central" ), efficiency ),
+        weightFromScaleFactor( jet, scaleFactor( jet, "down" ), efficiency ),
+        weightFromScaleFactor( jet, scaleFactor( jet, "up" ), efficiency ) };
+}
+
+
 double ReweighterBTag::weight( const Jet& jet ) const{
     return weight( jet, "central" );
 }
@@ -173,3 +193,12 @@ double ReweighterBTag::weightDown( const Event& event ) const{
 double ReweighterBTag::weightUp( const Event& event ) const{
     return weight( event, &ReweighterBTag::weightUp );
 }
+
+
+WeightVariations ReweighterBTag::weightVariations( const Event& event ) const{
+    WeightVariations weights;
+    for( const auto& jetPtr : event.jetCollection() ){
+        weights *= weightVariations( *jetPtr );
+    }
+    return weights;
+}
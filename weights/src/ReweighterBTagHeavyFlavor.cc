@@ -25,6 +25,20 @@ ReweighterBTagHeavyFlavor::ReweighterBTagHeavyFlavor(
     // - workingPoint: should be either "loose", "medium", "tight" or "reshaping"
     // - efficiencyC: 2D root histogram with b-tag efficiencies for c-jets
     // - efficiencyB: 2D root histogram with b-tag efficiencies for b-jets
+    ReweighterBTagHeavyFlavor( weightDirectory, sfFilePath, workingPoint,
+	std::make_shared< const ScaleFactorTable >( *efficiencyC ),
+	std::make_shared< const ScaleFactorTable >( *efficiencyB ) )
+{}
+
+
+ReweighterBTagHeavyFlavor::ReweighterBTagHeavyFlavor(
+	    const std::string& weightDirectory, 
+	    const std::string& sfFilePath,
+	    const std::string& workingPoint, 
+	    const std::shared_ptr< const ScaleFactorTable >& efficiencyC, 
+	    const std::shared_ptr< const ScaleFactorTable >& efficiencyB ):
+    // constructor with the efficiencies given as tables,
+    // e.g. shared between reweighters through the ScaleFactorRegistry
     ReweighterBTag( weightDirectory, sfFilePath, workingPoint, true ),
     bTagEfficiencyC( efficiencyC ),
     bTagEfficiencyB( efficiencyB )
@@ -35,9 +49,9 @@ double ReweighterBTagHeavyFlavor::efficiencyMC( const Jet& jet ) const{
     // get the b-tagging efficiency for a given jet.
     // the efficiency is read from the histograms, based on the pt and eta of the jet.
     if( jet.hadronFlavor() == 4 ){
-        return histogram::contentAtValues( bTagEfficiencyC.get(), jet.pt(), jet.absEta() );
+        return bTagEfficiencyC->value( jet.pt(), jet.absEta() );
     } else if( jet.hadronFlavor() == 5 ){
-        return histogram::contentAtValues( bTagEfficiencyB.get(), jet.pt(), jet.absEta() );
+        return bTagEfficiencyB->value( jet.pt(), jet.absEta() );
     } else {
         throw std::invalid_argument( "hadronFlavor of jet is " 
 		    + std::to_string( jet.hadronFlavor() ) 
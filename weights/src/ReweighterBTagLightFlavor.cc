@@ -23,6 +23,18 @@ ReweighterBTagLightFlavor::ReweighterBTagLightFlavor(
     // - sfFilePath: path to the scale factor csv file relative from ewkino/weights
     // - workingPoint: should be either "loose", "medium", "tight" or "reshaping"
     // - efficiencyUDSG: 2D root histogram with b-tag efficiencies for light jets
+    ReweighterBTagLightFlavor( weightDirectory, sfFilePath, workingPoint,
+	std::make_shared< const ScaleFactorTable >( *efficiencyUDSG ) )
+{}
+
+
+ReweighterBTagLightFlavor::ReweighterBTagLightFlavor(
+	const std::string& weightDirectory, 
+	const std::string& sfFilePath, 
+	const std::string& workingPoint, 
+	const std::shared_ptr< const ScaleFactorTable >& efficiencyUDSG ):
+    // constructor with the efficiencies given as a table,
+    // e.g. shared between reweighters through the ScaleFactorRegistry
     ReweighterBTag( weightDirectory, sfFilePath, workingPoint, false ),
     bTagEfficiencyUDSG( efficiencyUDSG )
 {}
@@ -32,7 +44,7 @@ double ReweighterBTagLightFlavor::efficiencyMC( const Jet& jet ) const{
     // get the b-tagging efficiency for a given jet.
     // the efficiency is read from the histograms, based on the pt and eta of the jet.
     if( jet.hadronFlavor() == 0 ){
-        return histogram::contentAtValues( bTagEfficiencyUDSG.get(), jet.pt(), jet.absEta() );
+        return bTagEfficiencyUDSG->value( jet.pt(), jet.absEta() );
     } else {
         throw std::invalid_argument( "hadronFlavor of jet is " 
 		    + std::to_string( jet.hadronFlavor() ) 
@@ -14,6 +14,21 @@ This method corresponds to "1d", whereas ReweighterBTag corresponds to "1a".
 
 #include "../interface/ReweighterBTagShape.h"
 
+// include C++ classes
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// include other parts of framework
+#include "../../TreeReader/interface/ParallelEventLoop.h"
+#include "../../Tools/interface/systemTools.h"
+
 
 /// constructor ///
 ReweighterBTagShape::ReweighterBTagShape(   const std::string& weightDirectory,
@@ -105,31 +120,37 @@ ReweighterBTagShape::ReweighterBTagShape(   const std::string& weightDirectory,
     // set the the working point to "reshaping"
     BTagEntry::OperatingPoint wp = BTagEntry::OP_RESHAPING;
 
-    // make the scale factor reader
+    // systematic variations to read from the csv file
     std::vector<std::string> var_ext;
     for( std::string var: _variations ){
 	var_ext.push_back("up_"+var);
 	var_ext.push_back("down_"+var);
     }
-    std::cout << "creating BTagCalibrationReader instance..." << std::endl;
-    bTagSFReader.reset( new BTagCalibrationReader( wp, "central", var_ext ) );
 
     // set the type of scale factors to be extracted
     std::string fitMethod = "iterativefit";
+    std::vector<BTagEntry::JetFlavor> flavors;
+    if( _flavor=="heavy" || _flavor=="all" ){
+	flavors.push_back( BTagEntry::FLAV_B );
+	flavors.push_back( BTagEntry::FLAV_C );
+    }
+    if( _flavor=="light" || _flavor=="all" ){
+	flavors.push_back( BTagEntry::FLAV_UDSG );
+    }
 
-    // calibrate the reader
+    // make and calibrate the reader
     // note: this part can be commented out for quicker testing!
     //	     in that case, make sure to also comment out the bTagSFReader->eval_auto_bounds call below
     //	     and return a default value instead!
-    std::cout << "reading requested scale factors from csv file..." << std::endl;
-    bTagSFCalibration = std::shared_ptr< BTagCalibration >( 
-	new BTagCalibration( "", stringTools::formatDirectoryName(weightDirectory)+sfFilePath ) );
-    if( _flavor=="heavy" || _flavor=="all" ){
-	bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_B, fitMethod );
-	bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_C, fitMethod );
-    }
-    if( _flavor=="light" || _flavor=="all" ){
-	bTagSFReader->load( *bTagSFCalibration, BTagEntry::FLAV_UDSG, fitMethod );
+    std::cout << "creating BTagCalibrationReader instance from csv file..." << std::endl;
+    _sfFile = stringTools::formatDirectoryName(weightDirectory)+sfFilePath;
+    // (the csv file is read and the reader is loaded only once per process, see ScaleFactorRegistry)
+    bTagSFReader = ScaleFactorRegistry::instance().bTagCalibrationReader( _sfFile, wp, var_ext, flavors, fitMethod );
+
+    // determine once which of the variations read from the csv file apply to which jets
+    for( const std::string& sysType: bTagSFReader->sysTypes() ){
+	_considerSysTypeForCJets.push_back( considerVariation( 4, sysType ) );
+	_considerSysTypeForOtherJets.push_back( considerVariation( 0, sysType ) );
     }
 
     std::cout << "done creating the ReweighterBTagShape instance." << std::endl;
@@ -154,16 +175,34 @@ void ReweighterBTagShape::initialize( const std::vector<Sample>& samples,
     //	     and uses weight 1 for each entry) and assume this is "good enough", 
     //       OR, one has to manually calculate the sum of weights after appropriate selections,
     //       and then set the norm factors with setNormFactors (see below).
+    // note: if a cache directory is set (see setNormFactorCache), the normalization factors
+    //       are read from the cache when they were already calculated for a sample,
+    //       and stored in the cache after calculating them otherwise.
     std::cout << "initializing ReweighterBTagShape" << std::endl;
     // loop over samples
     for( Sample sample: samples){
-        std::string pathToFile = sample.filePath();
-        std::string sampleName = sample.fileName();
+        if( !_normFactorCacheDirectory.empty() ){
+            if( this->loadNormFactors( sample, numberOfEntries ) ){
+                std::cout << "read normalization factors for " << sample.fileName();
+                std::cout << " from cache" << std::endl;
+                continue;
+            }
+            // a cache file with the name of this key was refused,
+            // i.e. its stored key does not match (hash collision or modified file) or it is damaged
+            std::string cacheKey = normFactorCacheKey( sample, numberOfEntries );
+            if( !cacheKey.empty() && systemTools::fileExists( normFactorCacheFile( cacheKey, sample ) ) ){
+                std::cout << "WARNING in ReweighterBTagShape::initialize: cache file ";
+                std::cout << normFactorCacheFile( cacheKey, sample ) << " does not match the sample";
+                std::cout << " and settings of this reweighter or is damaged,";
+                std::cout << " the normalization factors are recalculated and the file is overwritten." << std::endl;
+            }
+        }
         // calculate the sum of weights for this sample (per jet multiplicity)
         // and update the normalization factor
         std::map<int, double> averageOfWeights = this->calcAverageOfWeights( sample, 
 									     numberOfEntries );
         this->setNormFactors( sample, averageOfWeights );
+        if( !_normFactorCacheDirectory.empty() ) this->storeNormFactors( sample, numberOfEntries );
     }
     std::cout << "done initializing ReweighterBTagShape" << std::endl;
 }
@@ -189,13 +228,19 @@ bool ReweighterBTagShape::hasSystematic( const std::string systematic ) const{
 bool ReweighterBTagShape::considerVariation( const Jet& jet, 
 					      const std::string& variation ) const{
     // check if a given variation needs to be considered for a given jet
+    return considerVariation( jet.hadronFlavor(), variation );
+}
+
+bool ReweighterBTagShape::considerVariation( const unsigned hadronFlavor,
+					      const std::string& variation ) const{
+    // check if a given variation needs to be considered for jets of a given hadron flavor
     // see the recommendations: some systematics should only be applied to b-jets and light jets,
     //                          and others only to c-jets; 
     //                          the jec variations should not be applied to c-jets.
     std::vector<std::string> forbidden_variations;
-    if( jet.hadronFlavor()==5 || jet.hadronFlavor()==0 ){
+    if( hadronFlavor==5 || hadronFlavor==0 ){
 	forbidden_variations = {"cferr1", "cferr2"};
-    } else if( jet.hadronFlavor()==4 ){
+    } else if( hadronFlavor==4 ){
 	forbidden_variations = {"hf","lf","hfstats1","hfstats2","lfstats1","lfstats2",
 				"jes", "jesAbsoluteMPFBias", "jesAbsoluteScale", "jesAbsoluteStat",
                                 "jesRelativeBal", "jesRelativeFSR", "jesRelativeJEREC1",
@@ -275,40 +320,41 @@ void ReweighterBTagShape::printNormFactors() const{
 
 /// member functions for weights ///
 
+bool ReweighterBTagShape::isReweighted( const Jet& jet ) const{
+    // check if a jet gets a scale factor from this reweighter:
+    // - if this instance if for heavy flavor and the jet is light, it is not reweighted
+    // - if this instance is for light flavor and the jet is heavy, it is not reweighted
+    // - if the jet is outside b-tag acceptance, it is not reweighted
+    if( jet.hadronFlavor()==5 || jet.hadronFlavor()==4 ){
+	if( !(_flavor=="heavy" || _flavor=="all") ) return false;
+    } else{
+        if( !(_flavor=="light" || _flavor=="all") ) return false;
+    }
+    return jet.inBTagAcceptance();
+}
+
+double ReweighterBTagShape::bTagScore( const Jet& jet ) const{
+    // (in principle no checking for other values is needed, as already done in constructor)
+    return (_bTagAlgo=="deepFlavor")?jet.deepFlavor():
+	    (_bTagAlgo=="deepCSV")?jet.deepCSV():-99;
+}
+
 double ReweighterBTagShape::weight( const Jet& jet, const std::string& variation ) const{
     // get the weight for a single jet
-    // the weight is determined as follows:
-    // - if this instance if for heavy flavor and the jet is light, weight = 1
-    // - if this instance is for light flavor and the jet is heavy, weight = 1
-    // - if the jet is outside b-tag acceptance, weight = 1
-    // - else correct weight is read depending on flavor, eta, pt, b-tag score and systematic.
+    // the weight is 1 for jets that are not reweighted (see isReweighted),
+    // else correct weight is read depending on flavor, eta, pt, b-tag score and systematic.
     
     std::string sys = variation;
     // check if variation is valid for this jet
     if( !this->considerVariation( jet, variation ) ) sys = "central";
-    // check if jet is of correct flavor for this reweighter
-    if( jet.hadronFlavor()==5 || jet.hadronFlavor()==4 ){
-	if( !(_flavor=="heavy" || _flavor=="all") ) return 1;
-    } else{
-        if( !(_flavor=="light" || _flavor=="all") ) return 1;
-    }
-
-    // make sure jet is in b-tag acceptance
-    if( ! jet.inBTagAcceptance() ){
-        return 1.;
-    }
-
-    // determine bTagScore (note: maybe modify later to the model of bTagReweighter,
-    // which is probably faster as it does not involve evaluating this string for every jet)
-    double bTagScore = (_bTagAlgo=="deepFlavor")?jet.deepFlavor():
-			(_bTagAlgo=="deepCSV")?jet.deepCSV():-99; 
-    // (in principle no checking for other values is needed, as already done in constructor)
+    // check if jet is of correct flavor for this reweighter and in b-tag acceptance
+    if( !isReweighted( jet ) ) return 1.;
 
     // note: https://twiki.cern.ch/twiki/bin/view/CMS/BTagCalibration#Using_b_tag_scale_factors_in_you
     // this page recommends to use absolute value of eta, but BTagCalibrationStandalone.cc
     // seems to handle negative values of eta more correctly (only taking abs when needed)
     double scaleFactor = bTagSFReader->eval_auto_bounds( sys, jetFlavorEntry( jet ),
-    					jet.eta(), jet.pt(), bTagScore );
+    					jet.eta(), jet.pt(), bTagScore( jet ) );
     // printouts for testing
     /*if( scaleFactor==0 ){
 	std::cout << "found scale factor 0 ..." << std::endl;
@@ -379,6 +425,62 @@ double ReweighterBTagShape::weightNoNorm( const Event& event ) const{
 }
 
 
+std::map<std::string,double> ReweighterBTagShape::weightsAllVariations( const Event& event ) const{
+    // get the nominal weight and the weights for all up and down variations of an event
+    // with one call to the scale factor reader per jet, instead of one per jet and variation.
+    // the result is identical to calling weight( event, variation ) for each variation,
+    // i.e. the nominal jet collection is used and the weights are normalized.
+    const std::vector<std::string>& sysTypes = bTagSFReader->sysTypes();
+    std::vector<double> weights( sysTypes.size()+1, 1. );
+    std::vector<double> scaleFactors;
+    for( const auto& jetPtr: event.jetCollection().goodJetCollection() ){
+	const Jet& jet = *jetPtr;
+	if( !isReweighted( jet ) ) continue;
+	bTagSFReader->eval_auto_bounds( jetFlavorEntry( jet ), jet.eta(), jet.pt(), 
+					bTagScore( jet ), scaleFactors );
+	// variations that do not apply to this jet use the central scale factor
+	const std::vector<bool>& considerSysType = ( jet.hadronFlavor()==4 ) ?
+	    _considerSysTypeForCJets : _considerSysTypeForOtherJets;
+	weights[0] *= scaleFactors[0];
+	for( std::vector<std::string>::size_type i = 0; i < sysTypes.size(); ++i ){
+	    weights[i+1] *= ( considerSysType[i] ? scaleFactors[i+1] : scaleFactors[0] );
+	}
+    }
+    double normFactor = getNormFactor( event );
+    std::map<std::string,double> weightMap;
+    weightMap["central"] = weights[0]/normFactor;
+    for( std::vector<std::string>::size_type i = 0; i < sysTypes.size(); ++i ){
+	weightMap[sysTypes[i]] = weights[i+1]/normFactor;
+    }
+    return weightMap;
+}
+
+
+WeightVariations ReweighterBTagShape::weightVariations( const Event& event ) const{
+    std::map<std::string,double> systematicWeights;
+    return systematicWeightVariations( event, systematicWeights );
+}
+
+
+WeightVariations ReweighterBTagShape::systematicWeightVariations( const Event& event,
+				std::map<std::string,double>& systematicWeights ) const{
+    // get the nominal, down and up weights together with the weights of all variations,
+    // the jec variations are not included in the down and up weights as they need the varied jet collections
+    // (see weightJecVar)
+    systematicWeights = weightsAllVariations( event );
+    double nominal = systematicWeights.at("central");
+    double squaredShiftDown = 0.;
+    double squaredShiftUp = 0.;
+    for( const std::string& systematic: _systematics ){
+	double shiftDown = systematicWeights.at("down_"+systematic) - nominal;
+	double shiftUp = systematicWeights.at("up_"+systematic) - nominal;
+	squaredShiftDown += shiftDown*shiftDown;
+	squaredShiftUp += shiftUp*shiftUp;
+    }
+    return { nominal, nominal - std::sqrt(squaredShiftDown), nominal + std::sqrt(squaredShiftUp) };
+}
+
+
 double ReweighterBTagShape::weightJecVar( const Event& event, 
 					    const std::string& jecVariation ) const{
     // same as weight but with propagation of jec variations
@@ -419,49 +521,169 @@ std::map< int, double > ReweighterBTagShape::calcAverageOfWeights( const Sample&
     //   note: defaults to 0, in which case all entries in the file are used
     // note: for the averaging, each entry in the input sample is counted as 1, 
     //       regardless of lumi, cross-section, generator weight or other reweighting factors!
+    // note: the entries are processed by several threads (see setNumberOfThreads),
+    //       reading only the jets and the lepton branches needed to clean them.
 
-    // make a TreeReader
     std::string inputFilePath = sample.filePath();
-    std::cout << "making TreeReader..." << std::endl;
-    TreeReader treeReader;
-    treeReader.initSampleFromFile( inputFilePath );
+    ParallelEventLoop eventLoop( inputFilePath, _numberOfThreads );
+    eventLoop.setBranchProfile( BranchProfile( { BranchProfile::eventInfo, 
+	BranchProfile::leptonKinematics, BranchProfile::leptonID, BranchProfile::jets } ) );
+    eventLoop.setLazyReading();
+    eventLoop.setMaximumNumberOfEntries( numberOfEntries );
+    std::cout << "starting event loop for " << eventLoop.numberOfEntries() << " events";
+    std::cout << " in " << eventLoop.numberOfThreads() << " threads..." << std::endl;
+
+    // sums of weights and number of entries per jet multiplicity
+    using SumsOfWeights = std::pair< std::map< int, double >, std::map< int, long unsigned > >;
+    SumsOfWeights sums = eventLoop.run(
+	[](){ return SumsOfWeights(); },
+	[this]( Event& event, SumsOfWeights& output ){
+	    // do basic jet cleaning
+	    event.cleanJetsFromFOLeptons();
+	    event.jetCollection().selectGoodJets();
+	    // determine (nominal) b-tag reweighting and number of jets
+	    // (no normalization is applied, as the normalization is being calculated)
+	    double btagreweight = this->weightNoNorm( event );
+	    int njets = event.jetCollection().goodJetCollection().size();
+	    output.first[njets] += btagreweight;
+	    output.second[njets] += 1;
+	},
+	[]( SumsOfWeights& output, const SumsOfWeights& other ){
+	    for( const auto& entry: other.first ) output.first[entry.first] += entry.second;
+	    for( const auto& entry: other.second ) output.second[entry.first] += entry.second;
+	} );
 
-    // initialize the output map
+    // divide sum by number to get average
     std::map< int, double > averageOfWeights;
-    std::map< int, int > nEntries;
-
-    // loop over events
-    long unsigned availableEntries = treeReader.numberOfEntries();
-    if( numberOfEntries==0 ) numberOfEntries = availableEntries;
-    else numberOfEntries = std::min(numberOfEntries, availableEntries);
-    std::cout << "starting event loop for " << numberOfEntries << " events..." << std::endl;
-    for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
-        Event event = treeReader.buildEvent( entry );
-
-        // do basic jet cleaning
-        event.cleanJetsFromFOLeptons();
-        event.jetCollection().selectGoodJets();
-
-        // determine (nominal) b-tag reweighting and number of jets
-        double btagreweight = this->weight( event );
-	int njets = event.jetCollection().goodJetCollection().size();	
-
-        // add it to the map
-	if(averageOfWeights.find(njets)==averageOfWeights.end()){ 
-	    averageOfWeights[njets] = btagreweight;
-	    nEntries[njets] = 1;
-	}
-	else{
-	    averageOfWeights[njets] += btagreweight;
-	    nEntries[njets] += 1;
+    for( const auto& entry: sums.first ){
+	averageOfWeights[entry.first] = entry.second / sums.second[entry.first];
+    }
+    return averageOfWeights;
+}
+
+
+/// help functions for caching normalization factors ///
+
+namespace{
+
+    // size and modification time of a file, empty if the file can not be accessed
+    std::string fileSizeAndModificationTime( const std::string& filePath ){
+	struct stat status;
+	if( stat( filePath.c_str(), &status ) != 0 ) return "";
+	return std::to_string( status.st_size ) + " " + std::to_string( status.st_mtime );
+    }
+
+    // 64-bit FNV-1a hash, used to give the cache files of different keys a different name
+    std::string normFactorCacheHash( const std::string& key ){
+	std::uint64_t hash = 14695981039346656037ull;
+	for( char c: key ){
+	    hash ^= static_cast< unsigned char >( c );
+	    hash *= 1099511628211ull;
 	}
-    } 
+	std::ostringstream hashStream;
+	hashStream << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash;
+	return hashStream.str();
+    }
+}
 
-    // divide sum by number to get average
-    for( std::map<int,double>::iterator it = averageOfWeights.begin(); 
-	    it != averageOfWeights.end(); ++it){
-	averageOfWeights[it->first] = it->second / nEntries[it->first];
+
+std::string ReweighterBTagShape::normFactorCacheKey( const Sample& sample,
+						      long unsigned numberOfEntries ) const{
+    // description of everything the normalization factors of a sample depend on,
+    // empty if the sample or scale factor file can not be accessed (e.g. remote files)
+    std::string sampleStatus = fileSizeAndModificationTime( sample.filePath() );
+    std::string sfFileStatus = fileSizeAndModificationTime( _sfFile );
+    if( sampleStatus.empty() || sfFileStatus.empty() ) return "";
+    std::string key = "sample " + sample.filePath() + "\n";
+    key += "sampleFile " + sampleStatus + "\n";
+    key += "sfFile " + _sfFile + "\n";
+    key += "sfFileStatus " + sfFileStatus + "\n";
+    key += "flavor " + _flavor + "\n";
+    key += "bTagAlgo " + _bTagAlgo + "\n";
+    key += "variations";
+    for( const std::string& variation: _variations ) key += " " + variation;
+    key += "\n";
+    key += "numberOfEntries " + std::to_string( numberOfEntries ) + "\n";
+    return key;
+}
+
+std::string ReweighterBTagShape::normFactorCacheFile( const std::string& cacheKey,
+						       const Sample& sample ) const{
+    std::string fileName = stringTools::removeOccurencesOf( sample.fileName(), ".root" );
+    return stringTools::formatDirectoryName( _normFactorCacheDirectory ) 
+	+ "bTagShapeNormFactors_" + fileName + "_" + normFactorCacheHash( cacheKey ) + ".txt";
+}
+
+bool ReweighterBTagShape::loadNormFactors( const Sample& sample, long unsigned numberOfEntries ){
+    // the cache file contains the cache key, followed by one line per jet multiplicity
+    // with the jet multiplicity and the normalization factor
+    if( _normFactorCacheDirectory.empty() ){
+	throw std::invalid_argument( std::string("ERROR in ReweighterBTagShape::loadNormFactors: ")
+	    + "no cache directory was set." );
+    }
+    std::string cacheKey = normFactorCacheKey( sample, numberOfEntries );
+    if( cacheKey.empty() ) return false;
+    std::ifstream cacheStream( normFactorCacheFile( cacheKey, sample ) );
+    if( !cacheStream.good() ) return false;
+
+    // the key must be identical, as different keys can have the same hash
+    std::string storedKey;
+    std::string line;
+    long unsigned numberOfKeyLines = std::count( cacheKey.begin(), cacheKey.end(), '\n' );
+    for( long unsigned i = 0; i < numberOfKeyLines && std::getline( cacheStream, line ); ++i ){
+	storedKey += line + "\n";
+    }
+    if( storedKey != cacheKey ) return false;
+
+    std::map<int,double> normFactors;
+    while( std::getline( cacheStream, line ) ){
+	std::istringstream lineStream( line );
+	int njets;
+	double normFactor;
+	if( !( lineStream >> njets >> normFactor ) ) return false;
+	normFactors[njets] = normFactor;
+    }
+    if( normFactors.empty() ) return false;
+    setNormFactors( sample, normFactors );
+    return true;
+}
+
+void ReweighterBTagShape::storeNormFactors( const Sample& sample, long unsigned numberOfEntries ) const{
+    // store the current normalization factors of a sample in the cache
+    // note: the file is written under a temporary name and renamed afterwards,
+    //       so jobs running at the same time never read a partially written file.
+    if( _normFactorCacheDirectory.empty() ){
+	throw std::invalid_argument( std::string("ERROR in ReweighterBTagShape::storeNormFactors: ")
+	    + "no cache directory was set." );
+    }
+    std::string cacheKey = normFactorCacheKey( sample, numberOfEntries );
+    if( cacheKey.empty() ){
+	std::cout << "WARNING in ReweighterBTagShape::storeNormFactors: normalization factors of ";
+	std::cout << sample.fileName() << " can not be cached, since the sample or scale factor file";
+	std::cout << " can not be accessed as a local file." << std::endl;
+	return;
+    }
+    auto normFactorIt = _normFactors.find( sample.fileName() );
+    if( normFactorIt == _normFactors.end() ){
+	throw std::invalid_argument( std::string("ERROR in ReweighterBTagShape::storeNormFactors: ")
+	    + "ReweighterBTagShape was not initialized for this sample!" );
+    }
+    if( !systemTools::directoryExists( _normFactorCacheDirectory ) ){
+	systemTools::makeDirectory( _normFactorCacheDirectory );
     }
 
-    return averageOfWeights;
+    std::string cacheFile = normFactorCacheFile( cacheKey, sample );
+    std::string temporaryFile = cacheFile + ".tmp" + std::to_string( getpid() );
+    std::ofstream cacheStream( temporaryFile );
+    cacheStream << cacheKey;
+    cacheStream << std::setprecision( 17 );
+    for( const auto& entry: normFactorIt->second ){
+	cacheStream << entry.first << " " << entry.second << "\n";
+    }
+    cacheStream.close();
+    if( !cacheStream || std::rename( temporaryFile.c_str(), cacheFile.c_str() ) != 0 ){
+	std::remove( temporaryFile.c_str() );
+	throw std::runtime_error( std::string("ERROR in ReweighterBTagShape::storeNormFactors: ")
+	    + "could not write cache file '" + cacheFile + "'." );
+    }
 }
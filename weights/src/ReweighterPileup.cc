@@ -81,6 +81,18 @@ void computeAndWritePileupWeights( const Sample& sample, const std::string& weig
 }
 
 
+std::shared_ptr< const ScaleFactorTable > readPileupWeightTable( TFile* filePtr, const std::string& histogramName ){
+    // helper function to copy a histogram with pileup weights into a table,
+    // the histogram itself is deleted when the file is closed
+    TH1* histPtr = dynamic_cast< TH1* >( filePtr->Get( histogramName.c_str() ) );
+    if( histPtr == nullptr ){
+        throw std::runtime_error( "File " + std::string( filePtr->GetName() ) 
+	    + " does not contain pileup weights '" + histogramName + "'." );
+    }
+    return std::make_shared< const ScaleFactorTable >( *histPtr );
+}
+
+
 // ------------
 // constructor 
 // ------------
@@ -102,11 +114,6 @@ ReweighterPileup::ReweighterPileup( const std::vector< Sample >& sampleList,
         std::string pileupWeightPath = ( stringTools::formatDirectoryName( weightDirectory ) 
 	    + "weightFiles/pileupWeights/pileupWeights_" + sample.fileName() );
 
-        //for each sample check if the necessary pileup weights are available, and produce them if not 
-        if( !systemTools::fileExists( pileupWeightPath ) ){
-            computeAndWritePileupWeights( sample, weightDirectory );
-        }
-
         //extract the pileupweights from the file
         std::string yearSuffix;
         if( sample.is2016() ){
@@ -116,20 +123,24 @@ ReweighterPileup::ReweighterPileup( const std::vector< Sample >& sampleList,
         } else{
             yearSuffix = "2018";
         }
-        TFile* puWeightFilePtr = TFile::Open( pileupWeightPath.c_str() );
-        puWeightsCentral[ sample.uniqueName() ] = std::shared_ptr< TH1 >( 
-	    dynamic_cast< TH1* >( puWeightFilePtr->Get( 
-	    ( "pileupWeights_" + yearSuffix + "_central" ).c_str() ) ) );
-        puWeightsCentral[ sample.uniqueName() ]->SetDirectory( gROOT );
-        puWeightsDown[ sample.uniqueName() ] = std::shared_ptr< TH1 >( 
-	    dynamic_cast< TH1* >( puWeightFilePtr->Get( 
-	    ( "pileupWeights_" + yearSuffix + "_down" ).c_str() ) ) );
-        puWeightsDown[ sample.uniqueName() ]->SetDirectory( gROOT );
-        puWeightsUp[ sample.uniqueName() ] = std::shared_ptr< TH1 >( 
-	    dynamic_cast< TH1* >( puWeightFilePtr->Get( 
-	    ( "pileupWeights_" + yearSuffix + "_up" ).c_str() ) ) );
-        puWeightsUp[ sample.uniqueName() ]->SetDirectory( gROOT );
-        puWeightFilePtr->Close();
+        //(the tables are shared through the ScaleFactorRegistry, and if the necessary pileup weights
+        //are not available they are produced while loading the first table, so only once per process)
+        ScaleFactorRegistry& registry = ScaleFactorRegistry::instance();
+        auto loadTable = [&]( const std::string& histogramName ){
+            return registry.get< ScaleFactorTable >( pileupWeightPath, histogramName, [&](){
+                if( !systemTools::fileExists( pileupWeightPath ) ){
+                    computeAndWritePileupWeights( sample, weightDirectory );
+                }
+                TFile* puWeightFilePtr = TFile::Open( pileupWeightPath.c_str() );
+                std::shared_ptr< const ScaleFactorTable > table = readPileupWeightTable( puWeightFilePtr, 
+                    histogramName );
+                puWeightFilePtr->Close();
+                return table;
+            } );
+        };
+        puWeightsCentral[ sample.uniqueName() ] = loadTable( "pileupWeights_" + yearSuffix + "_central" );
+        puWeightsDown[ sample.uniqueName() ] = loadTable( "pileupWeights_" + yearSuffix + "_down" );
+        puWeightsUp[ sample.uniqueName() ] = loadTable( "pileupWeights_" + yearSuffix + "_up" );
     }
 }
 
@@ -143,17 +154,11 @@ ReweighterPileup::ReweighterPileup( const std::string& pileupWeightPath ) {
     // input arguments:
     // - pileupWeightFile: path to a root file containing directly the reweighting factors
     //                     per number of vertices.
-    TFile* puWeightFilePtr = TFile::Open( pileupWeightPath.c_str() );
-    puWeightsCentralUL = std::shared_ptr< TH1 >( 
-	dynamic_cast< TH1* >( puWeightFilePtr->Get( "nominal" ) ) );
-    puWeightsCentralUL->SetDirectory( gROOT );
-    puWeightsDownUL = std::shared_ptr< TH1 >( 
-	dynamic_cast< TH1* >( puWeightFilePtr->Get( "down" ) ) );
-    puWeightsDownUL->SetDirectory( gROOT );
-    puWeightsUpUL = std::shared_ptr< TH1 >( 
-	dynamic_cast< TH1* >( puWeightFilePtr->Get( "up" ) ) );
-    puWeightsUpUL->SetDirectory( gROOT );
-    puWeightFilePtr->Close();
+    // (the tables are shared through the ScaleFactorRegistry)
+    ScaleFactorRegistry& registry = ScaleFactorRegistry::instance();
+    puWeightsCentralUL = registry.table( pileupWeightPath, "nominal" );
+    puWeightsDownUL = registry.table( pileupWeightPath, "down" );
+    puWeightsUpUL = registry.table( pileupWeightPath, "up" );
     isUL = true;
 }
 
@@ -164,22 +169,20 @@ ReweighterPileup::ReweighterPileup( const std::string& pileupWeightPath ) {
 
 double ReweighterPileup::weight( 
 	const Event& event, 
-	const std::map< std::string, std::shared_ptr< TH1 > >& weightMap ) const{
+	const std::map< std::string, std::shared_ptr< const ScaleFactorTable > >& weightMap ) const{
     auto it = weightMap.find( event.sample().uniqueName() );
     if( it == weightMap.cend() ){
         throw std::invalid_argument( "No pileup weights for sample " 
 	+ event.sample().uniqueName() + " found, this sample was probably not present"
 	+" in the vector used to construct the Reweighter." );
     }
-    TH1* histPtr = it->second.get();
-    return histogram::contentAtValue( histPtr, event.generatorInfo().numberOfTrueInteractions() );
+    return it->second->value( event.generatorInfo().numberOfTrueInteractions() );
 }
 
 double ReweighterPileup::weight( 
 	const Event& event, 
-	const std::shared_ptr< TH1 >& weightHist) const {
-    TH1* histPtr = weightHist.get();
-    return histogram::contentAtValue( histPtr, event.generatorInfo().numberOfTrueInteractions() );
+	const std::shared_ptr< const ScaleFactorTable >& weightTable ) const {
+    return weightTable->value( event.generatorInfo().numberOfTrueInteractions() );
 }
 
 double ReweighterPileup::weight( const Event& event ) const{
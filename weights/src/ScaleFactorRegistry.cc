@@ -0,0 +1,166 @@
+#include "../interface/ScaleFactorRegistry.h"
+
+//include c++ library classes
+#include <iomanip>
+
+//include ROOT classes
+#include "TROOT.h"
+#include "TFile.h"
+#include "TH2.h"
+
+//include other parts of framework
+#include "../../Tools/interface/systemTools.h"
+
+
+std::size_t resourceMemoryUsage( const TH1& hist ){
+    //bytes per bin of the histogram type, plus the sums of squared weights if they are stored
+    std::size_t bytesPerBin = ( hist.InheritsFrom( "TArrayF" ) ? sizeof( float ) : sizeof( double ) );
+    return sizeof( hist ) + hist.GetNcells()*bytesPerBin + hist.GetSumw2N()*sizeof( double );
+}
+
+
+ScaleFactorRegistry& ScaleFactorRegistry::instance(){
+
+    //reweighters using the registry can be built and evaluated in several threads
+    static const bool threadSafetyEnabled = [](){ ROOT::EnableThreadSafety(); return true; }();
+    (void) threadSafetyEnabled;
+    static ScaleFactorRegistry registry;
+    return registry;
+}
+
+
+std::shared_ptr< const void > ScaleFactorRegistry::find( const std::pair< std::string, std::string >& key, const std::type_index& type ){
+    std::lock_guard< std::mutex > resourceLock( _resourceMutex );
+    auto it = _resources.find( key );
+    if( it == _resources.end() ) return nullptr;
+    if( it->second.type != type ){
+        throw std::invalid_argument( "ERROR in ScaleFactorRegistry::get: '" + key.second + "' from '" + key.first
+            + "' was already registered as a resource of another type." );
+    }
+    ++it->second.info.requests;
+    return it->second.object;
+}
+
+
+std::unique_ptr< TH1 > ScaleFactorRegistry::readHistogram( const std::string& filePath, const std::string& histogramName ){
+    if( !systemTools::fileExists( filePath ) ){
+        throw std::invalid_argument( "ERROR in ScaleFactorRegistry::readHistogram: file '" + filePath + "' does not exist." );
+    }
+    std::unique_ptr< TFile > filePtr( TFile::Open( filePath.c_str() ) );
+    if( !filePtr || filePtr->IsZombie() ){
+        throw std::runtime_error( "ERROR in ScaleFactorRegistry::readHistogram: file '" + filePath + "' can not be opened." );
+    }
+    TH1* histPtr = dynamic_cast< TH1* >( filePtr->Get( histogramName.c_str() ) );
+    if( histPtr == nullptr ){
+        throw std::invalid_argument( "ERROR in ScaleFactorRegistry::readHistogram: file '" + filePath
+            + "' does not contain a histogram '" + histogramName + "'." );
+    }
+
+    //the copy is not attached to the file or any other directory
+    std::unique_ptr< TH1 > copyPtr( dynamic_cast< TH1* >( histPtr->Clone() ) );
+    copyPtr->SetDirectory( nullptr );
+    filePtr->Close();
+    return copyPtr;
+}
+
+
+std::shared_ptr< const TH1 > ScaleFactorRegistry::histogram( const std::string& filePath, const std::string& histogramName ){
+    return get< TH1 >( filePath, histogramName, [&](){
+        return std::shared_ptr< const TH1 >( readHistogram( filePath, histogramName ) );
+    } );
+}
+
+
+std::shared_ptr< const ScaleFactorTable > ScaleFactorRegistry::table( const std::string& filePath, const std::string& histogramName ){
+    return get< ScaleFactorTable >( filePath, histogramName, [&](){
+        std::unique_ptr< TH1 > histPtr = readHistogram( filePath, histogramName );
+        const TH2* hist2DPtr = dynamic_cast< const TH2* >( histPtr.get() );
+        if( hist2DPtr != nullptr ){
+            return std::make_shared< const ScaleFactorTable >( *hist2DPtr );
+        }
+        return std::make_shared< const ScaleFactorTable >( *histPtr );
+    } );
+}
+
+
+std::shared_ptr< const BTagCalibration > ScaleFactorRegistry::bTagCalibration( const std::string& csvFilePath ){
+    return get< BTagCalibration >( csvFilePath, "BTagCalibration", [&](){
+        return std::make_shared< const BTagCalibration >( "", csvFilePath );
+    } );
+}
+
+
+std::shared_ptr< const BTagCalibrationReader > ScaleFactorRegistry::bTagCalibrationReader( const std::string& csvFilePath,
+        const BTagEntry::OperatingPoint operatingPoint, const std::vector< std::string >& otherSysTypes,
+        const std::vector< BTagEntry::JetFlavor >& flavors, const std::string& measurementType ){
+    std::string objectName = "BTagCalibrationReader " + std::to_string( operatingPoint ) + " " + measurementType + " flavors";
+    for( const auto flavor : flavors ){
+        objectName += " " + std::to_string( flavor );
+    }
+    objectName += " sysTypes";
+    for( const auto& sysType : otherSysTypes ){
+        objectName += " " + sysType;
+    }
+    return get< BTagCalibrationReader >( csvFilePath, objectName, [&](){
+        std::shared_ptr< const BTagCalibration > calibration = bTagCalibration( csvFilePath );
+        auto reader = std::make_shared< BTagCalibrationReader >( operatingPoint, "central", otherSysTypes );
+        for( const auto flavor : flavors ){
+            reader->load( *calibration, flavor, measurementType );
+        }
+        return std::shared_ptr< const BTagCalibrationReader >( reader );
+    } );
+}
+
+
+std::vector< ScaleFactorRegistry::ResourceInfo > ScaleFactorRegistry::resources() const{
+    std::lock_guard< std::mutex > resourceLock( _resourceMutex );
+    std::vector< ResourceInfo > infos;
+    for( const auto& key : _loadOrder ){
+        infos.push_back( _resources.at( key ).info );
+    }
+    return infos;
+}
+
+
+double ScaleFactorRegistry::totalLoadTime() const{
+    double total = 0.;
+    for( const auto& info : resources() ){
+        total += info.loadTime;
+    }
+    return total;
+}
+
+
+std::size_t ScaleFactorRegistry::totalMemoryUsage() const{
+    std::size_t total = 0;
+    for( const auto& info : resources() ){
+        total += info.memoryUsage;
+    }
+    return total;
+}
+
+
+void ScaleFactorRegistry::printSummary( std::ostream& os ) const{
+    std::ios_base::fmtflags flags( os.flags() );
+    std::streamsize precision = os.precision();
+    std::vector< ResourceInfo > infos = resources();
+    os << "ScaleFactorRegistry contains " << infos.size() << " resources:" << std::endl;
+    for( const auto& info : infos ){
+        os << " - " << info.filePath << " : " << info.objectName << std::endl;
+        os << "   loaded in " << std::fixed << std::setprecision( 3 ) << info.loadTime << " s, ";
+        os << std::setprecision( 1 ) << info.memoryUsage/1e3 << " kB, ";
+        os << info.requests << ( info.requests == 1 ? " request" : " requests" ) << std::endl;
+    }
+    os << "total: " << std::setprecision( 3 ) << totalLoadTime() << " s, ";
+    os << std::setprecision( 1 ) << totalMemoryUsage()/1e3 << " kB" << std::endl;
+    os.flags( flags );
+    os.precision( precision );
+}
+
+
+void ScaleFactorRegistry::clear(){
+    std::lock_guard< std::recursive_mutex > loadLock( _loadMutex );
+    std::lock_guard< std::mutex > resourceLock( _resourceMutex );
+    _resources.clear();
+    _loadOrder.clear();
+}
@@ -0,0 +1,62 @@
+#include "../interface/ScaleFactorTable.h"
+
+//include c++ library classes
+#include <stdexcept>
+#include <string>
+
+
+ScaleFactorTable::Axis::Axis( const TAxis& axis ) :
+    _uniform( !axis.IsVariableBinSize() )
+{
+    const int numberOfBins = axis.GetNbins();
+    if( numberOfBins < 1 ){
+        throw std::invalid_argument( "ERROR in ScaleFactorTable::Axis::Axis: axis has no bins." );
+    }
+    _edges.resize( numberOfBins + 1 );
+    for( int bin = 1; bin <= numberOfBins; ++bin ){
+        _edges[ bin - 1 ] = axis.GetBinLowEdge( bin );
+    }
+    _edges[ numberOfBins ] = axis.GetBinUpEdge( numberOfBins );
+    _minCenter = axis.GetBinCenter( 1 );
+    _maxCenter = axis.GetBinCenter( numberOfBins );
+}
+
+
+ScaleFactorTable::ScaleFactorTable( const TH1& hist ) :
+    _xAxis( *hist.GetXaxis() )
+{
+    if( hist.GetDimension() != 1 ){
+        throw std::invalid_argument( "ERROR in ScaleFactorTable::ScaleFactorTable: histogram '" + std::string( hist.GetName() ) 
+            + "' has dimension " + std::to_string( hist.GetDimension() ) + ", while a 1D histogram is expected." );
+    }
+    fill( hist );
+}
+
+
+ScaleFactorTable::ScaleFactorTable( const TH2& hist ) :
+    _xAxis( *hist.GetXaxis() ),
+    _yAxis( *hist.GetYaxis() )
+{
+    fill( hist );
+}
+
+
+void ScaleFactorTable::fill( const TH1& hist ){
+    const size_type numberOfXBins = _xAxis.numberOfBins();
+    const size_type numberOfYBins = _yAxis.numberOfBins();
+    _content.resize( numberOfXBins*numberOfYBins );
+    _errorLow.resize( _content.size() );
+    _errorUp.resize( _content.size() );
+    for( size_type yIndex = 0; yIndex < numberOfYBins; ++yIndex ){
+        for( size_type xIndex = 0; xIndex < numberOfXBins; ++xIndex ){
+
+            //the y bin is ignored for 1D histograms
+            const int bin = ( hist.GetDimension() == 1 ? static_cast< int >( xIndex + 1 ) : 
+                hist.GetBin( static_cast< int >( xIndex + 1 ), static_cast< int >( yIndex + 1 ) ) );
+            const size_type index = yIndex*numberOfXBins + xIndex;
+            _content[ index ] = hist.GetBinContent( bin );
+            _errorLow[ index ] = hist.GetBinErrorLow( bin );
+            _errorUp[ index ] = hist.GetBinErrorUp( bin );
+        }
+    }
+}
@@ -0,0 +1,97 @@
+/*
+Check of the compiled b-tag scale factor formulas (BTagFormula) against TF1
+for all entries of a scale factor csv file.
+The time needed to evaluate all formulas is printed for both.
+*/
+
+#include "../bTagSFCode/BTagCalibrationStandaloneUL.h"
+
+//include c++ library classes
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//include ROOT classes
+#include "TF1.h"
+
+
+int main( int argc, char* argv[] ){
+    std::string csvFile = "../weightFilesPreUL/bTagSF/DeepJet_102XSF_V2.csv";
+    if( argc > 1 ) csvFile = argv[1];
+
+    //a default-constructed formula evaluates to 0
+    if( BTagFormula().eval( 50. ) != 0. ){
+        throw std::runtime_error( "A default-constructed formula does not evaluate to 0." );
+    }
+
+    //read the entries of the csv file
+    std::ifstream csvStream( csvFile );
+    if( !csvStream.good() ){
+        throw std::invalid_argument( "csv file '" + csvFile + "' does not exist." );
+    }
+    std::vector< BTagEntry > entries;
+    std::string line;
+    while( std::getline( csvStream, line ) ){
+        line = BTagEntry::trimStr( line );
+        if( line.empty() || line.find( "OperatingPoint" ) != std::string::npos ) continue;
+        entries.push_back( BTagEntry( line ) );
+    }
+
+    //compile the formulas on their range and compare them to TF1
+    std::vector< BTagFormula > formulas;
+    std::vector< TF1 > functions;
+    std::vector< std::vector< double > > points;
+    unsigned numberCompiled = 0;
+    for( const auto& entry : entries ){
+        double xMin = entry.params.ptMin;
+        double xMax = entry.params.ptMax;
+        if( entry.params.operatingPoint == BTagEntry::OP_RESHAPING ){
+            xMin = entry.params.discrMin;
+            xMax = entry.params.discrMax;
+        }
+        formulas.push_back( BTagFormula( entry.formula, xMin, xMax ) );
+        functions.push_back( TF1( "", entry.formula.c_str(), xMin, xMax ) );
+        if( formulas.back().isCompiled() ) ++numberCompiled;
+
+        std::vector< double > entryPoints;
+        for( unsigned i = 0; i < 100; ++i ){
+            entryPoints.push_back( xMin + ( xMax - xMin )*( i + 0.5 )/100 );
+        }
+        points.push_back( entryPoints );
+    }
+    std::cout << numberCompiled << " out of " << entries.size() << " formulas are compiled." << std::endl;
+
+    for( std::vector< BTagEntry >::size_type e = 0; e < entries.size(); ++e ){
+        for( double x : points[e] ){
+            double compiled = formulas[e].eval( x );
+            double reference = functions[e].Eval( x );
+            if( std::isnan( compiled ) && std::isnan( reference ) ) continue;
+            if( !( std::fabs( compiled - reference ) <= 1e-9*std::max( 1., std::fabs( reference ) ) ) ){
+                throw std::runtime_error( "Formula '" + entries[e].formula + "' gives " + std::to_string( compiled )
+                    + " instead of " + std::to_string( reference ) + " at " + std::to_string( x ) + "." );
+            }
+        }
+    }
+
+    //time the evaluation of all formulas
+    double sum = 0.;
+    auto start = std::chrono::steady_clock::now();
+    for( std::vector< BTagEntry >::size_type e = 0; e < entries.size(); ++e ){
+        for( double x : points[e] ) sum += formulas[e].eval( x );
+    }
+    auto middle = std::chrono::steady_clock::now();
+    for( std::vector< BTagEntry >::size_type e = 0; e < entries.size(); ++e ){
+        for( double x : points[e] ) sum -= functions[e].Eval( x );
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "compiled formulas: " << std::chrono::duration< double >( middle - start ).count() << " s" << std::endl;
+    std::cout << "TF1: " << std::chrono::duration< double >( end - middle ).count() << " s" << std::endl;
+    std::cout << "(difference of the sums: " << sum << ")" << std::endl;
+
+    std::cout << "Test completed successfully." << std::endl;
+    return 0;
+}
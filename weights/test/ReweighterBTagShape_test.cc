@@ -9,6 +9,10 @@ Test script for b-tag shape reweighter
 #include "../../Tools/interface/HistInfo.h"
 #include "../../Tools/interface/stringTools.h"
 
+// include C++ classes
+#include <cmath>
+#include <stdexcept>
+
 
 int main( int argc, char* argv[] ){
 
@@ -148,6 +152,56 @@ int main( int argc, char* argv[] ){
     std::cout << "norm factors of b-tag reweighter after initialization: " << std::endl;
     reweighterBTagShape->printNormFactors();
 
+    // === check the calculation of the norm factors ===
+    // initialize reads the jets lazily in several threads and uses weightNoNorm,
+    // this should give the same averages as a serial loop over fully built events
+    for( unsigned i = 0; i < numberOfSamples; ++i ){
+	if( modeSampleList ) treeReader.initSample( samples[i] );
+	long unsigned numberOfEntries = std::min( nEvents, treeReader.numberOfEntries() );
+	std::map< int, double > sumOfWeightsSerial;
+	std::map< int, long unsigned > nEntriesSerial;
+	for( long unsigned entry = 0; entry < numberOfEntries; ++entry ){
+	    Event event = treeReader.buildEvent( entry );
+	    event.cleanJetsFromFOLeptons();
+	    event.jetCollection().selectGoodJets();
+	    int njets = event.jetCollection().goodJetCollection().size();
+	    sumOfWeightsSerial[njets] += reweighterBTagShape->weightNoNorm( event );
+	    nEntriesSerial[njets] += 1;
+	}
+	std::map< int, double > normFactors = reweighterBTagShape->getNormFactors().at( samples[i].fileName() );
+	if( normFactors.size() != sumOfWeightsSerial.size() ){
+	    throw std::runtime_error( "norm factors of " + samples[i].fileName() + " have " + std::to_string( normFactors.size() )
+		+ " jet multiplicities instead of " + std::to_string( sumOfWeightsSerial.size() ) + "." );
+	}
+	for( const auto& entry: sumOfWeightsSerial ){
+	    double averageSerial = entry.second / nEntriesSerial[entry.first];
+	    auto normFactorIt = normFactors.find( entry.first );
+	    if( normFactorIt == normFactors.end()
+		    || std::fabs( normFactorIt->second - averageSerial ) > 1e-9*std::fabs( averageSerial ) ){
+		throw std::runtime_error( "norm factor of " + samples[i].fileName() + " for " + std::to_string( entry.first )
+		    + " jets differs from the average of weights in a serial loop." );
+	    }
+	}
+    }
+    std::cout << "norm factors agree with the averages of weights in a serial loop." << std::endl;
+
+    // === check the cache of norm factors ===
+    // a new reweighter should read the same norm factors from the cache
+    std::string cacheDirectory = "normFactorCache_ReweighterBTagShape_test";
+    reweighterBTagShape->setNormFactorCache( cacheDirectory );
+    for( const Sample& sample: samples ) reweighterBTagShape->storeNormFactors( sample, nEvents );
+    ReweighterBTagShape cachedReweighter( weightDirectory, sfFilePath, flavor, bTagAlgo, variations, samples );
+    cachedReweighter.setNormFactorCache( cacheDirectory );
+    for( const Sample& sample: samples ){
+	if( !cachedReweighter.loadNormFactors( sample, nEvents ) ){
+	    throw std::runtime_error( "norm factors of " + sample.fileName() + " were not read from the cache." );
+	}
+    }
+    if( cachedReweighter.getNormFactors() != reweighterBTagShape->getNormFactors() ){
+	throw std::runtime_error( "norm factors read from the cache differ from the calculated ones." );
+    }
+    std::cout << "norm factors read from the cache agree with the calculated ones." << std::endl;
+
     // === re-loop ===
     std::map< int, double > averageOfWeightsPostNorm;
     for( unsigned i = 0; i < numberOfSamples; ++i ){
@@ -172,6 +226,19 @@ int main( int argc, char* argv[] ){
 		averageOfWeightsPostNorm[njets] += btagreweight; }
 	    // fill the histogram
 	    bWeightDistPostNorm->Fill( btagreweight );
+	    // the weights of all variations computed together (as in a weight bank) should agree with the separate ones
+	    std::map<std::string,double> systematicWeights;
+	    WeightVariations weightVariations = reweighterBTagShape->systematicWeightVariations( event, systematicWeights );
+	    std::vector<std::pair<double,double>> comparisons = { {weightVariations.nominal, btagreweight} };
+	    for( std::string variation: variations ){
+		comparisons.push_back( {systematicWeights.at("up_"+variation), reweighterBTagShape->weightUp( event, variation )} );
+		comparisons.push_back( {systematicWeights.at("down_"+variation), reweighterBTagShape->weightDown( event, variation )} );
+	    }
+	    for( const auto& comparison: comparisons ){
+		if( std::fabs( comparison.first - comparison.second ) > 1e-9*std::fabs( comparison.second ) ){
+		    throw std::runtime_error( "b-tag weights of all variations differ from the separately computed ones." );
+		}
+	    }
 	}
     }
     // divide sum by number to get average
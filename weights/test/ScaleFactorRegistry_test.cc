@@ -0,0 +1,94 @@
+/*
+Check of the ScaleFactorRegistry:
+build the ewkino and run-2 ultralegacy reweighters for all years, once in a single thread and once in several threads at once
+starting from an empty registry (so the resources, including the b-tag scale factor readers, are loaded concurrently),
+check that every scale factor resource is read only once and shared by all reweighters,
+and print the load time and memory use of the resources.
+*/
+
+#include "../interface/ScaleFactorRegistry.h"
+#include "../interface/ConcreteReweighterFactory.h"
+
+//include c++ library classes
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+
+
+void buildReweighters( const ReweighterFactory& factory, const std::string& weightDirectory, const std::vector< std::string >& years ){
+    for( const auto& year : years ){
+        factory.buildReweighter( weightDirectory, year, std::vector< Sample >() );
+    }
+}
+
+
+void checkFactory( const ReweighterFactory& factory, const std::string& factoryName, const std::string& weightDirectory,
+        const std::vector< std::string >& years, const unsigned numberOfThreads, const bool usesBTagReaders ){
+    ScaleFactorRegistry& registry = ScaleFactorRegistry::instance();
+
+    //build the reweighters for all years once to fill the registry
+    registry.clear();
+    buildReweighters( factory, weightDirectory, years );
+    std::vector< ScaleFactorRegistry::ResourceInfo > resourcesSerial = registry.resources();
+    bool hasBTagReader = false;
+    for( const auto& resource : resourcesSerial ){
+        if( resource.objectName.find( "BTagCalibrationReader" ) == 0 ) hasBTagReader = true;
+    }
+    if( usesBTagReaders && !hasBTagReader ){
+        throw std::runtime_error( "The " + factoryName + " reweighters did not load their b-tag scale factor readers through the registry." );
+    }
+
+    //build them in several threads at once starting from an empty registry, every resource should still be loaded once
+    registry.clear();
+    std::vector< std::thread > threads;
+    for( unsigned t = 0; t < numberOfThreads; ++t ){
+        threads.emplace_back( [&](){ buildReweighters( factory, weightDirectory, years ); } );
+    }
+    for( auto& thread : threads ){
+        thread.join();
+    }
+    std::vector< ScaleFactorRegistry::ResourceInfo > resourcesThreaded = registry.resources();
+    if( resourcesThreaded.size() != resourcesSerial.size() ){
+        throw std::runtime_error( "Building the " + factoryName + " reweighters in " + std::to_string( numberOfThreads ) + " threads loaded "
+            + std::to_string( resourcesThreaded.size() ) + " resources instead of " + std::to_string( resourcesSerial.size() ) + "." );
+    }
+
+    //building them once more should not load any new resource
+    buildReweighters( factory, weightDirectory, years );
+    std::vector< ScaleFactorRegistry::ResourceInfo > resourcesAfter = registry.resources();
+    if( resourcesAfter.size() != resourcesThreaded.size() ){
+        throw std::runtime_error( "Building the " + factoryName + " reweighters again loaded "
+            + std::to_string( resourcesAfter.size() - resourcesThreaded.size() ) + " new resources." );
+    }
+    for( std::vector< ScaleFactorRegistry::ResourceInfo >::size_type i = 0; i < resourcesAfter.size(); ++i ){
+        if( resourcesAfter[i].requests != resourcesThreaded[i].requests*( numberOfThreads + 1 )/numberOfThreads ){
+            throw std::runtime_error( "Resource '" + resourcesAfter[i].objectName + "' from '" + resourcesAfter[i].filePath
+                + "' was requested " + std::to_string( resourcesAfter[i].requests ) + " times instead of "
+                + std::to_string( resourcesThreaded[i].requests*( numberOfThreads + 1 )/numberOfThreads ) + "." );
+        }
+    }
+
+    //the same object is handed out for every request
+    const ScaleFactorRegistry::ResourceInfo& firstTable = resourcesAfter.front();
+    if( registry.table( firstTable.filePath, firstTable.objectName ) != registry.table( firstTable.filePath, firstTable.objectName ) ){
+        throw std::runtime_error( "The registry returned different objects for the same resource." );
+    }
+
+    registry.printSummary();
+    std::cout << factoryName << " reweighters passed." << std::endl;
+}
+
+
+int main( int argc, char* argv[] ){
+    std::string weightDirectory = "../";
+    if( argc > 1 ) weightDirectory = argv[1];
+    unsigned numberOfThreads = 4;
+    if( argc > 2 ) numberOfThreads = static_cast< unsigned >( std::stoul( argv[2] ) );
+
+    checkFactory( EwkinoReweighterFactory(), "ewkino", weightDirectory, { "2016", "2017", "2018" }, numberOfThreads, true );
+    checkFactory( Run2ULReweighterFactory(), "run-2 ultralegacy", weightDirectory, { "2016PreVFP", "2016PostVFP", "2017", "2018" }, numberOfThreads, false );
+    std::cout << "ScaleFactorRegistry test passed." << std::endl;
+    return 0;
+}
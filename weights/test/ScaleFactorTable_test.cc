@@ -0,0 +1,103 @@
+/*
+Check of the ScaleFactorTable lookups against the histogram lookups in histogramTools,
+for uniform and variable binning and values inside and outside the histogram ranges.
+The time needed for the lookups is printed for both.
+*/
+
+#include "../interface/ScaleFactorTable.h"
+
+//include c++ library classes
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+//include ROOT classes
+#include "TH1D.h"
+#include "TH2D.h"
+
+//include other parts of framework
+#include "../../Tools/interface/histogramTools.h"
+
+
+void compare( const double lhs, const double rhs, const std::string& name ){
+    if( lhs != rhs ){
+        throw std::runtime_error( "Table gives " + std::to_string( lhs ) + " for " + name + " instead of " + std::to_string( rhs ) + "." );
+    }
+}
+
+
+int main(){
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution< double > contentDistribution( 0.8, 1.2 );
+    std::uniform_real_distribution< double > errorDistribution( 0., 0.1 );
+
+    //pileup-like histogram with uniform binning
+    TH1D uniformHist( "uniformHist", "uniformHist", 100, 0., 100. );
+    for( int bin = 1; bin <= uniformHist.GetNbinsX(); ++bin ){
+        uniformHist.SetBinContent( bin, contentDistribution( generator ) );
+        uniformHist.SetBinError( bin, errorDistribution( generator ) );
+    }
+
+    //lepton scale factor like histogram with variable binning
+    const double ptBins[] = { 10., 15., 20., 25., 35., 50., 70., 100. };
+    const double etaBins[] = { 0., 0.9, 1.2, 2.1, 2.4 };
+    TH2D variableHist( "variableHist", "variableHist", 7, ptBins, 4, etaBins );
+    for( int xBin = 1; xBin <= variableHist.GetNbinsX(); ++xBin ){
+        for( int yBin = 1; yBin <= variableHist.GetNbinsY(); ++yBin ){
+            variableHist.SetBinContent( xBin, yBin, contentDistribution( generator ) );
+            variableHist.SetBinError( xBin, yBin, errorDistribution( generator ) );
+        }
+    }
+
+    const ScaleFactorTable uniformTable( uniformHist );
+    const ScaleFactorTable variableTable( variableHist );
+
+    std::uniform_real_distribution< double > xDistribution( -10., 120. );
+    std::uniform_real_distribution< double > ptDistribution( 0., 150. );
+    std::uniform_real_distribution< double > etaDistribution( 0., 3. );
+    const unsigned numberOfLookups = 1000000;
+    std::vector< double > xValues( numberOfLookups );
+    std::vector< double > ptValues( numberOfLookups );
+    std::vector< double > etaValues( numberOfLookups );
+    for( unsigned i = 0; i < numberOfLookups; ++i ){
+        xValues[ i ] = xDistribution( generator );
+        ptValues[ i ] = ptDistribution( generator );
+        etaValues[ i ] = etaDistribution( generator );
+    }
+
+    for( unsigned i = 0; i < numberOfLookups; ++i ){
+        const WeightVariations uniformVariations = uniformTable.variations( xValues[ i ] );
+        compare( uniformTable.value( xValues[ i ] ), histogram::contentAtValue( &uniformHist, xValues[ i ] ), "uniform content" );
+        compare( uniformVariations.down, histogram::contentDownAtValue( &uniformHist, xValues[ i ] ), "uniform down" );
+        compare( uniformVariations.up, histogram::contentUpAtValue( &uniformHist, xValues[ i ] ), "uniform up" );
+
+        const WeightVariations variableVariations = variableTable.variations( ptValues[ i ], etaValues[ i ] );
+        compare( variableTable.value( ptValues[ i ], etaValues[ i ] ), histogram::contentAtValues( &variableHist, ptValues[ i ], etaValues[ i ] ), "variable content" );
+        compare( variableVariations.down, histogram::contentDownAtValues( &variableHist, ptValues[ i ], etaValues[ i ] ), "variable down" );
+        compare( variableVariations.up, histogram::contentUpAtValues( &variableHist, ptValues[ i ], etaValues[ i ] ), "variable up" );
+    }
+
+    double histogramSum = 0.;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for( unsigned i = 0; i < numberOfLookups; ++i ){
+        histogramSum += histogram::contentAtValues( &variableHist, ptValues[ i ], etaValues[ i ] );
+        histogramSum += histogram::contentDownAtValues( &variableHist, ptValues[ i ], etaValues[ i ] );
+        histogramSum += histogram::contentUpAtValues( &variableHist, ptValues[ i ], etaValues[ i ] );
+    }
+    std::chrono::duration< double > histogramTime = std::chrono::high_resolution_clock::now() - begin;
+
+    double tableSum = 0.;
+    begin = std::chrono::high_resolution_clock::now();
+    for( unsigned i = 0; i < numberOfLookups; ++i ){
+        const WeightVariations variations = variableTable.variations( ptValues[ i ], etaValues[ i ] );
+        tableSum += variations.nominal + variations.down + variations.up;
+    }
+    std::chrono::duration< double > tableTime = std::chrono::high_resolution_clock::now() - begin;
+
+    std::cout << "histogram lookups : " << histogramTime.count() << " s (sum " << histogramSum << ")" << std::endl;
+    std::cout << "table lookups : " << tableTime.count() << " s (sum " << tableSum << ")" << std::endl;
+    std::cout << "Table lookups agree with histogram lookups." << std::endl;
+    return 0;
+}
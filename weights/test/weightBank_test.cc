@@ -0,0 +1,78 @@
+/*
+Check of the weight bank filled by CombinedReweighter::computeWeights.
+For every event the weights in the bank are compared to the weights of the individual reweighters,
+and the time needed to compute all variations is compared for both ways of computing them.
+*/
+
+#include "../interface/CombinedReweighter.h"
+#include "../interface/ConcreteReweighterFactory.h"
+
+//include c++ library classes
+#include <iostream>
+#include <memory>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+//include other parts of framework
+#include "../../TreeReader/interface/TreeReader.h"
+#include "../../Event/interface/Event.h"
+
+
+void compare( const double lhs, const double rhs, const std::string& name ){
+    if( std::fabs( lhs - rhs ) > 1e-9*std::fabs( rhs ) ){
+        throw std::runtime_error( "Weight bank gives " + std::to_string( lhs ) + " for " + name + " instead of " + std::to_string( rhs ) + "." );
+    }
+}
+
+
+int main(){
+
+    TreeReader treeReader;
+    treeReader.readSamples("../testData/samples_test.txt", "../testData");
+
+    std::shared_ptr< ReweighterFactory >reweighterFactory( new EwkinoReweighterFactory() );
+    CombinedReweighter reweighter = reweighterFactory->buildReweighter( 
+	"../", "2016", treeReader.sampleVector() );
+    const std::vector< std::string > names = { "muonID", "electronID", "electronReco_pTBelow20", "electronReco_pTAbove20", "pileup", "prefire", "bTag" };
+
+    std::chrono::duration< double > bankTime( 0. );
+    std::chrono::duration< double > separateTime( 0. );
+    WeightBank bank;
+    for( unsigned sampleIndex = 0; sampleIndex < treeReader.numberOfSamples(); ++sampleIndex ){
+        treeReader.initSample();
+        if( !treeReader.is2016() || treeReader.isData() ) continue;
+
+        for( long unsigned entry = 0; entry < treeReader.numberOfEntries();  ++entry ){
+            Event event = treeReader.buildEvent( entry );
+
+            auto begin = std::chrono::high_resolution_clock::now();
+            reweighter.computeWeights( event, bank );
+            bankTime += std::chrono::high_resolution_clock::now() - begin;
+
+            begin = std::chrono::high_resolution_clock::now();
+            double nominal = reweighter.totalWeight( event );
+            std::vector< double > totalDown;
+            std::vector< double > totalUp;
+            for( const auto& name : names ){
+                totalDown.push_back( nominal / reweighter[ name ]->weight( event ) * reweighter[ name ]->weightDown( event ) );
+                totalUp.push_back( nominal / reweighter[ name ]->weight( event ) * reweighter[ name ]->weightUp( event ) );
+            }
+            separateTime += std::chrono::high_resolution_clock::now() - begin;
+
+            compare( bank.nominal(), nominal, "nominal weight" );
+            for( std::vector< std::string >::size_type i = 0; i < names.size(); ++i ){
+                const auto index = reweighter.reweighterIndex( names[ i ] );
+                compare( bank.nominal( index ), reweighter[ names[ i ] ]->weight( event ), names[ i ] + " nominal" );
+                compare( bank.weightDown( index ), reweighter[ names[ i ] ]->weightDown( event ), names[ i ] + " down" );
+                compare( bank.weightUp( index ), reweighter[ names[ i ] ]->weightUp( event ), names[ i ] + " up" );
+                compare( bank.totalWeightDown( index ), totalDown[ i ], names[ i ] + " total down" );
+                compare( bank.totalWeightUp( index ), totalUp[ i ], names[ i ] + " total up" );
+            }
+        }
+    }
+    std::cout << "computing weight bank : " << bankTime.count() << " s" << std::endl;
+    std::cout << "computing variations separately : " << separateTime.count() << " s" << std::endl;
+    std::cout << "Weight bank agrees with the individual reweighters." << std::endl;
+    return 0;
+}